@@ -11,7 +11,9 @@
 #include "tim.h"
 #include "gpio.h"
 #include "usb_device.h"
+#include "charge_adc.h"
 #include "cmsis_os.h"
+#include "mem_section.h"
 
 /* 外部全局变量（需要在CubeMX生成的文件中定义） */
 extern TIM_HandleTypeDef htim1;
@@ -22,7 +24,7 @@ extern TIM_HandleTypeDef htim5;
 extern TIM_HandleTypeDef htim10;
 
 /* 全局应用对象 */
-static CleanBotApp_t g_CleanBotApp;
+CCM_DATA static CleanBotApp_t g_CleanBotApp;
 CleanBotApp_t *g_pCleanBotApp = &g_CleanBotApp;
 
 /**
@@ -92,6 +94,17 @@ void CleanBotApp_Init(CleanBotApp_t *app)
     PID_Init(&app->pidFan, PID_FAN_KP, PID_FAN_KI, PID_FAN_KD);
     PID_SetOutputLimit(&app->pidFan, PID_FAN_OUT_MIN, PID_FAN_OUT_MAX);
     
+    /* 初始化差速运动控制器 */
+    MotionCtrl_Init(&app->motionCtrl, WHEEL_TRACK_WIDTH_M);
+    MotionCtrl_SetLimits(&app->motionCtrl,
+                         MOTION_MAX_LINEAR_VEL, MOTION_MAX_LINEAR_ACC, MOTION_MAX_LINEAR_JERK,
+                         MOTION_MAX_ANGULAR_VEL, MOTION_MAX_ANGULAR_ACC, MOTION_MAX_ANGULAR_JERK);
+    MotionCtrl_SetSyncGains(&app->motionCtrl, MOTION_SYNC_KP, MOTION_SYNC_KI, MOTION_SYNC_INTEGRAL_MAX);
+    MotionCtrl_SetYawFeedback(&app->motionCtrl, MOTION_YAW_FEEDBACK_ENABLE != 0, MOTION_YAW_KP);
+    
+    /* 初始化轨迹缓冲 */
+    Trajectory_Init(&app->trajectory);
+    
     /* 初始化红外传感器 */
     IR_Sensor_Init(&app->irSensorLeft, IR_SENSOR_LEFT, 
                    L_RECEIVE_GPIO_Port, L_RECEIVE_Pin);
@@ -135,6 +148,11 @@ void CleanBotApp_Init(CleanBotApp_t *app)
     /* 初始化红外回冲定位模块 */
     IRHoming_Init(&app->irHoming);
     
+    /* 初始化充电触点检测 */
+    ChargeADC_Init();
+    ChargeContact_Init(&app->chargeContact, CHARGE_CONTACT_ON_MV, CHARGE_CONTACT_OFF_MV,
+                       CHARGE_CONTACT_ON_MS, CHARGE_CONTACT_OFF_MS);
+    
     /* 初始化下视传感器状态 */
     app->underLeftSuspended = false;
     app->underRightSuspended = false;
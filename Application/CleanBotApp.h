@@ -18,8 +18,11 @@ extern "C" {
 #include "motor.h"
 #include "encoder.h"
 #include "pid_controller.h"
+#include "motion_ctrl.h"
+#include "trajectory.h"
 #include "ir_sensor.h"
 #include "photo_gate.h"
+#include "charge_contact.h"
 #include "led.h"
 #include "buzzer.h"
 #include "usb_comm.h"
@@ -56,6 +59,10 @@ typedef struct {
     PIDController_t pidWheelRight; /* 右轮PID */
     PIDController_t pidFan;        /* 风机PID */
     
+    /* 运动控制 */
+    MotionCtrl_t motionCtrl;       /* 差速运动控制器 (v, ω) */
+    Trajectory_t trajectory;       /* 上位机轨迹缓冲 */
+    
     /* 传感器 */
     IR_Sensor_t irSensorLeft;      /* 左侧红外传感器 */
     IR_Sensor_t irSensorRight;     /* 右侧红外传感器 */
@@ -82,6 +89,7 @@ typedef struct {
     
     /* 回冲定位 */
     IRHoming_t irHoming;           /* 红外回冲定位模块 */
+    ChargeContact_t chargeContact; /* 充电触点接触判定 */
     
     /* 状态 */
     CleanBotState_t state;         /* 当前状态 */
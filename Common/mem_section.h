@@ -0,0 +1,48 @@
+/**
+  ******************************************************************************
+  * @file    mem_section.h
+  * @brief   RAM 区放置宏（CCM / DMA 可见的 SRAM1）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * STM32F407 的 64KB CCM（0x10000000）只挂在 Cortex-M4 D 总线上，DMA 与
+  * USB OTG 都不能访问；CPU 访问 CCM 不经过总线矩阵，不与 USART3 DMA、
+  * USB FIFO 搬运争用 SRAM1 端口。放置规则：
+  * - CCM_DATA：只由 CPU 读写的热数据（控制/PID/编码器状态、中断状态、
+  *   任务栈、跟踪环），栈上变量因此也不得交给 DMA
+  * - DMA_BUFFER：DMA 读写的缓冲，固定放在 SRAM1（RW_IRAM1）
+  * 两个宏只能用于不带初值的静态/全局变量（段名以 .bss 开头，由启动代码清零）。
+  * 段在 MDK-ARM/CleanBot.sct 中定位。MEM_CCM_ENABLE=0 时 CCM_DATA 为空，
+  * 变量回到 SRAM，用于前后对比抖动；非 armclang 编译（SIL/上位机）两宏均为空。
+  ******************************************************************************
+  */
+
+#ifndef __MEM_SECTION_H__
+#define __MEM_SECTION_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "system_config.h"
+
+#if defined(__ARMCC_VERSION)
+#define MEM_SECTION(name)           __attribute__((section(name)))
+#else
+#define MEM_SECTION(name)
+#endif
+
+#if MEM_CCM_ENABLE
+#define CCM_DATA                    MEM_SECTION(".bss.ccmram")
+#else
+#define CCM_DATA
+#endif
+
+#define DMA_BUFFER                  MEM_SECTION(".bss.sram1_dma")
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MEM_SECTION_H__ */
@@ -57,9 +57,18 @@ extern "C" {
 /* PID控制器模块 */
 #include "pid_controller.h"
 
+/* 运动控制模块 */
+#include "motion_ctrl.h"
+#include "trajectory.h"
+
 /* 传感器模块 */
 #include "ir_sensor.h"
 #include "photo_gate.h"
+#include "charge_contact.h"
+#include "charge_adc.h"
+
+/* 安全反射模块 */
+#include "safety_reflex.h"
 
 /* 指示器模块 */
 #include "led.h"
@@ -70,6 +79,7 @@ extern "C" {
 
 /* 工具模块 */
 #include "ring_buffer.h"
+#include "ir_decode.h"
 #include "nec_decode.h"
 
 /* ============================================
@@ -87,6 +87,9 @@ extern "C" {
 #define IR_SENSOR_FRONT_RIGHT_PORT  R_FOLLOW_CHECK_SIGNAL_GPIO_Port
 #define IR_SENSOR_FRONT_RIGHT_PIN   R_FOLLOW_CHECK_SIGNAL_Pin
 
+/* 红外一体化接收头输出极性：1=载波期间输出低电平（空闲高电平） */
+#define IR_RECEIVER_ACTIVE_LOW      1
+
 /* 光电门引脚 */
 #define PHOTO_GATE_LEFT_PORT   IFHIT_L_GPIO_Port
 #define PHOTO_GATE_LEFT_PIN    IFHIT_L_Pin
@@ -167,6 +170,35 @@ extern TIM_HandleTypeDef htim10;  /* 假设使用TIM10 */
 #define PID_FAN_OUT_MAX         1000.0f
 #define PID_FAN_OUT_MIN         0.0f
 
+/* ============================================
+   差速运动控制配置 (Motion Control Configuration)
+   ============================================ */
+
+/* 底盘几何参数 */
+#define WHEEL_DIAMETER_M            0.065f  /* 轮直径 (m) */
+#define WHEEL_TRACK_WIDTH_M         0.230f  /* 两轮轮距 (m)（需要实际测量后设置） */
+
+/* 速度/加速度/加加速度限制 */
+#define MOTION_MAX_LINEAR_VEL       0.50f   /* 最大线速度 (m/s) */
+#define MOTION_MAX_LINEAR_ACC       0.80f   /* 最大线加速度 (m/s^2) */
+#define MOTION_MAX_LINEAR_JERK      4.00f   /* 最大线加加速度 (m/s^3) */
+#define MOTION_MAX_ANGULAR_VEL      3.00f   /* 最大角速度 (rad/s) */
+#define MOTION_MAX_ANGULAR_ACC      6.00f   /* 最大角加速度 (rad/s^2) */
+#define MOTION_MAX_ANGULAR_JERK     30.0f   /* 最大角加加速度 (rad/s^3) */
+
+/* 交叉耦合同步参数 */
+#define MOTION_SYNC_KP              0.80f
+#define MOTION_SYNC_KI              2.00f
+#define MOTION_SYNC_INTEGRAL_MAX    0.10f   /* 同步积分限幅 (m/s) */
+
+/* IMU偏航角速度反馈 */
+#define MOTION_YAW_FEEDBACK_ENABLE  1       /* 1:启用 0:仅使用编码器 */
+#define MOTION_YAW_KP               0.50f
+
+/* IMU 数据超过该时间没有新帧（掉线、停靠停止接收）视为失效：偏航反馈与
+   打滑判定暂停，回冲航向改按指令角速度推算（模块输出 200Hz） */
+#define IMU_DATA_MAX_AGE_MS         50
+
 /* ============================================
    电机速度限制 (Motor Speed Limits)
    ============================================ */
@@ -199,6 +231,78 @@ extern TIM_HandleTypeDef htim10;  /* 假设使用TIM10 */
 #define FAN_MOTOR_SPEED_4       800    /* 档位4 */
 #define FAN_MOTOR_SPEED_5       1000    /* 档位5 */
 
+/* 辅助电机软启动斜率 (占空比/秒，满量程1000) */
+/* HEAVY=1 的通道互斥上升，错开启动电流峰值 */
+#define RAMP_BRUSH_SLEW_UP      1000.0f /* 边刷约0.8s升至高速 */
+#define RAMP_BRUSH_SLEW_DOWN    4000.0f
+#define RAMP_BRUSH_HEAVY        0
+#define RAMP_PUMP_SLEW_UP       1500.0f /* 水泵 */
+#define RAMP_PUMP_SLEW_DOWN     5000.0f
+#define RAMP_PUMP_HEAVY         1
+#define RAMP_FAN_SLEW_UP        800.0f  /* 风机约1.25s升至满速 */
+#define RAMP_FAN_SLEW_DOWN      3000.0f
+#define RAMP_FAN_HEAVY          1
+
+/* 轮电机堵转/打滑/卡滞检测（阈值需结合上位机采集的诊断数据整定） */
+#define MOTOR_DIAG_DUTY_DEADBAND    200.0f  /* 起转死区，与PID非零目标时的+200补偿一致 */
+#define MOTOR_DIAG_FREE_SPEED_MS    0.60f   /* 满占空比空载轮速 (m/s)（需要实际测量后设置） */
+#define MOTOR_DIAG_MODEL_TAU        0.15f   /* 占空比->轮速模型时间常数 (s) */
+#define MOTOR_DIAG_STALL_DUTY_MIN   500.0f  /* 堵转：占空比不低于该值 */
+#define MOTOR_DIAG_STALL_SPEED_MAX  0.02f   /* 堵转：轮速低于该值 (m/s) */
+#define MOTOR_DIAG_STALL_TIME       0.30f   /* 堵转：持续时间 (s) */
+#define MOTOR_DIAG_JAM_SPEED_RATIO  0.40f   /* 卡滞：实测不足模型速度的比例 */
+#define MOTOR_DIAG_JAM_DUTY_MIN     400.0f  /* 卡滞：占空比不低于该值 */
+#define MOTOR_DIAG_JAM_TIME         0.50f   /* 卡滞：持续时间 (s) */
+#define MOTOR_DIAG_SLIP_ENABLE      1       /* 1:用IMU偏航角速度判定打滑 */
+#define MOTOR_DIAG_SLIP_YAW_ERR     0.50f   /* 打滑：偏航角速度差 (rad/s) */
+#define MOTOR_DIAG_SLIP_TIME        0.20f   /* 打滑：持续时间 (s) */
+#define MOTOR_DIAG_DUTY_LIMIT_STALL 300.0f  /* 堵转时占空比上限（须低于STALL_DUTY_MIN） */
+#define MOTOR_DIAG_DUTY_LIMIT_JAM   600.0f  /* 卡滞时占空比上限 */
+#define MOTOR_DIAG_DUTY_LIMIT_SLIP  450.0f  /* 打滑时占空比上限 */
+#define MOTOR_DIAG_HOLD_TIME        1.00f   /* 条件消失后保持限幅时间 (s) */
+
+/* 碰撞/悬崖安全反射（策略：0=不动作 1=刹停 2=刹停后退 3=后退并转离触发侧） */
+/* 左右前下视与左右前红外接收头共用引脚，回充对接时屏蔽（见USB控制DOCK模式） */
+#define SAFETY_BUMPER_POLICY        3
+#define SAFETY_CLIFF_POLICY         2
+/* 左/右前下视：红外接收头空闲输出高电平，与"悬空"电平相同，无法区分无信号与
+   悬崖，硬件分离两路信号前不触发反射（仅上报传感器事件），中下视仍按上面策略 */
+#define SAFETY_SHARED_CLIFF_POLICY  0
+#define SAFETY_STOP_TIME_MS         50      /* 后退前刹停时间 (ms) */
+#define SAFETY_BACKOFF_SPEED_MS     0.15f   /* 后退速度 (m/s) */
+#define SAFETY_BACKOFF_TIME_MS      300     /* 后退时间 (ms) */
+#define SAFETY_TURN_SPEED_MS        0.10f   /* 转向轮速 (m/s) */
+#define SAFETY_TURN_TIME_MS         400     /* 转向时间 (ms) */
+
+/* 与红外接收头共用引脚的左/右前下视：电平保持不变超过该时间才确认（NEC 帧内
+   边沿间隔不超过 9ms），由电机控制任务每周期采样 */
+#define SAFETY_SHARED_CLIFF_STABLE_MS   20
+
+/* 轮电机PWM定时器(TIM4，APB1)计数时钟 (MHz)：反射延迟按比较值生效的更新事件计 */
+#define WHEEL_PWM_TIM_CLOCK_MHZ     84U
+
+/* 红外回冲航向：1=IMU偏航角闭环，0=按指令角速度积分推算航向（IMU不可用时） */
+#define HOMING_IMU_ENABLE           1
+#define HOMING_HEADING_KP           2.5f    /* 航向误差 -> 角速度增益 (1/s) */
+#define HOMING_MEMORY_MAX_AGE_MS    20000   /* 信标方向记忆有效期 (ms) */
+#define HOMING_DOCK_CONTACT_WAIT_MS 1500    /* 碰撞后继续顶住等待充电触点接通的时间 (ms) */
+#define HOMING_DOCK_CREEP_MAX_MS    30000   /* 对接阶段最长前进时间，超时未接触则重试 (ms) */
+#define HOMING_DOCK_MAX_RETRIES     3       /* 后退重新对准的最大次数，用完判为失败 */
+
+/* 充电触点检测：座端电压经分压接入 ADC1（PC0 = ADC123_IN10） */
+#define CHARGE_ADC_SOURCE           0       /* 0=ADC采样 1=替身模拟源（两侧碰撞同时触发时输出座端电压，台架测试用） */
+#define CHARGE_ADC_PORT             GPIOC
+#define CHARGE_ADC_PIN              GPIO_PIN_0
+#define CHARGE_ADC_CHANNEL          10U
+#define CHARGE_ADC_VREF_MV          3300U
+#define CHARGE_ADC_DIVIDER          11.0f   /* 分压比 (100k+10k)/10k（需按实际电路设置） */
+#define CHARGE_ADC_OVERSAMPLE       4U      /* 每次读取平均的转换次数 */
+#define CHARGE_DOCK_MV              19000U  /* 座端输出电压 (mV)，替身模拟源使用 */
+#define CHARGE_CONTACT_ON_MV        15000U  /* 高于该电压视为接通 (mV) */
+#define CHARGE_CONTACT_OFF_MV       10000U  /* 低于该电压视为断开 (mV) */
+#define CHARGE_CONTACT_ON_MS        60U     /* 接通确认时间，滤除触点弹跳 (ms) */
+#define CHARGE_CONTACT_OFF_MS       200U    /* 断开确认时间 (ms) */
+
 /* ============================================
    USB通信配置 (USB Communication Config)
    ============================================ */
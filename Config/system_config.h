@@ -86,6 +86,29 @@ extern "C" {
 #define DEBUG_USE_USB               1
 #define DEBUG_USE_UART              0
 
+/* 事件跟踪：中断进出/任务切换/代码标记写入环形缓冲，经USB导出（见 trace.h） */
+#define TRACE_ENABLE                DEBUG_ENABLE
+#define TRACE_RING_EVENTS           512     /* 环形缓冲事件数（2的幂，每个8字节） */
+
+/* 热点剖析：DWT周期计数探针的次数/极值/均值与log2直方图，经USB读取（见 prof.h） */
+#define PROF_ENABLE                 DEBUG_ENABLE
+
+/* ============================================
+   低功耗配置
+   ============================================ */
+
+/* 停靠模式：充电触点接通且整机空闲（无运动、辅助电机、回充动作）持续
+   POWER_DOCK_ENTER_MS 后进入，按键、USB 运动/工作模式命令或触点断开时退出
+   （见 power_mgr.h）；空闲 WFI 由 FreeRTOSConfig.h 的 configUSE_TICKLESS_IDLE 控制 */
+#define POWER_DOCK_ENABLE           1
+#define POWER_DOCK_ENTER_MS         5000
+#define POWER_DOCKED_CHARGE_MS      100     /* 停靠时充电触点采样周期 */
+#define POWER_DOCKED_REPORT_MS      1000    /* 停靠时 USB 连接检查与遥测周期 */
+
+/* 停靠时是否保留红外接收：基站持续发射信标，保留时每个边沿都会唤醒CPU，
+   默认屏蔽红外 EXTI 并暂停解码，离座后恢复 */
+#define POWER_DOCKED_IR_WAKE        0
+
 /* ============================================
    错误处理配置
    ============================================ */
@@ -114,13 +137,46 @@ typedef enum {
 
 #define WATCHDOG_ENABLE             1
 #define WATCHDOG_TIMEOUT_MS          5000
+#define WATCHDOG_CHECK_MS           100     /* 节拍钩子检查签到与喂狗周期 */
+#define WATCHDOG_CHECKIN_MS         500     /* 事件驱动任务的最长等待，保证按时签到 */
+
+/* 各任务签到超时（不小于任务最长等待的两倍） */
+#define WATCHDOG_SENSOR_TIMEOUT_MS  1000    /* 作业到期驱动，停靠时 POWER_DOCKED_CHARGE_MS */
+#define WATCHDOG_MOTOR_TIMEOUT_MS   1000    /* 2ms 控制周期，停靠时 WATCHDOG_CHECKIN_MS */
+#define WATCHDOG_USB_TIMEOUT_MS     2500    /* 最长等待 1s（系统状态/停靠连接检查） */
+#define WATCHDOG_IMU_TIMEOUT_MS     1000    /* 串口接收唤醒，停靠时 WATCHDOG_CHECKIN_MS */
+
+/* ============================================
+   黑匣子配置
+   ============================================ */
+
+/* 黑匣子：传感器任务按周期抽取轮速/IMU/控制/故障，差分编码写入 RAM 环；
+   签到超时、故障异常与 Error_Handler 时把 RAM 环写入内部 Flash 保留扇区，
+   复位后经 USB 0x16/0x2F 下载（见 blackbox.h） */
+#define BLACKBOX_ENABLE             1
+#define BLACKBOX_PERIOD_MS          20      /* 采样周期（50Hz，控制周期的 10 倍抽取） */
+#define BLACKBOX_DOCKED_PERIOD_MS   1000    /* 停靠时采样周期 */
+#define BLACKBOX_BLOCK_SIZE         512     /* 块大小，每块以关键帧开始，可独立解码 */
+#define BLACKBOX_RING_SIZE          16384   /* RAM 环大小（BLACKBOX_BLOCK_SIZE 的整数倍） */
+
+/* Flash 保留扇区：扇区11（0x080E0000，128KB），已在 MDK-ARM/CleanBot.sct 中
+   从代码区剔除；擦除期间 CPU 取指停顿约 1s，只在上电初始化（启动 IWDG 之前）进行 */
+#define BLACKBOX_FLASH_SECTOR       11U
+#define BLACKBOX_FLASH_OFFSET       0x000E0000U     /* 相对 FLASH_BASE */
+#define BLACKBOX_FLASH_SIZE         0x00020000U
+#define BLACKBOX_ERASE_TIMEOUT_MS   4000U           /* 128KB 扇区擦除上限（数据手册最大值），代替 HAL 的 50s */
 
 /* ============================================
    内存配置
    ============================================ */
 
-/* 堆内存配置 */
-#define HEAP_SIZE                   8192    /* FreeRTOS堆大小 (字节) */
+/* 任务、队列、定时器均为静态创建，FreeRTOS 堆（configTOTAL_HEAP_SIZE，见
+   FreeRTOSConfig.h）仅作预留；各模块 RAM 占用由 TEST/ram_budget.py 按链接
+   map 文件统计 */
+
+/* CCM 放置：CPU 独占的热数据与任务栈放入 64KB CCM（见 mem_section.h）；
+   置 0 时全部回到 SRAM，用于对比 prof 周期探针的抖动 */
+#define MEM_CCM_ENABLE              1
 
 /* 缓冲区大小 */
 #define RING_BUFFER_SIZE            256
@@ -63,12 +63,13 @@
 #define configSUPPORT_STATIC_ALLOCATION          1
 #define configSUPPORT_DYNAMIC_ALLOCATION         1
 #define configUSE_IDLE_HOOK                      0
-#define configUSE_TICK_HOOK                      0
+#define configUSE_TICK_HOOK                      1
+#define configUSE_TICKLESS_IDLE                  1
 #define configCPU_CLOCK_HZ                       ( SystemCoreClock )
 #define configTICK_RATE_HZ                       ((TickType_t)1000)
 #define configMAX_PRIORITIES                     ( 56 )
 #define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
-#define configTOTAL_HEAP_SIZE                    ((size_t)15360)
+#define configTOTAL_HEAP_SIZE                    ((size_t)1024)
 #define configMAX_TASK_NAME_LEN                  ( 16 )
 #define configUSE_TRACE_FACILITY                 1
 #define configUSE_16_BIT_TICKS                   0
@@ -165,6 +166,32 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* 运行时间统计：时基为 DWT 折算的微秒计数（Timebase_GetUs），供 task_stats 计算各任务CPU占用 */
+#define configGENERATE_RUN_TIME_STATS            1
+#define configUSE_STATS_FORMATTING_FUNCTIONS     0
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+void configureTimerForRunTimeStats(void);
+unsigned long getRunTimeCounterValue(void);
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS   configureTimerForRunTimeStats
+#define portGET_RUN_TIME_COUNTER_VALUE           getRunTimeCounterValue
+
+/* 低功耗：tickless 空闲 WFI 前后暂停/恢复 HAL 时基 TIM6 并统计睡眠与唤醒源，
+   任务切入时计唤醒延迟（power_mgr.c） */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+void PreSleepProcessing(uint32_t *ulExpectedIdleTime);
+void PostSleepProcessing(uint32_t *ulExpectedIdleTime);
+void PowerMgr_TaskSwitchedIn(void *task);
+#endif
+#define configPRE_SLEEP_PROCESSING(x)            PreSleepProcessing(&(x))
+#define configPOST_SLEEP_PROCESSING(x)           PostSleepProcessing(&(x))
+
+/* 事件跟踪：任务切入时记录任务编号（trace.c，TRACE_ENABLE=0 时为空操作） */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+void Trace_TaskSwitchedIn(uint32_t taskNumber);
+#endif
+#define traceTASK_SWITCHED_IN()                  do { Trace_TaskSwitchedIn(pxCurrentTCB->uxTCBNumber); \
+                                                      PowerMgr_TaskSwitchedIn(pxCurrentTCB); } while (0)
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -27,13 +27,21 @@
 /* USER CODE BEGIN Includes */
 #include "CleanBotApp.h"
 #include "sensor_manager.h"
+#include "safety_reflex.h"
+#include "power_mgr.h"
+#include "supervisor.h"
 #include "sensor_task.h"
 #include "motor_ctrl_task.h"
 #include "usb_comm_task.h"
 #include "imu_task.h"
+#include "timebase.h"
+#include "trace.h"
+#include "prof.h"
+#include "mem_section.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
+typedef StaticTask_t osStaticThreadDef_t;
 /* USER CODE BEGIN PTD */
 
 /* USER CODE END PTD */
@@ -54,9 +62,14 @@
 /* USER CODE END Variables */
 /* Definitions for defaultTask */
 osThreadId_t defaultTaskHandle;
+CCM_DATA uint32_t defaultTaskBuffer[ 128 ];
+CCM_DATA osStaticThreadDef_t defaultTaskControlBlock;
 const osThreadAttr_t defaultTask_attributes = {
   .name = "defaultTask",
-  .stack_size = 128 * 4,
+  .cb_mem = &defaultTaskControlBlock,
+  .cb_size = sizeof(defaultTaskControlBlock),
+  .stack_mem = &defaultTaskBuffer[0],
+  .stack_size = sizeof(defaultTaskBuffer),
   .priority = (osPriority_t) osPriorityNormal,
 };
 
@@ -64,33 +77,53 @@ const osThreadAttr_t defaultTask_attributes = {
 /* USER CODE BEGIN FunctionPrototypes */
 /* Definitions for SensorTask */
 osThreadId_t sensorTaskHandle;
+CCM_DATA uint32_t sensorTaskBuffer[ TASK_STACK_SIZE_SENSOR ];
+CCM_DATA osStaticThreadDef_t sensorTaskControlBlock;
 const osThreadAttr_t sensorTask_attributes = {
   .name = "sensorTask",
-  .stack_size = TASK_STACK_SIZE_SENSOR * 4,
+  .cb_mem = &sensorTaskControlBlock,
+  .cb_size = sizeof(sensorTaskControlBlock),
+  .stack_mem = &sensorTaskBuffer[0],
+  .stack_size = sizeof(sensorTaskBuffer),
   .priority = (osPriority_t) TASK_PRIORITY_SENSOR,
 };
 
 /* Definitions for MotorCtrlTask */
 osThreadId_t motorCtrlTaskHandle;
+CCM_DATA uint32_t motorCtrlTaskBuffer[ TASK_STACK_SIZE_MOTOR_CTRL ];
+CCM_DATA osStaticThreadDef_t motorCtrlTaskControlBlock;
 const osThreadAttr_t motorCtrlTask_attributes = {
   .name = "motorCtrlTask",
-  .stack_size = TASK_STACK_SIZE_MOTOR_CTRL * 4,
+  .cb_mem = &motorCtrlTaskControlBlock,
+  .cb_size = sizeof(motorCtrlTaskControlBlock),
+  .stack_mem = &motorCtrlTaskBuffer[0],
+  .stack_size = sizeof(motorCtrlTaskBuffer),
   .priority = (osPriority_t) TASK_PRIORITY_MOTOR_CTRL,
 };
 
 /* Definitions for USBCommTask */
 osThreadId_t usbCommTaskHandle;
+CCM_DATA uint32_t usbCommTaskBuffer[ TASK_STACK_SIZE_USB_COMM ];
+CCM_DATA osStaticThreadDef_t usbCommTaskControlBlock;
 const osThreadAttr_t usbCommTask_attributes = {
   .name = "usbCommTask",
-  .stack_size = TASK_STACK_SIZE_USB_COMM * 4,
+  .cb_mem = &usbCommTaskControlBlock,
+  .cb_size = sizeof(usbCommTaskControlBlock),
+  .stack_mem = &usbCommTaskBuffer[0],
+  .stack_size = sizeof(usbCommTaskBuffer),
   .priority = (osPriority_t) TASK_PRIORITY_USB_COMM,
 };
 
 /* Definitions for IMUTask */
 osThreadId_t imuTaskHandle;
+CCM_DATA uint32_t imuTaskBuffer[ 512 ];
+CCM_DATA osStaticThreadDef_t imuTaskControlBlock;
 const osThreadAttr_t imuTask_attributes = {
   .name = "imuTask",
-  .stack_size = 512 * 4,
+  .cb_mem = &imuTaskControlBlock,
+  .cb_size = sizeof(imuTaskControlBlock),
+  .stack_mem = &imuTaskBuffer[0],
+  .stack_size = sizeof(imuTaskBuffer),
   .priority = (osPriority_t) osPriorityAboveNormal,
 };
 extern void SensorTask_Run(void *argument);
@@ -106,6 +139,31 @@ void StartDefaultTask(void *argument);
 extern void MX_USB_DEVICE_Init(void);
 void MX_FREERTOS_Init(void); /* (MISRA C 2004 rule 8.1) */
 
+/* Hook prototypes */
+void vApplicationTickHook(void);
+
+/* USER CODE BEGIN 3 */
+void vApplicationTickHook( void )
+{
+  /* 检查各任务签到，全部正常才喂 IWDG */
+  Supervisor_TickHook();
+}
+/* USER CODE END 3 */
+
+/* USER CODE BEGIN PREPOSTSLEEP */
+void PreSleepProcessing(uint32_t *ulExpectedIdleTime)
+{
+  /* 暂停 HAL 时基并记录睡眠起点 */
+  PowerMgr_PreSleep(ulExpectedIdleTime);
+}
+
+void PostSleepProcessing(uint32_t *ulExpectedIdleTime)
+{
+  /* 补偿 HAL 时基，统计睡眠时间与唤醒源 */
+  PowerMgr_PostSleep(ulExpectedIdleTime);
+}
+/* USER CODE END PREPOSTSLEEP */
+
 /**
   * @brief  FreeRTOS initialization
   * @param  None
@@ -137,6 +195,11 @@ void MX_FREERTOS_Init(void) {
   defaultTaskHandle = osThreadNew(StartDefaultTask, NULL, &defaultTask_attributes);
 
   /* USER CODE BEGIN RTOS_THREADS */
+  /* 事件跟踪：上电即开始记录，供故障后经USB导出 */
+  Trace_Init();
+  /* 热点剖析：测量空探针开销并清零统计 */
+  Prof_Init();
+  
   /* 初始化应用层 */
   CleanBotApp_t *app = CleanBotApp_GetInstance();
   CleanBotApp_Init(app);
@@ -144,6 +207,12 @@ void MX_FREERTOS_Init(void) {
   /* 初始化传感器管理器 */
   SensorManager_Init(SensorManager_GetInstance());
   
+  /* 初始化碰撞/悬崖安全反射 */
+  SafetyReflex_Init();
+  
+  /* 初始化电源管理（停靠低功耗模式、睡眠统计） */
+  PowerMgr_Init();
+  
   /* 创建传感器任务 */
   sensorTaskHandle = osThreadNew(SensorTask_Run, NULL, &sensorTask_attributes);
   
@@ -189,6 +258,21 @@ void StartDefaultTask(void *argument)
 
 /* Private application code --------------------------------------------------*/
 /* USER CODE BEGIN Application */
+/**
+  * @brief  运行时间统计时基初始化（vTaskStartScheduler 中调用）
+  */
+void configureTimerForRunTimeStats(void)
+{
+  Timebase_Init();
+}
+
+/**
+  * @brief  运行时间统计计数值 (us)
+  */
+unsigned long getRunTimeCounterValue(void)
+{
+  return Timebase_GetUs();
+}
 
 /* USER CODE END Application */
 
@@ -45,14 +45,11 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
             SensorManager_IRQHandler_IR_Right();
             break;
         case L_FOLLOW_CHECK_SIGNAL_Pin:
-            /* 同时处理NEC解码和下视检测 */
+            /* 与左前下视共用：边沿只进红外捕获，下视电平由电机控制任务消抖采样 */
             SensorManager_IRQHandler_IR_FrontLeft();
-            SensorManager_IRQHandler_UnderLeft();
             break;
         case R_FOLLOW_CHECK_SIGNAL_Pin:
-            /* 同时处理NEC解码和下视检测 */
             SensorManager_IRQHandler_IR_FrontRight();
-            SensorManager_IRQHandler_UnderRight();
             break;
         case IFHIT_L_Pin:
             SensorManager_IRQHandler_PhotoGate_Left();
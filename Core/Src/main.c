@@ -30,6 +30,9 @@
 /* USER CODE BEGIN Includes */
 #include "CleanBotApp.h"
 #include "encoder.h"
+#include "prof.h"
+#include "supervisor.h"
+#include "blackbox.h"
 
 /* USER CODE END Includes */
 
@@ -91,7 +94,10 @@ int main(void)
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
-
+  /* 黑匣子：扫描 Flash 转储槽，写满且已全部清除时擦除扇区（数秒内无法喂狗，须在启动 IWDG 之前） */
+  BlackBox_Init();
+  /* 任务看门狗监督：取回上次故障快照、记录复位原因并启动 IWDG */
+  Supervisor_Init();
   /* USER CODE END SysInit */
 
   /* Initialize all configured peripherals */
@@ -207,6 +213,7 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
   {
     /* 1kHz编码器采样 */
     extern CleanBotApp_t *g_pCleanBotApp;
+    PROF_PERIOD(PROF_TIM7_PERIOD);
     if (g_pCleanBotApp != NULL) {
       Encoder_On1kHzTick(&g_pCleanBotApp->encoderWheelLeft);
       Encoder_On1kHzTick(&g_pCleanBotApp->encoderWheelRight);
@@ -226,6 +233,8 @@ void Error_Handler(void)
 {
   /* USER CODE BEGIN Error_Handler_Debug */
   /* User can add his own implementation to report the HAL error return state */
+  /* 记录调用处写入故障快照，停机后由 IWDG 复位 */
+  Supervisor_OnError((uint32_t)(uintptr_t)__builtin_return_address(0));
   __disable_irq();
   while (1)
   {
@@ -22,6 +22,8 @@
 #include "stm32f4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "trace.h"
+#include "supervisor.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -89,7 +91,8 @@ void NMI_Handler(void)
 void HardFault_Handler(void)
 {
   /* USER CODE BEGIN HardFault_IRQn 0 */
-
+  /* 取压栈帧写入故障快照后复位 */
+  SUPERVISOR_FAULT_ENTRY(SUPERVISOR_REASON_HARDFAULT);
   /* USER CODE END HardFault_IRQn 0 */
   while (1)
   {
@@ -104,7 +107,8 @@ void HardFault_Handler(void)
 void MemManage_Handler(void)
 {
   /* USER CODE BEGIN MemoryManagement_IRQn 0 */
-
+  /* 取压栈帧写入故障快照后复位 */
+  SUPERVISOR_FAULT_ENTRY(SUPERVISOR_REASON_MEMMANAGE);
   /* USER CODE END MemoryManagement_IRQn 0 */
   while (1)
   {
@@ -119,7 +123,8 @@ void MemManage_Handler(void)
 void BusFault_Handler(void)
 {
   /* USER CODE BEGIN BusFault_IRQn 0 */
-
+  /* 取压栈帧写入故障快照后复位 */
+  SUPERVISOR_FAULT_ENTRY(SUPERVISOR_REASON_BUSFAULT);
   /* USER CODE END BusFault_IRQn 0 */
   while (1)
   {
@@ -134,7 +139,8 @@ void BusFault_Handler(void)
 void UsageFault_Handler(void)
 {
   /* USER CODE BEGIN UsageFault_IRQn 0 */
-
+  /* 取压栈帧写入故障快照后复位 */
+  SUPERVISOR_FAULT_ENTRY(SUPERVISOR_REASON_USAGEFAULT);
   /* USER CODE END UsageFault_IRQn 0 */
   while (1)
   {
@@ -169,11 +175,11 @@ void DebugMon_Handler(void)
 void EXTI2_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI2_IRQn 0 */
-
+  TRACE_ISR_ENTER(TRACE_ISR_EXTI, 2);
   /* USER CODE END EXTI2_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(R_FOLLOW_CHECK_SIGNAL_Pin);
   /* USER CODE BEGIN EXTI2_IRQn 1 */
-
+  TRACE_ISR_EXIT(TRACE_ISR_EXTI);
   /* USER CODE END EXTI2_IRQn 1 */
 }
 
@@ -183,11 +189,11 @@ void EXTI2_IRQHandler(void)
 void EXTI3_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI3_IRQn 0 */
-
+  TRACE_ISR_ENTER(TRACE_ISR_EXTI, 3);
   /* USER CODE END EXTI3_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(R_RECEIVE_Pin);
   /* USER CODE BEGIN EXTI3_IRQn 1 */
-
+  TRACE_ISR_EXIT(TRACE_ISR_EXTI);
   /* USER CODE END EXTI3_IRQn 1 */
 }
 
@@ -197,11 +203,11 @@ void EXTI3_IRQHandler(void)
 void EXTI4_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI4_IRQn 0 */
-
+  TRACE_ISR_ENTER(TRACE_ISR_EXTI, 4);
   /* USER CODE END EXTI4_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(IFHIT_R_Pin);
   /* USER CODE BEGIN EXTI4_IRQn 1 */
-
+  TRACE_ISR_EXIT(TRACE_ISR_EXTI);
   /* USER CODE END EXTI4_IRQn 1 */
 }
 
@@ -225,14 +231,14 @@ void DMA1_Stream1_IRQHandler(void)
 void EXTI9_5_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI9_5_IRQn 0 */
-
+  TRACE_ISR_ENTER(TRACE_ISR_EXTI, 5);
   /* USER CODE END EXTI9_5_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(S_FOLLOW_CHECK_SIGNAL_Pin);
   HAL_GPIO_EXTI_IRQHandler(BUTTON1_Pin);
   HAL_GPIO_EXTI_IRQHandler(BUTTON2_Pin);
   HAL_GPIO_EXTI_IRQHandler(L_FOLLOW_CHECK_SIGNAL_Pin);
   /* USER CODE BEGIN EXTI9_5_IRQn 1 */
-
+  TRACE_ISR_EXIT(TRACE_ISR_EXTI);
   /* USER CODE END EXTI9_5_IRQn 1 */
 }
 
@@ -242,11 +248,11 @@ void EXTI9_5_IRQHandler(void)
 void USART3_IRQHandler(void)
 {
   /* USER CODE BEGIN USART3_IRQn 0 */
-
+  TRACE_ISR_ENTER(TRACE_ISR_USART3, 0);
   /* USER CODE END USART3_IRQn 0 */
   HAL_UART_IRQHandler(&huart3);
   /* USER CODE BEGIN USART3_IRQn 1 */
-
+  TRACE_ISR_EXIT(TRACE_ISR_USART3);
   /* USER CODE END USART3_IRQn 1 */
 }
 
@@ -256,14 +262,14 @@ void USART3_IRQHandler(void)
 void EXTI15_10_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI15_10_IRQn 0 */
-
+  TRACE_ISR_ENTER(TRACE_ISR_EXTI, 10);
   /* USER CODE END EXTI15_10_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(SIGNAL_1_Pin);
   HAL_GPIO_EXTI_IRQHandler(SIGNAL_2_Pin);
   HAL_GPIO_EXTI_IRQHandler(L_RECEIVE_Pin);
   HAL_GPIO_EXTI_IRQHandler(IFHIT_L_Pin);
   /* USER CODE BEGIN EXTI15_10_IRQn 1 */
-
+  TRACE_ISR_EXIT(TRACE_ISR_EXTI);
   /* USER CODE END EXTI15_10_IRQn 1 */
 }
 
@@ -287,11 +293,11 @@ void TIM6_DAC_IRQHandler(void)
 void TIM7_IRQHandler(void)
 {
   /* USER CODE BEGIN TIM7_IRQn 0 */
-
+  TRACE_ISR_ENTER(TRACE_ISR_TIM7, 0);
   /* USER CODE END TIM7_IRQn 0 */
   HAL_TIM_IRQHandler(&htim7);
   /* USER CODE BEGIN TIM7_IRQn 1 */
-
+  TRACE_ISR_EXIT(TRACE_ISR_TIM7);
   /* USER CODE END TIM7_IRQn 1 */
 }
 
@@ -301,11 +307,11 @@ void TIM7_IRQHandler(void)
 void OTG_FS_IRQHandler(void)
 {
   /* USER CODE BEGIN OTG_FS_IRQn 0 */
-
+  TRACE_ISR_ENTER(TRACE_ISR_OTG_FS, 0);
   /* USER CODE END OTG_FS_IRQn 0 */
   HAL_PCD_IRQHandler(&hpcd_USB_OTG_FS);
   /* USER CODE BEGIN OTG_FS_IRQn 1 */
-
+  TRACE_ISR_EXIT(TRACE_ISR_OTG_FS);
   /* USER CODE END OTG_FS_IRQn 1 */
 }
 
@@ -13,6 +13,12 @@
 #include "cmsis_os.h"
 #include <stddef.h>  /* 定义NULL */
 
+/* 收发缓冲单独放在默认SRAM：USB_Comm_t 随应用对象位于CCM，而 OTG 外设
+   不能访问CCM，缓冲不能嵌在结构体内（只支持单个USB通信实例） */
+static uint8_t s_usbRxData[USB_COMM_RX_BUFFER_SIZE];
+static uint8_t s_usbTxData[USB_COMM_TX_BUFFER_SIZE];
+static uint8_t s_usbTxPacket[USB_COMM_TX_PACKET_SIZE];
+
 static void USB_Comm_TryStartTx(USB_Comm_t *comm);
 static inline uint32_t USB_Comm_EnterCritical(void)
 {
@@ -35,11 +41,13 @@ void USB_Comm_Init(USB_Comm_t *comm)
 {
     if (comm == NULL) return;
     
-    RingBuffer_Init(&comm->rxBuffer, comm->rxData, USB_COMM_RX_BUFFER_SIZE);
-    RingBuffer_Init(&comm->txBuffer, comm->txData, USB_COMM_TX_BUFFER_SIZE);
+    RingBuffer_Init(&comm->rxBuffer, s_usbRxData, USB_COMM_RX_BUFFER_SIZE);
+    RingBuffer_Init(&comm->txBuffer, s_usbTxData, USB_COMM_TX_BUFFER_SIZE);
+    comm->txPacket = s_usbTxPacket;
     comm->connected = false;
     comm->enabled = true;
     comm->txBusy = false;
+    comm->notifyThread = NULL;
 }
 
 /**
@@ -198,6 +206,22 @@ void USB_Comm_RxCpltCallback(USB_Comm_t *comm, uint8_t *buf, uint32_t len)
     
     /* 将接收到的数据放入接收缓冲区 */
     RingBuffer_PutData(&comm->rxBuffer, buf, len);
+    
+    if (comm->notifyThread != NULL) {
+        osThreadFlagsSet(comm->notifyThread, USB_COMM_RX_THREAD_FLAG);
+    }
+}
+
+/**
+  * @brief  设置收到数据时唤醒的任务（USB通信任务）
+  * @param  comm: USB通信对象指针
+  * @param  thread: 线程ID
+  * @retval None
+  */
+void USB_Comm_SetNotifyThread(USB_Comm_t *comm, osThreadId_t thread)
+{
+    if (comm == NULL) return;
+    comm->notifyThread = thread;
 }
 
 /**
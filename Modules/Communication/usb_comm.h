@@ -17,6 +17,7 @@ extern "C" {
 #include "usb_device.h"
 #include "usbd_cdc_if.h"
 #include "ring_buffer.h"
+#include "cmsis_os.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -25,16 +26,18 @@ extern "C" {
 #define USB_COMM_TX_BUFFER_SIZE     512  /* 发送缓冲区大小 */
 #define USB_COMM_TX_PACKET_SIZE      64  /* 单次USB包最大64字节 */
 
+/* 收到数据时唤醒USB通信任务的线程标志 */
+#define USB_COMM_RX_THREAD_FLAG   0x0001U
+
 /* USB通信结构体 */
 typedef struct {
     RingBuffer_t rxBuffer;         /* 接收缓冲区 */
     RingBuffer_t txBuffer;         /* 发送缓冲区 */
-    uint8_t rxData[USB_COMM_RX_BUFFER_SIZE];  /* 接收数据缓冲区 */
-    uint8_t txData[USB_COMM_TX_BUFFER_SIZE];  /* 发送数据缓冲区 */
-    uint8_t txPacket[USB_COMM_TX_PACKET_SIZE];/* 正在发送的USB包 */
+    uint8_t *txPacket;             /* 正在发送的USB包（指向SRAM中的静态缓冲） */
     bool connected;                /* USB连接状态 */
     bool enabled;                  /* 使能标志 */
     bool txBusy;                   /* USB端点是否繁忙 */
+    osThreadId_t notifyThread;     /* 收到数据时唤醒的任务 */
 } USB_Comm_t;
 
 /* 函数声明 */
@@ -48,6 +51,7 @@ uint32_t USB_Comm_GetTxFree(USB_Comm_t *comm);
 bool USB_Comm_IsConnected(USB_Comm_t *comm);
 void USB_Comm_SetConnected(USB_Comm_t *comm, bool connected);  /* 设置连接状态 */
 void USB_Comm_UpdateConnectionState(USB_Comm_t *comm);  /* 更新连接状态（通过检查USB设备状态） */
+void USB_Comm_SetNotifyThread(USB_Comm_t *comm, osThreadId_t thread);  /* 设置收到数据时唤醒的任务 */
 void USB_Comm_RxCpltCallback(USB_Comm_t *comm, uint8_t *buf, uint32_t len);  /* 接收完成回调 */
 void USB_Comm_TxCpltCallback(USB_Comm_t *comm);  /* 发送完成回调 */
 
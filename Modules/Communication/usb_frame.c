@@ -0,0 +1,192 @@
+/**
+  ******************************************************************************
+  * @file    usb_frame.c
+  * @brief   USB协议帧编解码实现
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "usb_frame.h"
+#include <stddef.h>  /* 定义NULL */
+#include <string.h>
+
+#define USB_FRAME_CRC_INIT      0xFFFFU
+#define USB_FRAME_CRC_POLY      0x1021U
+
+/**
+  * @brief  CRC16-CCITT 累加一个字节
+  */
+static uint16_t UsbFrame_CrcByte(uint16_t crc, uint8_t byte)
+{
+    crc ^= (uint16_t)byte << 8;
+    for (uint8_t j = 0; j < 8U; ++j) {
+        if ((crc & 0x8000U) != 0U) {
+            crc = (uint16_t)((crc << 1) ^ USB_FRAME_CRC_POLY);
+        } else {
+            crc = (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+  * @brief  计算CRC16-CCITT（初值0xFFFF）
+  * @param  data: 数据
+  * @param  len: 长度
+  * @retval CRC
+  */
+uint16_t UsbFrame_Crc16(const uint8_t *data, uint32_t len)
+{
+    uint16_t crc = USB_FRAME_CRC_INIT;
+    if (data == NULL) return crc;
+
+    for (uint32_t i = 0; i < len; ++i) {
+        crc = UsbFrame_CrcByte(crc, data[i]);
+    }
+    return crc;
+}
+
+/**
+  * @brief  组帧
+  * @param  out: 输出缓冲
+  * @param  outSize: 输出缓冲大小
+  * @param  msgId: 消息ID
+  * @param  seq: 序号
+  * @param  payload: 负载（payloadLen为0时可为NULL）
+  * @param  payloadLen: 负载长度
+  * @retval 帧长，参数非法或缓冲不足返回0
+  */
+uint16_t UsbFrame_Encode(uint8_t *out, uint16_t outSize, uint8_t msgId, uint8_t seq,
+                         const uint8_t *payload, uint16_t payloadLen)
+{
+    if (out == NULL || payloadLen > USB_FRAME_MAX_PAYLOAD ||
+        (payloadLen > 0U && payload == NULL) ||
+        outSize < (uint16_t)(payloadLen + USB_FRAME_OVERHEAD)) {
+        return 0;
+    }
+
+    uint16_t idx = 0;
+    out[idx++] = USB_FRAME_HEADER0;
+    out[idx++] = USB_FRAME_HEADER1;
+    out[idx++] = USB_FRAME_VERSION;
+    out[idx++] = (uint8_t)(payloadLen & 0xFFU);
+    out[idx++] = (uint8_t)((payloadLen >> 8) & 0xFFU);
+    out[idx++] = msgId;
+    out[idx++] = seq;
+    if (payloadLen > 0U) {
+        memcpy(&out[idx], payload, payloadLen);
+        idx += payloadLen;
+    }
+
+    uint16_t crc = UsbFrame_Crc16(&out[2], (uint32_t)(5U + payloadLen));
+    out[idx++] = (uint8_t)(crc & 0xFFU);
+    out[idx++] = (uint8_t)((crc >> 8) & 0xFFU);
+    return idx;
+}
+
+/**
+  * @brief  初始化解析器（清零统计）
+  * @retval None
+  */
+void UsbFrame_ParserInit(UsbFrameParser_t *parser)
+{
+    if (parser == NULL) return;
+
+    memset(parser, 0, sizeof(UsbFrameParser_t));
+    parser->state = USB_FRAME_WAIT_HEADER0;
+}
+
+/**
+  * @brief  解析器回到等待帧头，保留统计
+  * @retval None
+  */
+void UsbFrame_ParserReset(UsbFrameParser_t *parser)
+{
+    if (parser == NULL) return;
+
+    parser->state = USB_FRAME_WAIT_HEADER0;
+    parser->payloadLen = 0;
+    parser->payloadIndex = 0;
+}
+
+/**
+  * @brief  输入一个字节
+  * @param  parser: 解析器
+  * @param  byte: 收到的字节
+  * @retval true=刚收完一帧CRC与版本均正确的帧
+  */
+bool UsbFrame_Parse(UsbFrameParser_t *parser, uint8_t byte)
+{
+    if (parser == NULL) return false;
+
+    switch (parser->state) {
+        case USB_FRAME_WAIT_HEADER0:
+            if (byte == USB_FRAME_HEADER0) {
+                parser->state = USB_FRAME_WAIT_HEADER1;
+            }
+            break;
+        case USB_FRAME_WAIT_HEADER1:
+            if (byte == USB_FRAME_HEADER1) {
+                parser->state = USB_FRAME_READ_VERSION;
+            } else if (byte != USB_FRAME_HEADER0) {
+                parser->state = USB_FRAME_WAIT_HEADER0;
+            }
+            break;
+        case USB_FRAME_READ_VERSION:
+            parser->version = byte;
+            parser->crc = UsbFrame_CrcByte(USB_FRAME_CRC_INIT, byte);
+            parser->state = USB_FRAME_READ_LEN_L;
+            break;
+        case USB_FRAME_READ_LEN_L:
+            parser->payloadLen = byte;
+            parser->crc = UsbFrame_CrcByte(parser->crc, byte);
+            parser->state = USB_FRAME_READ_LEN_H;
+            break;
+        case USB_FRAME_READ_LEN_H:
+            parser->payloadLen |= (uint16_t)((uint16_t)byte << 8);
+            parser->crc = UsbFrame_CrcByte(parser->crc, byte);
+            if (parser->payloadLen > USB_FRAME_MAX_PAYLOAD) {
+                parser->lenErrors++;
+                UsbFrame_ParserReset(parser);
+            } else {
+                parser->state = USB_FRAME_READ_MSG_ID;
+            }
+            break;
+        case USB_FRAME_READ_MSG_ID:
+            parser->msgId = byte;
+            parser->crc = UsbFrame_CrcByte(parser->crc, byte);
+            parser->state = USB_FRAME_READ_SEQ;
+            break;
+        case USB_FRAME_READ_SEQ:
+            parser->seq = byte;
+            parser->crc = UsbFrame_CrcByte(parser->crc, byte);
+            parser->payloadIndex = 0;
+            parser->state = (parser->payloadLen == 0U) ? USB_FRAME_READ_CRC_L : USB_FRAME_READ_PAYLOAD;
+            break;
+        case USB_FRAME_READ_PAYLOAD:
+            parser->payload[parser->payloadIndex++] = byte;
+            parser->crc = UsbFrame_CrcByte(parser->crc, byte);
+            if (parser->payloadIndex >= parser->payloadLen) {
+                parser->state = USB_FRAME_READ_CRC_L;
+            }
+            break;
+        case USB_FRAME_READ_CRC_L:
+            parser->rxCrc = byte;
+            parser->state = USB_FRAME_READ_CRC_H;
+            break;
+        case USB_FRAME_READ_CRC_H:
+            parser->rxCrc |= (uint16_t)((uint16_t)byte << 8);
+            parser->state = USB_FRAME_WAIT_HEADER0;
+            if (parser->rxCrc == parser->crc && parser->version == USB_FRAME_VERSION) {
+                parser->frames++;
+                return true;
+            }
+            parser->crcErrors++;
+            break;
+        default:
+            UsbFrame_ParserReset(parser);
+            break;
+    }
+    return false;
+}
@@ -0,0 +1,75 @@
+/**
+  ******************************************************************************
+  * @file    usb_frame.h
+  * @brief   USB协议帧编解码头文件
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 帧格式：0x55 0xAA + 版本 + 长度(u16,LE) + 消息ID + 序号 + 负载 + CRC16(LE)，
+  * CRC16-CCITT（初值0xFFFF）覆盖版本到负载末尾。逐字节解析器边收边算CRC，
+  * 不再在帧尾拷贝整帧重算。与硬件和RTOS无关，上位机 TEST/host 原样编译。
+  ******************************************************************************
+  */
+
+#ifndef __USB_FRAME_H__
+#define __USB_FRAME_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 协议常量 */
+#define USB_FRAME_HEADER0           0x55U
+#define USB_FRAME_HEADER1           0xAAU
+#define USB_FRAME_VERSION           0x01U
+#define USB_FRAME_MAX_PAYLOAD       96U
+#define USB_FRAME_OVERHEAD          9U      /* 帧头2 + 版本1 + 长度2 + ID1 + 序号1 + CRC2 */
+#define USB_FRAME_MAX_SIZE          (USB_FRAME_MAX_PAYLOAD + USB_FRAME_OVERHEAD)
+
+/* 解析状态 */
+typedef enum {
+    USB_FRAME_WAIT_HEADER0 = 0,
+    USB_FRAME_WAIT_HEADER1,
+    USB_FRAME_READ_VERSION,
+    USB_FRAME_READ_LEN_L,
+    USB_FRAME_READ_LEN_H,
+    USB_FRAME_READ_MSG_ID,
+    USB_FRAME_READ_SEQ,
+    USB_FRAME_READ_PAYLOAD,
+    USB_FRAME_READ_CRC_L,
+    USB_FRAME_READ_CRC_H
+} UsbFrameState_t;
+
+/* 逐字节解析器；Parse返回true后 msgId/seq/payload/payloadLen 在下一次调用前有效 */
+typedef struct {
+    UsbFrameState_t state;
+    uint8_t version;
+    uint8_t msgId;
+    uint8_t seq;
+    uint16_t payloadLen;
+    uint16_t payloadIndex;
+    uint16_t crc;               /* 边收边算的CRC */
+    uint16_t rxCrc;
+    uint8_t payload[USB_FRAME_MAX_PAYLOAD];
+    uint32_t frames;            /* 校验通过的帧数 */
+    uint32_t crcErrors;         /* CRC或版本错误 */
+    uint32_t lenErrors;         /* 长度超限 */
+} UsbFrameParser_t;
+
+/* 函数声明 */
+uint16_t UsbFrame_Crc16(const uint8_t *data, uint32_t len);
+uint16_t UsbFrame_Encode(uint8_t *out, uint16_t outSize, uint8_t msgId, uint8_t seq,
+                         const uint8_t *payload, uint16_t payloadLen);    /* 返回帧长，失败返回0 */
+void UsbFrame_ParserInit(UsbFrameParser_t *parser);
+void UsbFrame_ParserReset(UsbFrameParser_t *parser);                    /* 回到等待帧头，保留统计 */
+bool UsbFrame_Parse(UsbFrameParser_t *parser, uint8_t byte);            /* true=收到一帧完整有效帧 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USB_FRAME_H__ */
@@ -8,7 +8,9 @@
   */
 
 #include "encoder.h"
+#include "encoder_math.h"
 #include "cmsis_os.h"
+#include "prof.h"
 
 #define ENCODER_UPDATE_PERIOD_MS    10  /* 速度更新周期 (ms) */
 
@@ -114,16 +116,7 @@ int32_t Encoder_GetPulseCount(Encoder_t *encoder)
     static int16_t lastCounter[3] = {0, 0, 0};
     int32_t index = encoder->type;
     
-    if (counter - lastCounter[index] > 32768) {
-        encoder->overflowCount--;
-			 
-    } else if (counter - lastCounter[index] < -32768) {
-        encoder->overflowCount++;
-			 
-    }
-		 lastCounter[index] = counter;
-    
-    encoder->pulseCount = (int32_t)counter + encoder->overflowCount * 65536;
+    encoder->pulseCount = EncoderMath_ExtendCount(counter, &lastCounter[index], &encoder->overflowCount);
     return encoder->pulseCount;
 }
 
@@ -159,34 +152,16 @@ void Encoder_Update(Encoder_t *encoder)
         int32_t deltaCount = Encoder_GetDeltaCount(encoder);
         
         /* 计算速度 (RPM) */
-        /* 速度 = (增量脉冲数 / 每转脉冲数 / 减速比) / (时间(ms) / 60000) */
-        if (deltaTime > 0 && encoder->ppr > 0 && encoder->gearRatio > 0) {
-            float revolutions = (float)deltaCount / (encoder->ppr * encoder->gearRatio);
-            float minutes = (float)deltaTime / 60000.0f;
-            if (minutes > 0) {
-                encoder->speed = revolutions / minutes;
-            } else {
-                encoder->speed = 0.0f;
-            }
-        } else {
-            encoder->speed = 0.0f;
-        }
+        encoder->speed = EncoderMath_Rpm(deltaCount, (uint32_t)encoder->ppr * encoder->gearRatio, deltaTime);
         
         /* 计算速度 (m/s) - 仅用于轮电机 */
         if (encoder->type == ENCODER_TYPE_WHEEL_LEFT || encoder->type == ENCODER_TYPE_WHEEL_RIGHT) {
-            if (deltaTime > 0 && encoder->pulsePerMeter > 0) {
-                float deltaTimeSeconds = (float)deltaTime / 1000.0f;
-                float deltaMeters = (float)deltaCount / encoder->pulsePerMeter;
-                encoder->speedMs = deltaMeters / deltaTimeSeconds;
-            } else {
-                encoder->speedMs = 0.0f;
-            }
+            encoder->speedMs = EncoderMath_SpeedMs(deltaCount, encoder->pulsePerMeter, deltaTime);
         }
         
         /* 更新角度（弧度制）：角度 = (累计脉冲数 / 每转脉冲数) * 2π */
         if (encoder->ppr > 0) {
-            int32_t totalPulses = Encoder_GetPulseCount(encoder);
-            encoder->angle = ((float)totalPulses / (float)encoder->ppr) * 6.28318530718f;  /* 2π ≈ 6.28318530718 */
+            encoder->angle = EncoderMath_Angle(Encoder_GetPulseCount(encoder), encoder->ppr);
         }
         
         encoder->lastUpdateTime = currentTime;
@@ -226,8 +201,7 @@ float Encoder_GetAngle(Encoder_t *encoder)
     
     /* 实时计算角度，确保获取最新值 */
     if (encoder->ppr > 0) {
-        int32_t totalPulses = Encoder_GetPulseCount(encoder);
-        encoder->angle = ((float)totalPulses / (float)encoder->ppr) * 6.28318530718f;  /* 2π ≈ 6.28318530718 */
+        encoder->angle = EncoderMath_Angle(Encoder_GetPulseCount(encoder), encoder->ppr);
     }
     
     return encoder->angle;
@@ -241,6 +215,8 @@ void Encoder_On1kHzTick(Encoder_t *encoder)
 {
     if (encoder == NULL || !encoder->enabled || encoder->htim == NULL) return;
 
+    PROF_BEGIN(PROF_ENCODER_TICK);
+
     /* 读取当前累计脉冲（含溢出拓展） */
     int32_t currentCount = Encoder_GetPulseCount(encoder);
 		watch_count_now = currentCount;
@@ -249,11 +225,10 @@ void Encoder_On1kHzTick(Encoder_t *encoder)
 
     /* 1ms周期下的RPM计算：rpm = delta * 60000 / (ppr * gear) */
     if (encoder->ppr > 0 && encoder->gearRatio > 0) {
-        float denom = (float)(encoder->ppr * encoder->gearRatio);
-        float instRPM = (float)delta * 60000.0f / denom;
+        float instRPM = EncoderMath_Rpm(delta, (uint32_t)encoder->ppr * encoder->gearRatio, 1U);
         /* 简单一阶IIR滤波，减小抖动（alpha越小越平滑） */
         const float alphaRPM = 0.8f;
-        encoder->speed = alphaRPM * instRPM + (1.0f - alphaRPM) * encoder->speed;
+        encoder->speed = EncoderMath_Lowpass(encoder->speed, instRPM, alphaRPM);
     } else {
         encoder->speed = 0.0f;
     }
@@ -261,9 +236,9 @@ void Encoder_On1kHzTick(Encoder_t *encoder)
     /* 轮速 m/s：v = delta * 1000 / pulsePerMeter */
     if ((encoder->type == ENCODER_TYPE_WHEEL_LEFT || encoder->type == ENCODER_TYPE_WHEEL_RIGHT)
         && encoder->pulsePerMeter > 0) {
-        float instMs = ((float)delta) * 1000.0f / (float)encoder->pulsePerMeter;
+        float instMs = EncoderMath_SpeedMs(delta, encoder->pulsePerMeter, 1U);
         const float alphaMs = 0.2f;
-        encoder->speedMs = alphaMs * instMs + (1.0f - alphaMs) * encoder->speedMs;
+        encoder->speedMs = EncoderMath_Lowpass(encoder->speedMs, instMs, alphaMs);
     } else if (encoder->type == ENCODER_TYPE_FAN) {
         /* 非轮式不更新m/s */
     } else {
@@ -272,7 +247,9 @@ void Encoder_On1kHzTick(Encoder_t *encoder)
     
     /* 更新角度（弧度制）：角度 = (累计脉冲数 / 每转脉冲数) * 2π */
     if (encoder->ppr > 0) {
-        encoder->angle = ((float)currentCount / (float)encoder->ppr) * 6.28318530718f;  /* 2π ≈ 6.28318530718 */
+        encoder->angle = EncoderMath_Angle(currentCount, encoder->ppr);
     }
+
+    PROF_END(PROF_ENCODER_TICK);
 }
 
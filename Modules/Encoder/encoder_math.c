@@ -0,0 +1,82 @@
+/**
+  ******************************************************************************
+  * @file    encoder_math.c
+  * @brief   编码器计数与速度换算实现
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "encoder_math.h"
+#include <stddef.h>  /* 定义NULL */
+
+/**
+  * @brief  16位硬件计数扩展为32位累计脉冲
+  * @note   两次调用之间计数变化须小于半圈（32768）
+  * @param  counter: 当前硬件计数
+  * @param  lastCounter: 上次硬件计数（输入输出）
+  * @param  overflowCount: 溢出圈数（输入输出）
+  * @retval 累计脉冲
+  */
+int32_t EncoderMath_ExtendCount(int16_t counter, int16_t *lastCounter, int32_t *overflowCount)
+{
+    if (lastCounter == NULL || overflowCount == NULL) return (int32_t)counter;
+
+    int32_t diff = (int32_t)counter - (int32_t)*lastCounter;
+    if (diff > 32768) {
+        (*overflowCount)--;
+    } else if (diff < -32768) {
+        (*overflowCount)++;
+    }
+    *lastCounter = counter;
+
+    return (int32_t)counter + *overflowCount * 65536;
+}
+
+/**
+  * @brief  脉冲增量换算转速
+  * @param  delta: 周期内脉冲增量
+  * @param  pulsePerRev: 输出轴每转脉冲（ppr × 减速比）
+  * @param  periodMs: 周期 (ms)
+  * @retval 转速 (RPM)，参数为0时返回0
+  */
+float EncoderMath_Rpm(int32_t delta, uint32_t pulsePerRev, uint32_t periodMs)
+{
+    if (pulsePerRev == 0U || periodMs == 0U) return 0.0f;
+    return (float)delta * (60000.0f / (float)periodMs) / (float)pulsePerRev;
+}
+
+/**
+  * @brief  脉冲增量换算线速度
+  * @param  delta: 周期内脉冲增量
+  * @param  pulsePerMeter: 每米脉冲数
+  * @param  periodMs: 周期 (ms)
+  * @retval 线速度 (m/s)，参数为0时返回0
+  */
+float EncoderMath_SpeedMs(int32_t delta, uint32_t pulsePerMeter, uint32_t periodMs)
+{
+    if (pulsePerMeter == 0U || periodMs == 0U) return 0.0f;
+    return (float)delta * (1000.0f / (float)periodMs) / (float)pulsePerMeter;
+}
+
+/**
+  * @brief  累计脉冲换算角度
+  * @retval 角度 (rad，连续累加)，ppr为0时返回0
+  */
+float EncoderMath_Angle(int32_t count, uint16_t ppr)
+{
+    if (ppr == 0U) return 0.0f;
+    return ((float)count / (float)ppr) * ENCODER_MATH_TWO_PI;
+}
+
+/**
+  * @brief  一阶IIR低通
+  * @param  prev: 上次输出
+  * @param  input: 新输入
+  * @param  alpha: 新输入权重（越小越平滑）
+  * @retval 本次输出
+  */
+float EncoderMath_Lowpass(float prev, float input, float alpha)
+{
+    return alpha * input + (1.0f - alpha) * prev;
+}
@@ -0,0 +1,37 @@
+/**
+  ******************************************************************************
+  * @file    encoder_math.h
+  * @brief   编码器计数与速度换算头文件
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 从编码器驱动中拆出的纯计算部分：16位硬件计数扩展为32位累计脉冲、
+  * 脉冲增量换算转速/线速度/角度、一阶低通。不依赖HAL，上位机 TEST/host 原样编译。
+  ******************************************************************************
+  */
+
+#ifndef __ENCODER_MATH_H__
+#define __ENCODER_MATH_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ENCODER_MATH_TWO_PI         6.28318530718f
+
+/* 函数声明 */
+int32_t EncoderMath_ExtendCount(int16_t counter, int16_t *lastCounter, int32_t *overflowCount);
+float EncoderMath_Rpm(int32_t delta, uint32_t pulsePerRev, uint32_t periodMs);     /* 输出轴转速 (RPM) */
+float EncoderMath_SpeedMs(int32_t delta, uint32_t pulsePerMeter, uint32_t periodMs); /* 线速度 (m/s) */
+float EncoderMath_Angle(int32_t count, uint16_t ppr);                               /* 累计角度 (rad) */
+float EncoderMath_Lowpass(float prev, float input, float alpha);                    /* alpha为新值权重 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ENCODER_MATH_H__ */
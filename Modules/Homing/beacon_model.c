@@ -0,0 +1,215 @@
+/**
+  ******************************************************************************
+  * @file    beacon_model.c
+  * @brief   充电座信标观测模型实现
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "beacon_model.h"
+#include <stddef.h>  /* 定义NULL */
+#include <string.h>
+#include <math.h>
+
+/* 各扇区码对 sectorBalance 的贡献：最左 +1 ... 最右 -1 */
+static const float s_sectorWeight[BEACON_CODE_SECTORS] = { 1.0f, 1.0f / 3.0f, -1.0f / 3.0f, -1.0f };
+
+/**
+  * @brief  初始化观测模型
+  * @param  model: 模型对象指针
+  * @param  cfg: 模型参数
+  * @retval None
+  */
+void BeaconModel_Init(BeaconModel_t *model, const BeaconModelConfig_t *cfg)
+{
+    if (model == NULL || cfg == NULL) return;
+
+    memset(model, 0, sizeof(BeaconModel_t));
+    model->cfg = *cfg;
+    BeaconModel_Reset(model);
+}
+
+/**
+  * @brief  清空全部观测（参数保留）
+  * @param  model: 模型对象指针
+  * @retval None
+  */
+void BeaconModel_Reset(BeaconModel_t *model)
+{
+    if (model == NULL) return;
+
+    memset(model->rx, 0, sizeof(model->rx));
+    for (uint8_t i = 0; i < BEACON_RX_COUNT; i++) {
+        model->rx[i].dominantCode = BEACON_CODE_NONE;
+    }
+    model->slot = 0;
+    model->slotStartMs = 0;
+    model->started = false;
+    model->valid = false;
+    model->bearingRad = 0.0f;
+    model->confidence = 0.0f;
+    model->totalStrength = 0.0f;
+    model->sectorBalance = 0.0f;
+}
+
+/**
+  * @brief  命令码 -> 码编号
+  * @retval 0~3=扇区码，BEACON_CODE_OTHER=其他
+  */
+uint8_t BeaconModel_CodeIndex(const BeaconModel_t *model, uint8_t command)
+{
+    if (model == NULL) return BEACON_CODE_OTHER;
+
+    for (uint8_t i = 0; i < BEACON_CODE_SECTORS; i++) {
+        if (model->cfg.codes[i] == command) return i;
+    }
+    return BEACON_CODE_OTHER;
+}
+
+/**
+  * @brief  滑动窗口推进到当前时间，过期的槽清零
+  */
+static void BeaconModel_Advance(BeaconModel_t *model, uint32_t nowMs)
+{
+    if (!model->started) {
+        model->started = true;
+        model->slotStartMs = nowMs;
+        return;
+    }
+
+    uint32_t elapsed = nowMs - model->slotStartMs;
+    if (elapsed < BEACON_SLOT_MS) return;
+
+    uint32_t steps = elapsed / BEACON_SLOT_MS;
+    if (steps >= BEACON_WINDOW_SLOTS) {
+        /* 超过整个窗口未推进：全部清零 */
+        for (uint8_t i = 0; i < BEACON_RX_COUNT; i++) {
+            memset(model->rx[i].hits, 0, sizeof(model->rx[i].hits));
+        }
+        model->slot = 0;
+        model->slotStartMs = nowMs;
+        return;
+    }
+
+    for (uint32_t s = 0; s < steps; s++) {
+        model->slot = (uint8_t)((model->slot + 1U) % BEACON_WINDOW_SLOTS);
+        for (uint8_t i = 0; i < BEACON_RX_COUNT; i++) {
+            memset(model->rx[i].hits[model->slot], 0, BEACON_CODE_COUNT);
+        }
+    }
+    model->slotStartMs += steps * BEACON_SLOT_MS;
+}
+
+/**
+  * @brief  记录一次解码命中（每收到一帧调用一次，重复帧也计入）
+  * @param  model: 模型对象指针
+  * @param  rx: 接收头编号 (BEACON_RX_xxx)
+  * @param  command: 命令码
+  * @param  nowMs: 当前时间 (ms)
+  * @retval None
+  */
+void BeaconModel_Observe(BeaconModel_t *model, uint8_t rx, uint8_t command, uint32_t nowMs)
+{
+    if (model == NULL || rx >= BEACON_RX_COUNT) return;
+
+    BeaconModel_Advance(model, nowMs);
+
+    BeaconReceiver_t *r = &model->rx[rx];
+    uint8_t code = BeaconModel_CodeIndex(model, command);
+    if (r->hits[model->slot][code] < 0xFFU) {
+        r->hits[model->slot][code]++;
+    }
+    r->lastHitMs = nowMs;
+    r->everHit = true;
+}
+
+/**
+  * @brief  计算单个接收头的帧率/强度/码分布
+  */
+static void BeaconModel_UpdateReceiver(BeaconModel_t *model, BeaconReceiver_t *r, uint32_t nowMs)
+{
+    uint16_t perCode[BEACON_CODE_COUNT] = {0};
+    uint16_t total = 0;
+
+    for (uint8_t s = 0; s < BEACON_WINDOW_SLOTS; s++) {
+        for (uint8_t c = 0; c < BEACON_CODE_COUNT; c++) {
+            perCode[c] += r->hits[s][c];
+        }
+    }
+
+    r->dominantCode = BEACON_CODE_NONE;
+    uint16_t best = 0;
+    for (uint8_t c = 0; c < BEACON_CODE_COUNT; c++) {
+        total += perCode[c];
+        if (perCode[c] > best) {
+            best = perCode[c];
+            r->dominantCode = c;
+        }
+    }
+    for (uint8_t c = 0; c < BEACON_CODE_COUNT; c++) {
+        r->mixPct[c] = (total > 0U) ? (uint8_t)((uint32_t)perCode[c] * 100U / total) : 0U;
+    }
+
+    r->ageMs = r->everHit ? (nowMs - r->lastHitMs) : 0xFFFFFFFFU;
+    r->rateHz = (float)total * 1000.0f / (float)BEACON_WINDOW_MS;
+
+    /* 强度：帧率饱和到满帧率；超过命中超时视为无信号 */
+    float rate = (model->cfg.fullRateHz > 0.0f) ? (r->rateHz / model->cfg.fullRateHz) : 0.0f;
+    if (rate > 1.0f) rate = 1.0f;
+    bool fresh = r->everHit && (r->ageMs < model->cfg.hitTimeoutMs);
+    r->strength = fresh ? rate : 0.0f;
+}
+
+/**
+  * @brief  更新融合结果（在回冲导航周期中调用）
+  * @param  model: 模型对象指针
+  * @param  nowMs: 当前时间 (ms)
+  * @retval None
+  */
+void BeaconModel_Update(BeaconModel_t *model, uint32_t nowMs)
+{
+    if (model == NULL) return;
+
+    BeaconModel_Advance(model, nowMs);
+
+    float x = 0.0f;
+    float y = 0.0f;
+    float sum = 0.0f;
+    float balance = 0.0f;
+    float balanceWeight = 0.0f;
+
+    for (uint8_t i = 0; i < BEACON_RX_COUNT; i++) {
+        BeaconReceiver_t *r = &model->rx[i];
+        BeaconModel_UpdateReceiver(model, r, nowMs);
+        if (r->strength <= 0.0f) continue;
+
+        /* 按接收头朝向做加权矢量和 */
+        x += r->strength * cosf(model->cfg.mountRad[i]);
+        y += r->strength * sinf(model->cfg.mountRad[i]);
+        sum += r->strength;
+
+        for (uint8_t c = 0; c < BEACON_CODE_SECTORS; c++) {
+            float w = r->strength * (float)r->mixPct[c] * 0.01f;
+            balance += w * s_sectorWeight[c];
+            balanceWeight += w;
+        }
+    }
+
+    model->totalStrength = sum;
+    model->valid = (sum > 0.0f);
+    if (!model->valid) {
+        model->confidence = 0.0f;
+        model->sectorBalance = 0.0f;
+        return;
+    }
+
+    /* 置信度 = 强度因子 × 方向一致性（矢量长度/强度和，各头方向矛盾时变小） */
+    float strengthFactor = (model->cfg.confFullStrength > 0.0f) ? (sum / model->cfg.confFullStrength) : 1.0f;
+    if (strengthFactor > 1.0f) strengthFactor = 1.0f;
+    float agreement = sqrtf(x * x + y * y) / sum;
+
+    model->bearingRad = atan2f(y, x);
+    model->confidence = strengthFactor * agreement;
+    model->sectorBalance = (balanceWeight > 0.0f) ? (balance / balanceWeight) : 0.0f;
+}
@@ -0,0 +1,97 @@
+/**
+  ******************************************************************************
+  * @file    beacon_model.h
+  * @brief   充电座信标观测模型头文件
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 把四个接收头的离散解码结果变成连续的方位/置信度估计：
+  * - 每个接收头在滑动窗口内统计解码帧率、距上次命中的时间和各信标码占比
+  * - 信号强度 = 帧率/满帧率（超过命中超时置零），按接收头安装角做加权矢量和得到
+  *   充电座方位角（机体系，左正右负），矢量长度与总强度给出置信度
+  * - 信标码分布给出机器人位于充电座中线哪一侧（sectorBalance）
+  * 与硬件无关（时间由调用方传入），可在上位机编译测试。
+  ******************************************************************************
+  */
+
+#ifndef __BEACON_MODEL_H__
+#define __BEACON_MODEL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 接收头编号（与 IRPosition_t 顺序一致） */
+#define BEACON_RX_LEFT              0
+#define BEACON_RX_RIGHT             1
+#define BEACON_RX_FRONT_LEFT        2
+#define BEACON_RX_FRONT_RIGHT       3
+#define BEACON_RX_COUNT             4
+
+/* 信标码编号：四个扇区码 + 其他 */
+#define BEACON_CODE_SECTORS         4
+#define BEACON_CODE_OTHER           BEACON_CODE_SECTORS
+#define BEACON_CODE_COUNT           (BEACON_CODE_SECTORS + 1)
+#define BEACON_CODE_NONE            0xFFU
+
+/* 滑动窗口 */
+#define BEACON_SLOT_MS              50U     /* 单个统计槽时长 (ms) */
+#define BEACON_WINDOW_SLOTS         16U     /* 窗口槽数（800ms） */
+#define BEACON_WINDOW_MS            (BEACON_SLOT_MS * BEACON_WINDOW_SLOTS)
+
+/* 模型参数 */
+typedef struct {
+    float mountRad[BEACON_RX_COUNT];        /* 接收头朝向（机体系，左正，rad） */
+    uint8_t codes[BEACON_CODE_SECTORS];     /* 扇区码：从机器人视角左到右 */
+    float fullRateHz;                       /* 正对近距离时单头解码帧率 (Hz) */
+    uint32_t hitTimeoutMs;                  /* 超过该时间无命中视为无信号 (ms) */
+    float confFullStrength;                 /* 总强度达到该值时置信度不再受强度限制 */
+} BeaconModelConfig_t;
+
+/* 单个接收头观测 */
+typedef struct {
+    uint8_t hits[BEACON_WINDOW_SLOTS][BEACON_CODE_COUNT];  /* 各槽各码命中数 */
+    uint32_t lastHitMs;                     /* 最后命中时间 (ms) */
+    bool everHit;                           /* 启动后是否命中过 */
+
+    /* 输出（BeaconModel_Update 计算） */
+    float rateHz;                           /* 窗口内解码帧率 (Hz) */
+    float strength;                         /* 信号强度 (0~1) */
+    uint32_t ageMs;                         /* 距最后命中时间 (ms) */
+    uint8_t dominantCode;                   /* 窗口内最多的码编号，无命中为 BEACON_CODE_NONE */
+    uint8_t mixPct[BEACON_CODE_COUNT];      /* 各码占比 (%) */
+} BeaconReceiver_t;
+
+/* 信标观测模型 */
+typedef struct {
+    BeaconModelConfig_t cfg;
+    BeaconReceiver_t rx[BEACON_RX_COUNT];
+
+    uint8_t slot;                           /* 当前统计槽 */
+    uint32_t slotStartMs;                   /* 当前槽起始时间 */
+    bool started;
+
+    /* 融合结果 */
+    bool valid;                             /* 至少一个接收头有信号 */
+    float bearingRad;                       /* 充电座方位角（机体系，左正右负） */
+    float confidence;                       /* 方位置信度 (0~1) */
+    float totalStrength;                    /* 各接收头强度之和 */
+    float sectorBalance;                    /* 扇区码分布：+1=全为最左码，-1=全为最右码 */
+} BeaconModel_t;
+
+/* 函数声明 */
+void BeaconModel_Init(BeaconModel_t *model, const BeaconModelConfig_t *cfg);
+void BeaconModel_Reset(BeaconModel_t *model);
+void BeaconModel_Observe(BeaconModel_t *model, uint8_t rx, uint8_t command, uint32_t nowMs);
+void BeaconModel_Update(BeaconModel_t *model, uint32_t nowMs);
+uint8_t BeaconModel_CodeIndex(const BeaconModel_t *model, uint8_t command);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BEACON_MODEL_H__ */
@@ -9,7 +9,9 @@
 
 #include "ir_homing.h"
 #include "motor_ctrl_task.h"
+#include "imu_task.h"
 #include <string.h>
+#include <math.h>
 
 /* 配置参数 */
 #define IR_SIGNAL_TIMEOUT_MS     500    /* 信号超时时间（ms） */
@@ -19,11 +21,41 @@
 /* 速度配置（m/s） */
 #define SPEED_SEARCH            0.15f   /* 搜索速度 */
 #define SPEED_APPROACH          0.20f   /* 接近速度 */
-#define SPEED_ALIGN_FAST        0.25f   /* 快速对齐 */
-#define SPEED_ALIGN_SLOW        0.15f   /* 慢速对齐 */
 #define SPEED_DOCK              0.10f   /* 对接速度 */
 #define SPEED_ROTATE            0.12f   /* 旋转速度 */
 
+/* 信标观测模型 */
+#define BEACON_MOUNT_SIDE_RAD   1.571f  /* 左/右接收头朝向 ±90°（需实测） */
+#define BEACON_MOUNT_FRONT_RAD  0.524f  /* 左前/右前接收头朝向 ±30°（需实测） */
+#define BEACON_FULL_RATE        8.0f    /* 近距离正对时单头解码帧率 (Hz) */
+#define BEACON_CONF_FULL        1.5f    /* 总强度达到该值置信度不受强度限制 */
+
+/* 接近：方位可信时锁定航向直行 */
+#define APPROACH_CONF_MIN       0.30f   /* 置信度低于该值不按方位转向 */
+#define APPROACH_OMEGA_MAX      1.0f    /* 接近时最大角速度 (rad/s) */
+#define APPROACH_ROTATE_BEARING 0.87f   /* 方位角超过约50°时原地转向 (rad) */
+#define HEADING_BLEND           0.05f   /* 每周期按置信度把锁定航向拉向信标方向的比例 */
+
+/* 航向闭环转向 */
+#define TURN_OMEGA_MIN          0.30f   /* 最小转向角速度，克服起转死区 (rad/s) */
+#define SEARCH_RETURN_TOL_DEG   10.0f   /* 转回记忆方向的到位误差 (deg) */
+#define SEARCH_RETURN_DWELL_MS  300U    /* 到位后等待信号的时间 (ms) */
+
+/* 对接：充电触点接通即成功；碰撞后顶住等待，未接通则后退重新对准 */
+#define DOCK_BACKOFF_MS         1500U   /* 重试后退时间（约15cm，侧面接收头重新看到信标） */
+
+/* 信标方位取窗口内的平均，航向按相同时延滤波后再与方位相加 */
+#define YAW_LAG_TAU_MS          ((float)BEACON_WINDOW_MS * 0.5f)
+
+static const BeaconModelConfig_t s_beaconConfig = {
+    .mountRad = { BEACON_MOUNT_SIDE_RAD, -BEACON_MOUNT_SIDE_RAD,
+                  BEACON_MOUNT_FRONT_RAD, -BEACON_MOUNT_FRONT_RAD },
+    .codes = { IR_CODE_LEFT, IR_CODE_FRONT_LEFT, IR_CODE_FRONT_RIGHT, IR_CODE_RIGHT },
+    .fullRateHz = BEACON_FULL_RATE,
+    .hitTimeoutMs = IR_SIGNAL_TIMEOUT_MS,
+    .confFullStrength = BEACON_CONF_FULL
+};
+
 /**
  * @brief  初始化红外回冲模块
  */
@@ -36,6 +68,7 @@ void IRHoming_Init(IRHoming_t *homing)
     homing->enabled = false;
     homing->debug = false;
     homing->timeout = DEFAULT_TIMEOUT_MS;
+    BeaconModel_Init(&homing->beacon, &s_beaconConfig);
 }
 
 /**
@@ -65,6 +98,10 @@ void IRHoming_Stop(IRHoming_t *homing)
     
     homing->enabled = false;
     homing->state = HOMING_STATE_IDLE;
+    homing->targetSpeedLeft = 0.0f;
+    homing->targetSpeedRight = 0.0f;
+    homing->targetLinear = 0.0f;
+    homing->targetAngular = 0.0f;
     
     /* 停止电机 */
     MotorCtrlTask_SetWheelSpeed(0.0f, 0.0f);
@@ -103,6 +140,8 @@ void IRHoming_UpdateReceiver(IRHoming_t *homing, IRPosition_t position, NEC_Data
     receiver->address = necData->address;
     receiver->lastDetectTime = HAL_GetTick();
     receiver->detectCount++;
+
+    BeaconModel_Observe(&homing->beacon, (uint8_t)position, necData->command, receiver->lastDetectTime);
 }
 
 /**
@@ -146,6 +185,150 @@ static bool IRHoming_CheckTimeout(IRHoming_t *homing)
     return false;
 }
 
+/**
+ * @brief  角度归一化到 (-180, 180]
+ */
+static float IRHoming_WrapDeg(float deg)
+{
+    while (deg > 180.0f) deg -= 360.0f;
+    while (deg <= -180.0f) deg += 360.0f;
+    return deg;
+}
+
+/**
+ * @brief  更新连续航向
+ * @note   HOMING_IMU_ENABLE=0 或IMU数据失效时按上周期输出的角速度积分推算，
+ *         IMU恢复后以新读数为基准继续累加
+ */
+static void IRHoming_UpdateYaw(IRHoming_t *homing, uint32_t now)
+{
+    float dtMs = homing->yawInit ? (float)(now - homing->lastProcessTime) : 0.0f;
+    float delta = RAD_TO_DEG(homing->targetAngular) * dtMs * 0.001f;
+
+#if HOMING_IMU_ENABLE
+    bool fresh = IMUTask_IsDataFresh(IMU_DATA_MAX_AGE_MS);
+    if (fresh) {
+        float yaw = 0.0f;
+        IMUTask_GetEuler(NULL, NULL, &yaw);
+        if (homing->yawInit && homing->yawImuValid) {
+            delta = IRHoming_WrapDeg(yaw - homing->lastRawYawDeg);
+        }
+        homing->lastRawYawDeg = yaw;
+    }
+    homing->yawImuValid = fresh;
+#endif
+
+    homing->yawDeltaDeg = delta;
+    homing->yawDeg += delta;
+    if (!homing->yawInit) {
+        homing->yawLagDeg = homing->yawDeg;
+    } else {
+        homing->yawLagDeg += (homing->yawDeg - homing->yawLagDeg) * dtMs / (YAW_LAG_TAU_MS + dtMs);
+    }
+    homing->yawInit = true;
+    homing->lastProcessTime = now;
+}
+
+/**
+ * @brief  信标方位对应的充电座方向（连续航向，deg）
+ */
+static float IRHoming_DockYaw(const IRHoming_t *homing)
+{
+    return homing->yawLagDeg + RAD_TO_DEG(homing->beacon.bearingRad);
+}
+
+/**
+ * @brief  记录各扇区码信号最强时的充电座方向
+ */
+static void IRHoming_UpdateMemory(IRHoming_t *homing, uint32_t now)
+{
+    const BeaconModel_t *beacon = &homing->beacon;
+    if (!beacon->valid || beacon->confidence < APPROACH_CONF_MIN) return;
+
+    float dockYaw = IRHoming_DockYaw(homing);
+    for (uint8_t c = 0; c < BEACON_CODE_SECTORS; c++) {
+        float strength = 0.0f;
+        for (uint8_t i = 0; i < BEACON_RX_COUNT; i++) {
+            strength += beacon->rx[i].strength * (float)beacon->rx[i].mixPct[c] * 0.01f;
+        }
+        if (strength <= 0.0f) continue;
+
+        HomingBeaconMemory_t *mem = &homing->memory[c];
+        if (!mem->valid || strength >= mem->strength || (now - mem->time) > HOMING_MEMORY_MAX_AGE_MS) {
+            mem->valid = true;
+            mem->strength = strength;
+            mem->dockYawDeg = dockYaw;
+            mem->time = now;
+        }
+    }
+}
+
+/**
+ * @brief  取有效记忆中信号最强的充电座方向
+ * @retval true=有可用记忆
+ */
+static bool IRHoming_RecallDock(const IRHoming_t *homing, float *dockYawDeg)
+{
+    uint32_t now = HAL_GetTick();
+    float best = 0.0f;
+    bool found = false;
+
+    for (uint8_t c = 0; c < BEACON_CODE_SECTORS; c++) {
+        const HomingBeaconMemory_t *mem = &homing->memory[c];
+        if (!mem->valid || (now - mem->time) > HOMING_MEMORY_MAX_AGE_MS) continue;
+        if (mem->strength > best) {
+            best = mem->strength;
+            *dockYawDeg = mem->dockYawDeg;
+            found = true;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief  按航向误差计算角速度（限幅）
+ * @param  errRad: 航向误差（rad，左正）
+ */
+static float IRHoming_HeadingOmega(float errRad, float omegaMax)
+{
+    float omega = HOMING_HEADING_KP * errRad;
+    if (omega > omegaMax) omega = omegaMax;
+    if (omega < -omegaMax) omega = -omegaMax;
+    return omega;
+}
+
+/**
+ * @brief  由 (v, ω) 设置左右轮目标速度
+ */
+static void IRHoming_SetVelocity(IRHoming_t *homing, float linear, float omega)
+{
+    homing->targetSpeedLeft = linear - omega * WHEEL_TRACK_WIDTH_M * 0.5f;
+    homing->targetSpeedRight = linear + omega * WHEEL_TRACK_WIDTH_M * 0.5f;
+}
+
+/**
+ * @brief  航向闭环原地转向
+ * @param  targetYawDeg: 目标航向（连续航向，deg）
+ * @param  tolDeg: 到位误差（deg）
+ * @retval true=已到位（轮速置零）
+ */
+static bool IRHoming_TurnTo(IRHoming_t *homing, float targetYawDeg, float tolDeg)
+{
+    float err = IRHoming_WrapDeg(targetYawDeg - homing->yawDeg);
+    if (fabsf(err) <= tolDeg) {
+        IRHoming_SetVelocity(homing, 0.0f, 0.0f);
+        return true;
+    }
+
+    float omegaMax = 2.0f * SPEED_ROTATE / WHEEL_TRACK_WIDTH_M;
+    float omega = IRHoming_HeadingOmega(DEG_TO_RAD(err), omegaMax);
+    if (fabsf(omega) < TURN_OMEGA_MIN) {
+        omega = (omega > 0.0f) ? TURN_OMEGA_MIN : -TURN_OMEGA_MIN;
+    }
+    IRHoming_SetVelocity(homing, 0.0f, omega);
+    return false;
+}
+
 /**
  * @brief  搜索充电座
  */
@@ -156,19 +339,35 @@ static void IRHoming_Search(IRHoming_t *homing)
         homing->frontLeft.detected || homing->frontRight.detected) {
         /* 检测到信号，切换到接近模式 */
         homing->state = HOMING_STATE_APPROACHING;
+        homing->returning = false;
         return;
     }
     
-    /* 原地旋转搜索充电座 */
+    /* 本次回冲中见过信标：直接转回信号最强时的充电座方向 */
+    if (!homing->returning && IRHoming_RecallDock(homing, &homing->returnYawDeg)) {
+        homing->returning = true;
+        homing->returnArrived = false;
+    }
+    if (homing->returning) {
+        if (!homing->returnArrived) {
+            if (!IRHoming_TurnTo(homing, homing->returnYawDeg, SEARCH_RETURN_TOL_DEG)) return;
+            homing->returnArrived = true;
+            homing->returnArriveTime = HAL_GetTick();
+        }
+        if ((HAL_GetTick() - homing->returnArriveTime) < SEARCH_RETURN_DWELL_MS) {
+            IRHoming_SetVelocity(homing, 0.0f, 0.0f);
+            return;
+        }
+        /* 到位后仍无信号：记忆作废，改为原地旋转搜索 */
+        homing->returning = false;
+        memset(homing->memory, 0, sizeof(homing->memory));
+    }
+    
+    /* 原地旋转搜索充电座，按实际转过的角度计圈 */
     homing->targetSpeedLeft = SPEED_ROTATE;
     homing->targetSpeedRight = -SPEED_ROTATE;
-    
-    /* 记录旋转次数（每360度计数） */
-    static uint32_t lastRotateTime = 0;
-    if (HAL_GetTick() - lastRotateTime > 3000) {  /* 约3秒一圈 */
-        homing->searchRotations++;
-        lastRotateTime = HAL_GetTick();
-    }
+    homing->searchTurnDeg += fabsf(homing->yawDeltaDeg);
+    homing->searchRotations = (uint16_t)(homing->searchTurnDeg / 360.0f);
 }
 
 /**
@@ -185,77 +384,119 @@ bool IRHoming_IsAligned(IRHoming_t *homing)
             homing->right.detected && homing->right.command == IR_CODE_RIGHT);
 }
 
+/**
+ * @brief  进入对接阶段
+ */
+static void IRHoming_EnterDocking(IRHoming_t *homing)
+{
+    homing->state = HOMING_STATE_DOCKING;
+    homing->dockingStart = HAL_GetTick();
+    homing->contactWaitActive = false;
+    homing->dockBackoffActive = false;
+    homing->headingLocked = false;
+    homing->targetSpeedLeft = SPEED_DOCK;
+    homing->targetSpeedRight = SPEED_DOCK;
+}
+
+/**
+ * @brief  停车并保持当前状态（已对接/失败），不再参与导航
+ */
+static void IRHoming_Halt(IRHoming_t *homing)
+{
+    homing->enabled = false;
+    homing->contactWaitActive = false;
+    homing->dockBackoffActive = false;
+    homing->targetSpeedLeft = 0.0f;
+    homing->targetSpeedRight = 0.0f;
+    homing->targetLinear = 0.0f;
+    homing->targetAngular = 0.0f;
+
+    MotorCtrlTask_SetWheelSpeed(0.0f, 0.0f);
+}
+
+/**
+ * @brief  对接未接通：后退重新对准，次数用完判为失败
+ */
+static void IRHoming_RetryDock(IRHoming_t *homing)
+{
+    homing->contactWaitActive = false;
+    if (homing->dockRetries >= HOMING_DOCK_MAX_RETRIES) {
+        homing->state = HOMING_STATE_FAILED;
+        IRHoming_Halt(homing);
+        return;
+    }
+
+    homing->dockRetries++;
+    homing->dockBackoffActive = true;
+    homing->dockBackoffStart = HAL_GetTick();
+    homing->targetSpeedLeft = -SPEED_DOCK;
+    homing->targetSpeedRight = -SPEED_DOCK;
+}
+
 /**
  * @brief  接近充电座
+ * @note   方位偏差大时航向闭环原地转向；否则锁定充电座方向由IMU保持直行，
+ *         信标方位只按置信度缓慢修正锁定值，线速度随置信度增大
  */
 static void IRHoming_Approach(IRHoming_t *homing)
 {
+    const BeaconModel_t *beacon = &homing->beacon;
+
+    /* 碰撞：可能已顶到充电座，进入对接阶段等待触点（未接通会后退重试） */
+    if (homing->bumperLeftTriggered || homing->bumperRightTriggered) {
+        IRHoming_EnterDocking(homing);
+        return;
+    }
+
     /* 情况1：完美对准 - 所有传感器接收到正确信号 */
     if (IRHoming_IsAligned(homing)) {
         /* 已对准，切换到对接模式 */
         homing->state = HOMING_STATE_ALIGNING;
+        homing->headingLocked = false;
         homing->targetSpeedLeft = SPEED_APPROACH;
         homing->targetSpeedRight = SPEED_APPROACH;
         return;
     }
     
-    /* 情况2：左前和右前都检测到正确信号 - 基本对准 */
-    if (homing->frontLeft.detected && homing->frontLeft.command == IR_CODE_FRONT_LEFT &&
-        homing->frontRight.detected && homing->frontRight.command == IR_CODE_FRONT_RIGHT) {
-        /* 前方已对准，继续前进 */
-        homing->targetSpeedLeft = SPEED_APPROACH;
-        homing->targetSpeedRight = SPEED_APPROACH;
-        return;
-    }
-    
-    /* 情况3：只有左前检测到正确信号 - 需要左转 */
-    if (homing->frontLeft.detected && homing->frontLeft.command == IR_CODE_FRONT_LEFT &&
-        !homing->frontRight.detected) {
-        /* 左转修正 */
-        homing->targetSpeedLeft = SPEED_ALIGN_SLOW;
-        homing->targetSpeedRight = SPEED_ALIGN_FAST;
-        return;
-    }
-    
-    /* 情况4：只有右前检测到正确信号 - 需要右转 */
-    if (homing->frontRight.detected && homing->frontRight.command == IR_CODE_FRONT_RIGHT &&
-        !homing->frontLeft.detected) {
-        /* 右转修正 */
-        homing->targetSpeedLeft = SPEED_ALIGN_FAST;
-        homing->targetSpeedRight = SPEED_ALIGN_SLOW;
-        return;
-    }
-    
-    /* 情况5：只有左侧检测到信号 - 充电座在左侧，原地左转 */
-    if (homing->left.detected && (homing->left.command == IR_CODE_LEFT || 
-                                   homing->left.command == IR_CODE_EXTRA) &&
-        !homing->frontLeft.detected && !homing->frontRight.detected) {
-        /* 原地左转 */
-        homing->targetSpeedLeft = -SPEED_ROTATE;
-        homing->targetSpeedRight = SPEED_ROTATE;
-        return;
-    }
-    
-    /* 情况6：只有右侧检测到信号 - 充电座在右侧，原地右转 */
-    if (homing->right.detected && (homing->right.command == IR_CODE_RIGHT || 
-                                    homing->right.command == IR_CODE_EXTRA) &&
-        !homing->frontLeft.detected && !homing->frontRight.detected) {
-        /* 原地右转 */
-        homing->targetSpeedLeft = SPEED_ROTATE;
-        homing->targetSpeedRight = -SPEED_ROTATE;
+    /* 情况2：方位可信 */
+    if (beacon->valid && beacon->confidence >= APPROACH_CONF_MIN) {
+        float dockYaw = IRHoming_DockYaw(homing);
+
+        /* 偏差大：原地转向充电座方向 */
+        if (fabsf(beacon->bearingRad) > APPROACH_ROTATE_BEARING) {
+            homing->headingLocked = false;
+            (void)IRHoming_TurnTo(homing, dockYaw, 0.0f);
+            return;
+        }
+
+        if (!homing->headingLocked) {
+            homing->headingLocked = true;
+            homing->headingTargetDeg = dockYaw;
+        } else {
+            homing->headingTargetDeg += IRHoming_WrapDeg(dockYaw - homing->headingTargetDeg) *
+                                        HEADING_BLEND * beacon->confidence;
+        }
+
+        float err = DEG_TO_RAD(IRHoming_WrapDeg(homing->headingTargetDeg - homing->yawDeg));
+        float linear = (SPEED_SEARCH + (SPEED_APPROACH - SPEED_SEARCH) * beacon->confidence) * cosf(err);
+        IRHoming_SetVelocity(homing, linear, IRHoming_HeadingOmega(err, APPROACH_OMEGA_MAX));
         return;
     }
     
-    /* 情况7：检测到任意信号，但方向不明确 - 慢速前进同时微调 */
+    /* 情况3：检测到信号但方位不可信 - 保持锁定航向慢速前进，等待更多观测 */
     if (homing->left.detected || homing->right.detected ||
         homing->frontLeft.detected || homing->frontRight.detected) {
-        /* 慢速前进 */
-        homing->targetSpeedLeft = SPEED_SEARCH;
-        homing->targetSpeedRight = SPEED_SEARCH;
+        float omega = 0.0f;
+        if (homing->headingLocked) {
+            float err = DEG_TO_RAD(IRHoming_WrapDeg(homing->headingTargetDeg - homing->yawDeg));
+            omega = IRHoming_HeadingOmega(err, APPROACH_OMEGA_MAX);
+        }
+        IRHoming_SetVelocity(homing, SPEED_SEARCH, omega);
         return;
     }
     
-    /* 情况8：失去所有信号 - 返回搜索模式 */
+    /* 情况4：失去所有信号 - 返回搜索模式（有记忆时直接转回） */
+    homing->headingLocked = false;
     homing->state = HOMING_STATE_SEARCHING;
 }
 
@@ -264,19 +505,9 @@ static void IRHoming_Approach(IRHoming_t *homing)
  */
 static void IRHoming_Align(IRHoming_t *homing)
 {
-    if (homing->bumperLeftTriggered && homing->bumperRightTriggered) {
-        homing->state = HOMING_STATE_DOCKED;
-        homing->dockingTimerActive = false;
-        homing->dockBackoffActive = false;
-        return;
-    }
-
-    /* 检查是否完美对准（4个传感器都接收到正确信号） */
-    if (IRHoming_IsAligned(homing)) {
-        /* 完美对准，准备对接 */
-        homing->state = HOMING_STATE_DOCKING;
-        homing->targetSpeedLeft = SPEED_DOCK;
-        homing->targetSpeedRight = SPEED_DOCK;
+    /* 碰撞或完美对准（4个传感器都接收到正确信号）：进入对接 */
+    if (homing->bumperLeftTriggered || homing->bumperRightTriggered || IRHoming_IsAligned(homing)) {
+        IRHoming_EnterDocking(homing);
         return;
     }
     
@@ -313,36 +544,55 @@ static void IRHoming_Align(IRHoming_t *homing)
 
 /**
  * @brief  对接充电座
+ * @note   成功只由充电触点判定（见 IRHoming_Process）；这里负责前进、
+ *         碰撞后顶住等待，以及未接通时的后退重试
  */
 static void IRHoming_Dock(IRHoming_t *homing)
 {
-    if (homing->bumperLeftTriggered && homing->bumperRightTriggered) {
-        homing->state = HOMING_STATE_DOCKED;
-        homing->dockingTimerActive = false;
+    uint32_t now = HAL_GetTick();
+
+    /* 重试：后退一段距离后回到接近阶段重新对准 */
+    if (homing->dockBackoffActive) {
+        if ((now - homing->dockBackoffStart) < DOCK_BACKOFF_MS) {
+            homing->targetSpeedLeft = -SPEED_DOCK;
+            homing->targetSpeedRight = -SPEED_DOCK;
+            return;
+        }
         homing->dockBackoffActive = false;
+        homing->state = HOMING_STATE_APPROACHING;
+        return;
+    }
+
+    /* 碰撞：保持低速顶住，给触点接通留出时间 */
+    if ((homing->bumperLeftTriggered || homing->bumperRightTriggered) && !homing->contactWaitActive) {
+        homing->contactWaitActive = true;
+        homing->contactWaitStart = now;
+    }
+    if (homing->contactWaitActive) {
+        if ((now - homing->contactWaitStart) >= HOMING_DOCK_CONTACT_WAIT_MS) {
+            IRHoming_RetryDock(homing);
+            return;
+        }
+    } else if ((now - homing->dockingStart) >= HOMING_DOCK_CREEP_MAX_MS) {
+        /* 一直没有碰到充电座：方向偏了，重新对准 */
+        IRHoming_RetryDock(homing);
         return;
     }
 
     /* 极低速前进对接 */
     homing->targetSpeedLeft = SPEED_DOCK * 0.5f;
     homing->targetSpeedRight = SPEED_DOCK * 0.5f;
+}
+
+/**
+ * @brief  将导航轮速折算为 (v, ω) 并送入运动控制器
+ */
+static void IRHoming_ApplyMotion(IRHoming_t *homing)
+{
+    homing->targetLinear = (homing->targetSpeedLeft + homing->targetSpeedRight) * 0.5f;
+    homing->targetAngular = (homing->targetSpeedRight - homing->targetSpeedLeft) / WHEEL_TRACK_WIDTH_M;
     
-    /* TODO: 这里可以添加充电检测逻辑 */
-    /* 如果检测到充电电流，表示对接成功 */
-    /* 示例：if (charging_detected) { */
-    /*     homing->state = HOMING_STATE_DOCKED; */
-    /* } */
-    
-    /* 暂时：持续对接10秒后认为成功（兜底） */
-    if (!homing->dockingTimerActive) {
-        homing->dockingTimerActive = true;
-        homing->dockingTimerStart = HAL_GetTick();
-    }
-    if ((HAL_GetTick() - homing->dockingTimerStart) > 10000) {
-        homing->state = HOMING_STATE_DOCKED;
-        homing->dockingTimerActive = false;
-        homing->dockBackoffActive = false;
-    }
+    MotorCtrlTask_SetVelocity(homing->targetLinear, homing->targetAngular);
 }
 
 /**
@@ -358,8 +608,16 @@ void IRHoming_Process(IRHoming_t *homing)
         return;
     }
     
-    /* 检查信号超时 */
+    /* 检查信号超时，更新航向、信标方位估计与方向记忆 */
     IRHoming_CheckSignalTimeout(homing);
+    IRHoming_UpdateYaw(homing, HAL_GetTick());
+    BeaconModel_Update(&homing->beacon, HAL_GetTick());
+    IRHoming_UpdateMemory(homing, HAL_GetTick());
+    
+    /* 充电触点接通：任何导航阶段都立即完成对接 */
+    if (homing->chargeContact) {
+        homing->state = HOMING_STATE_DOCKED;
+    }
     
     /* 根据当前状态执行相应的导航算法 */
     switch (homing->state) {
@@ -380,20 +638,8 @@ void IRHoming_Process(IRHoming_t *homing)
             break;
             
         case HOMING_STATE_DOCKED:
-            if (!homing->dockBackoffActive) {
-                homing->dockBackoffActive = true;
-                homing->dockBackoffStart = HAL_GetTick();
-            }
-            if ((HAL_GetTick() - homing->dockBackoffStart) < 1000) {
-                homing->targetSpeedLeft = -SPEED_DOCK;
-                homing->targetSpeedRight = -SPEED_DOCK;
-            } else {
-                homing->targetSpeedLeft = 0.0f;
-                homing->targetSpeedRight = 0.0f;
-                homing->dockBackoffActive = false;
-                homing->state = HOMING_STATE_IDLE;
-                homing->enabled = false;
-            }
+            /* 停在充电座上保持已对接状态，DOCK模式下不会被重新启动 */
+            IRHoming_Halt(homing);
             break;
             
         case HOMING_STATE_FAILED:
@@ -406,8 +652,8 @@ void IRHoming_Process(IRHoming_t *homing)
             break;
     }
     
-    /* 应用速度到电机控制 */
-    MotorCtrlTask_SetWheelSpeed(homing->targetSpeedLeft, homing->targetSpeedRight);
+    /* 应用速度到运动控制器（加速度限制 + 两轮同步） */
+    IRHoming_ApplyMotion(homing);
 }
 
 /**
@@ -460,15 +706,30 @@ void IRHoming_Reset(IRHoming_t *homing)
     memset(&homing->right, 0, sizeof(IRReceiverStatus_t));
     memset(&homing->frontLeft, 0, sizeof(IRReceiverStatus_t));
     memset(&homing->frontRight, 0, sizeof(IRReceiverStatus_t));
+    BeaconModel_Reset(&homing->beacon);
     
     /* 重置导航参数 */
     homing->targetSpeedLeft = 0.0f;
     homing->targetSpeedRight = 0.0f;
+    homing->targetLinear = 0.0f;
+    homing->targetAngular = 0.0f;
     homing->searchRotations = 0;
+    homing->searchTurnDeg = 0.0f;
+    homing->yawInit = false;
+    homing->yawImuValid = false;
+    homing->yawDeg = 0.0f;
+    homing->yawLagDeg = 0.0f;
+    homing->yawDeltaDeg = 0.0f;
+    homing->returning = false;
+    homing->returnArrived = false;
+    homing->headingLocked = false;
+    memset(homing->memory, 0, sizeof(homing->memory));
     homing->bumperLeftTriggered = false;
     homing->bumperRightTriggered = false;
-    homing->dockingTimerActive = false;
-    homing->dockingTimerStart = 0;
+    homing->dockingStart = 0;
+    homing->contactWaitActive = false;
+    homing->contactWaitStart = 0;
+    homing->dockRetries = 0;
     homing->dockBackoffActive = false;
     homing->dockBackoffStart = 0;
 }
@@ -482,3 +743,12 @@ void IRHoming_UpdateBumperState(IRHoming_t *homing, bool leftTriggered, bool rig
     homing->bumperRightTriggered = rightTriggered;
 }
 
+/**
+ * @brief  更新充电触点状态
+ */
+void IRHoming_UpdateChargeContact(IRHoming_t *homing, bool present)
+{
+    if (homing == NULL) return;
+    homing->chargeContact = present;
+}
+
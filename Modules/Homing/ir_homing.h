@@ -22,6 +22,7 @@ extern "C" {
 
 #include "main.h"
 #include "ir_sensor.h"
+#include "beacon_model.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -72,6 +73,14 @@ typedef struct {
     uint16_t detectCount;         /* 连续检测次数 */
 } IRReceiverStatus_t;
 
+/* 信标方向记忆：某扇区码信号最强时充电座所在的航向 */
+typedef struct {
+    bool valid;
+    float strength;               /* 当时该码的强度之和 */
+    float dockYawDeg;             /* 当时充电座方向（连续航向，deg） */
+    uint32_t time;                /* 记录时间（ms） */
+} HomingBeaconMemory_t;
+
 /* 回冲导航数据 */
 typedef struct {
     /* 当前状态 */
@@ -82,10 +91,36 @@ typedef struct {
     IRReceiverStatus_t right;     /* 右侧接收器 */
     IRReceiverStatus_t frontLeft; /* 左前接收器 */
     IRReceiverStatus_t frontRight;/* 右前接收器 */
+
+    /* 信标观测模型：方位/置信度 */
+    BeaconModel_t beacon;
+
+    /* 航向（IMU偏航角展开为连续角度） */
+    float yawDeg;                 /* 当前航向（deg，左转为正） */
+    float yawDeltaDeg;            /* 本周期航向变化 */
+    float yawLagDeg;              /* 按信标窗口时延滤波的航向，与方位角相加 */
+    float lastRawYawDeg;          /* 上次IMU原始偏航角（±180） */
+    bool yawImuValid;             /* lastRawYawDeg 来自有效的IMU数据 */
+    bool yawInit;
+    uint32_t lastProcessTime;     /* 上次导航周期时间（ms） */
+
+    /* 搜索：转回记忆方向 / 原地旋转计圈 */
+    HomingBeaconMemory_t memory[BEACON_CODE_SECTORS];
+    bool returning;               /* 正在转回记忆方向 */
+    float returnYawDeg;           /* 记忆的充电座方向 */
+    bool returnArrived;           /* 已转到记忆方向，等待信号 */
+    uint32_t returnArriveTime;
+    float searchTurnDeg;          /* 原地搜索累计转过的角度 */
+
+    /* 接近：航向锁定 */
+    bool headingLocked;
+    float headingTargetDeg;       /* 锁定的充电座方向（连续航向，deg） */
     
     /* 导航参数 */
     float targetSpeedLeft;        /* 左轮目标速度（m/s） */
     float targetSpeedRight;       /* 右轮目标速度（m/s） */
+    float targetLinear;           /* 折算线速度（m/s），送入运动控制器 */
+    float targetAngular;          /* 折算角速度（rad/s），送入运动控制器 */
     
     /* 统计信息 */
     uint32_t startTime;           /* 回冲开始时间 */
@@ -100,11 +135,15 @@ typedef struct {
     bool bumperLeftTriggered;     /* 左碰撞触发 */
     bool bumperRightTriggered;    /* 右碰撞触发 */
 
-    /* Docking阶段控制 */
-    bool dockingTimerActive;
-    uint32_t dockingTimerStart;
+    bool chargeContact;           /* 充电触点已接通（去抖后） */
 
-    /* Docked后退控制 */
+    /* Docking阶段控制：以充电触点接通为对接成功 */
+    uint32_t dockingStart;        /* 进入对接阶段时间 */
+    bool contactWaitActive;       /* 已碰撞，顶住等待触点接通 */
+    uint32_t contactWaitStart;
+    uint8_t dockRetries;          /* 已后退重新对准的次数 */
+
+    /* 重试后退控制 */
     bool dockBackoffActive;
     uint32_t dockBackoffStart;
 } IRHoming_t;
@@ -201,6 +240,14 @@ void IRHoming_Reset(IRHoming_t *homing);
  */
 void IRHoming_UpdateBumperState(IRHoming_t *homing, bool leftTriggered, bool rightTriggered);
 
+/**
+ * @brief  更新充电触点状态（去抖后的接通判定）
+ * @param  homing: 回冲对象指针
+ * @param  present: true=触点已接通
+ * @retval None
+ */
+void IRHoming_UpdateChargeContact(IRHoming_t *homing, bool present);
+
 #ifdef __cplusplus
 }
 #endif
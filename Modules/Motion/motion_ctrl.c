@@ -0,0 +1,272 @@
+/**
+  ******************************************************************************
+  * @file    motion_ctrl.c
+  * @brief   差速底盘运动控制器实现
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "motion_ctrl.h"
+#include <stddef.h>  /* 定义NULL */
+#include <math.h>
+
+/**
+  * @brief  初始化单轴规划状态
+  */
+static void MotionCtrl_AxisInit(MotionAxis_t *axis, float maxVel, float maxAcc, float maxJerk)
+{
+    axis->target = 0.0f;
+    axis->command = 0.0f;
+    axis->accel = 0.0f;
+    axis->maxVel = maxVel;
+    axis->maxAcc = maxAcc;
+    axis->maxJerk = maxJerk;
+}
+
+/**
+  * @brief  单轴加速度/加加速度限制（S曲线）
+  * @note   期望加速度取 sqrt(2*J*|误差|)，保证按加加速度减速时恰好在目标处加速度归零
+  * @param  axis: 单轴规划状态
+  * @param  dt: 控制周期 (s)
+  * @retval None
+  */
+static void MotionCtrl_AxisStep(MotionAxis_t *axis, float dt)
+{
+    float target = axis->target;
+    if (target > axis->maxVel) target = axis->maxVel;
+    if (target < -axis->maxVel) target = -axis->maxVel;
+
+    float error = target - axis->command;
+
+    /* 期望加速度 */
+    float accDesired = sqrtf(2.0f * axis->maxJerk * fabsf(error));
+    if (accDesired > axis->maxAcc) accDesired = axis->maxAcc;
+    if (error < 0.0f) accDesired = -accDesired;
+
+    /* 加加速度限制 */
+    float maxDelta = axis->maxJerk * dt;
+    float delta = accDesired - axis->accel;
+    if (delta > maxDelta) delta = maxDelta;
+    if (delta < -maxDelta) delta = -maxDelta;
+    axis->accel += delta;
+
+    /* 积分得到指令值，越过目标时直接收敛 */
+    float step = axis->accel * dt;
+    if ((error >= 0.0f && step >= error) || (error <= 0.0f && step <= error)) {
+        axis->command = target;
+        axis->accel = 0.0f;
+    } else {
+        axis->command += step;
+    }
+}
+
+/**
+  * @brief  初始化运动控制器
+  * @param  mc: 运动控制器对象指针
+  * @param  trackWidth: 轮距 (m)
+  * @retval None
+  */
+void MotionCtrl_Init(MotionCtrl_t *mc, float trackWidth)
+{
+    if (mc == NULL) return;
+
+    MotionCtrl_AxisInit(&mc->linear, 0.5f, 1.0f, 5.0f);
+    MotionCtrl_AxisInit(&mc->angular, 3.0f, 6.0f, 30.0f);
+    mc->trackWidth = trackWidth;
+
+    mc->syncKp = 0.0f;
+    mc->syncKi = 0.0f;
+    mc->syncIntegral = 0.0f;
+    mc->syncIntegralMax = 0.1f;
+    mc->syncError = 0.0f;
+
+    mc->yawFeedbackEnabled = false;
+    mc->yawKp = 0.0f;
+    mc->yawRateError = 0.0f;
+
+    mc->leftSpeedMs = 0.0f;
+    mc->rightSpeedMs = 0.0f;
+}
+
+/**
+  * @brief  设置速度/加速度/加加速度限制
+  * @param  mc: 运动控制器对象指针
+  * @param  maxLinearVel: 最大线速度 (m/s)
+  * @param  maxLinearAcc: 最大线加速度 (m/s^2)
+  * @param  maxLinearJerk: 最大线加加速度 (m/s^3)
+  * @param  maxAngularVel: 最大角速度 (rad/s)
+  * @param  maxAngularAcc: 最大角加速度 (rad/s^2)
+  * @param  maxAngularJerk: 最大角加加速度 (rad/s^3)
+  * @retval None
+  */
+void MotionCtrl_SetLimits(MotionCtrl_t *mc, float maxLinearVel, float maxLinearAcc, float maxLinearJerk,
+                          float maxAngularVel, float maxAngularAcc, float maxAngularJerk)
+{
+    if (mc == NULL) return;
+
+    mc->linear.maxVel = maxLinearVel;
+    mc->linear.maxAcc = maxLinearAcc;
+    mc->linear.maxJerk = maxLinearJerk;
+    mc->angular.maxVel = maxAngularVel;
+    mc->angular.maxAcc = maxAngularAcc;
+    mc->angular.maxJerk = maxAngularJerk;
+}
+
+/**
+  * @brief  设置交叉耦合同步增益
+  * @param  mc: 运动控制器对象指针
+  * @param  kp: 比例系数
+  * @param  ki: 积分系数
+  * @param  integralMax: 积分限幅 (m/s)
+  * @retval None
+  */
+void MotionCtrl_SetSyncGains(MotionCtrl_t *mc, float kp, float ki, float integralMax)
+{
+    if (mc == NULL) return;
+
+    mc->syncKp = kp;
+    mc->syncKi = ki;
+    mc->syncIntegralMax = integralMax;
+}
+
+/**
+  * @brief  设置IMU偏航角速度反馈
+  * @param  mc: 运动控制器对象指针
+  * @param  enable: 是否启用
+  * @param  kp: 偏航角速度误差比例系数
+  * @retval None
+  */
+void MotionCtrl_SetYawFeedback(MotionCtrl_t *mc, bool enable, float kp)
+{
+    if (mc == NULL) return;
+
+    mc->yawFeedbackEnabled = enable;
+    mc->yawKp = kp;
+}
+
+/**
+  * @brief  设置运动目标
+  * @param  mc: 运动控制器对象指针
+  * @param  linearMs: 目标线速度 (m/s)，前进为正
+  * @param  angularRadS: 目标角速度 (rad/s)，逆时针（左转）为正
+  * @retval None
+  */
+void MotionCtrl_SetTarget(MotionCtrl_t *mc, float linearMs, float angularRadS)
+{
+    if (mc == NULL) return;
+
+    mc->linear.target = linearMs;
+    mc->angular.target = angularRadS;
+}
+
+/**
+  * @brief  复位运动控制器（规划状态从给定速度开始，避免切换模式时跳变）
+  * @param  mc: 运动控制器对象指针
+  * @param  linearMs: 当前线速度 (m/s)
+  * @param  angularRadS: 当前角速度 (rad/s)
+  * @retval None
+  */
+void MotionCtrl_Reset(MotionCtrl_t *mc, float linearMs, float angularRadS)
+{
+    if (mc == NULL) return;
+
+    mc->linear.target = linearMs;
+    mc->linear.command = linearMs;
+    mc->linear.accel = 0.0f;
+    mc->angular.target = angularRadS;
+    mc->angular.command = angularRadS;
+    mc->angular.accel = 0.0f;
+
+    mc->syncIntegral = 0.0f;
+    mc->syncError = 0.0f;
+    mc->yawRateError = 0.0f;
+}
+
+/**
+  * @brief  运动控制器周期更新
+  * @param  mc: 运动控制器对象指针
+  * @param  dt: 控制周期 (s)
+  * @param  leftMeasMs: 左轮实测速度 (m/s)
+  * @param  rightMeasMs: 右轮实测速度 (m/s)
+  * @param  yawRateRadS: IMU实测偏航角速度 (rad/s)，未启用偏航反馈时忽略
+  * @param  yawValid: IMU数据是否可用，不可用时本周期不做偏航反馈
+  * @retval None
+  */
+void MotionCtrl_Update(MotionCtrl_t *mc, float dt, float leftMeasMs, float rightMeasMs,
+                       float yawRateRadS, bool yawValid)
+{
+    if (mc == NULL || dt <= 0.0f) return;
+
+    /* 加速度/加加速度限制 */
+    MotionCtrl_AxisStep(&mc->linear, dt);
+    MotionCtrl_AxisStep(&mc->angular, dt);
+
+    float v = mc->linear.command;
+    float w = mc->angular.command;
+
+    /* 静止：输出严格为0，清除积分，避免轮速PID死区补偿导致抖动 */
+    if (v == 0.0f && w == 0.0f) {
+        mc->syncIntegral = 0.0f;
+        mc->syncError = 0.0f;
+        mc->yawRateError = 0.0f;
+        mc->leftSpeedMs = 0.0f;
+        mc->rightSpeedMs = 0.0f;
+        return;
+    }
+
+    /* 差速运动学分解 */
+    float halfTrack = mc->trackWidth * 0.5f;
+    float leftRef = v - w * halfTrack;
+    float rightRef = v + w * halfTrack;
+
+    /* 交叉耦合：两轮跟踪误差之差，>0 表示左轮相对超前 */
+    mc->syncError = (leftMeasMs - leftRef) - (rightMeasMs - rightRef);
+    mc->syncIntegral += mc->syncError * dt;
+    if (mc->syncIntegral > mc->syncIntegralMax) mc->syncIntegral = mc->syncIntegralMax;
+    if (mc->syncIntegral < -mc->syncIntegralMax) mc->syncIntegral = -mc->syncIntegralMax;
+    float syncCorr = mc->syncKp * mc->syncError + mc->syncKi * mc->syncIntegral;
+
+    /* 偏航角速度反馈：补偿打滑等编码器无法观测的偏差 */
+    float yawCorr = 0.0f;
+    if (mc->yawFeedbackEnabled && yawValid) {
+        mc->yawRateError = w - yawRateRadS;
+        yawCorr = mc->yawKp * mc->yawRateError * halfTrack;
+    } else {
+        mc->yawRateError = 0.0f;
+    }
+
+    mc->leftSpeedMs = leftRef - 0.5f * syncCorr - yawCorr;
+    mc->rightSpeedMs = rightRef + 0.5f * syncCorr + yawCorr;
+}
+
+/**
+  * @brief  获取左右轮目标速度
+  * @param  mc: 运动控制器对象指针
+  * @param  leftSpeedMs: 左轮目标速度输出 (m/s)
+  * @param  rightSpeedMs: 右轮目标速度输出 (m/s)
+  * @retval None
+  */
+void MotionCtrl_GetWheelSpeed(MotionCtrl_t *mc, float *leftSpeedMs, float *rightSpeedMs)
+{
+    if (mc == NULL) return;
+
+    if (leftSpeedMs != NULL) *leftSpeedMs = mc->leftSpeedMs;
+    if (rightSpeedMs != NULL) *rightSpeedMs = mc->rightSpeedMs;
+}
+
+/**
+  * @brief  获取经限制后的 (v, ω) 指令
+  * @param  mc: 运动控制器对象指针
+  * @param  linearMs: 线速度输出 (m/s)
+  * @param  angularRadS: 角速度输出 (rad/s)
+  * @retval None
+  */
+void MotionCtrl_GetCommand(MotionCtrl_t *mc, float *linearMs, float *angularRadS)
+{
+    if (mc == NULL) return;
+
+    if (linearMs != NULL) *linearMs = mc->linear.command;
+    if (angularRadS != NULL) *angularRadS = mc->angular.command;
+}
+
@@ -0,0 +1,77 @@
+/**
+  ******************************************************************************
+  * @file    motion_ctrl.h
+  * @brief   差速底盘运动控制器头文件
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 输入线速度 v (m/s) 和角速度 ω (rad/s) 目标，经加速度/加加速度限制后
+  * 分解为左右轮速度，并通过交叉耦合（两轮同步误差）以及可选的IMU偏航角速度
+  * 反馈修正两轮目标，避免两轮独立PID造成直行跑偏。
+  * 输出仍为左右轮 m/s 目标，由电机控制任务中的轮速PID执行。
+  ******************************************************************************
+  */
+
+#ifndef __MOTION_CTRL_H__
+#define __MOTION_CTRL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 单轴（线速度或角速度）规划状态 */
+typedef struct {
+    float target;               /* 目标值 */
+    float command;              /* 经限制后的指令值 */
+    float accel;                /* 当前加速度 */
+    float maxVel;               /* 最大速度 */
+    float maxAcc;               /* 最大加速度 */
+    float maxJerk;              /* 最大加加速度 */
+} MotionAxis_t;
+
+/* 差速运动控制器结构体 */
+typedef struct {
+    MotionAxis_t linear;        /* 线速度轴 (m/s) */
+    MotionAxis_t angular;       /* 角速度轴 (rad/s) */
+    float trackWidth;           /* 轮距 (m) */
+
+    /* 交叉耦合同步控制 */
+    float syncKp;               /* 同步误差比例系数 */
+    float syncKi;               /* 同步误差积分系数 */
+    float syncIntegral;         /* 同步误差积分 */
+    float syncIntegralMax;      /* 同步误差积分限幅 (m/s) */
+    float syncError;            /* 当前同步误差 (m/s) */
+
+    /* 偏航角速度反馈（IMU） */
+    bool yawFeedbackEnabled;    /* 是否启用IMU偏航角速度反馈 */
+    float yawKp;                /* 偏航角速度误差比例系数 */
+    float yawRateError;         /* 当前偏航角速度误差 (rad/s) */
+
+    /* 输出 */
+    float leftSpeedMs;          /* 左轮目标速度 (m/s) */
+    float rightSpeedMs;         /* 右轮目标速度 (m/s) */
+} MotionCtrl_t;
+
+/* 函数声明 */
+void MotionCtrl_Init(MotionCtrl_t *mc, float trackWidth);
+void MotionCtrl_SetLimits(MotionCtrl_t *mc, float maxLinearVel, float maxLinearAcc, float maxLinearJerk,
+                          float maxAngularVel, float maxAngularAcc, float maxAngularJerk);
+void MotionCtrl_SetSyncGains(MotionCtrl_t *mc, float kp, float ki, float integralMax);
+void MotionCtrl_SetYawFeedback(MotionCtrl_t *mc, bool enable, float kp);
+void MotionCtrl_SetTarget(MotionCtrl_t *mc, float linearMs, float angularRadS);
+void MotionCtrl_Reset(MotionCtrl_t *mc, float linearMs, float angularRadS);
+void MotionCtrl_Update(MotionCtrl_t *mc, float dt, float leftMeasMs, float rightMeasMs,
+                       float yawRateRadS, bool yawValid);
+void MotionCtrl_GetWheelSpeed(MotionCtrl_t *mc, float *leftSpeedMs, float *rightSpeedMs);
+void MotionCtrl_GetCommand(MotionCtrl_t *mc, float *linearMs, float *angularRadS);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTION_CTRL_H__ */
+
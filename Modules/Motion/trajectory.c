@@ -0,0 +1,248 @@
+/**
+  ******************************************************************************
+  * @file    trajectory.c
+  * @brief   上位机轨迹缓冲与执行实现
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "trajectory.h"
+#include <stddef.h>  /* 定义NULL */
+#include <string.h>
+
+/* 编译器屏障：保证先写入轨迹点再发布写指针（单核，无需DMB） */
+#define TRAJ_BARRIER()  __asm volatile ("" ::: "memory")
+
+/**
+  * @brief  初始化轨迹缓冲
+  * @param  traj: 轨迹对象指针
+  * @retval None
+  */
+void Trajectory_Init(Trajectory_t *traj)
+{
+    if (traj == NULL) return;
+
+    memset(traj, 0, sizeof(Trajectory_t));
+    traj->state = TRAJ_STATE_IDLE;
+    traj->type = TRAJ_TYPE_WHEEL;
+}
+
+/**
+  * @brief  缓冲区已存点数
+  */
+uint16_t Trajectory_GetCount(const Trajectory_t *traj)
+{
+    if (traj == NULL) return 0;
+    return (uint16_t)((traj->head + TRAJECTORY_BUFFER_SIZE - traj->tail) % TRAJECTORY_BUFFER_SIZE);
+}
+
+/**
+  * @brief  缓冲区剩余空间（保留一个空位区分满/空）
+  */
+uint16_t Trajectory_GetFree(const Trajectory_t *traj)
+{
+    if (traj == NULL) return 0;
+    return (uint16_t)(TRAJECTORY_BUFFER_SIZE - 1U - Trajectory_GetCount(traj));
+}
+
+/**
+  * @brief  缓冲区内尚未执行的轨迹时长 (ms)
+  */
+uint32_t Trajectory_GetBufferedMs(const Trajectory_t *traj)
+{
+    if (traj == NULL) return 0;
+
+    uint32_t total = 0;
+    uint16_t idx = traj->tail;
+    uint16_t head = traj->head;
+    while (idx != head) {
+        total += traj->buf[idx].dtMs;
+        idx = (uint16_t)((idx + 1U) % TRAJECTORY_BUFFER_SIZE);
+    }
+    return total;
+}
+
+/**
+  * @brief  轨迹是否在执行（含缓冲耗尽后的等待）
+  */
+bool Trajectory_IsActive(const Trajectory_t *traj)
+{
+    if (traj == NULL) return false;
+    return (traj->state == TRAJ_STATE_RUNNING || traj->state == TRAJ_STATE_UNDERRUN);
+}
+
+/**
+  * @brief  追加轨迹点（USB任务调用）
+  * @note   序号从0开始的追加在空闲/完成状态下开始一条新轨迹；
+  *         已接收过的序号视为重发并忽略，序号跳跃返回 TRAJ_APPEND_GAP；
+  *         中止请求未被取走前拒绝追加（取走时会清空缓冲），返回 TRAJ_APPEND_ABORTING
+  * @param  traj: 轨迹对象指针
+  * @param  type: 轨迹类型
+  * @param  firstIndex: 首个点的序号
+  * @param  points: 轨迹点数组
+  * @param  count: 点数
+  * @retval 追加结果
+  */
+TrajectoryAppendResult_t Trajectory_Append(Trajectory_t *traj, TrajectoryType_t type, uint16_t firstIndex,
+                                           const TrajectoryPoint_t *points, uint8_t count)
+{
+    if (traj == NULL || points == NULL) return TRAJ_APPEND_GAP;
+    if (traj->abortRequest) return TRAJ_APPEND_ABORTING;
+
+    bool idle = (traj->state == TRAJ_STATE_IDLE || traj->state == TRAJ_STATE_DONE);
+    if (idle) {
+        if (firstIndex != 0U) {
+            return TRAJ_APPEND_GAP;
+        }
+        /* 开始新轨迹（消费者在空闲状态不访问缓冲区） */
+        traj->head = 0;
+        traj->tail = 0;
+        traj->nextIndex = 0;
+        traj->type = type;
+        traj->endOfStream = false;
+        traj->startRequest = false;
+    } else if (type != traj->type) {
+        return TRAJ_APPEND_TYPE_MISMATCH;
+    }
+
+    int16_t offset = (int16_t)(traj->nextIndex - firstIndex);
+    if (offset < 0) {
+        return TRAJ_APPEND_GAP;
+    }
+
+    for (uint8_t i = (uint8_t)((offset < (int16_t)count) ? offset : count); i < count; i++) {
+        uint16_t next = (uint16_t)((traj->head + 1U) % TRAJECTORY_BUFFER_SIZE);
+        if (next == traj->tail) {
+            return TRAJ_APPEND_FULL;
+        }
+        traj->buf[traj->head] = points[i];
+        if (traj->buf[traj->head].dtMs == 0U) {
+            traj->buf[traj->head].dtMs = 1U;
+        }
+        TRAJ_BARRIER();
+        traj->head = next;
+        traj->nextIndex++;
+    }
+
+    if (idle) {
+        traj->state = TRAJ_STATE_LOADED;
+    }
+    return TRAJ_APPEND_OK;
+}
+
+/**
+  * @brief  请求开始执行
+  * @param  traj: 轨迹对象指针
+  * @retval true=已受理，false=无可执行的轨迹
+  */
+bool Trajectory_RequestStart(Trajectory_t *traj)
+{
+    if (traj == NULL) return false;
+    if (traj->state != TRAJ_STATE_LOADED) return false;
+
+    traj->startRequest = true;
+    return true;
+}
+
+/**
+  * @brief  请求中止执行并清空缓冲
+  * @param  traj: 轨迹对象指针
+  * @retval None
+  */
+void Trajectory_RequestAbort(Trajectory_t *traj)
+{
+    if (traj == NULL) return;
+    if (traj->state == TRAJ_STATE_IDLE) return;
+
+    traj->abortRequest = true;
+}
+
+/**
+  * @brief  标记已发送最后一段，缓冲耗尽即视为正常完成
+  * @param  traj: 轨迹对象指针
+  * @retval None
+  */
+void Trajectory_MarkEndOfStream(Trajectory_t *traj)
+{
+    if (traj == NULL) return;
+    traj->endOfStream = true;
+}
+
+/**
+  * @brief  执行一个控制周期（电机控制任务调用）
+  * @param  traj: 轨迹对象指针
+  * @param  dtMs: 控制周期 (ms)
+  * @param  curA: 当前指令 a（启动/恢复时作为插值起点）
+  * @param  curB: 当前指令 b
+  * @param  a: 输出 a
+  * @param  b: 输出 b
+  * @retval true=轨迹正在输出，false=无输出（空闲/耗尽/完成）
+  */
+bool Trajectory_Step(Trajectory_t *traj, float dtMs, float curA, float curB, float *a, float *b)
+{
+    if (traj == NULL || a == NULL || b == NULL) return false;
+
+    if (traj->abortRequest) {
+        traj->tail = traj->head;
+        traj->state = TRAJ_STATE_IDLE;
+        traj->startRequest = false;
+        traj->abortRequest = false;
+        return false;
+    }
+
+    if (traj->startRequest) {
+        traj->startRequest = false;
+        if (traj->state == TRAJ_STATE_LOADED) {
+            traj->from.dtMs = 0;
+            traj->from.a = curA;
+            traj->from.b = curB;
+            traj->segElapsedMs = 0.0f;
+            traj->state = TRAJ_STATE_RUNNING;
+        }
+    }
+
+    /* 缓冲耗尽后有新点到达：从当前指令平滑接续 */
+    if (traj->state == TRAJ_STATE_UNDERRUN && traj->tail != traj->head) {
+        traj->from.a = curA;
+        traj->from.b = curB;
+        traj->segElapsedMs = 0.0f;
+        traj->state = TRAJ_STATE_RUNNING;
+    }
+
+    if (traj->state != TRAJ_STATE_RUNNING) {
+        return false;
+    }
+
+    traj->segElapsedMs += dtMs;
+    while (1) {
+        if (traj->tail == traj->head) {
+            traj->state = traj->endOfStream ? TRAJ_STATE_DONE : TRAJ_STATE_UNDERRUN;
+            if (!traj->endOfStream) {
+                traj->underrunCount++;
+            }
+            return false;
+        }
+
+        const TrajectoryPoint_t *to = &traj->buf[traj->tail];
+        if (traj->segElapsedMs >= (float)to->dtMs) {
+            /* 本段执行完毕，进入下一段 */
+            traj->segElapsedMs -= (float)to->dtMs;
+            traj->from = *to;
+            traj->tail = (uint16_t)((traj->tail + 1U) % TRAJECTORY_BUFFER_SIZE);
+            traj->executedCount++;
+            continue;
+        }
+
+        /* 段内线性插值 */
+        float ratio = traj->segElapsedMs / (float)to->dtMs;
+        traj->outA = traj->from.a + (to->a - traj->from.a) * ratio;
+        traj->outB = traj->from.b + (to->b - traj->from.b) * ratio;
+        break;
+    }
+
+    *a = traj->outA;
+    *b = traj->outB;
+    return true;
+}
+
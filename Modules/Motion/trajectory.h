@@ -0,0 +1,108 @@
+/**
+  ******************************************************************************
+  * @file    trajectory.h
+  * @brief   上位机轨迹缓冲与执行头文件
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 上位机预先上传带时间参数的 (v, ω) 或左右轮速度轨迹点，控制任务按控制周期
+  * 在相邻点之间线性插值执行，上位机只需提前追加后续段，USB调度抖动不再直接
+  * 造成速度突变。
+  * 缓冲区为单生产者（USB任务追加）/单消费者（电机控制任务执行）环形队列，
+  * 启动/中止以请求标志的方式交给消费者处理。
+  ******************************************************************************
+  */
+
+#ifndef __TRAJECTORY_H__
+#define __TRAJECTORY_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 轨迹点缓冲容量（20ms点间隔约2.5s） */
+#define TRAJECTORY_BUFFER_SIZE      128U
+
+/* 轨迹类型 */
+typedef enum {
+    TRAJ_TYPE_WHEEL = 0,            /* a=左轮 m/s，b=右轮 m/s */
+    TRAJ_TYPE_VW                    /* a=线速度 m/s，b=角速度 rad/s */
+} TrajectoryType_t;
+
+/* 轨迹执行状态 */
+typedef enum {
+    TRAJ_STATE_IDLE = 0,            /* 空闲 */
+    TRAJ_STATE_LOADED,              /* 已装载，等待启动 */
+    TRAJ_STATE_RUNNING,             /* 执行中 */
+    TRAJ_STATE_UNDERRUN,            /* 缓冲耗尽，已减速停车，有新点时继续 */
+    TRAJ_STATE_DONE                 /* 执行完毕 */
+} TrajectoryState_t;
+
+/* 追加结果 */
+typedef enum {
+    TRAJ_APPEND_OK = 0,             /* 成功（含重复段，已忽略） */
+    TRAJ_APPEND_GAP,                /* 序号不连续 */
+    TRAJ_APPEND_TYPE_MISMATCH,      /* 与当前轨迹类型不一致 */
+    TRAJ_APPEND_FULL,               /* 缓冲区已满 */
+    TRAJ_APPEND_ABORTING            /* 中止请求尚未被控制任务处理 */
+} TrajectoryAppendResult_t;
+
+/* 轨迹点：从上一点经过 dtMs 到达 (a, b) */
+typedef struct {
+    uint16_t dtMs;                  /* 距上一点时间 (ms) */
+    float a;
+    float b;
+} TrajectoryPoint_t;
+
+/* 轨迹缓冲与执行器 */
+typedef struct {
+    TrajectoryPoint_t buf[TRAJECTORY_BUFFER_SIZE];
+    volatile uint16_t head;         /* 写指针（生产者） */
+    volatile uint16_t tail;         /* 读指针（消费者） */
+    uint16_t nextIndex;             /* 期望的下一个点序号 */
+    TrajectoryType_t type;          /* 轨迹类型 */
+    volatile TrajectoryState_t state;
+    volatile bool startRequest;     /* 启动请求 */
+    volatile bool abortRequest;     /* 中止请求 */
+    volatile bool endOfStream;      /* 上位机已发送最后一段 */
+
+    /* 执行状态（消费者） */
+    TrajectoryPoint_t from;         /* 当前段起点 */
+    float segElapsedMs;             /* 当前段已执行时间 */
+    float outA;                     /* 当前输出 a */
+    float outB;                     /* 当前输出 b */
+
+    /* 统计 */
+    uint32_t executedCount;         /* 已执行点数 */
+    uint16_t underrunCount;         /* 缓冲耗尽次数 */
+} Trajectory_t;
+
+/* 函数声明 */
+void Trajectory_Init(Trajectory_t *traj);
+
+/* 生产者（USB任务） */
+TrajectoryAppendResult_t Trajectory_Append(Trajectory_t *traj, TrajectoryType_t type, uint16_t firstIndex,
+                                           const TrajectoryPoint_t *points, uint8_t count);
+bool Trajectory_RequestStart(Trajectory_t *traj);
+void Trajectory_RequestAbort(Trajectory_t *traj);
+void Trajectory_MarkEndOfStream(Trajectory_t *traj);
+
+/* 消费者（电机控制任务） */
+bool Trajectory_Step(Trajectory_t *traj, float dtMs, float curA, float curB, float *a, float *b);
+
+/* 状态查询 */
+bool Trajectory_IsActive(const Trajectory_t *traj);
+uint16_t Trajectory_GetCount(const Trajectory_t *traj);
+uint16_t Trajectory_GetFree(const Trajectory_t *traj);
+uint32_t Trajectory_GetBufferedMs(const Trajectory_t *traj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TRAJECTORY_H__ */
+
@@ -9,23 +9,53 @@
 
 #include "motor.h"
 
-/* 私有函数声明 */
-static void Motor_Private_SetSpeed(Motor_t *motor, int16_t speed);
-static void Motor_Private_SetDirection(Motor_t *motor, MotorState_t dir);
-static void Motor_Private_Stop(Motor_t *motor);
-static void Motor_Private_Brake(Motor_t *motor);
-static int16_t Motor_Private_GetSpeed(Motor_t *motor);
-static MotorState_t Motor_Private_GetState(Motor_t *motor);
-
-/* 虚拟函数表 */
-static const MotorVTable_t Motor_VTable = {
-    .SetSpeed = Motor_Private_SetSpeed,
-    .SetDirection = Motor_Private_SetDirection,
-    .Stop = Motor_Private_Stop,
-    .Brake = Motor_Private_Brake,
-    .GetSpeed = Motor_Private_GetSpeed,
-    .GetState = Motor_Private_GetState
-};
+/**
+  * @brief  缓存比较寄存器地址和CCR换算系数
+  * @note   TIM_CHANNEL_1..4 = 0x0/0x4/0x8/0xC，CCR1..CCR4 为连续的32位寄存器
+  * @param  motor: 电机对象指针
+  * @retval None
+  */
+static void Motor_Private_CacheOutput(Motor_t *motor)
+{
+    motor->ccrA = NULL;
+    motor->ccrB = NULL;
+    motor->arr = 0;
+    motor->ccrScaleQ16 = 0;
+    motor->lastCcrA = 0;
+    motor->lastCcrB = 0;
+
+    if (motor->htim == NULL) return;
+
+    motor->ccrA = &motor->htim->Instance->CCR1 + (motor->pwmChannel >> 2);
+    if (motor->dualPWM) {
+        motor->ccrB = &motor->htim->Instance->CCR1 + (motor->pwmChannelB >> 2);
+    }
+
+    /* 向上取整，保证 speed=1000 时 CCR 恰好等于 ARR */
+    motor->arr = __HAL_TIM_GET_AUTORELOAD(motor->htim);
+    motor->ccrScaleQ16 = (uint32_t)((((uint64_t)motor->arr << 16) + 999U) / 1000U);
+}
+
+/**
+  * @brief  写比较寄存器（仅在数值变化时写入）
+  * @param  motor: 电机对象指针
+  * @param  ccrA: 通道A比较值
+  * @param  ccrB: 通道B比较值（单PWM模式忽略）
+  * @retval None
+  */
+static inline void Motor_Private_WriteCCR(Motor_t *motor, uint32_t ccrA, uint32_t ccrB)
+{
+    if (motor->ccrA == NULL) return;
+
+    if (ccrA != motor->lastCcrA) {
+        *motor->ccrA = ccrA;
+        motor->lastCcrA = ccrA;
+    }
+    if (motor->ccrB != NULL && ccrB != motor->lastCcrB) {
+        *motor->ccrB = ccrB;
+        motor->lastCcrB = ccrB;
+    }
+}
 
 /**
   * @brief  初始化电机
@@ -37,12 +67,11 @@ static const MotorVTable_t Motor_VTable = {
   * @param  dirPin: 方向控制引脚
   * @retval None
   */
-void Motor_Init(Motor_t *motor, MotorType_t type, TIM_HandleTypeDef *htim, 
+void Motor_Init(Motor_t *motor, MotorType_t type, TIM_HandleTypeDef *htim,
                 uint32_t channel, GPIO_TypeDef *dirPort, uint16_t dirPin)
 {
     if (motor == NULL) return;
-    
-    motor->vtable = &Motor_VTable;
+
     motor->type = type;
     motor->state = MOTOR_STATE_STOP;
     motor->currentSpeed = 0;
@@ -54,12 +83,15 @@ void Motor_Init(Motor_t *motor, MotorType_t type, TIM_HandleTypeDef *htim,
     motor->htim = htim;
     motor->enabled = false;
     motor->dualPWM = false;  /* 单PWM模式 */
-    
+
+    Motor_Private_CacheOutput(motor);
+
     /* 启动PWM */
     if (htim != NULL) {
+        __HAL_TIM_SET_COMPARE(htim, channel, 0);
         HAL_TIM_PWM_Start(htim, channel);
     }
-    
+
     /* 初始化方向引脚为低电平 */
     if (dirPort != NULL) {
         HAL_GPIO_WritePin(dirPort, dirPin, GPIO_PIN_RESET);
@@ -75,12 +107,11 @@ void Motor_Init(Motor_t *motor, MotorType_t type, TIM_HandleTypeDef *htim,
   * @param  channelB: PWM通道B (INB)
   * @retval None
   */
-void Motor_InitDualPWM(Motor_t *motor, MotorType_t type, TIM_HandleTypeDef *htim, 
+void Motor_InitDualPWM(Motor_t *motor, MotorType_t type, TIM_HandleTypeDef *htim,
                        uint32_t channelA, uint32_t channelB)
 {
     if (motor == NULL) return;
-    
-    motor->vtable = &Motor_VTable;
+
     motor->type = type;
     motor->state = MOTOR_STATE_STOP;
     motor->currentSpeed = 0;
@@ -92,18 +123,21 @@ void Motor_InitDualPWM(Motor_t *motor, MotorType_t type, TIM_HandleTypeDef *htim
     motor->htim = htim;
     motor->enabled = false;
     motor->dualPWM = true;  /* 双PWM模式 */
-    
-    /* 启动两个PWM通道 */
-    if (htim != NULL) {
-        HAL_TIM_PWM_Start(htim, channelA);
-        HAL_TIM_PWM_Start(htim, channelB);
-    }
-    
-    /* 初始化两个通道都为低电平（滑行状态） */
+
+    Motor_Private_CacheOutput(motor);
+
     if (htim != NULL) {
-        uint32_t arr = __HAL_TIM_GET_AUTORELOAD(htim);
+        /* 比较值预装载：新占空比在更新事件时生效，配合 Motor_BeginSyncUpdate 使用 */
+        __HAL_TIM_ENABLE_OCxPRELOAD(htim, channelA);
+        __HAL_TIM_ENABLE_OCxPRELOAD(htim, channelB);
+
+        /* 初始化两个通道都为低电平（滑行状态） */
         __HAL_TIM_SET_COMPARE(htim, channelA, 0);
         __HAL_TIM_SET_COMPARE(htim, channelB, 0);
+
+        /* 启动两个PWM通道 */
+        HAL_TIM_PWM_Start(htim, channelA);
+        HAL_TIM_PWM_Start(htim, channelB);
     }
 }
 
@@ -113,139 +147,67 @@ void Motor_InitDualPWM(Motor_t *motor, MotorType_t type, TIM_HandleTypeDef *htim
   * @param  speed: 速度值 (0-1000)
   * @retval None
   */
-uint32_t ccr_left,arr_left=0;
-static void Motor_Private_SetSpeed(Motor_t *motor, int16_t speed)
+void Motor_SetSpeed(Motor_t *motor, int16_t speed)
 {
     if (motor == NULL || motor->htim == NULL) return;
-    
+
     /* 限制速度范围 */
     if (speed > 1000) speed = 1000;
     if (speed < 0) speed = 0;
-    
+
     motor->targetSpeed = speed;
-    
+
     if (!motor->enabled) {
+        /* 未使能：输出为0（双PWM模式两脚均低，滑行） */
         motor->currentSpeed = 0;
-        if (motor->dualPWM) {
-            /* 双PWM模式：两脚均低（滑行） */
-            __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannel, 0);
-            __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannelB, 0);
-        } else {
-            /* 单PWM模式：PWM为0 */
-            __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannel, 0);
-        }
+        Motor_Private_WriteCCR(motor, 0, 0);
         return;
     }
-    
+
     /* 计算PWM占空比 */
-    uint32_t arr = __HAL_TIM_GET_AUTORELOAD(motor->htim);
-    uint32_t ccr = speed *arr/1000 ;
-    
+    uint32_t ccr = ((uint32_t)speed * motor->ccrScaleQ16) >> 16;
+
     motor->currentSpeed = speed;
-    
-		if(motor->type == MOTOR_TYPE_WHEEL)
-		{ccr_left = ccr;
-		arr_left = arr;}
-		
+
     if (motor->dualPWM) {
         /* 双PWM模式：根据方向设置PWM */
-        if (motor->state == MOTOR_STATE_FORWARD) {
-            /* 正向：INA=PWM，INB=低电平（0） */
-            __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannel, ccr);
-            __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannelB, 0);
-        } else if (motor->state == MOTOR_STATE_BACKWARD) {
-            /* 反向：INA=低电平（0），INB=PWM */
-            __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannel, 0);
-            __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannelB, ccr);
-        } else if (motor->state == MOTOR_STATE_BRAKE) {
-            /* 刹车：两脚均高（100%占空比），忽略速度设置 */
-            uint32_t arr = __HAL_TIM_GET_AUTORELOAD(motor->htim);
-            __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannel, arr);
-            __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannelB, arr);
-        } else {
-            /* 停止/滑行：两脚均低（0），忽略速度设置 */
-            __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannel, 0);
-            __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannelB, 0);
+        switch (motor->state) {
+            case MOTOR_STATE_FORWARD:
+                /* 正向：INA=PWM，INB=低电平（0） */
+                Motor_Private_WriteCCR(motor, ccr, 0);
+                break;
+            case MOTOR_STATE_BACKWARD:
+                /* 反向：INA=低电平（0），INB=PWM */
+                Motor_Private_WriteCCR(motor, 0, ccr);
+                break;
+            case MOTOR_STATE_BRAKE:
+                /* 刹车：两脚均高（100%占空比），忽略速度设置 */
+                Motor_Private_WriteCCR(motor, motor->arr, motor->arr);
+                break;
+            case MOTOR_STATE_STOP:
+            default:
+                /* 停止/滑行：两脚均低（0），忽略速度设置 */
+                Motor_Private_WriteCCR(motor, 0, 0);
+                break;
         }
     } else {
         /* 单PWM模式：只设置PWM占空比，方向由dirPin控制 */
-        __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannel, ccr);
+        Motor_Private_WriteCCR(motor, ccr, 0);
     }
 }
 
 /**
   * @brief  设置电机方向
+  * @note   双PWM模式下方向在下一次 Motor_SetSpeed 时输出
   * @param  motor: 电机对象指针
   * @param  dir: 方向
   * @retval None
   */
-static void Motor_Private_SetDirection(Motor_t *motor, MotorState_t dir)
+void Motor_SetDirection(Motor_t *motor, MotorState_t dir)
 {
     if (motor == NULL) return;
-    
+
     motor->state = dir;
-    
-//    if (motor->dualPWM) {
-//        /* 双PWM模式：通过PWM控制方向和状态 */
-//        uint32_t arr = __HAL_TIM_GET_AUTORELOAD(motor->htim);
-//        uint32_t maxCCR = arr;  /* 100%占空比 */
-//        
-//        switch (dir) {
-//            case MOTOR_STATE_FORWARD:
-//                /* 正向：根据当前速度设置PWM，如果没有速度则设置为滑行状态 */
-//                if (motor->currentSpeed > 0) {
-//                    uint32_t ccr = (motor->currentSpeed * arr) / 1000;
-//                    __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannel, ccr);
-//                    __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannelB, 0);
-//                } else {
-//                    /* 速度为0时，设置为滑行状态 */
-//                    __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannel, 0);
-//                    __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannelB, 0);
-//                }
-//                break;
-//            case MOTOR_STATE_BACKWARD:
-//                /* 反向：根据当前速度设置PWM，如果没有速度则设置为滑行状态 */
-//                if (motor->currentSpeed > 0) {
-//                    uint32_t ccr = (motor->currentSpeed * arr) / 1000;
-//                    __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannel, 0);
-//                    __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannelB, ccr);
-//                } else {
-//                    /* 速度为0时，设置为滑行状态 */
-//                    __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannel, 0);
-//                    __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannelB, 0);
-//                }
-//                break;
-//            case MOTOR_STATE_BRAKE:
-//                /* 刹车：两脚均高（100%占空比） */
-//                __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannel, maxCCR);
-//                __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannelB, maxCCR);
-//                break;
-//            case MOTOR_STATE_STOP:
-//            default:
-//                /* 停止/滑行：两脚均低（0） */
-//                __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannel, 0);
-//                __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannelB, 0);
-//                break;
-//        }
-//    } else {
-//        /* 单PWM模式：通过GPIO控制方向 */
-//        if (motor->dirPort == NULL) return;
-//        
-//        switch (dir) {
-//            case MOTOR_STATE_FORWARD:
-//                HAL_GPIO_WritePin(motor->dirPort, motor->dirPin, GPIO_PIN_SET);
-//                break;
-//            case MOTOR_STATE_BACKWARD:
-//                HAL_GPIO_WritePin(motor->dirPort, motor->dirPin, GPIO_PIN_RESET);
-//                break;
-//            case MOTOR_STATE_STOP:
-//            case MOTOR_STATE_BRAKE:
-//                HAL_GPIO_WritePin(motor->dirPort, motor->dirPin, GPIO_PIN_RESET);
-//                break;
-//            default:
-//                break;
-//        }
-//    }
 }
 
 /**
@@ -253,24 +215,16 @@ static void Motor_Private_SetDirection(Motor_t *motor, MotorState_t dir)
   * @param  motor: 电机对象指针
   * @retval None
   */
-static void Motor_Private_Stop(Motor_t *motor)
+void Motor_Stop(Motor_t *motor)
 {
     if (motor == NULL) return;
-    
+
     motor->state = MOTOR_STATE_STOP;
     motor->targetSpeed = 0;
     motor->currentSpeed = 0;
-    
-    if (motor->htim != NULL) {
-        if (motor->dualPWM) {
-            /* 双PWM模式：两脚均低（滑行） */
-            __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannel, 0);
-            __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannelB, 0);
-        } else {
-            /* 单PWM模式：PWM为0 */
-            __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannel, 0);
-        }
-    }
+
+    /* 双PWM模式两脚均低（滑行），单PWM模式PWM为0 */
+    Motor_Private_WriteCCR(motor, 0, 0);
 }
 
 /**
@@ -278,27 +232,23 @@ static void Motor_Private_Stop(Motor_t *motor)
   * @param  motor: 电机对象指针
   * @retval None
   */
-static void Motor_Private_Brake(Motor_t *motor)
+void Motor_Brake(Motor_t *motor)
 {
     if (motor == NULL) return;
-    
+
     motor->state = MOTOR_STATE_BRAKE;
     motor->targetSpeed = 0;
     motor->currentSpeed = 0;
-    
-    if (motor->htim != NULL) {
-        if (motor->dualPWM) {
-            /* 双PWM模式：两脚均高（100%占空比） */
-            uint32_t arr = __HAL_TIM_GET_AUTORELOAD(motor->htim);
-            __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannel, arr);
-            __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannelB, arr);
-        } else {
-            /* 单PWM模式：设置方向引脚为低电平，PWM为0 */
-            if (motor->dirPort != NULL) {
-                HAL_GPIO_WritePin(motor->dirPort, motor->dirPin, GPIO_PIN_RESET);
-            }
-            __HAL_TIM_SET_COMPARE(motor->htim, motor->pwmChannel, 0);
+
+    if (motor->dualPWM) {
+        /* 双PWM模式：两脚均高（100%占空比） */
+        Motor_Private_WriteCCR(motor, motor->arr, motor->arr);
+    } else {
+        /* 单PWM模式：设置方向引脚为低电平，PWM为0 */
+        if (motor->dirPort != NULL) {
+            HAL_GPIO_WritePin(motor->dirPort, motor->dirPin, GPIO_PIN_RESET);
         }
+        Motor_Private_WriteCCR(motor, 0, 0);
     }
 }
 
@@ -307,7 +257,7 @@ static void Motor_Private_Brake(Motor_t *motor)
   * @param  motor: 电机对象指针
   * @retval 当前速度值
   */
-static int16_t Motor_Private_GetSpeed(Motor_t *motor)
+int16_t Motor_GetSpeed(Motor_t *motor)
 {
     if (motor == NULL) return 0;
     return motor->currentSpeed;
@@ -318,57 +268,12 @@ static int16_t Motor_Private_GetSpeed(Motor_t *motor)
   * @param  motor: 电机对象指针
   * @retval 当前状态
   */
-static MotorState_t Motor_Private_GetState(Motor_t *motor)
+MotorState_t Motor_GetState(Motor_t *motor)
 {
     if (motor == NULL) return MOTOR_STATE_STOP;
     return motor->state;
 }
 
-/* 公共接口函数 */
-void Motor_SetSpeed(Motor_t *motor, int16_t speed)
-{
-    if (motor != NULL && motor->vtable != NULL && motor->vtable->SetSpeed != NULL) {
-        motor->vtable->SetSpeed(motor, speed);
-    }
-}
-
-void Motor_SetDirection(Motor_t *motor, MotorState_t dir)
-{
-    if (motor != NULL && motor->vtable != NULL && motor->vtable->SetDirection != NULL) {
-        motor->vtable->SetDirection(motor, dir);
-    }
-}
-
-void Motor_Stop(Motor_t *motor)
-{
-    if (motor != NULL && motor->vtable != NULL && motor->vtable->Stop != NULL) {
-        motor->vtable->Stop(motor);
-    }
-}
-
-void Motor_Brake(Motor_t *motor)
-{
-    if (motor != NULL && motor->vtable != NULL && motor->vtable->Brake != NULL) {
-        motor->vtable->Brake(motor);
-    }
-}
-
-int16_t Motor_GetSpeed(Motor_t *motor)
-{
-    if (motor != NULL && motor->vtable != NULL && motor->vtable->GetSpeed != NULL) {
-        return motor->vtable->GetSpeed(motor);
-    }
-    return 0;
-}
-
-MotorState_t Motor_GetState(Motor_t *motor)
-{
-    if (motor != NULL && motor->vtable != NULL && motor->vtable->GetState != NULL) {
-        return motor->vtable->GetState(motor);
-    }
-    return MOTOR_STATE_STOP;
-}
-
 void Motor_Enable(Motor_t *motor)
 {
     if (motor == NULL) return;
@@ -388,3 +293,41 @@ bool Motor_IsEnabled(Motor_t *motor)
     return motor->enabled;
 }
 
+/**
+  * @brief  开始同步更新：暂停更新事件，期间写入的预装载比较值不会生效
+  * @param  htim: 定时器句柄
+  * @retval None
+  */
+void Motor_BeginSyncUpdate(TIM_HandleTypeDef *htim)
+{
+    if (htim == NULL) return;
+    htim->Instance->CR1 |= TIM_CR1_UDIS;
+}
+
+/**
+  * @brief  结束同步更新：恢复更新事件，所有通道的新比较值在下一个PWM周期同时生效
+  * @param  htim: 定时器句柄
+  * @retval None
+  */
+void Motor_EndSyncUpdate(TIM_HandleTypeDef *htim)
+{
+    if (htim == NULL) return;
+    htim->Instance->CR1 &= ~TIM_CR1_UDIS;
+}
+
+/**
+  * @brief  距下一个更新事件（预装载的比较值生效）的时间
+  * @param  htim: 定时器句柄（向上计数）
+  * @param  timClockMHz: 定时器计数时钟 (MHz，预分频前)
+  * @retval 微秒数
+  */
+uint32_t Motor_GetUsToUpdate(TIM_HandleTypeDef *htim, uint32_t timClockMHz)
+{
+    if (htim == NULL || timClockMHz == 0U) return 0U;
+    
+    uint32_t arr = htim->Instance->ARR;
+    uint32_t cnt = htim->Instance->CNT;
+    uint32_t ticks = (cnt <= arr) ? (arr - cnt + 1U) : 1U;
+    return (ticks * (htim->Instance->PSC + 1U)) / timClockMHz;
+}
+
@@ -34,22 +34,8 @@ typedef enum {
     MOTOR_STATE_BRAKE          /* 刹车 */
 } MotorState_t;
 
-/* 电机控制结构体（基类） */
-typedef struct Motor Motor_t;
-
-/* 电机虚拟函数表 */
-typedef struct {
-    void (*SetSpeed)(Motor_t *motor, int16_t speed);       /* 设置速度 */
-    void (*SetDirection)(Motor_t *motor, MotorState_t dir); /* 设置方向 */
-    void (*Stop)(Motor_t *motor);                           /* 停止 */
-    void (*Brake)(Motor_t *motor);                          /* 刹车 */
-    int16_t (*GetSpeed)(Motor_t *motor);                    /* 获取当前速度 */
-    MotorState_t (*GetState)(Motor_t *motor);               /* 获取当前状态 */
-} MotorVTable_t;
-
 /* 电机结构体 */
-struct Motor {
-    const MotorVTable_t *vtable;  /* 虚拟函数表 */
+typedef struct Motor {
     MotorType_t type;             /* 电机类型 */
     MotorState_t state;           /* 当前状态 */
     int16_t currentSpeed;         /* 当前速度 (0-1000) */
@@ -61,7 +47,15 @@ struct Motor {
     TIM_HandleTypeDef *htim;      /* 定时器句柄 */
     bool enabled;                 /* 使能标志 */
     bool dualPWM;                 /* 是否使用双PWM模式 */
-};
+    
+    /* 输出级缓存（初始化时预计算，避免每周期读ARR和做除法） */
+    volatile uint32_t *ccrA;      /* 通道A比较寄存器地址 */
+    volatile uint32_t *ccrB;      /* 通道B比较寄存器地址（单PWM为NULL） */
+    uint32_t arr;                 /* 自动重装载值 */
+    uint32_t ccrScaleQ16;         /* CCR = (speed * ccrScaleQ16) >> 16 */
+    uint32_t lastCcrA;            /* 上次写入通道A的值 */
+    uint32_t lastCcrB;            /* 上次写入通道B的值 */
+} Motor_t;
 
 /* 函数声明 */
 void Motor_Init(Motor_t *motor, MotorType_t type, TIM_HandleTypeDef *htim, 
@@ -78,6 +72,11 @@ void Motor_Enable(Motor_t *motor);
 void Motor_Disable(Motor_t *motor);
 bool Motor_IsEnabled(Motor_t *motor);
 
+/* 同一定时器多通道同步更新（占空比在同一PWM周期生效） */
+void Motor_BeginSyncUpdate(TIM_HandleTypeDef *htim);
+void Motor_EndSyncUpdate(TIM_HandleTypeDef *htim);
+uint32_t Motor_GetUsToUpdate(TIM_HandleTypeDef *htim, uint32_t timClockMHz);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,213 @@
+/**
+  ******************************************************************************
+  * @file    motor_diag.c
+  * @brief   轮电机堵转/打滑/卡滞检测实现
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "motor_diag.h"
+#include <stddef.h>  /* 定义NULL */
+#include <string.h>
+#include <math.h>
+
+/**
+  * @brief  初始化诊断器
+  * @param  diag: 诊断器对象指针
+  * @param  cfg: 检测参数
+  * @param  trackWidth: 轮距 (m)
+  * @retval None
+  */
+void MotorDiag_Init(MotorDiag_t *diag, const MotorDiagConfig_t *cfg, float trackWidth)
+{
+    if (diag == NULL || cfg == NULL) return;
+
+    memset(diag, 0, sizeof(MotorDiag_t));
+    diag->cfg = *cfg;
+    diag->trackWidth = trackWidth;
+}
+
+/**
+  * @brief  清除所有故障与计时（统计次数保留）
+  * @param  diag: 诊断器对象指针
+  * @retval None
+  */
+void MotorDiag_Reset(MotorDiag_t *diag)
+{
+    if (diag == NULL) return;
+
+    for (uint8_t i = 0; i < MOTOR_DIAG_WHEEL_COUNT; i++) {
+        MotorDiagWheel_t *w = &diag->wheel[i];
+        w->stallTimer = 0.0f;
+        w->jamTimer = 0.0f;
+        w->slipTimer = 0.0f;
+        w->holdTimer = 0.0f;
+        w->faults = 0;
+        w->modelMs = 0.0f;
+    }
+}
+
+/**
+  * @brief  占空比对应的稳态轮速（扣除起转死区）
+  */
+static float MotorDiag_SteadySpeed(const MotorDiagConfig_t *cfg, float duty)
+{
+    float mag = fabsf(duty) - cfg->dutyDeadband;
+    if (mag <= 0.0f) return 0.0f;
+
+    float speed = mag * cfg->freeSpeedMs / (1000.0f - cfg->dutyDeadband);
+    return (duty >= 0.0f) ? speed : -speed;
+}
+
+/**
+  * @brief  持续条件计时，达到时限时置故障位
+  * @retval true=本周期新检出
+  */
+static bool MotorDiag_Debounce(MotorDiagWheel_t *w, float *timer, bool cond, float limit, float dt, uint8_t bit)
+{
+    if (!cond) {
+        *timer = 0.0f;
+        return false;
+    }
+
+    *timer += dt;
+    if (*timer < limit) return false;
+
+    *timer = limit;
+    if ((w->faults & bit) != 0U) return false;
+
+    w->faults |= bit;
+    return true;
+}
+
+/**
+  * @brief  诊断周期更新（在轮速控制周期中调用）
+  * @param  diag: 诊断器对象指针
+  * @param  dt: 控制周期 (s)
+  * @param  target: 左右轮目标速度 (m/s)
+  * @param  duty: 本周期施加的占空比 (-1000~1000)
+  * @param  meas: 实测轮速 (m/s)
+  * @param  yawRateRadS: IMU偏航角速度 (rad/s)
+  * @param  yawValid: IMU数据是否可用，不可用时不做打滑判定
+  * @retval None
+  */
+void MotorDiag_Update(MotorDiag_t *diag, float dt,
+                      const float target[MOTOR_DIAG_WHEEL_COUNT],
+                      const float duty[MOTOR_DIAG_WHEEL_COUNT],
+                      const float meas[MOTOR_DIAG_WHEEL_COUNT],
+                      float yawRateRadS, bool yawValid)
+{
+    if (diag == NULL || target == NULL || duty == NULL || meas == NULL) return;
+    if (dt <= 0.0f) return;
+
+    const MotorDiagConfig_t *cfg = &diag->cfg;
+    MotorDiagWheel_t *left = &diag->wheel[MOTOR_DIAG_WHEEL_LEFT];
+    MotorDiagWheel_t *right = &diag->wheel[MOTOR_DIAG_WHEEL_RIGHT];
+
+    /* 偏航角速度：编码器推算 vs IMU */
+    diag->yawRateImu = yawRateRadS;
+    diag->yawRateOdom = (diag->trackWidth > 0.0f) ?
+                        (meas[MOTOR_DIAG_WHEEL_RIGHT] - meas[MOTOR_DIAG_WHEEL_LEFT]) / diag->trackWidth : 0.0f;
+
+    /* 打滑侧：以另一侧为基准按IMU角速度推算本侧应有速度，实测明显偏快的一侧判为打滑 */
+    uint8_t slipWheel = MOTOR_DIAG_WHEEL_COUNT;
+    if (yawValid && fabsf(diag->yawRateOdom - diag->yawRateImu) > cfg->slipYawErr) {
+        float expLeft = meas[MOTOR_DIAG_WHEEL_RIGHT] - yawRateRadS * diag->trackWidth;
+        float expRight = meas[MOTOR_DIAG_WHEEL_LEFT] + yawRateRadS * diag->trackWidth;
+        float excessLeft = fabsf(meas[MOTOR_DIAG_WHEEL_LEFT]) - fabsf(expLeft);
+        float excessRight = fabsf(meas[MOTOR_DIAG_WHEEL_RIGHT]) - fabsf(expRight);
+        if (excessLeft > 0.0f || excessRight > 0.0f) {
+            slipWheel = (excessLeft >= excessRight) ? MOTOR_DIAG_WHEEL_LEFT : MOTOR_DIAG_WHEEL_RIGHT;
+        }
+    }
+
+    float filter = dt / (cfg->modelTau + dt);
+    for (uint8_t i = 0; i < MOTOR_DIAG_WHEEL_COUNT; i++) {
+        MotorDiagWheel_t *w = (i == MOTOR_DIAG_WHEEL_LEFT) ? left : right;
+
+        w->targetMs = target[i];
+        w->duty = duty[i];
+        w->measMs = meas[i];
+        w->modelMs += (MotorDiag_SteadySpeed(cfg, duty[i]) - w->modelMs) * filter;
+
+        /* 停止指令：清除故障，重新开始 */
+        if (target[i] == 0.0f && fabsf(duty[i]) <= cfg->dutyDeadband) {
+            w->stallTimer = 0.0f;
+            w->jamTimer = 0.0f;
+            w->slipTimer = 0.0f;
+            w->holdTimer = 0.0f;
+            w->faults = 0;
+            continue;
+        }
+
+        float absDuty = fabsf(duty[i]);
+        float absMeas = fabsf(meas[i]);
+        float absModel = fabsf(w->modelMs);
+
+        bool stall = (absDuty >= cfg->stallDutyMin) && (absMeas < cfg->stallSpeedMax);
+        bool jam = !stall && (absDuty >= cfg->jamDutyMin) && (absModel > cfg->stallSpeedMax) &&
+                   (absMeas < absModel * cfg->jamSpeedRatio);
+        bool slip = (slipWheel == i) && (absMeas >= cfg->stallSpeedMax);
+
+        if (MotorDiag_Debounce(w, &w->stallTimer, stall, cfg->stallTime, dt, MOTOR_DIAG_FAULT_STALL)) {
+            w->stallCount++;
+        }
+        if (MotorDiag_Debounce(w, &w->jamTimer, jam, cfg->jamTime, dt, MOTOR_DIAG_FAULT_JAM)) {
+            w->jamCount++;
+        }
+        if (MotorDiag_Debounce(w, &w->slipTimer, slip, cfg->slipTime, dt, MOTOR_DIAG_FAULT_SLIP)) {
+            w->slipCount++;
+        }
+
+        /* 故障保持：限幅后条件通常随之消失，保持一段时间再释放重试 */
+        if (w->faults != 0U) {
+            if (stall || jam || slip) {
+                w->holdTimer = cfg->holdTime;
+            } else {
+                w->holdTimer -= dt;
+                if (w->holdTimer <= 0.0f) {
+                    w->holdTimer = 0.0f;
+                    w->faults = 0;
+                }
+            }
+        }
+    }
+}
+
+/**
+  * @brief  获取轮子当前允许的最大占空比
+  * @param  diag: 诊断器对象指针
+  * @param  id: 轮子编号
+  * @retval 占空比上限 (0-1000)
+  */
+float MotorDiag_GetDutyLimit(const MotorDiag_t *diag, MotorDiagWheelId_t id)
+{
+    if (diag == NULL || id >= MOTOR_DIAG_WHEEL_COUNT) return 1000.0f;
+
+    uint8_t faults = diag->wheel[id].faults;
+    float limit = 1000.0f;
+    if ((faults & MOTOR_DIAG_FAULT_STALL) != 0U && diag->cfg.dutyLimitStall < limit) {
+        limit = diag->cfg.dutyLimitStall;
+    }
+    if ((faults & MOTOR_DIAG_FAULT_JAM) != 0U && diag->cfg.dutyLimitJam < limit) {
+        limit = diag->cfg.dutyLimitJam;
+    }
+    if ((faults & MOTOR_DIAG_FAULT_SLIP) != 0U && diag->cfg.dutyLimitSlip < limit) {
+        limit = diag->cfg.dutyLimitSlip;
+    }
+    return limit;
+}
+
+/**
+  * @brief  获取轮子当前故障位
+  * @param  diag: 诊断器对象指针
+  * @param  id: 轮子编号
+  * @retval 故障位 (MOTOR_DIAG_FAULT_xxx)
+  */
+uint8_t MotorDiag_GetFaults(const MotorDiag_t *diag, MotorDiagWheelId_t id)
+{
+    if (diag == NULL || id >= MOTOR_DIAG_WHEEL_COUNT) return 0;
+    return diag->wheel[id].faults;
+}
+
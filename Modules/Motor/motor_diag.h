@@ -0,0 +1,108 @@
+/**
+  ******************************************************************************
+  * @file    motor_diag.h
+  * @brief   轮电机堵转/打滑/卡滞检测头文件
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 在控制周期内比较PID输出占空比、编码器实测轮速与IMU偏航角速度：
+  * - 堵转(STALL)：占空比较大但轮子几乎不转（卡线、顶墙）
+  * - 卡滞(JAM)  ：轮子在转但明显低于占空比模型预测速度（缠毛发、负载过大）
+  * - 打滑(SLIP) ：编码器推算的偏航角速度与IMU不一致，转得偏快的一侧判为打滑
+  * 检出后限制该轮占空比并上报故障位，保持一段时间后自动释放重试。
+  * 各特征量每周期更新，经USB上报供上位机离线学习阈值。
+  ******************************************************************************
+  */
+
+#ifndef __MOTOR_DIAG_H__
+#define __MOTOR_DIAG_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 轮子编号 */
+typedef enum {
+    MOTOR_DIAG_WHEEL_LEFT = 0,
+    MOTOR_DIAG_WHEEL_RIGHT,
+    MOTOR_DIAG_WHEEL_COUNT
+} MotorDiagWheelId_t;
+
+/* 故障位 */
+#define MOTOR_DIAG_FAULT_STALL      (1U << 0)   /* 堵转 */
+#define MOTOR_DIAG_FAULT_SLIP       (1U << 1)   /* 打滑 */
+#define MOTOR_DIAG_FAULT_JAM        (1U << 2)   /* 卡滞 */
+
+/* 检测参数 */
+typedef struct {
+    float dutyDeadband;             /* 电机起转死区占空比 (0-1000) */
+    float freeSpeedMs;              /* 满占空比空载轮速 (m/s) */
+    float modelTau;                 /* 占空比->轮速一阶模型时间常数 (s) */
+
+    float stallDutyMin;             /* 堵转判定最小占空比 */
+    float stallSpeedMax;            /* 堵转判定最大轮速 (m/s) */
+    float stallTime;                /* 堵转持续时间 (s) */
+
+    float jamSpeedRatio;            /* 实测/模型速度低于该比例判为卡滞 */
+    float jamDutyMin;               /* 卡滞判定最小占空比 */
+    float jamTime;                  /* 卡滞持续时间 (s) */
+
+    float slipYawErr;               /* 编码器与IMU偏航角速度差阈值 (rad/s) */
+    float slipTime;                 /* 打滑持续时间 (s) */
+
+    float dutyLimitStall;           /* 堵转时占空比上限 */
+    float dutyLimitJam;             /* 卡滞时占空比上限 */
+    float dutyLimitSlip;            /* 打滑时占空比上限 */
+    float holdTime;                 /* 条件消失后故障保持时间 (s) */
+} MotorDiagConfig_t;
+
+/* 单轮诊断状态 */
+typedef struct {
+    /* 特征量 */
+    float targetMs;                 /* 目标轮速 (m/s) */
+    float duty;                     /* 实际施加的占空比 (-1000~1000) */
+    float measMs;                   /* 实测轮速 (m/s) */
+    float modelMs;                  /* 模型预测轮速 (m/s) */
+
+    /* 检测计时 (s) */
+    float stallTimer;
+    float jamTimer;
+    float slipTimer;
+    float holdTimer;
+
+    uint8_t faults;                 /* 当前故障位 */
+    uint16_t stallCount;            /* 堵转次数 */
+    uint16_t jamCount;              /* 卡滞次数 */
+    uint16_t slipCount;             /* 打滑次数 */
+} MotorDiagWheel_t;
+
+/* 轮电机诊断器 */
+typedef struct {
+    MotorDiagConfig_t cfg;
+    MotorDiagWheel_t wheel[MOTOR_DIAG_WHEEL_COUNT];
+    float trackWidth;               /* 轮距 (m) */
+    float yawRateImu;               /* IMU偏航角速度 (rad/s) */
+    float yawRateOdom;              /* 编码器推算偏航角速度 (rad/s) */
+} MotorDiag_t;
+
+/* 函数声明 */
+void MotorDiag_Init(MotorDiag_t *diag, const MotorDiagConfig_t *cfg, float trackWidth);
+void MotorDiag_Update(MotorDiag_t *diag, float dt,
+                      const float target[MOTOR_DIAG_WHEEL_COUNT],
+                      const float duty[MOTOR_DIAG_WHEEL_COUNT],
+                      const float meas[MOTOR_DIAG_WHEEL_COUNT],
+                      float yawRateRadS, bool yawValid);
+void MotorDiag_Reset(MotorDiag_t *diag);
+float MotorDiag_GetDutyLimit(const MotorDiag_t *diag, MotorDiagWheelId_t id);
+uint8_t MotorDiag_GetFaults(const MotorDiag_t *diag, MotorDiagWheelId_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTOR_DIAG_H__ */
+
@@ -0,0 +1,139 @@
+/**
+  ******************************************************************************
+  * @file    motor_ramp.c
+  * @brief   辅助电机软启动斜坡发生器实现
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "motor_ramp.h"
+#include <string.h>
+
+/**
+  * @brief  初始化斜坡发生器（默认斜率足够大，相当于阶跃）
+  * @param  ramp: 斜坡发生器对象指针
+  * @retval None
+  */
+void MotorRamp_Init(MotorRamp_t *ramp)
+{
+    if (ramp == NULL) return;
+
+    memset(ramp, 0, sizeof(MotorRamp_t));
+    for (uint8_t i = 0; i < MOTOR_RAMP_CH_COUNT; i++) {
+        ramp->ch[i].slewUp = 100000.0f;
+        ramp->ch[i].slewDown = 100000.0f;
+        ramp->ch[i].heavy = false;
+    }
+    ramp->heavyActive = MOTOR_RAMP_NONE;
+}
+
+/**
+  * @brief  配置通道斜率
+  * @param  ramp: 斜坡发生器对象指针
+  * @param  id: 通道
+  * @param  slewUp: 上升斜率 (占空比/秒)
+  * @param  slewDown: 下降斜率 (占空比/秒)
+  * @param  heavy: 是否为大电流负载
+  * @retval None
+  */
+void MotorRamp_Config(MotorRamp_t *ramp, MotorRampChannelId_t id, float slewUp, float slewDown, bool heavy)
+{
+    if (ramp == NULL || id >= MOTOR_RAMP_CH_COUNT) return;
+
+    ramp->ch[id].slewUp = slewUp;
+    ramp->ch[id].slewDown = slewDown;
+    ramp->ch[id].heavy = heavy;
+}
+
+/**
+  * @brief  设置通道目标占空比
+  * @param  ramp: 斜坡发生器对象指针
+  * @param  id: 通道
+  * @param  target: 目标占空比 (0-1000)
+  * @retval None
+  */
+void MotorRamp_SetTarget(MotorRamp_t *ramp, MotorRampChannelId_t id, int16_t target)
+{
+    if (ramp == NULL || id >= MOTOR_RAMP_CH_COUNT) return;
+
+    if (target < 0) target = 0;
+    if (target > 1000) target = 1000;
+    ramp->ch[id].target = target;
+}
+
+/**
+  * @brief  斜坡周期更新（在控制周期中调用）
+  * @note   下降不受限制立即开始；大电流通道上升需先取得唯一的上升许可，
+  *         到达目标后释放，排队的通道在下一周期开始上升
+  * @param  ramp: 斜坡发生器对象指针
+  * @param  dt: 控制周期 (s)
+  * @retval None
+  */
+void MotorRamp_Update(MotorRamp_t *ramp, float dt)
+{
+    if (ramp == NULL || dt <= 0.0f) return;
+
+    for (uint8_t i = 0; i < MOTOR_RAMP_CH_COUNT; i++) {
+        MotorRampChannel_t *c = &ramp->ch[i];
+        float target = (float)c->target;
+
+        if (c->output > target) {
+            c->output -= c->slewDown * dt;
+            if (c->output < target) c->output = target;
+        } else if (c->output < target) {
+            if (c->heavy) {
+                if (ramp->heavyActive == MOTOR_RAMP_NONE) {
+                    ramp->heavyActive = i;
+                }
+                if (ramp->heavyActive != i) {
+                    continue;  /* 排队等待 */
+                }
+            }
+            c->output += c->slewUp * dt;
+            if (c->output > target) c->output = target;
+        }
+
+        /* 到达目标（或目标被调低）后释放上升许可 */
+        if (ramp->heavyActive == i && c->output >= target) {
+            ramp->heavyActive = MOTOR_RAMP_NONE;
+        }
+    }
+}
+
+/**
+  * @brief  获取通道当前输出
+  * @param  ramp: 斜坡发生器对象指针
+  * @param  id: 通道
+  * @retval 输出占空比 (0-1000)
+  */
+int16_t MotorRamp_GetOutput(const MotorRamp_t *ramp, MotorRampChannelId_t id)
+{
+    if (ramp == NULL || id >= MOTOR_RAMP_CH_COUNT) return 0;
+    return (int16_t)(ramp->ch[id].output + 0.5f);
+}
+
+/**
+  * @brief  获取通道目标
+  * @param  ramp: 斜坡发生器对象指针
+  * @param  id: 通道
+  * @retval 目标占空比 (0-1000)
+  */
+int16_t MotorRamp_GetTarget(const MotorRamp_t *ramp, MotorRampChannelId_t id)
+{
+    if (ramp == NULL || id >= MOTOR_RAMP_CH_COUNT) return 0;
+    return ramp->ch[id].target;
+}
+
+/**
+  * @brief  通道是否处于斜坡过渡中
+  * @param  ramp: 斜坡发生器对象指针
+  * @param  id: 通道
+  * @retval true=过渡中
+  */
+bool MotorRamp_IsRamping(const MotorRamp_t *ramp, MotorRampChannelId_t id)
+{
+    if (ramp == NULL || id >= MOTOR_RAMP_CH_COUNT) return false;
+    return (ramp->ch[id].output != (float)ramp->ch[id].target);
+}
+
@@ -0,0 +1,65 @@
+/**
+  ******************************************************************************
+  * @file    motor_ramp.h
+  * @brief   辅助电机软启动斜坡发生器头文件
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 边刷、水泵、风机的档位切换不再直接阶跃到目标占空比，而是按各自斜率
+  * 逐周期逼近，降低电池侧冲击电流。标记为大电流的通道同一时刻只允许
+  * 一个处于上升阶段，其余排队等待，错开峰值电流。
+  ******************************************************************************
+  */
+
+#ifndef __MOTOR_RAMP_H__
+#define __MOTOR_RAMP_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 斜坡通道 */
+typedef enum {
+    MOTOR_RAMP_CH_BRUSH_LEFT = 0,   /* 左边刷 */
+    MOTOR_RAMP_CH_BRUSH_RIGHT,      /* 右边刷 */
+    MOTOR_RAMP_CH_PUMP,             /* 水泵 */
+    MOTOR_RAMP_CH_FAN,              /* 风机 */
+    MOTOR_RAMP_CH_COUNT
+} MotorRampChannelId_t;
+
+#define MOTOR_RAMP_NONE     0xFFU   /* 无大电流通道在上升 */
+
+/* 单通道斜坡状态 */
+typedef struct {
+    int16_t target;                 /* 目标占空比 (0-1000) */
+    float output;                   /* 当前输出占空比 (0-1000) */
+    float slewUp;                   /* 上升斜率 (占空比/秒) */
+    float slewDown;                 /* 下降斜率 (占空比/秒) */
+    bool heavy;                     /* 大电流负载，需与其他大电流通道错峰上升 */
+} MotorRampChannel_t;
+
+/* 斜坡发生器 */
+typedef struct {
+    MotorRampChannel_t ch[MOTOR_RAMP_CH_COUNT];
+    uint8_t heavyActive;            /* 正在上升的大电流通道，MOTOR_RAMP_NONE表示空闲 */
+} MotorRamp_t;
+
+/* 函数声明 */
+void MotorRamp_Init(MotorRamp_t *ramp);
+void MotorRamp_Config(MotorRamp_t *ramp, MotorRampChannelId_t id, float slewUp, float slewDown, bool heavy);
+void MotorRamp_SetTarget(MotorRamp_t *ramp, MotorRampChannelId_t id, int16_t target);
+void MotorRamp_Update(MotorRamp_t *ramp, float dt);
+int16_t MotorRamp_GetOutput(const MotorRamp_t *ramp, MotorRampChannelId_t id);
+int16_t MotorRamp_GetTarget(const MotorRamp_t *ramp, MotorRampChannelId_t id);
+bool MotorRamp_IsRamping(const MotorRamp_t *ramp, MotorRampChannelId_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTOR_RAMP_H__ */
+
@@ -0,0 +1,316 @@
+/**
+  ******************************************************************************
+  * @file    power_mgr.c
+  * @brief   电源管理实现（停靠低功耗模式与睡眠统计）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "power_mgr.h"
+#include "system_config.h"
+#include "hw_config.h"
+#include "main.h"
+#include "timebase.h"
+#include "prof.h"
+#include "mem_section.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stddef.h>  /* 定义NULL */
+#include <string.h>
+
+/* 全局电源管理实例 */
+CCM_DATA static PowerMgr_t g_PowerMgr;
+
+/* 空闲任务句柄（睡眠发生在空闲任务中） */
+static TaskHandle_t s_idleTask;
+
+#if configUSE_TICKLESS_IDLE
+/* HAL 时基（stm32f4xx_hal_timebase_tim.c），1MHz 计数、1000 计数溢出一次 */
+extern TIM_HandleTypeDef htim6;
+#define POWER_TIM6_COUNTS_PER_TICK  1000U
+
+/* 睡眠前 TIM6 计数值与挂起的更新标志 */
+static uint32_t s_tim6Count;
+static bool s_tim6Pending;
+
+/* 唤醒源判定用的 EXTI 线（EXTI 线号即引脚号） */
+#define POWER_EXTI_IR_LINES         ((uint32_t)(IR_SENSOR_LEFT_PIN | IR_SENSOR_RIGHT_PIN | \
+                                                IR_SENSOR_FRONT_LEFT_PIN | IR_SENSOR_FRONT_RIGHT_PIN))
+#define POWER_EXTI_BUTTON_LINES     ((uint32_t)(BUTTON1_Pin | BUTTON2_Pin))
+#endif
+
+/**
+  * @brief  初始化电源管理（创建任务前调用）
+  * @retval None
+  */
+void PowerMgr_Init(void)
+{
+    PowerMgr_t *pm = &g_PowerMgr;
+
+    memset(pm, 0, sizeof(PowerMgr_t));
+    pm->mode = POWER_MODE_ACTIVE;
+    /* 统计窗口起点为0：调度器启动时 Timebase_Init 将微秒计数清零 */
+    s_idleTask = NULL;
+
+#if configUSE_TICKLESS_IDLE
+    /* Sleep 模式下保持 HCLK，DWT 周期计数继续，微秒时基与运行时间统计不失真 */
+    DBGMCU->CR |= DBGMCU_CR_DBG_SLEEP;
+#endif
+}
+
+/**
+  * @brief  获取全局电源管理实例
+  */
+PowerMgr_t* PowerMgr_GetInstance(void)
+{
+    return &g_PowerMgr;
+}
+
+/**
+  * @brief  登记模式切换时需唤醒的任务
+  * @param  thread: 线程ID
+  * @retval None
+  */
+void PowerMgr_RegisterThread(osThreadId_t thread)
+{
+    PowerMgr_t *pm = &g_PowerMgr;
+
+    if (thread == NULL || pm->threadCount >= POWER_MAX_THREADS) return;
+    pm->threads[pm->threadCount++] = thread;
+}
+
+/**
+  * @brief  当前是否处于停靠模式
+  */
+bool PowerMgr_IsDocked(void)
+{
+    return g_PowerMgr.mode == POWER_MODE_DOCKED;
+}
+
+/**
+  * @brief  切换模式并唤醒登记的任务
+  */
+static void PowerMgr_SetMode(PowerMgr_t *pm, PowerMode_t mode, uint32_t nowMs)
+{
+    if (pm->mode == mode) return;
+
+    if (mode == POWER_MODE_DOCKED) {
+        pm->dockedSinceMs = nowMs;
+        pm->dockedEntries++;
+    }
+    pm->mode = mode;
+
+    for (uint8_t i = 0; i < pm->threadCount; i++) {
+        osThreadFlagsSet(pm->threads[i], POWER_MODE_THREAD_FLAG);
+    }
+}
+
+/**
+  * @brief  停靠判定（传感器任务充电触点采样后调用）
+  * @param  chargePresent: 充电触点去抖后的接通状态
+  * @param  idle: 整机空闲（无运动/辅助电机/回充动作）
+  * @param  nowMs: 当前时间 (ms)
+  * @retval None
+  */
+void PowerMgr_Update(bool chargePresent, bool idle, uint32_t nowMs)
+{
+    PowerMgr_t *pm = &g_PowerMgr;
+
+    if (pm->mode == POWER_MODE_DOCKED) {
+        if (!chargePresent) {
+            PowerMgr_SetMode(pm, POWER_MODE_ACTIVE, nowMs);
+        }
+        return;
+    }
+
+#if POWER_DOCK_ENABLE
+    if (!chargePresent || !idle) {
+        pm->idleTiming = false;
+        return;
+    }
+    if (!pm->idleTiming) {
+        pm->idleTiming = true;
+        pm->idleSinceMs = nowMs;
+        return;
+    }
+    if ((nowMs - pm->idleSinceMs) >= POWER_DOCK_ENTER_MS) {
+        pm->idleTiming = false;
+        PowerMgr_SetMode(pm, POWER_MODE_DOCKED, nowMs);
+    }
+#else
+    (void)idle;
+#endif
+}
+
+/**
+  * @brief  请求回到工作模式（按键、USB 运动/工作模式命令）
+  * @param  nowMs: 当前时间 (ms)
+  * @retval None
+  */
+void PowerMgr_RequestActive(uint32_t nowMs)
+{
+    PowerMgr_t *pm = &g_PowerMgr;
+
+    pm->idleTiming = false;
+    PowerMgr_SetMode(pm, POWER_MODE_ACTIVE, nowMs);
+}
+
+/**
+  * @brief  读取并清零统计窗口
+  * @param  report: 输出快照
+  * @retval None
+  */
+void PowerMgr_Sample(PowerReport_t *report)
+{
+    PowerMgr_t *pm = &g_PowerMgr;
+
+    if (report == NULL) return;
+
+    uint32_t nowUs = Timebase_GetUs();
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t windowUs = nowUs - pm->windowStartUs;
+    uint32_t sleepUs = pm->sleepUs;
+    uint32_t sleepCount = pm->sleepCount;
+    uint32_t wakeCount[POWER_WAKE_COUNT];
+    memcpy(wakeCount, pm->wakeCount, sizeof(wakeCount));
+    uint32_t latencySumUs = pm->latencySumUs;
+    uint32_t latencyMaxUs = pm->latencyMaxUs;
+    uint32_t latencyCount = pm->latencyCount;
+    pm->windowStartUs = nowUs;
+    pm->sleepUs = 0;
+    pm->sleepCount = 0;
+    memset(pm->wakeCount, 0, sizeof(pm->wakeCount));
+    pm->latencySumUs = 0;
+    pm->latencyMaxUs = 0;
+    pm->latencyCount = 0;
+    __set_PRIMASK(primask);
+
+    report->mode = pm->mode;
+    report->windowUs = windowUs;
+    report->sleepUs = sleepUs;
+    report->sleepPermille = (windowUs > 0U) ?
+        (uint16_t)(((uint64_t)sleepUs * 1000U) / windowUs) : 0U;
+    if (report->sleepPermille > 1000U) {
+        report->sleepPermille = 1000U;
+    }
+    report->sleepCount = (sleepCount > 0xFFFFU) ? 0xFFFFU : (uint16_t)sleepCount;
+    for (uint32_t i = 0; i < POWER_WAKE_COUNT; i++) {
+        report->wakeCount[i] = (wakeCount[i] > 0xFFFFU) ? 0xFFFFU : (uint16_t)wakeCount[i];
+    }
+    report->latencyCount = (latencyCount > 0xFFFFU) ? 0xFFFFU : (uint16_t)latencyCount;
+    uint32_t avg = (latencyCount > 0U) ? latencySumUs / latencyCount : 0U;
+    report->latencyAvgUs = (avg > 0xFFFFU) ? 0xFFFFU : (uint16_t)avg;
+    report->latencyMaxUs = (latencyMaxUs > 0xFFFFU) ? 0xFFFFU : (uint16_t)latencyMaxUs;
+    report->dockedEntries = pm->dockedEntries;
+    report->dockedMs = (pm->mode == POWER_MODE_DOCKED) ?
+        (osKernelGetTickCount() - pm->dockedSinceMs) : 0U;
+}
+
+#if configUSE_TICKLESS_IDLE
+/**
+  * @brief  唤醒源：睡眠退出时（中断仍屏蔽）挂起的中断
+  */
+static PowerWakeSource_t PowerMgr_GetWakeSource(void)
+{
+    uint32_t exti = EXTI->PR;
+
+    if (NVIC_GetPendingIRQ(OTG_FS_IRQn) != 0U) {
+        return POWER_WAKE_USB;
+    }
+    if ((exti & POWER_EXTI_BUTTON_LINES) != 0U) {
+        return POWER_WAKE_BUTTON;
+    }
+    if ((exti & POWER_EXTI_IR_LINES) != 0U) {
+        return POWER_WAKE_IR;
+    }
+    if (NVIC_GetPendingIRQ(USART3_IRQn) != 0U || NVIC_GetPendingIRQ(DMA1_Stream1_IRQn) != 0U) {
+        return POWER_WAKE_IMU;
+    }
+    if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0U) {
+        return POWER_WAKE_TICK;
+    }
+    return POWER_WAKE_OTHER;
+}
+#endif
+
+/**
+  * @brief  进入 WFI 前（空闲任务，中断已屏蔽）
+  * @param  expectedIdleTicks: 预计空闲节拍数，置0表示已自行睡眠
+  * @retval None
+  */
+void PowerMgr_PreSleep(uint32_t *expectedIdleTicks)
+{
+    PowerMgr_t *pm = &g_PowerMgr;
+    (void)expectedIdleTicks;
+
+#if configUSE_TICKLESS_IDLE
+    /* 关 TIM6 更新中断，否则 HAL 1ms 时基每毫秒唤醒一次；计数器继续运行 */
+    HAL_SuspendTick();
+    s_tim6Pending = (__HAL_TIM_GET_FLAG(&htim6, TIM_FLAG_UPDATE) != RESET);
+    s_tim6Count = __HAL_TIM_GET_COUNTER(&htim6);
+#endif
+
+    s_idleTask = xTaskGetCurrentTaskHandle();
+    pm->wakePending = false;
+    pm->sleepStartUs = Timebase_GetUs();
+}
+
+/**
+  * @brief  WFI 返回后（空闲任务，中断仍屏蔽）
+  * @param  expectedIdleTicks: 预计空闲节拍数
+  * @retval None
+  */
+void PowerMgr_PostSleep(uint32_t *expectedIdleTicks)
+{
+    PowerMgr_t *pm = &g_PowerMgr;
+    (void)expectedIdleTicks;
+
+    uint32_t nowUs = Timebase_GetUs();
+    uint32_t sleptUs = nowUs - pm->sleepStartUs;
+
+#if configUSE_TICKLESS_IDLE
+    /* 补偿 uwTick：睡眠期间 TIM6 溢出次数（计数 1us，按计数值取整消除时基误差），
+       加上睡眠前已挂起的一次；挂起的更新标志在恢复后由中断再计一次 */
+    uint32_t countNow = __HAL_TIM_GET_COUNTER(&htim6);
+    uint32_t events = (s_tim6Count + sleptUs + (POWER_TIM6_COUNTS_PER_TICK / 2U) - countNow) /
+                      POWER_TIM6_COUNTS_PER_TICK + (s_tim6Pending ? 1U : 0U);
+    if (__HAL_TIM_GET_FLAG(&htim6, TIM_FLAG_UPDATE) != RESET && events > 0U) {
+        events--;
+    }
+    uwTick += events;
+    HAL_ResumeTick();
+
+    pm->wakeCount[PowerMgr_GetWakeSource()]++;
+#endif
+
+    pm->sleepUs += sleptUs;
+    pm->sleepCount++;
+    pm->wakeCycles = DWT->CYCCNT;
+    pm->wakePending = true;
+}
+
+/**
+  * @brief  任务切入钩子（traceTASK_SWITCHED_IN）：唤醒后首个非空闲任务计入唤醒延迟
+  * @param  task: 切入任务的句柄
+  * @retval None
+  */
+void PowerMgr_TaskSwitchedIn(void *task)
+{
+    PowerMgr_t *pm = &g_PowerMgr;
+
+    if (!pm->wakePending || task == (void *)s_idleTask) return;
+    pm->wakePending = false;
+
+    uint32_t cycles = DWT->CYCCNT - pm->wakeCycles;
+    uint32_t latencyUs = cycles / (SystemCoreClock / 1000000U);
+    pm->latencySumUs += latencyUs;
+    pm->latencyCount++;
+    if (latencyUs > pm->latencyMaxUs) {
+        pm->latencyMaxUs = latencyUs;
+    }
+#if PROF_ENABLE
+    Prof_Record(PROF_WAKE_LATENCY, cycles);
+#endif
+}
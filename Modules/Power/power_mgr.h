@@ -0,0 +1,121 @@
+/**
+  ******************************************************************************
+  * @file    power_mgr.h
+  * @brief   电源管理头文件（停靠低功耗模式与睡眠统计）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 两种模式：
+  * - ACTIVE：各任务按原周期工作（电机2ms、遥测5ms起）
+  * - DOCKED：充电触点接通且整机空闲持续 POWER_DOCK_ENTER_MS 后进入。电机
+  *   控制任务停止输出并停掉 TIM7，IMU 任务停止 DMA 接收，传感器任务只保留
+  *   充电触点采样，USB 任务只做连接检查与 1Hz 系统/电源状态上报。按键、
+  *   USB 运动/工作模式命令或触点断开时回到 ACTIVE。
+  * 模式切换时向登记的任务发送 POWER_MODE_THREAD_FLAG，各任务在自己的
+  * 事件等待中一并等待该标志。
+  * 空闲时 FreeRTOS tickless 空闲执行 WFI（Sleep 模式），睡眠前后由
+  * PowerMgr_PreSleep/PostSleep 暂停 HAL 时基 TIM6 并补偿 uwTick，同时统计
+  * 睡眠时间、唤醒源（睡眠退出时挂起的中断）与唤醒延迟（唤醒到首个非空闲
+  * 任务切入）。USB 0x2D 帧按 1Hz 上报这些统计。
+  ******************************************************************************
+  */
+
+#ifndef __POWER_MGR_H__
+#define __POWER_MGR_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cmsis_os.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 模式切换时唤醒登记任务的线程标志（与各任务自身标志不重叠） */
+#define POWER_MODE_THREAD_FLAG      0x0100U
+
+/* 可登记的任务数 */
+#define POWER_MAX_THREADS           4U
+
+/* 电源模式 */
+typedef enum {
+    POWER_MODE_ACTIVE = 0,          /* 正常工作 */
+    POWER_MODE_DOCKED               /* 停靠低功耗 */
+} PowerMode_t;
+
+/* 唤醒源（睡眠退出时挂起的中断） */
+typedef enum {
+    POWER_WAKE_TICK = 0,            /* SysTick：任务延时/等待超时到期 */
+    POWER_WAKE_USB,                 /* OTG_FS */
+    POWER_WAKE_IR,                  /* 红外接收头 EXTI */
+    POWER_WAKE_BUTTON,              /* 按键 EXTI */
+    POWER_WAKE_IMU,                 /* USART3 / DMA1_Stream1 */
+    POWER_WAKE_OTHER,               /* 其他中断（TIM7、碰撞/悬崖 EXTI 等） */
+    POWER_WAKE_COUNT
+} PowerWakeSource_t;
+
+/* 统计窗口快照（PowerMgr_Sample 返回） */
+typedef struct {
+    PowerMode_t mode;
+    uint32_t windowUs;              /* 窗口长度 (us) */
+    uint32_t sleepUs;               /* 窗口内 WFI 睡眠时间 (us) */
+    uint16_t sleepPermille;         /* 睡眠占比 (‰) */
+    uint16_t sleepCount;            /* 睡眠次数 */
+    uint16_t wakeCount[POWER_WAKE_COUNT];
+    uint16_t latencyCount;          /* 唤醒后有任务运行的次数 */
+    uint16_t latencyAvgUs;          /* 唤醒 -> 首个任务切入平均延迟 (us) */
+    uint16_t latencyMaxUs;          /* 最大延迟 (us) */
+    uint16_t dockedEntries;         /* 累计进入停靠模式次数 */
+    uint32_t dockedMs;              /* 本次停靠已持续时间 (ms)，ACTIVE 时为0 */
+} PowerReport_t;
+
+/* 电源管理对象 */
+typedef struct {
+    /* 模式（任务维护） */
+    volatile PowerMode_t mode;
+    bool idleTiming;                /* 触点接通且整机空闲，正在计时 */
+    uint32_t idleSinceMs;           /* 计时起点 (ms) */
+    uint32_t dockedSinceMs;         /* 进入停靠模式时间 */
+    uint16_t dockedEntries;
+    osThreadId_t threads[POWER_MAX_THREADS];
+    uint8_t threadCount;
+
+    /* 睡眠统计（空闲任务/任务切换钩子维护，读取清零在关中断内完成） */
+    uint32_t sleepStartUs;          /* 本次睡眠开始时间 */
+    uint32_t sleepUs;               /* 窗口内累计睡眠时间 */
+    uint32_t sleepCount;
+    uint32_t wakeCount[POWER_WAKE_COUNT];
+    volatile bool wakePending;      /* 已唤醒，等待首个非空闲任务切入 */
+    uint32_t wakeCycles;            /* 唤醒时刻 DWT 周期数 */
+    uint32_t latencySumUs;
+    uint32_t latencyMaxUs;
+    uint32_t latencyCount;
+    uint32_t windowStartUs;         /* 统计窗口起点 */
+} PowerMgr_t;
+
+/* 函数声明 */
+void PowerMgr_Init(void);
+PowerMgr_t* PowerMgr_GetInstance(void);
+void PowerMgr_RegisterThread(osThreadId_t thread);  /* 任务初始化时调用 */
+bool PowerMgr_IsDocked(void);
+
+/* 传感器任务充电触点采样后调用：idle=无运动/辅助电机/回充动作 */
+void PowerMgr_Update(bool chargePresent, bool idle, uint32_t nowMs);
+
+/* 按键、USB 运动命令等：退出停靠模式并重新计空闲时间 */
+void PowerMgr_RequestActive(uint32_t nowMs);
+
+/* 读取并清零统计窗口 */
+void PowerMgr_Sample(PowerReport_t *report);
+
+/* FreeRTOS 钩子（freertos.c / FreeRTOSConfig.h） */
+void PowerMgr_PreSleep(uint32_t *expectedIdleTicks);
+void PowerMgr_PostSleep(uint32_t *expectedIdleTicks);
+void PowerMgr_TaskSwitchedIn(void *task);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __POWER_MGR_H__ */
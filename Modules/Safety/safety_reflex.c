@@ -0,0 +1,296 @@
+/**
+  ******************************************************************************
+  * @file    safety_reflex.c
+  * @brief   碰撞/悬崖安全反射实现
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "safety_reflex.h"
+#include "hw_config.h"
+#include "mem_section.h"
+#include <stddef.h>  /* 定义NULL */
+#include <string.h>
+
+/* 全局安全反射实例 */
+CCM_DATA static SafetyReflex_t g_SafetyReflex;
+
+/* 左/右侧触发源（决定转向方向） */
+#define SAFETY_LEFT_MASK    (SAFETY_SRC_BIT(SAFETY_SRC_BUMPER_LEFT) | SAFETY_SRC_BIT(SAFETY_SRC_CLIFF_LEFT))
+#define SAFETY_RIGHT_MASK   (SAFETY_SRC_BIT(SAFETY_SRC_BUMPER_RIGHT) | SAFETY_SRC_BIT(SAFETY_SRC_CLIFF_RIGHT))
+
+/**
+  * @brief  初始化安全反射（在使能传感器中断前调用）
+  * @retval None
+  */
+void SafetyReflex_Init(void)
+{
+    SafetyReflex_t *sr = &g_SafetyReflex;
+
+    memset(sr, 0, sizeof(SafetyReflex_t));
+    sr->policy[SAFETY_SRC_BUMPER_LEFT] = (SafetyPolicy_t)SAFETY_BUMPER_POLICY;
+    sr->policy[SAFETY_SRC_BUMPER_RIGHT] = (SafetyPolicy_t)SAFETY_BUMPER_POLICY;
+    sr->policy[SAFETY_SRC_CLIFF_LEFT] = (SafetyPolicy_t)SAFETY_SHARED_CLIFF_POLICY;
+    sr->policy[SAFETY_SRC_CLIFF_CENTER] = (SafetyPolicy_t)SAFETY_CLIFF_POLICY;
+    sr->policy[SAFETY_SRC_CLIFF_RIGHT] = (SafetyPolicy_t)SAFETY_SHARED_CLIFF_POLICY;
+    sr->stopTimeMs = SAFETY_STOP_TIME_MS;
+    sr->backoffSpeedMs = SAFETY_BACKOFF_SPEED_MS;
+    sr->backoffTimeMs = SAFETY_BACKOFF_TIME_MS;
+    sr->turnSpeedMs = SAFETY_TURN_SPEED_MS;
+    sr->turnTimeMs = SAFETY_TURN_TIME_MS;
+    sr->state = SAFETY_STATE_IDLE;
+    sr->turnDir = 1;
+}
+
+/**
+  * @brief  获取全局安全反射实例
+  */
+SafetyReflex_t* SafetyReflex_GetInstance(void)
+{
+    return &g_SafetyReflex;
+}
+
+/**
+  * @brief  设置触发源的反射策略
+  * @param  src: 触发源
+  * @param  policy: 反射策略
+  * @retval None
+  */
+void SafetyReflex_SetPolicy(SafetySource_t src, SafetyPolicy_t policy)
+{
+    if (src >= SAFETY_SRC_COUNT) return;
+    g_SafetyReflex.policy[src] = policy;
+}
+
+/**
+  * @brief  屏蔽触发源（如回充对接时碰撞是正常接触，侧下视脚上有基站红外信号）
+  * @param  mask: 屏蔽位 (SAFETY_SRC_BIT)
+  * @retval None
+  */
+void SafetyReflex_SetSuppressMask(uint8_t mask)
+{
+    g_SafetyReflex.suppressMask = mask;
+}
+
+/**
+  * @brief  设置触发时唤醒的线程（电机控制任务）
+  * @param  thread: 线程ID
+  * @retval None
+  */
+void SafetyReflex_SetNotifyThread(osThreadId_t thread)
+{
+    g_SafetyReflex.notifyThread = thread;
+}
+
+/**
+  * @brief  更新触发电平，新进入触发电平且策略有效、未被屏蔽时登记触发
+  * @retval true=登记了新触发
+  */
+static bool SafetyReflex_Latch(SafetyReflex_t *sr, SafetySource_t src, bool active, uint32_t timeUs)
+{
+    uint8_t bit = SAFETY_SRC_BIT(src);
+    bool wasActive = (sr->activeMask & bit) != 0U;
+    if (active) {
+        sr->activeMask |= bit;
+    } else {
+        sr->activeMask &= (uint8_t)~bit;
+    }
+
+    if (!active || wasActive) return false;
+    if (sr->policy[src] == SAFETY_POLICY_NONE || (sr->suppressMask & bit) != 0U) return false;
+
+    if (sr->pendingMask == 0U) {
+        sr->edgeTimeUs = timeUs;
+    }
+    sr->pendingMask |= bit;
+    return true;
+}
+
+/**
+  * @brief  传感器边沿（GPIO中断中调用）
+  * @param  src: 触发源
+  * @param  active: true=碰撞/悬空
+  * @param  timeUs: 边沿时间戳 (us)
+  * @retval None
+  */
+void SafetyReflex_OnEdgeFromISR(SafetySource_t src, bool active, uint32_t timeUs)
+{
+    SafetyReflex_t *sr = &g_SafetyReflex;
+    if (src >= SAFETY_SRC_COUNT) return;
+
+    /* 新触发立即唤醒控制任务 */
+    if (SafetyReflex_Latch(sr, src, active, timeUs) && sr->notifyThread != NULL) {
+        osThreadFlagsSet(sr->notifyThread, SAFETY_REFLEX_THREAD_FLAG);
+    }
+}
+
+/**
+  * @brief  已消抖的传感器电平（电机控制任务在 SafetyReflex_Update 之前调用）
+  * @note   调用者即被唤醒的任务，不再设置线程标志；与碰撞中断共用掩码，关中断更新
+  * @param  src: 触发源
+  * @param  active: true=悬空
+  * @param  timeUs: 电平开始保持的时刻 (us)，延迟统计包含消抖时间
+  * @retval None
+  */
+void SafetyReflex_OnLevel(SafetySource_t src, bool active, uint32_t timeUs)
+{
+    if (src >= SAFETY_SRC_COUNT) return;
+
+    __disable_irq();
+    (void)SafetyReflex_Latch(&g_SafetyReflex, src, active, timeUs);
+    __enable_irq();
+}
+
+/**
+  * @brief  丢弃尚未处理的触发（退出停靠模式时调用，停靠期间与基站接触产生的边沿不再执行反射）
+  * @retval None
+  */
+void SafetyReflex_DiscardPending(void)
+{
+    __disable_irq();
+    g_SafetyReflex.pendingMask = 0;
+    __enable_irq();
+}
+
+/**
+  * @brief  进入下一阶段
+  */
+static void SafetyReflex_EnterState(SafetyReflex_t *sr, SafetyState_t state, uint32_t nowMs)
+{
+    sr->state = state;
+    sr->phaseStartMs = nowMs;
+}
+
+/**
+  * @brief  反射状态机更新（电机控制任务每周期调用）
+  * @param  nowMs: 当前时间 (ms)
+  * @retval 反射输出，active=false 时按正常指令控制
+  */
+SafetyReflexOutput_t SafetyReflex_Update(uint32_t nowMs)
+{
+    SafetyReflex_t *sr = &g_SafetyReflex;
+    SafetyReflexOutput_t out = { false, false, false, 0.0f, 0.0f };
+
+    /* 取走中断登记的新触发 */
+    __disable_irq();
+    uint8_t pending = sr->pendingMask;
+    uint32_t edgeUs = sr->edgeTimeUs;
+    sr->pendingMask = 0;
+    __enable_irq();
+
+    pending &= (uint8_t)~sr->suppressMask;
+    if (sr->state != SAFETY_STATE_IDLE && sr->state != SAFETY_STATE_HOLD) {
+        /* 动作执行中同一触发源的抖动不重新开始 */
+        pending &= (uint8_t)~sr->triggerMask;
+    }
+
+    if (pending != 0U) {
+        SafetyPolicy_t policy = SAFETY_POLICY_NONE;
+        for (uint8_t i = 0; i < SAFETY_SRC_COUNT; i++) {
+            if ((pending & SAFETY_SRC_BIT(i)) != 0U && sr->policy[i] > policy) {
+                policy = sr->policy[i];
+            }
+        }
+
+        if (policy != SAFETY_POLICY_NONE) {
+            if (sr->state == SAFETY_STATE_IDLE) {
+                sr->triggerMask = 0;
+                sr->activePolicy = SAFETY_POLICY_NONE;
+            }
+            sr->triggerMask |= pending;
+            if (policy > sr->activePolicy) {
+                sr->activePolicy = policy;
+            }
+
+            /* 转离触发侧：只有左侧触发则右转，只有右侧触发则左转 */
+            bool left = (sr->triggerMask & SAFETY_LEFT_MASK) != 0U;
+            bool right = (sr->triggerMask & SAFETY_RIGHT_MASK) != 0U;
+            sr->turnDir = (right && !left) ? -1 : 1;
+
+            sr->triggerCount++;
+            sr->lastTriggerMask = sr->triggerMask;
+            sr->latencyPending = true;
+            sr->latencyEdgeUs = edgeUs;
+            SafetyReflex_EnterState(sr, SAFETY_STATE_STOP, nowMs);
+            out.triggered = true;
+        }
+    }
+
+    uint32_t elapsed = nowMs - sr->phaseStartMs;
+    switch (sr->state) {
+        case SAFETY_STATE_STOP:
+            if (sr->activePolicy >= SAFETY_POLICY_BACKOFF && elapsed >= sr->stopTimeMs) {
+                SafetyReflex_EnterState(sr, SAFETY_STATE_BACKOFF, nowMs);
+            } else if (sr->activePolicy == SAFETY_POLICY_STOP) {
+                SafetyReflex_EnterState(sr, SAFETY_STATE_HOLD, nowMs);
+            }
+            break;
+
+        case SAFETY_STATE_BACKOFF:
+            if (elapsed >= sr->backoffTimeMs) {
+                SafetyReflex_EnterState(sr, (sr->activePolicy == SAFETY_POLICY_BACKOFF_TURN) ?
+                                        SAFETY_STATE_TURN : SAFETY_STATE_HOLD, nowMs);
+            }
+            break;
+
+        case SAFETY_STATE_TURN:
+            if (elapsed >= sr->turnTimeMs) {
+                SafetyReflex_EnterState(sr, SAFETY_STATE_HOLD, nowMs);
+            }
+            break;
+
+        case SAFETY_STATE_HOLD:
+            /* 触发源全部解除后交还控制 */
+            if ((sr->activeMask & sr->triggerMask & (uint8_t)~sr->suppressMask) == 0U) {
+                SafetyReflex_EnterState(sr, SAFETY_STATE_IDLE, nowMs);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    switch (sr->state) {
+        case SAFETY_STATE_STOP:
+        case SAFETY_STATE_HOLD:
+            out.active = true;
+            out.brake = true;
+            break;
+
+        case SAFETY_STATE_BACKOFF:
+            out.active = true;
+            out.leftSpeedMs = -sr->backoffSpeedMs;
+            out.rightSpeedMs = -sr->backoffSpeedMs;
+            break;
+
+        case SAFETY_STATE_TURN:
+            out.active = true;
+            out.leftSpeedMs = (float)sr->turnDir * sr->turnSpeedMs;
+            out.rightSpeedMs = -(float)sr->turnDir * sr->turnSpeedMs;
+            break;
+
+        default:
+            break;
+    }
+
+    return out;
+}
+
+/**
+  * @brief  记录反射输出已生效（电机控制任务写完比较值后调用）
+  * @param  nowUs: 新比较值生效的时刻 (us)：比较值预装载，调用方传入下一个
+  *                PWM更新事件的时间，而不是写CCR的时间
+  * @retval None
+  */
+void SafetyReflex_MarkOutputApplied(uint32_t nowUs)
+{
+    SafetyReflex_t *sr = &g_SafetyReflex;
+    if (!sr->latencyPending) return;
+
+    sr->latencyPending = false;
+    sr->lastLatencyUs = nowUs - sr->latencyEdgeUs;
+    if (sr->lastLatencyUs > sr->maxLatencyUs) {
+        sr->maxLatencyUs = sr->lastLatencyUs;
+    }
+}
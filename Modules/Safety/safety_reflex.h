@@ -0,0 +1,125 @@
+/**
+  ******************************************************************************
+  * @file    safety_reflex.h
+  * @brief   碰撞/悬崖安全反射头文件
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 碰撞光电门与下视悬崖传感器的边沿不再只经传感器事件队列慢速处理：
+  * 中断中记录触发源和微秒时间戳，并以线程标志立即唤醒电机控制任务
+  * （高优先级），由其在当前控制周期内按配置的反射策略停车/后退/转向，
+  * 同时统计从边沿到PWM变化的延迟（截止到新占空比生效的PWM更新事件）。
+  * 反射动作期间覆盖上位机轮速指令，动作结束且触发源解除后恢复。
+  ******************************************************************************
+  */
+
+#ifndef __SAFETY_REFLEX_H__
+#define __SAFETY_REFLEX_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cmsis_os.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 唤醒电机控制任务的线程标志 */
+#define SAFETY_REFLEX_THREAD_FLAG   0x0001U
+
+/* 触发源位 */
+#define SAFETY_SRC_BIT(src)         ((uint8_t)(1U << (src)))
+
+/* 触发源 */
+typedef enum {
+    SAFETY_SRC_BUMPER_LEFT = 0,     /* 左碰撞 */
+    SAFETY_SRC_BUMPER_RIGHT,        /* 右碰撞 */
+    SAFETY_SRC_CLIFF_LEFT,          /* 左前悬崖 */
+    SAFETY_SRC_CLIFF_CENTER,        /* 中间悬崖 */
+    SAFETY_SRC_CLIFF_RIGHT,         /* 右前悬崖 */
+    SAFETY_SRC_COUNT
+} SafetySource_t;
+
+/* 反射策略 */
+typedef enum {
+    SAFETY_POLICY_NONE = 0,         /* 不动作（仅上报） */
+    SAFETY_POLICY_STOP,             /* 刹停，触发源解除前保持 */
+    SAFETY_POLICY_BACKOFF,          /* 刹停后后退 */
+    SAFETY_POLICY_BACKOFF_TURN      /* 刹停后后退，再转离触发侧 */
+} SafetyPolicy_t;
+
+/* 反射状态 */
+typedef enum {
+    SAFETY_STATE_IDLE = 0,          /* 空闲 */
+    SAFETY_STATE_STOP,              /* 刹停 */
+    SAFETY_STATE_BACKOFF,           /* 后退 */
+    SAFETY_STATE_TURN,              /* 转向 */
+    SAFETY_STATE_HOLD               /* 动作完成，等待触发源解除 */
+} SafetyState_t;
+
+/* 反射输出（电机控制任务使用） */
+typedef struct {
+    bool active;                    /* 反射接管轮电机 */
+    bool brake;                     /* 立即刹停（不经PID） */
+    bool triggered;                 /* 本周期新触发 */
+    float leftSpeedMs;              /* 左轮目标速度 (m/s) */
+    float rightSpeedMs;             /* 右轮目标速度 (m/s) */
+} SafetyReflexOutput_t;
+
+/* 安全反射对象 */
+typedef struct {
+    /* 配置 */
+    SafetyPolicy_t policy[SAFETY_SRC_COUNT];
+    uint32_t stopTimeMs;            /* 后退前刹停时间 */
+    float backoffSpeedMs;           /* 后退速度 (m/s) */
+    uint32_t backoffTimeMs;         /* 后退时间 */
+    float turnSpeedMs;              /* 原地转向轮速 (m/s) */
+    uint32_t turnTimeMs;            /* 转向时间 */
+
+    /* 中断维护 */
+    volatile uint8_t activeMask;    /* 当前处于触发电平的源 */
+    volatile uint8_t pendingMask;   /* 新触发待处理的源 */
+    volatile uint32_t edgeTimeUs;   /* 最近一次触发边沿时间 */
+    volatile uint8_t suppressMask;  /* 屏蔽的触发源 */
+    osThreadId_t notifyThread;      /* 被唤醒的电机控制任务 */
+
+    /* 执行状态（电机控制任务） */
+    SafetyState_t state;
+    SafetyPolicy_t activePolicy;    /* 当前执行的策略 */
+    uint8_t triggerMask;            /* 本次反射的触发源 */
+    int8_t turnDir;                 /* 转向方向（1=右转，-1=左转） */
+    uint32_t phaseStartMs;          /* 当前阶段开始时间 */
+    bool latencyPending;            /* 等待记录输出延迟 */
+    uint32_t latencyEdgeUs;         /* 待记录延迟的边沿时间 */
+
+    /* 统计 */
+    uint16_t triggerCount;          /* 触发次数 */
+    uint8_t lastTriggerMask;        /* 最近一次触发源 */
+    uint32_t lastLatencyUs;         /* 最近一次边沿->PWM延迟 (us) */
+    uint32_t maxLatencyUs;          /* 最大边沿->PWM延迟 (us) */
+} SafetyReflex_t;
+
+/* 函数声明 */
+void SafetyReflex_Init(void);
+SafetyReflex_t* SafetyReflex_GetInstance(void);
+void SafetyReflex_SetPolicy(SafetySource_t src, SafetyPolicy_t policy);
+void SafetyReflex_SetSuppressMask(uint8_t mask);
+void SafetyReflex_SetNotifyThread(osThreadId_t thread);
+
+/* 中断中调用 */
+void SafetyReflex_OnEdgeFromISR(SafetySource_t src, bool active, uint32_t timeUs);
+
+/* 电机控制任务中调用：已消抖的电平（共用引脚的下视），timeUs 为电平开始保持的时刻 */
+void SafetyReflex_OnLevel(SafetySource_t src, bool active, uint32_t timeUs);
+
+/* 电机控制任务中调用（MarkOutputApplied 传入比较值生效的更新事件时刻） */
+SafetyReflexOutput_t SafetyReflex_Update(uint32_t nowMs);
+void SafetyReflex_MarkOutputApplied(uint32_t nowUs);
+void SafetyReflex_DiscardPending(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SAFETY_REFLEX_H__ */
@@ -0,0 +1,113 @@
+/**
+  ******************************************************************************
+  * @file    button_gesture.c
+  * @brief   按键手势识别实现
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "button_gesture.h"
+#include <stddef.h>  /* 定义NULL */
+#include <string.h>
+
+/**
+  * @brief  初始化手势识别器
+  * @param  bg: 识别器指针
+  * @param  count: 按键数（不超过 BUTTON_GESTURE_MAX）
+  * @param  debounceMs: 去抖确认时间 (ms)
+  * @param  doubleGapMs: 双击窗口 (ms)
+  * @param  longPressMs: 长按判定时间 (ms)
+  * @retval None
+  */
+void ButtonGesture_Init(ButtonGesture_t *bg, uint8_t count, uint16_t debounceMs, uint16_t doubleGapMs, uint16_t longPressMs)
+{
+    if (bg == NULL) return;
+
+    memset(bg, 0, sizeof(ButtonGesture_t));
+    bg->count = (count > BUTTON_GESTURE_MAX) ? BUTTON_GESTURE_MAX : count;
+    bg->debounceMs = debounceMs;
+    bg->doubleGapMs = doubleGapMs;
+    bg->longPressMs = longPressMs;
+}
+
+/**
+  * @brief  输入一个按键的一次采样
+  * @param  bg: 识别器指针
+  * @param  index: 按键序号
+  * @param  raw: 原始电平（true=按下）
+  * @param  nowMs: 当前时间 (ms)
+  * @retval 本次确认的手势位掩码（BUTTON_GESTURE_BIT），同一次可能同时有释放与双击
+  */
+uint8_t ButtonGesture_Update(ButtonGesture_t *bg, uint8_t index, bool raw, uint32_t nowMs)
+{
+    if (bg == NULL || index >= bg->count) return 0;
+
+    ButtonGestureState_t *b = &bg->button[index];
+    uint8_t gestures = 0;
+
+    if (raw != b->raw) {
+        b->raw = raw;
+        b->rawSince = nowMs;
+    }
+
+    /* 去抖：原始电平与确认状态不同并保持足够久才翻转 */
+    if (b->raw != b->pressed && (nowMs - b->rawSince) >= bg->debounceMs) {
+        b->pressed = b->raw;
+        if (b->pressed) {
+            gestures |= BUTTON_GESTURE_BIT(BUTTON_GESTURE_PRESS);
+            b->pressTime = nowMs;
+            b->longFired = false;
+        } else {
+            gestures |= BUTTON_GESTURE_BIT(BUTTON_GESTURE_RELEASE);
+            b->releaseTime = nowMs;
+            /* 长按后的释放不计入单击 */
+            if (!b->longFired) {
+                b->clicks++;
+                if (b->clicks >= 2U) {
+                    gestures |= BUTTON_GESTURE_BIT(BUTTON_GESTURE_DOUBLE_CLICK);
+                    b->clicks = 0;
+                }
+            }
+        }
+    }
+
+    if (b->pressed) {
+        if (!b->longFired && (nowMs - b->pressTime) >= bg->longPressMs) {
+            /* 单击后再长按：先补报前一次单击 */
+            if (b->clicks > 0U) {
+                gestures |= BUTTON_GESTURE_BIT(BUTTON_GESTURE_CLICK);
+                b->clicks = 0;
+            }
+            gestures |= BUTTON_GESTURE_BIT(BUTTON_GESTURE_LONG_PRESS);
+            b->longFired = true;
+        }
+    } else if (b->clicks > 0U && (nowMs - b->releaseTime) >= bg->doubleGapMs) {
+        /* 双击窗口内没有第二次按下 */
+        gestures |= BUTTON_GESTURE_BIT(BUTTON_GESTURE_CLICK);
+        b->clicks = 0;
+    }
+
+    return gestures;
+}
+
+/**
+  * @brief  是否所有按键都无需继续采样
+  * @note   按住但已上报长按也视为空闲：之后只等释放边沿，由中断重新启动采样
+  * @retval true=空闲
+  */
+bool ButtonGesture_IsIdle(const ButtonGesture_t *bg)
+{
+    if (bg == NULL) return true;
+
+    for (uint8_t i = 0; i < bg->count; i++) {
+        const ButtonGestureState_t *b = &bg->button[i];
+        if (b->raw != b->pressed || b->clicks > 0U) {
+            return false;
+        }
+        if (b->pressed && !b->longFired) {
+            return false;
+        }
+    }
+    return true;
+}
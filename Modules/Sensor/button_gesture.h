@@ -0,0 +1,69 @@
+/**
+  ******************************************************************************
+  * @file    button_gesture.h
+  * @brief   按键手势识别头文件（去抖/单击/双击/长按）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 对 N 个按键统一做手势识别：调用方按固定周期输入每个按键的原始电平，
+  * 模块先做去抖（电平保持 debounceMs 才确认），再在确认后的按下/释放边沿上
+  * 识别单击、双击和长按，结果以手势位掩码返回。与硬件无关（电平与时间由
+  * 调用方传入），由传感器管理器的软件定时器驱动，所有按键空闲时定时器即停。
+  ******************************************************************************
+  */
+
+#ifndef __BUTTON_GESTURE_H__
+#define __BUTTON_GESTURE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 最多支持的按键数 */
+#define BUTTON_GESTURE_MAX          4
+
+/* 手势类型（Update返回值中的位号） */
+typedef enum {
+    BUTTON_GESTURE_PRESS = 0,       /* 去抖后按下 */
+    BUTTON_GESTURE_RELEASE,         /* 去抖后释放 */
+    BUTTON_GESTURE_CLICK,           /* 单击（双击窗口超时后确认） */
+    BUTTON_GESTURE_DOUBLE_CLICK,    /* 双击（第二次释放时确认） */
+    BUTTON_GESTURE_LONG_PRESS       /* 长按（按住达到 longPressMs 时确认，释放不再产生单击） */
+} ButtonGestureType_t;
+
+#define BUTTON_GESTURE_BIT(type)    (1U << (type))
+
+/* 单个按键状态 */
+typedef struct {
+    bool raw;                   /* 最近一次输入电平（true=按下） */
+    bool pressed;               /* 去抖后状态 */
+    uint32_t rawSince;          /* 原始电平保持起始时间 (ms) */
+    uint32_t pressTime;         /* 去抖后按下时间 (ms) */
+    uint32_t releaseTime;       /* 去抖后释放时间 (ms) */
+    uint8_t clicks;             /* 双击窗口内已完成的单击数 */
+    bool longFired;             /* 本次按下已上报长按 */
+} ButtonGestureState_t;
+
+/* 按键手势识别器 */
+typedef struct {
+    uint16_t debounceMs;        /* 去抖确认时间 (ms) */
+    uint16_t doubleGapMs;       /* 双击窗口：释放后等待第二次按下的时间 (ms) */
+    uint16_t longPressMs;       /* 长按判定时间 (ms) */
+    uint8_t count;              /* 按键数 */
+    ButtonGestureState_t button[BUTTON_GESTURE_MAX];
+} ButtonGesture_t;
+
+/* 函数声明 */
+void ButtonGesture_Init(ButtonGesture_t *bg, uint8_t count, uint16_t debounceMs, uint16_t doubleGapMs, uint16_t longPressMs);
+uint8_t ButtonGesture_Update(ButtonGesture_t *bg, uint8_t index, bool raw, uint32_t nowMs);  /* 返回手势位掩码 */
+bool ButtonGesture_IsIdle(const ButtonGesture_t *bg);       /* 全部按键释放且无待定手势 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BUTTON_GESTURE_H__ */
@@ -0,0 +1,106 @@
+/**
+  ******************************************************************************
+  * @file    charge_adc.c
+  * @brief   充电触点电压采样实现
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "charge_adc.h"
+#include "hw_config.h"
+#include "main.h"
+
+#define CHARGE_ADC_FULL_SCALE       4095U
+#define CHARGE_ADC_EOC_TIMEOUT      2000U   /* 等待转换完成的轮询上限（单次转换约25us） */
+#define CHARGE_ADC_SMP_480          7U      /* 采样时间 480 周期 */
+
+/* 替身模拟源输出 (mV) */
+static volatile uint16_t s_standinMv = 0;
+
+/* ADC是否已初始化 */
+static bool s_adcReady = false;
+
+/**
+  * @brief  初始化触点电压采样
+  * @note   APB2=42MHz，ADC时钟二分频为21MHz；480周期采样+12周期转换约23us
+  * @retval None
+  */
+void ChargeADC_Init(void)
+{
+#if CHARGE_ADC_SOURCE == 0
+    GPIO_InitTypeDef gpio = {0};
+
+    __HAL_RCC_GPIOC_CLK_ENABLE();
+    __HAL_RCC_ADC1_CLK_ENABLE();
+
+    gpio.Pin = CHARGE_ADC_PIN;
+    gpio.Mode = GPIO_MODE_ANALOG;
+    gpio.Pull = GPIO_NOPULL;
+    HAL_GPIO_Init(CHARGE_ADC_PORT, &gpio);
+
+    ADC->CCR &= ~ADC_CCR_ADCPRE;                /* PCLK2/2 */
+    ADC1->CR1 = 0;                              /* 12位，非扫描 */
+    ADC1->CR2 = 0;                              /* 单次转换，右对齐 */
+#if CHARGE_ADC_CHANNEL >= 10U
+    ADC1->SMPR1 = (ADC1->SMPR1 & ~(7UL << ((CHARGE_ADC_CHANNEL - 10U) * 3U))) |
+                  ((uint32_t)CHARGE_ADC_SMP_480 << ((CHARGE_ADC_CHANNEL - 10U) * 3U));
+#else
+    ADC1->SMPR2 = (ADC1->SMPR2 & ~(7UL << (CHARGE_ADC_CHANNEL * 3U))) |
+                  ((uint32_t)CHARGE_ADC_SMP_480 << (CHARGE_ADC_CHANNEL * 3U));
+#endif
+    ADC1->SQR1 = 0;                             /* 规则序列长度 1 */
+    ADC1->SQR3 = CHARGE_ADC_CHANNEL;
+    ADC1->CR2 |= ADC_CR2_ADON;
+    s_adcReady = true;
+#else
+    s_adcReady = false;
+#endif
+}
+
+/**
+  * @brief  单次转换
+  * @retval 原始值 (0~4095)，超时返回0
+  */
+static uint16_t ChargeADC_Convert(void)
+{
+    ADC1->SR &= ~(ADC_SR_EOC | ADC_SR_OVR);
+    ADC1->CR2 |= ADC_CR2_SWSTART;
+
+    for (uint32_t i = 0; i < CHARGE_ADC_EOC_TIMEOUT; i++) {
+        if ((ADC1->SR & ADC_SR_EOC) != 0U) {
+            return (uint16_t)(ADC1->DR & CHARGE_ADC_FULL_SCALE);
+        }
+    }
+    return 0;
+}
+
+/**
+  * @brief  读取触点电压
+  * @retval 触点电压 (mV)
+  */
+uint16_t ChargeADC_ReadMv(void)
+{
+    if (!s_adcReady) {
+        return s_standinMv;
+    }
+
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < CHARGE_ADC_OVERSAMPLE; i++) {
+        sum += ChargeADC_Convert();
+    }
+
+    float mv = (float)sum / (float)CHARGE_ADC_OVERSAMPLE *
+               (float)CHARGE_ADC_VREF_MV / (float)CHARGE_ADC_FULL_SCALE * CHARGE_ADC_DIVIDER;
+    return (mv > 65535.0f) ? 65535U : (uint16_t)mv;
+}
+
+/**
+  * @brief  设置替身模拟源输出（CHARGE_ADC_SOURCE=1 时生效）
+  * @param  mv: 触点电压 (mV)
+  * @retval None
+  */
+void ChargeADC_SetStandinMv(uint16_t mv)
+{
+    s_standinMv = mv;
+}
@@ -0,0 +1,34 @@
+/**
+  ******************************************************************************
+  * @file    charge_adc.h
+  * @brief   充电触点电压采样头文件
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * ADC1 单通道软件触发转换，在传感器任务的周期作业中调用。工程未引入
+  * HAL ADC 驱动，这里直接配置 ADC1 寄存器（12位、最长采样时间，适合分压后
+  * 的高阻信号源）。CHARGE_ADC_SOURCE=1 时不访问ADC，改用替身模拟源。
+  ******************************************************************************
+  */
+
+#ifndef __CHARGE_ADC_H__
+#define __CHARGE_ADC_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 函数声明 */
+void ChargeADC_Init(void);
+uint16_t ChargeADC_ReadMv(void);                /* 触点电压 (mV，已折算分压比) */
+void ChargeADC_SetStandinMv(uint16_t mv);       /* 替身模拟源输出 (mV) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CHARGE_ADC_H__ */
@@ -0,0 +1,83 @@
+/**
+  ******************************************************************************
+  * @file    charge_contact.c
+  * @brief   充电触点接触判定实现
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "charge_contact.h"
+#include <stddef.h>  /* 定义NULL */
+#include <string.h>
+
+/**
+  * @brief  初始化触点判定
+  * @param  cc: 判定对象指针
+  * @param  onMv: 接通阈值 (mV)
+  * @param  offMv: 断开阈值 (mV)，应低于 onMv
+  * @param  onMs: 接通确认时间 (ms)
+  * @param  offMs: 断开确认时间 (ms)
+  * @retval None
+  */
+void ChargeContact_Init(ChargeContact_t *cc, uint16_t onMv, uint16_t offMv, uint16_t onMs, uint16_t offMs)
+{
+    if (cc == NULL) return;
+
+    memset(cc, 0, sizeof(ChargeContact_t));
+    cc->onMv = onMv;
+    cc->offMv = (offMv < onMv) ? offMv : onMv;
+    cc->onMs = onMs;
+    cc->offMs = offMs;
+}
+
+/**
+  * @brief  输入一次采样
+  * @param  cc: 判定对象指针
+  * @param  mv: 触点电压 (mV)
+  * @param  nowMs: 当前时间 (ms)
+  * @retval true=接触状态发生变化
+  */
+bool ChargeContact_Update(ChargeContact_t *cc, uint16_t mv, uint32_t nowMs)
+{
+    if (cc == NULL) return false;
+
+    cc->mv = mv;
+
+    /* 滞回比较：接通时看是否掉到断开阈值以下，断开时看是否升到接通阈值以上 */
+    bool opposite = cc->present ? (mv < cc->offMv) : (mv >= cc->onMv);
+    if (!opposite) {
+        if (cc->pending) {
+            cc->pending = false;
+            if (cc->bounceCount < 0xFFFFU) cc->bounceCount++;
+        }
+        return false;
+    }
+
+    if (!cc->pending) {
+        cc->pending = true;
+        cc->pendingSince = nowMs;
+    }
+
+    uint16_t confirmMs = cc->present ? cc->offMs : cc->onMs;
+    if ((nowMs - cc->pendingSince) < confirmMs) {
+        return false;
+    }
+
+    cc->present = !cc->present;
+    cc->pending = false;
+    cc->changeTime = nowMs;
+    if (cc->present && cc->makeCount < 0xFFFFU) {
+        cc->makeCount++;
+    }
+    return true;
+}
+
+/**
+  * @brief  是否已接通
+  */
+bool ChargeContact_IsPresent(const ChargeContact_t *cc)
+{
+    if (cc == NULL) return false;
+    return cc->present;
+}
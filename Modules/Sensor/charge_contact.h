@@ -0,0 +1,50 @@
+/**
+  ******************************************************************************
+  * @file    charge_contact.h
+  * @brief   充电触点接触判定头文件
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 输入触点电压采样（mV），按接通/断开两个阈值做滞回比较，再分别按接通/断开
+  * 确认时间去抖：触点刚压上时的弹跳、对接中车体晃动造成的短暂断开都不会
+  * 改变判定结果。与硬件无关（采样值与时间由调用方传入），可在上位机编译测试。
+  ******************************************************************************
+  */
+
+#ifndef __CHARGE_CONTACT_H__
+#define __CHARGE_CONTACT_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 充电触点判定 */
+typedef struct {
+    uint16_t onMv;              /* 高于该电压视为接通 (mV) */
+    uint16_t offMv;             /* 低于该电压视为断开 (mV) */
+    uint16_t onMs;              /* 接通确认时间 (ms) */
+    uint16_t offMs;             /* 断开确认时间 (ms) */
+
+    uint16_t mv;                /* 最近一次采样 (mV) */
+    bool present;               /* 去抖后的接触状态 */
+    bool pending;               /* 与 present 相反的候选状态正在计时 */
+    uint32_t pendingSince;      /* 候选状态起始时间 (ms) */
+    uint32_t changeTime;        /* 上次判定变化时间 (ms) */
+    uint16_t makeCount;         /* 接通次数 */
+    uint16_t bounceCount;       /* 未达确认时间即恢复的次数 */
+} ChargeContact_t;
+
+/* 函数声明 */
+void ChargeContact_Init(ChargeContact_t *cc, uint16_t onMv, uint16_t offMv, uint16_t onMs, uint16_t offMs);
+bool ChargeContact_Update(ChargeContact_t *cc, uint16_t mv, uint32_t nowMs);  /* 返回true=判定发生变化 */
+bool ChargeContact_IsPresent(const ChargeContact_t *cc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CHARGE_CONTACT_H__ */
@@ -0,0 +1,101 @@
+/**
+  ******************************************************************************
+  * @file    ir_capture.c
+  * @brief   红外边沿捕获缓冲实现
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "ir_capture.h"
+#include <stddef.h>  /* 定义NULL */
+#include <string.h>
+
+#define IR_CAPTURE_MASK     (IR_CAPTURE_BUFFER_SIZE - 1U)
+
+/* 编译器屏障：保证先写入边沿再发布写指针（单核，无需DMB） */
+#define IR_CAPTURE_BARRIER()  __asm volatile ("" ::: "memory")
+
+/**
+  * @brief  初始化边沿捕获缓冲
+  * @param  cap: 捕获缓冲对象指针
+  * @param  idleLevel: 接收头空闲电平
+  * @retval None
+  */
+void IRCapture_Init(IRCapture_t *cap, bool idleLevel)
+{
+    if (cap == NULL) return;
+
+    memset(cap, 0, sizeof(IRCapture_t));
+    cap->lastLevel = idleLevel;
+}
+
+/**
+  * @brief  记录一个边沿（EXTI中断中调用）
+  * @param  cap: 捕获缓冲对象指针
+  * @param  timeUs: 边沿时间（微秒）
+  * @param  level: 边沿后的引脚电平
+  * @retval None
+  */
+void IRCapture_PushEdgeFromISR(IRCapture_t *cap, uint32_t timeUs, bool level)
+{
+    if (cap == NULL) return;
+    if (level == cap->lastLevel) return;
+    cap->lastLevel = level;
+
+    uint16_t head = cap->head;
+    uint16_t next = (uint16_t)((head + 1U) & IR_CAPTURE_MASK);
+    if (next == cap->tail) {
+        cap->overflow = true;
+        cap->overflowCount++;
+        return;
+    }
+
+    cap->buf[head].timeUs = timeUs;
+    cap->buf[head].level = level;
+    IR_CAPTURE_BARRIER();
+    cap->head = next;
+}
+
+/**
+  * @brief  取出一个边沿（任务中调用）
+  * @param  cap: 捕获缓冲对象指针
+  * @param  edge: 输出边沿
+  * @retval true=取到边沿
+  */
+bool IRCapture_PopEdge(IRCapture_t *cap, IRCaptureEdge_t *edge)
+{
+    if (cap == NULL || edge == NULL) return false;
+
+    uint16_t tail = cap->tail;
+    if (tail == cap->head) return false;
+
+    *edge = cap->buf[tail];
+    IR_CAPTURE_BARRIER();
+    cap->tail = (uint16_t)((tail + 1U) & IR_CAPTURE_MASK);
+    return true;
+}
+
+/**
+  * @brief  读取并清除溢出标志（消费者据此复位解码器，避免拼接残帧）
+  * @param  cap: 捕获缓冲对象指针
+  * @retval true=自上次读取后发生过溢出
+  */
+bool IRCapture_TakeOverflow(IRCapture_t *cap)
+{
+    if (cap == NULL || !cap->overflow) return false;
+
+    cap->overflow = false;
+    return true;
+}
+
+/**
+  * @brief  检查缓冲是否为空（无待取边沿且无溢出）
+  * @param  cap: 捕获缓冲对象指针
+  * @retval true=无需处理
+  */
+bool IRCapture_IsEmpty(const IRCapture_t *cap)
+{
+    if (cap == NULL) return true;
+    return (cap->head == cap->tail) && !cap->overflow;
+}
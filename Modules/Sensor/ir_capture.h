@@ -0,0 +1,56 @@
+/**
+  ******************************************************************************
+  * @file    ir_capture.h
+  * @brief   红外边沿捕获缓冲头文件
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 每个红外接收头一个独立的边沿缓冲：中断中只记录（微秒时间戳, 电平），
+  * 不再逐边沿投递传感器事件队列；任务中批量取出交给解码器，只有解码
+  * 成功的编码才作为事件上报，碰撞/下视事件不会被红外边沿挤掉。
+  * 缓冲为单生产者（EXTI中断）/单消费者（传感器任务）环形队列，无需加锁。
+  ******************************************************************************
+  */
+
+#ifndef __IR_CAPTURE_H__
+#define __IR_CAPTURE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 边沿缓冲容量（2的幂，约两帧NEC） */
+#define IR_CAPTURE_BUFFER_SIZE      128U
+
+/* 捕获的边沿 */
+typedef struct {
+    uint32_t timeUs;                /* 边沿时间（微秒） */
+    bool level;                     /* 边沿后的引脚电平 */
+} IRCaptureEdge_t;
+
+/* 边沿捕获缓冲 */
+typedef struct {
+    IRCaptureEdge_t buf[IR_CAPTURE_BUFFER_SIZE];
+    volatile uint16_t head;         /* 写指针（中断） */
+    volatile uint16_t tail;         /* 读指针（任务） */
+    volatile bool overflow;         /* 发生溢出，待消费者重新同步 */
+    bool lastLevel;                 /* 上次电平（过滤无变化的重复中断） */
+    uint32_t overflowCount;         /* 溢出丢弃的边沿数 */
+} IRCapture_t;
+
+/* 函数声明 */
+void IRCapture_Init(IRCapture_t *cap, bool idleLevel);
+void IRCapture_PushEdgeFromISR(IRCapture_t *cap, uint32_t timeUs, bool level);
+bool IRCapture_PopEdge(IRCapture_t *cap, IRCaptureEdge_t *edge);
+bool IRCapture_TakeOverflow(IRCapture_t *cap);
+bool IRCapture_IsEmpty(const IRCapture_t *cap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __IR_CAPTURE_H__ */
@@ -8,6 +8,8 @@
   */
 
 #include "ir_sensor.h"
+#include "hw_config.h"
+#include "timebase.h"
 
 /**
   * @brief  初始化红外传感器
@@ -68,12 +70,11 @@ void IR_Sensor_Update(IR_Sensor_t *sensor)
     
     /* 检测边沿 */
     if (currentLevel != sensor->lastLevel) {
-        /* 计算时间差（微秒） */
-        uint32_t currentTime = HAL_GetTick() * 1000;  /* 转换为微秒（近似） */
-        uint32_t period = currentTime - sensor->lastEdgeTime;
+        /* 边沿时间（微秒） */
+        uint32_t currentTime = Timebase_GetUs();
         
         /* 处理边沿 */
-        NEC_Decoder_ProcessEdge(&sensor->decoder, period, currentLevel);
+        NEC_Decoder_ProcessEdge(&sensor->decoder, currentTime, IR_RECEIVER_ACTIVE_LOW ? !currentLevel : currentLevel);
         
         sensor->lastEdgeTime = currentTime;
         sensor->lastLevel = currentLevel;
@@ -10,22 +10,47 @@
 #include "sensor_manager.h"
 #include "ir_sensor.h"
 #include "photo_gate.h"
+#include "timebase.h"
+#include "safety_reflex.h"
+#include "hw_config.h"
 #include "main.h"
+#include "mem_section.h"
 #include "cmsis_os.h"
 
 /* 全局传感器管理器实例 */
-static SensorManager_t g_SensorManager;
+CCM_DATA static SensorManager_t g_SensorManager;
+
+/* 事件队列与按钮采样定时器的静态控制块和存储区（编译期确定大小，不占用 FreeRTOS 堆） */
+CCM_DATA static StaticQueue_t s_eventQueueCb;
+CCM_DATA static uint8_t s_eventQueueStorage[SENSOR_EVENT_QUEUE_LENGTH * sizeof(SensorEvent_t)];
+CCM_DATA static StaticTimer_t s_buttonTimerCb;
 
 /* 按钮配置 */
-#define BUTTON_CLICK_TIMEOUT_MS     500     /* 单击超时时间 (ms) */
-#define BUTTON_DOUBLE_CLICK_GAP_MS  300     /* 双击间隔时间 (ms) */
+#define BUTTON_SCAN_PERIOD_MS       5       /* 采样定时器周期 (ms) */
 #define BUTTON_DEBOUNCE_TIME_MS     10      /* 按钮滤波时间 (ms) */
+#define BUTTON_DOUBLE_CLICK_GAP_MS  300     /* 双击间隔时间 (ms) */
+#define BUTTON_LONG_PRESS_MS        800     /* 长按判定时间 (ms) */
+
+/* 按钮定义：引脚（低电平表示按下）与各手势对应的事件类型 */
+typedef struct {
+    GPIO_TypeDef *port;
+    uint16_t pin;
+    SensorEventType_t events[BUTTON_GESTURE_LONG_PRESS + 1];    /* 按 ButtonGestureType_t 顺序 */
+} SensorButtonDef_t;
+
+static const SensorButtonDef_t s_buttonDefs[SENSOR_MANAGER_BUTTON_COUNT] = {
+    { BUTTON1_GPIO_Port, BUTTON1_Pin,
+      { SENSOR_EVENT_BUTTON1_PRESS, SENSOR_EVENT_BUTTON1_RELEASE, SENSOR_EVENT_BUTTON1_CLICK,
+        SENSOR_EVENT_BUTTON1_DOUBLE_CLICK, SENSOR_EVENT_BUTTON1_LONG_PRESS } },
+    { BUTTON2_GPIO_Port, BUTTON2_Pin,
+      { SENSOR_EVENT_BUTTON2_PRESS, SENSOR_EVENT_BUTTON2_RELEASE, SENSOR_EVENT_BUTTON2_CLICK,
+        SENSOR_EVENT_BUTTON2_DOUBLE_CLICK, SENSOR_EVENT_BUTTON2_LONG_PRESS } },
+};
 
-/* 中断回调中使用的静态变量（用于边沿检测） */
-static struct {
-    uint32_t lastEdgeTime[4];   /* 红外传感器上次边沿时间 */
-    bool lastLevel[4];          /* 红外传感器上次电平 */
-} irSensorState;
+static void SensorManager_ButtonTimerCallback(TimerHandle_t timer);
+
+/* 红外接收头空闲电平（无载波） */
+#define IR_RECEIVER_IDLE_LEVEL      (IR_RECEIVER_ACTIVE_LOW ? true : false)
 
 /**
  * @brief  初始化传感器管理器
@@ -34,29 +59,25 @@ void SensorManager_Init(SensorManager_t *manager)
 {
     if (manager == NULL) return;
     
+    /* 红外边沿时间戳使用微秒时间基准 */
+    Timebase_Init();
+    
     /* 创建事件队列 */
-    manager->eventQueue = xQueueCreate(20, sizeof(SensorEvent_t));
-    
-    /* 初始化按钮状态 */
-    manager->button1.pressTime = 0;
-    manager->button1.releaseTime = 0;
-    manager->button1.isPressed = false;
-    manager->button1.lastState = true;  /* 默认高电平（未按下） */
-    manager->button1.clickCount = 0;
-    manager->button1.lastClickTime = 0;
-    manager->button1.debouncePending = false;
-    manager->button1.debounceTime = 0;
-    manager->button1.debounceState = false;
-    
-    manager->button2.pressTime = 0;
-    manager->button2.releaseTime = 0;
-    manager->button2.isPressed = false;
-    manager->button2.lastState = true;
-    manager->button2.clickCount = 0;
-    manager->button2.lastClickTime = 0;
-    manager->button2.debouncePending = false;
-    manager->button2.debounceTime = 0;
-    manager->button2.debounceState = false;
+    manager->eventQueue = xQueueCreateStatic(SENSOR_EVENT_QUEUE_LENGTH, sizeof(SensorEvent_t),
+                                             s_eventQueueStorage, &s_eventQueueCb);
+    manager->eventPostCount = 0;
+    manager->eventDropCount = 0;
+    manager->eventHighWater = 0;
+    manager->eventBatchMax = 0;
+    
+    /* 初始化按钮手势识别，采样定时器由按钮中断按需启动 */
+    ButtonGesture_Init(&manager->buttons, SENSOR_MANAGER_BUTTON_COUNT,
+                       BUTTON_DEBOUNCE_TIME_MS, BUTTON_DOUBLE_CLICK_GAP_MS, BUTTON_LONG_PRESS_MS);
+    manager->buttonTimer = xTimerCreateStatic("ButtonScan", pdMS_TO_TICKS(BUTTON_SCAN_PERIOD_MS), pdTRUE,
+                                              NULL, SensorManager_ButtonTimerCallback, &s_buttonTimerCb);
+    manager->buttonScanActive = false;
+    manager->buttonEdgePending = false;
+    manager->buttonScanCount = 0;
     
     /* 初始化传感器状态 */
     manager->photoGateLeftBlocked = false;
@@ -66,12 +87,13 @@ void SensorManager_Init(SensorManager_t *manager)
     manager->underLeftSuspended = false;
     manager->underRightSuspended = false;
     manager->underCenterSuspended = false;
+    manager->underLeftEdgeUs = 0;
+    manager->underRightEdgeUs = 0;
     
     /* 初始化红外传感器状态 */
-    for (int i = 0; i < 4; i++) {
+    for (int i = 0; i < SENSOR_MANAGER_IR_COUNT; i++) {
         manager->irSensors[i].dataReady = false;
-        irSensorState.lastEdgeTime[i] = 0;
-        irSensorState.lastLevel[i] = false;
+        IRCapture_Init(&manager->irCapture[i], IR_RECEIVER_IDLE_LEVEL);
     }
     
     manager->enabled = false;
@@ -96,113 +118,162 @@ void SensorManager_Stop(SensorManager_t *manager)
 }
 
 /**
- * @brief  红外传感器中断处理（左侧）
+ * @brief  屏蔽/恢复四个红外接收头的 EXTI（停靠模式下基站信标不再逐边沿唤醒 CPU）
+ * @note   左前/右前接收头与左/右下视传感器共用引脚，下视由电机控制任务按周期采样，
+ *         停靠模式下该任务不运行、电机已停，不影响安全反射
+ * @param  manager: 传感器管理器指针
+ * @param  enabled: true=恢复捕获
  */
-void SensorManager_IRQHandler_IR_Left(void)
+void SensorManager_SetIRCaptureEnabled(SensorManager_t *manager, bool enabled)
 {
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    SensorEvent_t event;
-    
-    bool currentLevel = HAL_GPIO_ReadPin(L_RECEIVE_GPIO_Port, L_RECEIVE_Pin) == GPIO_PIN_SET;
-    uint32_t currentTime = HAL_GetTick() * 1000;  /* 转换为微秒（近似） */
+    if (manager == NULL) return;
     
-    /* 检测边沿 */
-    if (currentLevel != irSensorState.lastLevel[0]) {
-        uint32_t period = currentTime - irSensorState.lastEdgeTime[0];
-        
-        /* 发送边沿事件到队列（在任务中处理NEC解码） */
-        event.type = SENSOR_EVENT_IR_LEFT;
-        event.timestamp = currentTime;
-        event.data = (currentLevel ? 1 : 0) | (period << 1);  /* 临时存储边沿信息 */
-        
-        xQueueSendFromISR(g_SensorManager.eventQueue, &event, &xHigherPriorityTaskWoken);
-        
-        irSensorState.lastEdgeTime[0] = currentTime;
-        irSensorState.lastLevel[0] = currentLevel;
+    uint32_t lines = (uint32_t)(L_RECEIVE_Pin | R_RECEIVE_Pin |
+                                L_FOLLOW_CHECK_SIGNAL_Pin | R_FOLLOW_CHECK_SIGNAL_Pin);
+    __disable_irq();
+    if (enabled) {
+        EXTI->PR = lines;       /* 丢弃屏蔽期间挂起的边沿 */
+        EXTI->IMR |= lines;
+    } else {
+        EXTI->IMR &= ~lines;
     }
-    
+    __enable_irq();
+}
+
+/**
+ * @brief  记录投递结果与队列最高占用
+ */
+static void SensorManager_RecordPost(SensorManager_t *manager, BaseType_t result, UBaseType_t waiting)
+{
+    if (result != pdTRUE) {
+        manager->eventDropCount++;
+        return;
+    }
+    manager->eventPostCount++;
+    if (waiting > manager->eventHighWater) {
+        manager->eventHighWater = (uint8_t)waiting;
+    }
+}
+
+/**
+ * @brief  中断中投递事件
+ */
+static void SensorManager_PostEventFromISR(const SensorEvent_t *event)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    BaseType_t result = xQueueSendFromISR(g_SensorManager.eventQueue, event, &xHigherPriorityTaskWoken);
+    SensorManager_RecordPost(&g_SensorManager, result, uxQueueMessagesWaitingFromISR(g_SensorManager.eventQueue));
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
+/**
+ * @brief  投递事件（任务上下文）
+ */
+bool SensorManager_PostEvent(SensorManager_t *manager, const SensorEvent_t *event)
+{
+    if (manager == NULL || event == NULL) return false;
+    
+    BaseType_t result = xQueueSend(manager->eventQueue, event, 0);
+    taskENTER_CRITICAL();
+    SensorManager_RecordPost(manager, result, uxQueueMessagesWaiting(manager->eventQueue));
+    taskEXIT_CRITICAL();
+    return result == pdTRUE;
+}
+
+/**
+ * @brief  记录红外边沿（中断中只写捕获缓冲，不投递事件队列）
+ */
+static void SensorManager_CaptureIREdge(uint8_t index, GPIO_TypeDef *port, uint16_t pin)
+{
+    bool level = HAL_GPIO_ReadPin(port, pin) == GPIO_PIN_SET;
+    IRCapture_PushEdgeFromISR(&g_SensorManager.irCapture[index], Timebase_GetUs(), level);
+}
+
+/**
+ * @brief  红外传感器中断处理（左侧）
+ */
+void SensorManager_IRQHandler_IR_Left(void)
+{
+    SensorManager_CaptureIREdge(IR_SENSOR_LEFT, L_RECEIVE_GPIO_Port, L_RECEIVE_Pin);
+}
+
 /**
  * @brief  红外传感器中断处理（右侧）
  */
 void SensorManager_IRQHandler_IR_Right(void)
 {
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    SensorEvent_t event;
-    
-    bool currentLevel = HAL_GPIO_ReadPin(R_RECEIVE_GPIO_Port, R_RECEIVE_Pin) == GPIO_PIN_SET;
-    uint32_t currentTime = HAL_GetTick() * 1000;
-    
-    if (currentLevel != irSensorState.lastLevel[1]) {
-        uint32_t period = currentTime - irSensorState.lastEdgeTime[1];
-        
-        event.type = SENSOR_EVENT_IR_RIGHT;
-        event.timestamp = currentTime;
-        event.data = (currentLevel ? 1 : 0) | (period << 1);
-        
-        xQueueSendFromISR(g_SensorManager.eventQueue, &event, &xHigherPriorityTaskWoken);
-        
-        irSensorState.lastEdgeTime[1] = currentTime;
-        irSensorState.lastLevel[1] = currentLevel;
-    }
-    
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    SensorManager_CaptureIREdge(IR_SENSOR_RIGHT, R_RECEIVE_GPIO_Port, R_RECEIVE_Pin);
 }
 
 /**
- * @brief  红外传感器中断处理（左前）
+ * @brief  红外传感器中断处理（左前，与左前下视共用引脚）
+ * @note   只写捕获缓冲并记录边沿时间，下视电平由 SensorManager_SampleSharedCliff 消抖，
+ *         NEC 帧的边沿不进入事件队列、不触发安全反射
  */
 void SensorManager_IRQHandler_IR_FrontLeft(void)
 {
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    SensorEvent_t event;
-    
-    bool currentLevel = HAL_GPIO_ReadPin(L_FOLLOW_CHECK_SIGNAL_GPIO_Port, L_FOLLOW_CHECK_SIGNAL_Pin) == GPIO_PIN_SET;
-    uint32_t currentTime = HAL_GetTick() * 1000;
-    
-    if (currentLevel != irSensorState.lastLevel[2]) {
-        uint32_t period = currentTime - irSensorState.lastEdgeTime[2];
-        
-        event.type = SENSOR_EVENT_IR_FRONT_LEFT;
-        event.timestamp = currentTime;
-        event.data = (currentLevel ? 1 : 0) | (period << 1);
-        
-        xQueueSendFromISR(g_SensorManager.eventQueue, &event, &xHigherPriorityTaskWoken);
-        
-        irSensorState.lastEdgeTime[2] = currentTime;
-        irSensorState.lastLevel[2] = currentLevel;
-    }
-    
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    g_SensorManager.underLeftEdgeUs = Timebase_GetUs();
+    SensorManager_CaptureIREdge(IR_SENSOR_FRONT_LEFT, L_FOLLOW_CHECK_SIGNAL_GPIO_Port, L_FOLLOW_CHECK_SIGNAL_Pin);
 }
 
 /**
- * @brief  红外传感器中断处理（右前）
+ * @brief  红外传感器中断处理（右前，与右前下视共用引脚）
  */
 void SensorManager_IRQHandler_IR_FrontRight(void)
 {
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    SensorEvent_t event;
+    g_SensorManager.underRightEdgeUs = Timebase_GetUs();
+    SensorManager_CaptureIREdge(IR_SENSOR_FRONT_RIGHT, R_FOLLOW_CHECK_SIGNAL_GPIO_Port, R_FOLLOW_CHECK_SIGNAL_Pin);
+}
+
+/**
+ * @brief  红外边沿批量解码（在Sensor任务中定期调用）
+ * @param  manager: 传感器管理器
+ * @param  index: 接收头编号 (IR_SensorType_t)
+ * @param  decoder: 该接收头的NEC解码器
+ * @retval 本次解码成功的帧数
+ */
+uint8_t SensorManager_ProcessIR(SensorManager_t *manager, uint8_t index, NEC_Decoder_t *decoder)
+{
+    if (manager == NULL || decoder == NULL || index >= SENSOR_MANAGER_IR_COUNT) return 0;
     
-    bool currentLevel = HAL_GPIO_ReadPin(R_FOLLOW_CHECK_SIGNAL_GPIO_Port, R_FOLLOW_CHECK_SIGNAL_Pin) == GPIO_PIN_SET;
-    uint32_t currentTime = HAL_GetTick() * 1000;
+    IRCapture_t *cap = &manager->irCapture[index];
+    uint8_t decoded = 0;
     
-    if (currentLevel != irSensorState.lastLevel[3]) {
-        uint32_t period = currentTime - irSensorState.lastEdgeTime[3];
-        
-        event.type = SENSOR_EVENT_IR_FRONT_RIGHT;
-        event.timestamp = currentTime;
-        event.data = (currentLevel ? 1 : 0) | (period << 1);
+    /* 无新边沿且解码器不在帧内：没有要解码或超时丢弃的内容 */
+    if (IRCapture_IsEmpty(cap) && NEC_Decoder_IsIdle(decoder)) return 0;
+    
+    /* 缓冲溢出丢过边沿，丢弃解码器中的残帧 */
+    if (IRCapture_TakeOverflow(cap)) {
+        NEC_Decoder_Reset(decoder);
+    }
+    
+    IRCaptureEdge_t edge;
+    while (IRCapture_PopEdge(cap, &edge)) {
+        bool mark = IR_RECEIVER_ACTIVE_LOW ? !edge.level : edge.level;
+        if (!NEC_Decoder_ProcessEdge(decoder, edge.timeUs, mark)) {
+            continue;
+        }
         
-        xQueueSendFromISR(g_SensorManager.eventQueue, &event, &xHigherPriorityTaskWoken);
+        NEC_Data_t necData = NEC_Decoder_GetData(decoder);
+        manager->irSensors[index].necData = necData;
+        manager->irSensors[index].dataReady = true;
         
-        irSensorState.lastEdgeTime[3] = currentTime;
-        irSensorState.lastLevel[3] = currentLevel;
+        /* 只上报解码成功的编码 */
+        SensorEvent_t event;
+        event.type = (SensorEventType_t)(SENSOR_EVENT_IR_LEFT + index);
+        event.timestamp = HAL_GetTick();
+        event.data = (uint32_t)necData.address |
+                     ((uint32_t)necData.command << 8) |
+                     ((uint32_t)necData.addressInv << 16) |
+                     ((uint32_t)necData.commandInv << 24);
+        SensorManager_PostEvent(manager, &event);
+        decoded++;
     }
     
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    /* 边沿已取空，帧内长时间无新边沿则丢弃残帧 */
+    NEC_Decoder_Poll(decoder, Timebase_GetUs());
+    
+    return decoded;
 }
 
 /**
@@ -210,18 +281,19 @@ void SensorManager_IRQHandler_IR_FrontRight(void)
  */
 void SensorManager_IRQHandler_PhotoGate_Left(void)
 {
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
     SensorEvent_t event;
     
     /* 读取GPIO状态（高电平表示碰撞） */
     bool isBlocked = HAL_GPIO_ReadPin(IFHIT_L_GPIO_Port, IFHIT_L_Pin) == GPIO_PIN_SET;
     
+    /* 安全反射：直接唤醒电机控制任务 */
+    SafetyReflex_OnEdgeFromISR(SAFETY_SRC_BUMPER_LEFT, isBlocked, Timebase_GetUs());
+    
     event.type = SENSOR_EVENT_PHOTO_GATE_LEFT;
     event.timestamp = HAL_GetTick();
     event.data = isBlocked ? 1 : 0;
     
-    xQueueSendFromISR(g_SensorManager.eventQueue, &event, &xHigherPriorityTaskWoken);
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    SensorManager_PostEventFromISR(&event);
 }
 
 /**
@@ -229,162 +301,141 @@ void SensorManager_IRQHandler_PhotoGate_Left(void)
  */
 void SensorManager_IRQHandler_PhotoGate_Right(void)
 {
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
     SensorEvent_t event;
     
     bool isBlocked = HAL_GPIO_ReadPin(IFHIT_R_GPIO_Port, IFHIT_R_Pin) == GPIO_PIN_SET;
     
+    /* 安全反射：直接唤醒电机控制任务 */
+    SafetyReflex_OnEdgeFromISR(SAFETY_SRC_BUMPER_RIGHT, isBlocked, Timebase_GetUs());
+    
     event.type = SENSOR_EVENT_PHOTO_GATE_RIGHT;
     event.timestamp = HAL_GetTick();
     event.data = isBlocked ? 1 : 0;
     
-    xQueueSendFromISR(g_SensorManager.eventQueue, &event, &xHigherPriorityTaskWoken);
+    SensorManager_PostEventFromISR(&event);
+}
+
+/**
+ * @brief  按钮边沿：按需启动采样定时器
+ * @note   定时器运行期间只记边沿标志，抖动产生的连串边沿不会反复向定时器队列发命令
+ */
+static void SensorManager_ButtonEdgeFromISR(void)
+{
+    g_SensorManager.buttonEdgePending = true;
+    /* 定时器为静态创建，句柄为空只表示 SensorManager_Init 尚未执行 */
+    if (g_SensorManager.buttonScanActive || g_SensorManager.buttonTimer == NULL) {
+        return;
+    }
+    
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    if (xTimerStartFromISR(g_SensorManager.buttonTimer, &xHigherPriorityTaskWoken) == pdPASS) {
+        g_SensorManager.buttonScanActive = true;
+    }
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
 /**
- * @brief  按钮1中断处理（带10ms滤波检测）
+ * @brief  按钮1中断处理
  */
 void SensorManager_IRQHandler_Button1(void)
 {
-    /* 读取GPIO状态（低电平表示按下） */
-    bool isPressed = HAL_GPIO_ReadPin(BUTTON1_GPIO_Port, BUTTON1_Pin) == GPIO_PIN_RESET;
-    
-    /* 记录滤波检测信息 */
-    g_SensorManager.button1.debouncePending = true;
-    g_SensorManager.button1.debounceTime = HAL_GetTick();
-    g_SensorManager.button1.debounceState = isPressed;
+    SensorManager_ButtonEdgeFromISR();
 }
 
 /**
- * @brief  按钮2中断处理（带10ms滤波检测）
+ * @brief  按钮2中断处理
  */
 void SensorManager_IRQHandler_Button2(void)
 {
-    /* 读取GPIO状态（低电平表示按下） */
-    bool isPressed = HAL_GPIO_ReadPin(BUTTON2_GPIO_Port, BUTTON2_Pin) == GPIO_PIN_RESET;
-    
-    /* 记录滤波检测信息 */
-    g_SensorManager.button2.debouncePending = true;
-    g_SensorManager.button2.debounceTime = HAL_GetTick();
-    g_SensorManager.button2.debounceState = isPressed;
+    SensorManager_ButtonEdgeFromISR();
 }
 
 /**
- * @brief  按钮滤波检测（在Sensor任务中定期调用）
+ * @brief  按钮采样定时器回调（定时器服务任务上下文）
+ * @note   采样全部按钮并投递手势事件；全部空闲且期间没有新边沿时停止定时器
  */
-void SensorManager_CheckButtonDebounce(SensorManager_t *manager)
+static void SensorManager_ButtonTimerCallback(TimerHandle_t timer)
 {
-    if (manager == NULL) return;
-    
-    uint32_t currentTime = HAL_GetTick();
+    SensorManager_t *manager = &g_SensorManager;
+    uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
     SensorEvent_t event;
     
-    /* 检查按钮1滤波 */
-    if (manager->button1.debouncePending) {
-        /* 检查是否已经过了滤波时间 */
-        if ((currentTime - manager->button1.debounceTime) >= BUTTON_DEBOUNCE_TIME_MS) {
-            /* 再次读取GPIO状态确认 */
-            bool isPressed = HAL_GPIO_ReadPin(BUTTON1_GPIO_Port, BUTTON1_Pin) == GPIO_PIN_RESET;
-            
-            /* 如果状态与记录的一致，说明是有效事件 */
-            if (isPressed == manager->button1.debounceState) {
-                if (isPressed && !manager->button1.lastState) {
-                    /* 按下事件 */
-                    event.type = SENSOR_EVENT_BUTTON1_PRESS;
-                    event.timestamp = currentTime;
-                    event.data = 0;
-                    xQueueSend(manager->eventQueue, &event, 0);
-                } else if (!isPressed && manager->button1.lastState) {
-                    /* 释放事件 */
-                    event.type = SENSOR_EVENT_BUTTON1_RELEASE;
-                    event.timestamp = currentTime;
-                    event.data = 0;
-                    xQueueSend(manager->eventQueue, &event, 0);
-                }
-                
-                manager->button1.lastState = isPressed;
-            }
-            
-            /* 清除滤波待检测标志 */
-            manager->button1.debouncePending = false;
+    manager->buttonEdgePending = false;
+    manager->buttonScanCount++;
+    
+    for (uint8_t i = 0; i < SENSOR_MANAGER_BUTTON_COUNT; i++) {
+        const SensorButtonDef_t *def = &s_buttonDefs[i];
+        bool raw = HAL_GPIO_ReadPin(def->port, def->pin) == GPIO_PIN_RESET;
+        uint8_t gestures = ButtonGesture_Update(&manager->buttons, i, raw, now);
+        
+        for (uint8_t g = BUTTON_GESTURE_PRESS; gestures != 0U; g++, gestures >>= 1) {
+            if ((gestures & 1U) == 0U) continue;
+            event.type = def->events[g];
+            event.timestamp = now;
+            event.data = (g == BUTTON_GESTURE_LONG_PRESS) ? (now - manager->buttons.button[i].pressTime) : 0U;
+            SensorManager_PostEvent(manager, &event);
         }
     }
     
-    /* 检查按钮2滤波 */
-    if (manager->button2.debouncePending) {
-        /* 检查是否已经过了滤波时间 */
-        if ((currentTime - manager->button2.debounceTime) >= BUTTON_DEBOUNCE_TIME_MS) {
-            /* 再次读取GPIO状态确认 */
-            bool isPressed = HAL_GPIO_ReadPin(BUTTON2_GPIO_Port, BUTTON2_Pin) == GPIO_PIN_RESET;
-            
-            /* 如果状态与记录的一致，说明是有效事件 */
-            if (isPressed == manager->button2.debounceState) {
-                if (isPressed && !manager->button2.lastState) {
-                    /* 按下事件 */
-                    event.type = SENSOR_EVENT_BUTTON2_PRESS;
-                    event.timestamp = currentTime;
-                    event.data = 0;
-                    xQueueSend(manager->eventQueue, &event, 0);
-                } else if (!isPressed && manager->button2.lastState) {
-                    /* 释放事件 */
-                    event.type = SENSOR_EVENT_BUTTON2_RELEASE;
-                    event.timestamp = currentTime;
-                    event.data = 0;
-                    xQueueSend(manager->eventQueue, &event, 0);
-                }
-                
-                manager->button2.lastState = isPressed;
-            }
-            
-            /* 清除滤波待检测标志 */
-            manager->button2.debouncePending = false;
-        }
+    if (!ButtonGesture_IsIdle(&manager->buttons)) {
+        return;
+    }
+    
+    /* 与按钮中断互斥：停止命令发出前的新边沿留给下一轮采样 */
+    taskENTER_CRITICAL();
+    if (!manager->buttonEdgePending) {
+        xTimerStop(timer, 0);
+        manager->buttonScanActive = false;
     }
+    taskEXIT_CRITICAL();
 }
 
 /**
- * @brief  下视传感器中断处理（左前）
+ * @brief  共用引脚下视消抖：引脚在稳定时间内有边沿（红外载波）时保持原状态
+ * @retval true=确认的电平发生变化
  */
-void SensorManager_IRQHandler_UnderLeft(void)
+static bool SensorManager_DebounceSharedCliff(GPIO_TypeDef *port, uint16_t pin, uint32_t edgeUs,
+                                              uint32_t nowUs, bool *suspended)
 {
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    SensorEvent_t event;
-    
-    /* 读取GPIO状态（高电平表示悬空） */
-    bool isSuspended = HAL_GPIO_ReadPin(L_FOLLOW_CHECK_SIGNAL_GPIO_Port, L_FOLLOW_CHECK_SIGNAL_Pin) == GPIO_PIN_SET;
-    
-    event.type = SENSOR_EVENT_UNDER_LEFT;
-    event.timestamp = HAL_GetTick();
-    event.data = isSuspended ? 1 : 0;  /* 1=悬空，0=地面 */
-    
-    /* 更新状态 */
-    g_SensorManager.underLeftSuspended = isSuspended;
+    if (nowUs - edgeUs < (uint32_t)SAFETY_SHARED_CLIFF_STABLE_MS * 1000U) return false;
     
-    xQueueSendFromISR(g_SensorManager.eventQueue, &event, &xHigherPriorityTaskWoken);
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    bool level = HAL_GPIO_ReadPin(port, pin) == GPIO_PIN_SET;  /* 高电平表示悬空 */
+    if (level == *suspended) return false;
+    *suspended = level;
+    return true;
 }
 
 /**
- * @brief  下视传感器中断处理（右前）
+ * @brief  采样左/右前下视（电机控制任务每周期在安全反射更新前调用）
+ * @note   确认的电平送安全反射（时间戳为最后一个边沿，延迟统计包含消抖时间），
+ *         变化时投递 SENSOR_EVENT_UNDER_LEFT/RIGHT
  */
-void SensorManager_IRQHandler_UnderRight(void)
+void SensorManager_SampleSharedCliff(SensorManager_t *manager)
 {
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    SensorEvent_t event;
-    
-    /* 读取GPIO状态（高电平表示悬空） */
-    bool isSuspended = HAL_GPIO_ReadPin(R_FOLLOW_CHECK_SIGNAL_GPIO_Port, R_FOLLOW_CHECK_SIGNAL_Pin) == GPIO_PIN_SET;
+    if (manager == NULL) return;
     
-    event.type = SENSOR_EVENT_UNDER_RIGHT;
-    event.timestamp = HAL_GetTick();
-    event.data = isSuspended ? 1 : 0;  /* 1=悬空，0=地面 */
+    uint32_t nowUs = Timebase_GetUs();
+    SensorEvent_t event;
     
-    /* 更新状态 */
-    g_SensorManager.underRightSuspended = isSuspended;
+    uint32_t edgeUs = manager->underLeftEdgeUs;
+    if (SensorManager_DebounceSharedCliff(L_FOLLOW_CHECK_SIGNAL_GPIO_Port, L_FOLLOW_CHECK_SIGNAL_Pin,
+                                          edgeUs, nowUs, &manager->underLeftSuspended)) {
+        SafetyReflex_OnLevel(SAFETY_SRC_CLIFF_LEFT, manager->underLeftSuspended, edgeUs);
+        event.type = SENSOR_EVENT_UNDER_LEFT;
+        event.timestamp = HAL_GetTick();
+        event.data = manager->underLeftSuspended ? 1 : 0;  /* 1=悬空，0=地面 */
+        SensorManager_PostEvent(manager, &event);
+    }
     
-    xQueueSendFromISR(g_SensorManager.eventQueue, &event, &xHigherPriorityTaskWoken);
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    edgeUs = manager->underRightEdgeUs;
+    if (SensorManager_DebounceSharedCliff(R_FOLLOW_CHECK_SIGNAL_GPIO_Port, R_FOLLOW_CHECK_SIGNAL_Pin,
+                                          edgeUs, nowUs, &manager->underRightSuspended)) {
+        SafetyReflex_OnLevel(SAFETY_SRC_CLIFF_RIGHT, manager->underRightSuspended, edgeUs);
+        event.type = SENSOR_EVENT_UNDER_RIGHT;
+        event.timestamp = HAL_GetTick();
+        event.data = manager->underRightSuspended ? 1 : 0;
+        SensorManager_PostEvent(manager, &event);
+    }
 }
 
 /**
@@ -392,12 +443,14 @@ void SensorManager_IRQHandler_UnderRight(void)
  */
 void SensorManager_IRQHandler_UnderCenter(void)
 {
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
     SensorEvent_t event;
     
     /* 读取GPIO状态（高电平表示悬空） */
     bool isSuspended = HAL_GPIO_ReadPin(S_FOLLOW_CHECK_SIGNAL_GPIO_Port, S_FOLLOW_CHECK_SIGNAL_Pin) == GPIO_PIN_SET;
     
+    /* 安全反射：直接唤醒电机控制任务 */
+    SafetyReflex_OnEdgeFromISR(SAFETY_SRC_CLIFF_CENTER, isSuspended, Timebase_GetUs());
+    
     event.type = SENSOR_EVENT_UNDER_CENTER;
     event.timestamp = HAL_GetTick();
     event.data = isSuspended ? 1 : 0;  /* 1=悬空，0=地面 */
@@ -405,8 +458,7 @@ void SensorManager_IRQHandler_UnderCenter(void)
     /* 更新状态 */
     g_SensorManager.underCenterSuspended = isSuspended;
     
-    xQueueSendFromISR(g_SensorManager.eventQueue, &event, &xHigherPriorityTaskWoken);
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    SensorManager_PostEventFromISR(&event);
 }
 
 /**
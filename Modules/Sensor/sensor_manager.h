@@ -15,12 +15,23 @@ extern "C" {
 #endif
 
 #include "cleanbot_config.h"
+#include "ir_capture.h"
+#include "button_gesture.h"
 #include <stdint.h>
 #include <stdbool.h>
 
+/* 红外接收头数量（与 IR_SensorType_t 顺序一致） */
+#define SENSOR_MANAGER_IR_COUNT    4
+
+/* 按键数量（与按键定义表顺序一致） */
+#define SENSOR_MANAGER_BUTTON_COUNT 2
+
+/* 事件队列深度 */
+#define SENSOR_EVENT_QUEUE_LENGTH  32
+
 /* 传感器事件类型 */
 typedef enum {
-    SENSOR_EVENT_IR_LEFT = 0,          /* 左侧红外传感器事件 */
+    SENSOR_EVENT_IR_LEFT = 0,          /* 左侧红外传感器事件（data为解码后的NEC 32位编码） */
     SENSOR_EVENT_IR_RIGHT,             /* 右侧红外传感器事件 */
     SENSOR_EVENT_IR_FRONT_LEFT,        /* 左前红外传感器事件 */
     SENSOR_EVENT_IR_FRONT_RIGHT,       /* 右前红外传感器事件 */
@@ -34,6 +45,8 @@ typedef enum {
     SENSOR_EVENT_BUTTON1_DOUBLE_CLICK, /* 按钮1双击事件 */
     SENSOR_EVENT_BUTTON2_CLICK,        /* 按钮2单击事件 */
     SENSOR_EVENT_BUTTON2_DOUBLE_CLICK, /* 按钮2双击事件 */
+    SENSOR_EVENT_BUTTON1_LONG_PRESS,   /* 按钮1长按事件（data为判定时的按住时长ms） */
+    SENSOR_EVENT_BUTTON2_LONG_PRESS,   /* 按钮2长按事件 */
     SENSOR_EVENT_UNDER_LEFT,           /* 左前下视传感器事件 */
     SENSOR_EVENT_UNDER_RIGHT,          /* 右前下视传感器事件 */
     SENSOR_EVENT_UNDER_CENTER          /* 中间下视传感器事件 */
@@ -43,7 +56,7 @@ typedef enum {
 typedef struct {
     SensorEventType_t type;    /* 事件类型 */
     uint32_t timestamp;        /* 时间戳 */
-    uint32_t data;             /* 事件数据（如NEC命令码） */
+    uint32_t data;             /* 事件数据（如NEC编码：地址|命令<<8|地址反码<<16|命令反码<<24） */
 } SensorEvent_t;
 
 /* 传感器管理器结构体 */
@@ -51,33 +64,40 @@ typedef struct {
     /* 事件队列 */
     QueueHandle_t eventQueue;
     
-    /* 按钮状态 */
-    struct {
-        uint32_t pressTime;        /* 按下时间 */
-        uint32_t releaseTime;      /* 释放时间 */
-        bool isPressed;            /* 是否按下 */
-        bool lastState;            /* 上次状态 */
-        uint32_t clickCount;       /* 单击计数 */
-        uint32_t lastClickTime;    /* 上次单击时间 */
-        bool debouncePending;      /* 滤波待检测标志 */
-        uint32_t debounceTime;     /* 滤波触发时间 */
-        bool debounceState;        /* 滤波待检测状态 */
-    } button1, button2;
+    /* 事件队列统计 */
+    volatile uint32_t eventPostCount;  /* 投递成功事件数 */
+    volatile uint32_t eventDropCount;  /* 队列满丢弃事件数 */
+    volatile uint8_t eventHighWater;   /* 队列最高占用 */
+    uint8_t eventBatchMax;             /* 任务单次唤醒处理的最多事件数 */
+    
+    /* 按键手势识别（软件定时器周期采样，全部按键空闲时停止） */
+    ButtonGesture_t buttons;
+    TimerHandle_t buttonTimer;
+    volatile bool buttonScanActive;    /* 采样定时器已启动 */
+    volatile bool buttonEdgePending;   /* 本轮采样后又有按键边沿 */
+    uint32_t buttonScanCount;          /* 采样次数（空闲时不增长） */
     
     /* 传感器状态 */
     bool photoGateLeftBlocked;     /* 左侧光电门被遮挡 */
     bool photoGateRightBlocked;    /* 右侧光电门被遮挡 */
     
-    /* 下视传感器状态 */
+    /* 下视传感器状态（左/右前为消抖后的电平） */
     bool underLeftSuspended;       /* 左前下视传感器悬空（高电平） */
     bool underRightSuspended;       /* 右前下视传感器悬空（高电平） */
     bool underCenterSuspended;     /* 中间下视传感器悬空（高电平） */
     
+    /* 左/右前下视与前红外接收头共用引脚：中断只记最近边沿时间，电平由电机控制任务消抖 */
+    volatile uint32_t underLeftEdgeUs;
+    volatile uint32_t underRightEdgeUs;
+    
+    /* 红外边沿捕获缓冲（中断写入，任务批量解码） */
+    IRCapture_t irCapture[SENSOR_MANAGER_IR_COUNT];
+    
     /* NEC解码数据 */
     struct {
         bool dataReady;            /* 数据就绪 */
         NEC_Data_t necData;        /* NEC数据 */
-    } irSensors[4];
+    } irSensors[SENSOR_MANAGER_IR_COUNT];
     
     bool enabled;                  /* 使能标志 */
 } SensorManager_t;
@@ -96,15 +116,23 @@ void SensorManager_IRQHandler_PhotoGate_Left(void);
 void SensorManager_IRQHandler_PhotoGate_Right(void);
 void SensorManager_IRQHandler_Button1(void);
 void SensorManager_IRQHandler_Button2(void);
-void SensorManager_IRQHandler_UnderLeft(void);
-void SensorManager_IRQHandler_UnderRight(void);
 void SensorManager_IRQHandler_UnderCenter(void);
 
+/* 采样共用引脚的左/右前下视，电平保持 SAFETY_SHARED_CLIFF_STABLE_MS 后确认，
+   变化时送安全反射并投递下视事件（电机控制任务每周期调用） */
+void SensorManager_SampleSharedCliff(SensorManager_t *manager);
+
 /* 获取事件（在Sensor任务中调用） */
 bool SensorManager_GetEvent(SensorManager_t *manager, SensorEvent_t *event, uint32_t timeout);
 
-/* 按钮滤波检测（在Sensor任务中定期调用） */
-void SensorManager_CheckButtonDebounce(SensorManager_t *manager);
+/* 投递事件（任务上下文，带队列统计） */
+bool SensorManager_PostEvent(SensorManager_t *manager, const SensorEvent_t *event);
+
+/* 红外边沿批量解码，成功的编码投递事件队列（在Sensor任务中定期调用） */
+uint8_t SensorManager_ProcessIR(SensorManager_t *manager, uint8_t index, NEC_Decoder_t *decoder);
+
+/* 屏蔽/恢复红外接收头 EXTI（停靠低功耗模式） */
+void SensorManager_SetIRCaptureEnabled(SensorManager_t *manager, bool enabled);
 
 /* 获取全局传感器管理器实例 */
 SensorManager_t* SensorManager_GetInstance(void);
@@ -0,0 +1,391 @@
+/**
+  ******************************************************************************
+  * @file    supervisor.c
+  * @brief   任务看门狗监督实现（任务心跳、IWDG 喂狗与故障快照）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "supervisor.h"
+#include "system_config.h"
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mem_section.h"
+#include "blackbox.h"
+#include <stddef.h>  /* 定义NULL */
+#include <string.h>
+
+/* 快照有效标志 */
+#define SUPERVISOR_MAGIC            0x53555056U     /* "SUPV" */
+
+/* 快照位于备份 SRAM 起始处 */
+#define SUPERVISOR_BKP_SNAPSHOT     ((SupervisorSnapshot_t *)BKPSRAM_BASE)
+
+/* IWDG 键值与 LSI 标称频率 */
+#define SUPERVISOR_IWDG_KEY_RELOAD  0xAAAAU
+#define SUPERVISOR_IWDG_KEY_UNLOCK  0x5555U
+#define SUPERVISOR_IWDG_KEY_START   0xCCCCU
+#define SUPERVISOR_IWDG_RELOAD_MAX  0x1000U
+#define SUPERVISOR_LSI_HZ           32000U
+
+/* 全局监督实例 */
+CCM_DATA static Supervisor_t g_Supervisor;
+
+/* 各任务签到超时 (ms)，下标为 SupervisorTask_t */
+static const uint16_t s_timeoutMs[SUPERVISOR_TASK_COUNT] = {
+    WATCHDOG_SENSOR_TIMEOUT_MS,
+    WATCHDOG_MOTOR_TIMEOUT_MS,
+    WATCHDOG_USB_TIMEOUT_MS,
+    WATCHDOG_IMU_TIMEOUT_MS,
+};
+
+/**
+  * @brief  快照校验和（magic、checksum 之后的所有字节）
+  */
+static uint32_t Supervisor_Checksum(const SupervisorSnapshot_t *snapshot)
+{
+    const uint8_t *data = (const uint8_t *)snapshot + offsetof(SupervisorSnapshot_t, count);
+    uint32_t len = sizeof(SupervisorSnapshot_t) - offsetof(SupervisorSnapshot_t, count);
+    uint32_t sum = 5381U;
+
+    for (uint32_t i = 0; i < len; i++) {
+        sum = sum * 33U + data[i];
+    }
+    return sum;
+}
+
+static bool Supervisor_SnapshotValid(const SupervisorSnapshot_t *snapshot)
+{
+    return snapshot->magic == SUPERVISOR_MAGIC && snapshot->checksum == Supervisor_Checksum(snapshot);
+}
+
+/**
+  * @brief  读取并清除复位原因标志
+  */
+static uint8_t Supervisor_ReadResetFlags(void)
+{
+    uint32_t csr = RCC->CSR;
+    uint8_t flags = 0;
+
+    if ((csr & (RCC_CSR_PORRSTF | RCC_CSR_BORRSTF)) != 0U) flags |= SUPERVISOR_RESET_POWER;
+    if ((csr & RCC_CSR_PINRSTF) != 0U) flags |= SUPERVISOR_RESET_PIN;
+    if ((csr & RCC_CSR_SFTRSTF) != 0U) flags |= SUPERVISOR_RESET_SOFTWARE;
+    if ((csr & RCC_CSR_IWDGRSTF) != 0U) flags |= SUPERVISOR_RESET_IWDG;
+    if ((csr & RCC_CSR_WWDGRSTF) != 0U) flags |= SUPERVISOR_RESET_WWDG;
+    if ((csr & RCC_CSR_LPWRRSTF) != 0U) flags |= SUPERVISOR_RESET_LOW_POWER;
+
+    RCC->CSR |= RCC_CSR_RMVF;
+    return flags;
+}
+
+/**
+  * @brief  启动 IWDG（启动后不能停止）
+  * @param  timeoutMs: 超时时间，按 LSI 标称频率取能容纳的最小分频
+  */
+static void Supervisor_StartIwdg(uint32_t timeoutMs)
+{
+    uint32_t prescaler = 0U;    /* 分频 4 << prescaler */
+    uint32_t reload = timeoutMs * (SUPERVISOR_LSI_HZ / 1000U) / 4U;
+
+    while (reload > SUPERVISOR_IWDG_RELOAD_MAX && prescaler < 6U) {
+        prescaler++;
+        reload >>= 1;
+    }
+    if (reload > SUPERVISOR_IWDG_RELOAD_MAX) reload = SUPERVISOR_IWDG_RELOAD_MAX;
+    if (reload == 0U) reload = 1U;
+
+    /* 调试器暂停内核时冻结 IWDG，断点不会触发复位 */
+    DBGMCU->APB1FZ |= DBGMCU_APB1_FZ_DBG_IWDG_STOP;
+
+    IWDG->KR = SUPERVISOR_IWDG_KEY_START;
+    IWDG->KR = SUPERVISOR_IWDG_KEY_UNLOCK;
+    IWDG->PR = prescaler;
+    IWDG->RLR = reload - 1U;
+    while ((IWDG->SR & (IWDG_SR_PVU | IWDG_SR_RVU)) != 0U) {
+    }
+    IWDG->KR = SUPERVISOR_IWDG_KEY_RELOAD;
+    g_Supervisor.iwdgRunning = true;
+}
+
+#if defined(__ARM_ARCH_7EM__)
+/**
+  * @brief  任务的硬件压栈帧（r0-r3, r12, lr, pc, xpsr）
+  * @note   在 SysTick 中调用：当前任务的帧在 PSP；已切出的任务由 PendSV 在
+  *         pxTopOfStack（TCB 首成员）处保存 r4-r11 与 EXC_RETURN，用过 FPU
+  *         时其后还有 s16-s31，再往上才是硬件压栈帧（RVDS ARM_CM4F 端口）
+  */
+static const uint32_t* Supervisor_TaskFrame(TaskHandle_t task)
+{
+    if (task == xTaskGetCurrentTaskHandle()) {
+        return (const uint32_t *)__get_PSP();
+    }
+
+    const uint32_t *sp = *(const uint32_t * const *)task;
+    uint32_t excReturn = sp[8];
+    sp += 9U;
+    if ((excReturn & 0x10U) == 0U) {
+        sp += 16U;
+    }
+    return sp;
+}
+#endif
+
+/**
+  * @brief  关断电机PWM输出（轮电机 TIM4，边刷/风机/水泵 TIM3，见 CleanBotApp_Init）
+  * @note   心跳超时与故障路径的第一步，先于快照和黑匣子 Flash 转储（数十 ms）；
+  *         清 CCER 通道使能立即生效（引脚输出低，H桥滑行）；比较值同时清零，
+  *         预装载下一周期生效，防止其他代码再次使能通道后恢复旧占空比
+  */
+static void Supervisor_ForceOutputsSafe(void)
+{
+    const uint32_t ccerMask = TIM_CCER_CC1E | TIM_CCER_CC2E | TIM_CCER_CC3E | TIM_CCER_CC4E;
+    TIM_TypeDef *const tims[] = { TIM4, TIM3 };
+
+    for (uint32_t i = 0; i < sizeof(tims) / sizeof(tims[0]); i++) {
+        tims[i]->CCER &= ~ccerMask;
+        tims[i]->CCR1 = 0U;
+        tims[i]->CCR2 = 0U;
+        tims[i]->CCR3 = 0U;
+        tims[i]->CCR4 = 0U;
+    }
+}
+
+/**
+  * @brief  写入故障快照（中断/故障上下文中调用，调用前已关断电机输出）
+  */
+static void Supervisor_Record(uint8_t reason, uint8_t task, uint8_t missMask, const uint32_t *frame)
+{
+    Supervisor_t *sv = &g_Supervisor;
+    SupervisorSnapshot_t *snap = SUPERVISOR_BKP_SNAPSHOT;
+    uint32_t now = HAL_GetTick();
+    uint16_t count = Supervisor_SnapshotValid(snap) ? snap->count : 0U;
+
+    memset(snap, 0, sizeof(SupervisorSnapshot_t));
+    snap->count = (count < UINT16_MAX) ? (uint16_t)(count + 1U) : count;
+    snap->reason = reason;
+    snap->task = task;
+    snap->missMask = missMask;
+    snap->uptimeMs = now;
+    if (frame != NULL) {
+        snap->lr = frame[5];
+        snap->pc = frame[6];
+        snap->psr = frame[7];
+    }
+
+    snap->cfsr = SCB->CFSR;
+    snap->hfsr = SCB->HFSR;
+    if ((snap->cfsr & SCB_CFSR_MMARVALID_Msk) != 0U) {
+        snap->faultAddr = SCB->MMFAR;
+    } else if ((snap->cfsr & SCB_CFSR_BFARVALID_Msk) != 0U) {
+        snap->faultAddr = SCB->BFAR;
+    }
+
+    if (sv->setpointSource != NULL) {
+        sv->setpointSource(&snap->setpoints);
+    }
+
+    for (uint32_t i = 0; i < SUPERVISOR_TASK_COUNT; i++) {
+        uint32_t age = now - sv->lastBeatMs[i];
+        snap->beatAgeMs[i] = (age < UINT16_MAX) ? (uint16_t)age : UINT16_MAX;
+        if (sv->threads[i] != NULL) {
+            UBaseType_t words = uxTaskGetStackHighWaterMark((TaskHandle_t)sv->threads[i]);
+            snap->stackFreeWords[i] = (words < UINT16_MAX) ? (uint16_t)words : UINT16_MAX;
+        }
+    }
+
+    const char *running = "main";
+    if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED) {
+        running = pcTaskGetName(NULL);
+    }
+    strncpy(snap->runningTask, running, SUPERVISOR_NAME_LEN);
+
+    snap->checksum = Supervisor_Checksum(snap);
+    snap->magic = SUPERVISOR_MAGIC;
+
+    /* 快照之后把黑匣子 RAM 环写入 Flash（耗时数十 ms，随后即复位） */
+    BlackBox_OnFault(reason);
+}
+
+/**
+  * @brief  签到超时：记录超时任务的现场
+  * @note   当前运行的任务也超时则优先记录它（死循环），否则记录编号最小的
+  *         超时任务停在何处（阻塞点或被抢占点）
+  */
+static void Supervisor_RecordHang(uint8_t missMask)
+{
+    Supervisor_t *sv = &g_Supervisor;
+    uint8_t task = SUPERVISOR_TASK_NONE;
+    const uint32_t *frame = NULL;
+    TaskHandle_t current = xTaskGetCurrentTaskHandle();
+
+    for (uint32_t i = 0; i < SUPERVISOR_TASK_COUNT; i++) {
+        if ((missMask & (1U << i)) == 0U) continue;
+        if (task == SUPERVISOR_TASK_NONE || (TaskHandle_t)sv->threads[i] == current) {
+            task = (uint8_t)i;
+        }
+    }
+
+#if defined(__ARM_ARCH_7EM__)
+    if (task != SUPERVISOR_TASK_NONE && sv->threads[task] != NULL) {
+        frame = Supervisor_TaskFrame((TaskHandle_t)sv->threads[task]);
+    }
+#endif
+
+    Supervisor_Record(SUPERVISOR_REASON_HEARTBEAT, task, missMask, frame);
+}
+
+/**
+  * @brief  初始化监督（SystemClock_Config 之后、外设初始化之前调用）
+  * @note   取回上次留下的快照并记录复位原因，然后启动 IWDG；
+  *         各任务签到时间从此刻起算，未启动的任务同样会超时
+  */
+void Supervisor_Init(void)
+{
+    Supervisor_t *sv = &g_Supervisor;
+
+    memset(sv, 0, sizeof(Supervisor_t));
+
+    /* 备份 SRAM：PWR 时钟、备份域写使能、BKPSRAM 时钟 */
+    __HAL_RCC_PWR_CLK_ENABLE();
+    HAL_PWR_EnableBkUpAccess();
+    __HAL_RCC_BKPSRAM_CLK_ENABLE();
+
+    sv->resetFlags = Supervisor_ReadResetFlags();
+    if (Supervisor_SnapshotValid(SUPERVISOR_BKP_SNAPSHOT)) {
+        sv->snapshot = *SUPERVISOR_BKP_SNAPSHOT;
+        sv->hasSnapshot = true;
+    }
+
+    uint32_t now = HAL_GetTick();
+    for (uint32_t i = 0; i < SUPERVISOR_TASK_COUNT; i++) {
+        sv->lastBeatMs[i] = now;
+    }
+    sv->lastCheckMs = now;
+
+#if WATCHDOG_ENABLE
+    Supervisor_StartIwdg(WATCHDOG_TIMEOUT_MS);
+#endif
+}
+
+/**
+  * @brief  获取全局监督实例
+  */
+Supervisor_t* Supervisor_GetInstance(void)
+{
+    return &g_Supervisor;
+}
+
+/**
+  * @brief  登记任务线程（快照中读取其栈余量与现场）
+  */
+void Supervisor_RegisterTask(SupervisorTask_t task, osThreadId_t thread)
+{
+    if (task >= SUPERVISOR_TASK_COUNT) return;
+
+    g_Supervisor.threads[task] = thread;
+    g_Supervisor.lastBeatMs[task] = HAL_GetTick();
+}
+
+/**
+  * @brief  任务签到
+  */
+void Supervisor_Heartbeat(SupervisorTask_t task)
+{
+    if (task >= SUPERVISOR_TASK_COUNT) return;
+
+    g_Supervisor.lastBeatMs[task] = HAL_GetTick();
+}
+
+/**
+  * @brief  登记控制设定值来源（电机控制任务）
+  */
+void Supervisor_SetSetpointSource(SupervisorSetpointFn_t source)
+{
+    g_Supervisor.setpointSource = source;
+}
+
+/**
+  * @brief  节拍钩子：检查签到，全部正常才喂狗
+  * @note   tickless 睡眠期间不调用，睡眠时长受各任务最长等待限制，
+  *         远小于 IWDG 超时
+  */
+void Supervisor_TickHook(void)
+{
+    Supervisor_t *sv = &g_Supervisor;
+    uint32_t now = HAL_GetTick();
+
+    if (sv->tripped || (now - sv->lastCheckMs) < WATCHDOG_CHECK_MS) return;
+    sv->lastCheckMs = now;
+
+    uint8_t missMask = 0;
+    for (uint32_t i = 0; i < SUPERVISOR_TASK_COUNT; i++) {
+        if ((now - sv->lastBeatMs[i]) > s_timeoutMs[i]) {
+            missMask |= (uint8_t)(1U << i);
+        }
+    }
+
+    if (missMask != 0U) {
+        /* 只记录第一次超时：先关断电机输出再记录现场，此后不再喂狗 */
+        sv->tripped = true;
+        Supervisor_ForceOutputsSafe();
+        Supervisor_RecordHang(missMask);
+        return;
+    }
+
+    if (sv->iwdgRunning) {
+        IWDG->KR = SUPERVISOR_IWDG_KEY_RELOAD;
+    }
+}
+
+/**
+  * @brief  读取上次留下的快照
+  * @retval 无快照返回 false
+  */
+bool Supervisor_GetSnapshot(SupervisorSnapshot_t *snapshot)
+{
+    if (snapshot == NULL || !g_Supervisor.hasSnapshot) return false;
+
+    *snapshot = g_Supervisor.snapshot;
+    return true;
+}
+
+/**
+  * @brief  本次上电的复位原因（SUPERVISOR_RESET_xxx）
+  */
+uint8_t Supervisor_GetResetFlags(void)
+{
+    return g_Supervisor.resetFlags;
+}
+
+/**
+  * @brief  清除快照（上位机读取后）
+  */
+void Supervisor_ClearSnapshot(void)
+{
+    SUPERVISOR_BKP_SNAPSHOT->magic = 0U;
+    g_Supervisor.hasSnapshot = false;
+}
+
+/**
+  * @brief  故障异常：关断电机输出，记录压栈帧与故障状态后立即复位
+  */
+void Supervisor_OnFault(const uint32_t *frame, uint32_t reason)
+{
+    Supervisor_ForceOutputsSafe();
+    Supervisor_Record((uint8_t)reason, SUPERVISOR_TASK_NONE, 0U, frame);
+    NVIC_SystemReset();
+}
+
+/**
+  * @brief  Error_Handler：关断电机输出，记录调用处地址，随后关中断停机由 IWDG 复位
+  */
+void Supervisor_OnError(uint32_t callerPc)
+{
+    uint32_t frame[8] = {0};
+
+    frame[6] = callerPc;
+    Supervisor_ForceOutputsSafe();
+    Supervisor_Record(SUPERVISOR_REASON_ERROR, SUPERVISOR_TASK_NONE, 0U, frame);
+}
@@ -0,0 +1,156 @@
+/**
+  ******************************************************************************
+  * @file    supervisor.h
+  * @brief   任务看门狗监督头文件（任务心跳、IWDG 喂狗与故障快照）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 各任务在主循环中调用 Supervisor_Heartbeat 签到，事件驱动的任务等待时间
+  * 不超过 WATCHDOG_CHECKIN_MS。FreeRTOS 节拍钩子每 WATCHDOG_CHECK_MS 检查
+  * 一次各任务签到间隔，全部在各自超时内才喂独立看门狗 IWDG；任一任务超时
+  * 后不再喂狗，由 IWDG 复位。钩子运行在 SysTick 中断中，高优先级任务死循环
+  * 把其他任务饿死时也能检测到。
+  *
+  * 心跳超时、HardFault/MemManage/BusFault/UsageFault 与 Error_Handler 首先
+  * 关断电机PWM输出，再把一份快照写入备份 SRAM（BKPSRAM，复位后保留）：
+  * 原因、超时任务、PC/LR、故障状态寄存器、运行中的任务名、最后的控制设定
+  * 值、各任务栈余量与签到间隔。下次上电由 USB 0x2E 上报，上位机 0x15 清除。
+  * 快照之后把黑匣子 RAM 环转储到 Flash（见 blackbox.h，约 70ms）。
+  ******************************************************************************
+  */
+
+#ifndef __SUPERVISOR_H__
+#define __SUPERVISOR_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cmsis_os.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 快照中任务名长度（超出截断） */
+#define SUPERVISOR_NAME_LEN         12U
+
+/* 快照中无对应任务 */
+#define SUPERVISOR_TASK_NONE        0xFFU
+
+/* 受监督的任务 */
+typedef enum {
+    SUPERVISOR_TASK_SENSOR = 0,
+    SUPERVISOR_TASK_MOTOR,
+    SUPERVISOR_TASK_USB,
+    SUPERVISOR_TASK_IMU,
+    SUPERVISOR_TASK_COUNT
+} SupervisorTask_t;
+
+/* 快照原因 */
+typedef enum {
+    SUPERVISOR_REASON_NONE = 0,
+    SUPERVISOR_REASON_HEARTBEAT,    /* 任务签到超时 */
+    SUPERVISOR_REASON_HARDFAULT,
+    SUPERVISOR_REASON_MEMMANAGE,
+    SUPERVISOR_REASON_BUSFAULT,
+    SUPERVISOR_REASON_USAGEFAULT,
+    SUPERVISOR_REASON_ERROR         /* Error_Handler */
+} SupervisorReason_t;
+
+/* 复位原因（RCC->CSR 折算） */
+#define SUPERVISOR_RESET_POWER      (1U << 0)   /* 上电/掉电复位 */
+#define SUPERVISOR_RESET_PIN        (1U << 1)   /* NRST 引脚 */
+#define SUPERVISOR_RESET_SOFTWARE   (1U << 2)   /* NVIC_SystemReset */
+#define SUPERVISOR_RESET_IWDG       (1U << 3)
+#define SUPERVISOR_RESET_WWDG       (1U << 4)
+#define SUPERVISOR_RESET_LOW_POWER  (1U << 5)
+
+/* 最后的控制设定值 */
+typedef struct {
+    float leftSpeedMs;              /* 左轮目标速度 (m/s) */
+    float rightSpeedMs;             /* 右轮目标速度 (m/s) */
+    float linearMs;                 /* 目标线速度 (m/s) */
+    float angularRadS;              /* 目标角速度 (rad/s) */
+    uint8_t brushLeft;              /* 边刷/水泵/风机档位 */
+    uint8_t brushRight;
+    uint8_t pump;
+    uint8_t fan;
+} SupervisorSetpoints_t;
+
+/* 设定值来源（故障上下文中调用，只允许读取静态变量） */
+typedef void (*SupervisorSetpointFn_t)(SupervisorSetpoints_t *setpoints);
+
+/* 故障快照（位于备份 SRAM） */
+typedef struct {
+    uint32_t magic;
+    uint32_t checksum;              /* magic、checksum 之后所有字节 */
+    uint16_t count;                 /* 清除以来的快照次数（保留最近一次） */
+    uint8_t reason;                 /* SupervisorReason_t */
+    uint8_t task;                   /* 超时任务（SupervisorTask_t），其他原因为 SUPERVISOR_TASK_NONE */
+    uint8_t missMask;               /* 超时任务位图 */
+    uint8_t reserved[3];
+    uint32_t uptimeMs;
+    uint32_t pc;                    /* 故障/超时任务的 PC、LR、xPSR */
+    uint32_t lr;
+    uint32_t psr;
+    uint32_t cfsr;                  /* SCB 故障状态 */
+    uint32_t hfsr;
+    uint32_t faultAddr;             /* MMFAR/BFAR（有效时） */
+    SupervisorSetpoints_t setpoints;
+    uint16_t stackFreeWords[SUPERVISOR_TASK_COUNT];  /* 栈历史最小余量 (word) */
+    uint16_t beatAgeMs[SUPERVISOR_TASK_COUNT];       /* 快照时距上次签到 (ms) */
+    char runningTask[SUPERVISOR_NAME_LEN];           /* 快照时正在运行的任务 */
+} SupervisorSnapshot_t;
+
+/* 监督对象 */
+typedef struct {
+    osThreadId_t threads[SUPERVISOR_TASK_COUNT];
+    volatile uint32_t lastBeatMs[SUPERVISOR_TASK_COUNT];
+    uint32_t lastCheckMs;
+    bool tripped;                   /* 已有任务超时，停止喂狗等待复位 */
+    bool iwdgRunning;
+    SupervisorSetpointFn_t setpointSource;
+
+    /* 本次上电的复位原因与上次留下的快照 */
+    uint8_t resetFlags;
+    bool hasSnapshot;
+    SupervisorSnapshot_t snapshot;
+} Supervisor_t;
+
+/* 函数声明 */
+void Supervisor_Init(void);                 /* SystemClock_Config 之后调用，启动 IWDG */
+Supervisor_t* Supervisor_GetInstance(void);
+void Supervisor_RegisterTask(SupervisorTask_t task, osThreadId_t thread);
+void Supervisor_Heartbeat(SupervisorTask_t task);
+void Supervisor_SetSetpointSource(SupervisorSetpointFn_t source);
+void Supervisor_TickHook(void);             /* vApplicationTickHook 中调用 */
+
+/* 上次快照与本次复位原因（USB 上报），清除备份 SRAM 中的快照 */
+bool Supervisor_GetSnapshot(SupervisorSnapshot_t *snapshot);
+uint8_t Supervisor_GetResetFlags(void);
+void Supervisor_ClearSnapshot(void);
+
+/* 故障入口：frame 为异常压栈帧（r0-r3, r12, lr, pc, xpsr），记录后复位 */
+void Supervisor_OnFault(const uint32_t *frame, uint32_t reason);
+/* Error_Handler 中调用：记录调用处地址，由 IWDG 复位 */
+void Supervisor_OnError(uint32_t callerPc);
+
+/**
+  * @brief  故障异常处理入口，放在 xxx_Handler 的第一条语句
+  * @note   按 EXC_RETURN 选择 MSP/PSP 取压栈帧后跳转 Supervisor_OnFault。
+  *         处理函数中不得有其他语句，避免编译器生成压栈序言改变 MSP。
+  */
+#define SUPERVISOR_FAULT_ENTRY(reason)                      \
+    __asm volatile("tst lr, #4          \n"                 \
+                   "ite eq              \n"                 \
+                   "mrseq r0, msp       \n"                 \
+                   "mrsne r0, psp       \n"                 \
+                   "movs r1, %0         \n"                 \
+                   "b Supervisor_OnFault\n"                 \
+                   : : "i"(reason) : "r0", "r1")
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SUPERVISOR_H__ */
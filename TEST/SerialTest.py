@@ -18,10 +18,39 @@ from PySide6.QtWidgets import (
 HEADER = b'\x55\xAA'
 VERSION = 0x01
 MSG_CONTROL_CMD = 0x10
+MSG_TRAJ_APPEND = 0x11
+MSG_TRAJ_CONTROL = 0x12
 MSG_IMU = 0x20
 MSG_WHEEL = 0x21
 MSG_SENSOR = 0x22
+MSG_SYSTEM_STATUS = 0x23
 MSG_ACK = 0x24
+MSG_ACTUATOR = 0x25
+MSG_TRAJ_STATUS = 0x26
+MSG_MOTOR_DIAG = 0x27
+MSG_IR_STATS = 0x28
+MSG_SAFETY_STATUS = 0x29
+MSG_HOMING_STATUS = 0x2A
+
+RAMP_CHANNELS = ["ramp_brush_l", "ramp_brush_r", "ramp_pump", "ramp_fan"]
+TRAJ_STATES = ["IDLE", "LOADED", "RUNNING", "UNDERRUN", "DONE"]
+IR_RECEIVERS = ["ir_l", "ir_r", "ir_fl", "ir_fr"]
+SAFETY_STATES = ["IDLE", "STOP", "BACKOFF", "TURN", "HOLD"]
+SAFETY_SOURCES = ["BUMP_L", "BUMP_R", "CLIFF_L", "CLIFF_C", "CLIFF_R"]
+HOMING_STATES = ["IDLE", "SEARCH", "APPROACH", "ALIGN", "DOCKING", "DOCKED", "FAILED", "TIMEOUT"]
+BEACON_CODES = ["0x17", "0x65", "0x9A", "0xB4", "其他"]
+TASK_STATES = ["RUN", "READY", "BLOCK", "SUSP", "DEL"]
+TASK_NAME_LEN = 16       # configMAX_TASK_NAME_LEN
+STACK_WARN_WORDS = 32    # 栈历史最小剩余低于该值时标红
+
+
+def wheel_fault_text(bits):
+    names = [name for bit, name in ((0x01, "STALL"), (0x02, "SLIP"), (0x04, "JAM")) if bits & bit]
+    return "|".join(names) if names else "OK"
+
+def safety_source_text(bits):
+    names = [name for i, name in enumerate(SAFETY_SOURCES) if bits & (1 << i)]
+    return "|".join(names) if names else "-"
 
 WORK_MODES = [
     ("Idle", 0),
@@ -42,6 +71,9 @@ TARGET_FREQ = {
 }
 MAX_PAYLOAD_LEN = 128
 
+# CONTROL_CMD 标志字节（payload[14]）
+CTRL_FLAG_VELOCITY_MODE = 0x01  # 左/右速度字段解释为 v (m/s) / ω (rad/s)
+
 # CRC16-CCITT
 def crc16_ccitt(data, init=0xFFFF):
     crc = init
@@ -71,6 +103,7 @@ class SerialWorker(QObject):
         self._reset_parser()
         self.last_seq = defaultdict(lambda: None)
         self.ack_wait = {}
+        self.task_rows = []      # SYSTEM_STATUS 分帧拼接
         self.lock = threading.Lock()
 
     def start(self):
@@ -238,6 +271,70 @@ class SerialWorker(QObject):
                     "dock_status": payload[7],
                     "reserved": payload[8]
                 }
+            if msg_id == MSG_ACTUATOR and len(payload) == 17:
+                vals = struct.unpack('<8HB', payload)
+                data = {}
+                for i, key in enumerate(RAMP_CHANNELS):
+                    data[key] = f"{vals[i * 2 + 1]}/{vals[i * 2]}"
+                data["ramp_heavy"] = "-" if vals[8] == 0xFF else RAMP_CHANNELS[vals[8]] if vals[8] < 4 else vals[8]
+                return data
+            if msg_id == MSG_TRAJ_STATUS and len(payload) == 14:
+                state, ttype, count, buffered_ms, next_index, executed, underruns = \
+                    struct.unpack('<BBHHHIH', payload)
+                return {
+                    "traj_state": TRAJ_STATES[state] if state < len(TRAJ_STATES) else state,
+                    "traj_buffer": f"{count} 点 / {buffered_ms} ms",
+                    "traj_progress": f"next={next_index} exec={executed} ({'v/ω' if ttype else 'wheel'})",
+                    "traj_underrun": underruns,
+                }
+            if msg_id == MSG_MOTOR_DIAG and len(payload) == 38:
+                vals = struct.unpack('<hfffBhfffBff', payload)
+                data = {}
+                for side, base in (("l", 0), ("r", 5)):
+                    duty, target, meas, model, faults = vals[base:base + 5]
+                    data[f"diag_{side}"] = (f"duty={duty} tgt={target:.2f} meas={meas:.2f} "
+                                            f"model={model:.2f} {wheel_fault_text(faults)}")
+                data["diag_yaw"] = f"imu={vals[10]:.2f} odom={vals[11]:.2f}"
+                return data
+            if msg_id == MSG_IR_STATS and len(payload) == 76:
+                data = {}
+                for i, key in enumerate(IR_RECEIVERS):
+                    edges, frames, ok, errors, dropped = struct.unpack_from('<IHHHH', payload, i * 12)
+                    repeats, timeouts, jitter, margin = struct.unpack_from('<HHBB', payload, 52 + i * 6)
+                    rate = 100.0 * ok / frames if frames else 0.0
+                    data[key] = (f"{ok}/{frames} ({rate:.0f}%) err={errors} edges={edges} drop={dropped} "
+                                 f"rep={repeats} tmo={timeouts} jit={jitter}us margin={margin}%")
+                high_water, batch_max, event_drops = struct.unpack_from('<BBH', payload, 48)
+                data["event_queue"] = f"峰值={high_water} 批量={batch_max} 丢弃={event_drops}"
+                return data
+            if msg_id == MSG_SAFETY_STATUS and len(payload) == 13:
+                state, active, last, count, last_us, max_us = struct.unpack('<BBBHII', payload)
+                return {
+                    "safety_state": (f"{SAFETY_STATES[state] if state < len(SAFETY_STATES) else state} "
+                                     f"active={safety_source_text(active)}"),
+                    "safety_trigger": f"{count} 次, 最近 {safety_source_text(last)}",
+                    "safety_latency": f"last={last_us} us max={max_us} us",
+                }
+            if msg_id == MSG_HOMING_STATUS and len(payload) == 20:
+                state, conf, bearing, balance = struct.unpack_from('<BBhb', payload, 0)
+                rotations, flags, heading_err = struct.unpack_from('<BBh', payload, 13)
+                contact_mv, retries = struct.unpack_from('<HB', payload, 17)
+                rx = []
+                for i in range(4):
+                    strength, code = payload[5 + i * 2], payload[6 + i * 2]
+                    rx.append(f"{strength}%/{BEACON_CODES[code] if code < len(BEACON_CODES) else '-'}")
+                return {
+                    "homing_state": HOMING_STATES[state] if state < len(HOMING_STATES) else str(state),
+                    "homing_bearing": f"{bearing / 10.0:+.1f}° 置信度={conf}% 扇区={balance:+d}%",
+                    "homing_rx": " ".join(rx),
+                    "homing_heading": (f"圈数={rotations} "
+                                       f"{'锁定' if flags & 0x01 else ('转回记忆' if flags & 0x02 else '-')} "
+                                       f"误差={heading_err / 10.0:+.1f}°"),
+                    "homing_contact": (f"{'接通' if flags & 0x04 else '断开'} {contact_mv / 1000.0:.2f} V "
+                                       f"重试={retries}"),
+                }
+            if msg_id == MSG_SYSTEM_STATUS and len(payload) >= 14:
+                return self.parse_system_status(payload)
             if msg_id == MSG_ACK and len(payload) >= 2:
                 return {"cmd_id": payload[0], "status": payload[1],
                         "info": payload[2] if len(payload) > 2 else 0}
@@ -245,9 +342,40 @@ class SerialWorker(QObject):
             self.log_message.emit(f"[WARN] Payload decode error (msg {msg_id})")
         return {}
 
+    def parse_system_status(self, payload):
+        """任务统计分多帧发送，first=0 开始新一轮，收齐 total 个任务后刷新显示"""
+        total, first, cpu_load, heap_free, heap_min, window_ms = struct.unpack_from('<BBHIIH', payload, 0)
+        entry_size = 7 + TASK_NAME_LEN
+        if first == 0:
+            self.task_rows = []
+        if first != len(self.task_rows):
+            return {}
+        for off in range(14, len(payload) - entry_size + 1, entry_size):
+            number, prio, state, cpu, stack_free = struct.unpack_from('<BBBHH', payload, off)
+            name = payload[off + 7:off + entry_size].split(b"\0", 1)[0].decode(errors="replace")
+            self.task_rows.append((number, name, prio, state, cpu, stack_free))
+        if len(self.task_rows) < total:
+            return {}
+
+        lines = []
+        low_stack = []
+        for number, name, prio, state, cpu, stack_free in self.task_rows:
+            state_text = TASK_STATES[state] if state < len(TASK_STATES) else str(state)
+            lines.append(f"#{number:<2} {name:<14} P{prio:<2} {state_text:<5} "
+                         f"{cpu / 10.0:5.1f}%  栈余 {stack_free} 字")
+            if stack_free < STACK_WARN_WORDS:
+                low_stack.append(name)
+        if low_stack:
+            self.log_message.emit(f"[WARN] 栈余量不足 {STACK_WARN_WORDS} 字: {', '.join(low_stack)}")
+        return {
+            "sys_cpu": f"{cpu_load / 10.0:.1f}% (窗口 {window_ms} ms)",
+            "sys_heap": f"剩余 {heap_free} B, 历史最小 {heap_min} B",
+            "sys_tasks": "\n".join(lines),
+        }
+
 # ----------------- 主界面 -----------------
 class ControlPanel(QWidget):
-    def __init__(self):
+    def __init__(self, default_port=None):
         super().__init__()
         self.setWindowTitle("CleanBot USB 调试工具")
         self.resize(1100, 700)
@@ -270,8 +398,11 @@ class ControlPanel(QWidget):
         row = 0
         ctrl_layout.addWidget(QLabel("串口："), row, 0)
         self.port_combo = QComboBox()
+        self.port_combo.setEditable(True)  # 可直接输入路径，如 SIL 的 pty
         for port in serial.tools.list_ports.comports():
             self.port_combo.addItem(port.device)
+        if default_port:
+            self.port_combo.setEditText(default_port)
         ctrl_layout.addWidget(self.port_combo, row, 1)
         self.connect_btn = QPushButton("连接")
         ctrl_layout.addWidget(self.connect_btn, row, 2)
@@ -325,6 +456,8 @@ class ControlPanel(QWidget):
         ctrl_layout.addWidget(self.need_ack, row, 0)
         self.send_btn = QPushButton("发送 CONTROL_CMD")
         ctrl_layout.addWidget(self.send_btn, row, 1)
+        self.velocity_mode = QCheckBox("v/ω 模式（左=v，右=ω）")
+        ctrl_layout.addWidget(self.velocity_mode, row, 2)
 
         # 中间：传感器显示
         sensor_box = QGroupBox("传感器/状态")
@@ -344,6 +477,20 @@ class ControlPanel(QWidget):
             ("bumper_left", "左碰撞"), ("bumper_right", "右碰撞"),
             ("ir_down0", "下视0"), ("ir_down1", "下视1"), ("ir_down2", "下视2"),
             ("heartbeat", "心跳"), ("dock_status", "Dock状态"), ("fault", "故障掩码"),
+            ("ramp_brush_l", "左边刷 输出/目标"), ("ramp_brush_r", "右边刷 输出/目标"),
+            ("ramp_pump", "水泵 输出/目标"), ("ramp_fan", "风机 输出/目标"),
+            ("ramp_heavy", "上升中大电流通道"),
+            ("traj_state", "轨迹状态"), ("traj_buffer", "轨迹缓冲"),
+            ("traj_progress", "轨迹进度"), ("traj_underrun", "轨迹欠载次数"),
+            ("diag_l", "左轮诊断"), ("diag_r", "右轮诊断"), ("diag_yaw", "偏航角速度 (rad/s)"),
+            ("ir_l", "红外左 解码"), ("ir_r", "红外右 解码"),
+            ("ir_fl", "红外左前 解码"), ("ir_fr", "红外右前 解码"),
+            ("event_queue", "传感器事件队列"),
+            ("safety_state", "安全反射状态"), ("safety_trigger", "反射触发"),
+            ("safety_latency", "边沿->PWM延迟"),
+            ("homing_state", "回冲状态"), ("homing_bearing", "信标方位"),
+            ("homing_rx", "信标强度 左/右/左前/右前"), ("homing_heading", "回冲航向"), ("homing_contact", "充电触点"),
+            ("sys_cpu", "CPU占用"), ("sys_heap", "FreeRTOS堆"), ("sys_tasks", "任务 CPU/栈余量"),
         ]
         for row, (key, name) in enumerate(sensors):
             sensor_layout.addWidget(QLabel(name), row, 0)
@@ -429,7 +576,7 @@ class ControlPanel(QWidget):
             self.connect_btn.setText("连接")
             return
 
-        port = self.port_combo.currentText()
+        port = self.port_combo.currentText().strip()
         if not port:
             QMessageBox.warning(self, "提示", "没有可用串口")
             return
@@ -461,13 +608,13 @@ class ControlPanel(QWidget):
         brush_l = self.brush_left.value()
         brush_r = self.brush_right.value()
         need_ack = 1 if self.need_ack.isChecked() else 0
-        reserved = 0
+        flags = CTRL_FLAG_VELOCITY_MODE if self.velocity_mode.isChecked() else 0
 
         payload = struct.pack(
             '<ffBBBBBBB',
             left, right,
             work_mode, brush_l, brush_r, fan, pump,
-            need_ack, reserved
+            need_ack, flags
         )
         return payload
 
@@ -531,7 +678,8 @@ class ControlPanel(QWidget):
 # ----------------- 入口 -----------------
 def main():
     app = QApplication(sys.argv)
-    panel = ControlPanel()
+    # 可选参数：默认串口，例如 python SerialTest.py /tmp/cleanbot
+    panel = ControlPanel(sys.argv[1] if len(sys.argv) > 1 else None)
     panel.show()
     sys.exit(app.exec())
     
@@ -0,0 +1,272 @@
+/**
+  ******************************************************************************
+  * @file    beacon_sim.c
+  * @brief   信标观测模型上位机测试：模拟充电座与四个接收头
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 充电座位于原点、朝 +x 发射，四个扇区码按接收头相对充电座中线的角度区分
+  * （机器人面向充电座时，左侧为 0x17/0x65，右侧为 0x9A/0xB4）。每个接收头
+  * 每帧的解码成功率 = 接收头入射角余弦 × 充电座发射角余弦 × 距离衰减。
+  * 在一组起始位姿上回放观测，统计方位误差、左右判断正确率与置信度，
+  * 不满足门限时返回非0。参数与 ir_homing.c 保持一致。
+  ******************************************************************************
+  */
+
+#include "beacon_model.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PI_F                3.14159265f
+#define DEG(x)              ((x) * PI_F / 180.0f)
+#define TO_DEG(x)           ((x) * 180.0f / PI_F)
+
+/* 机器人与充电座 */
+#define ROBOT_RADIUS_M      0.16f   /* 接收头到机体中心距离 */
+#define RX_FOV_RAD          DEG(80.0f)
+#define DOCK_HALF_ANGLE     DEG(70.0f)
+#define DOCK_RANGE_M        4.0f
+#define DOCK_CENTER_DEG     6.0f    /* 中间两个扇区的半宽 */
+#define DOCK_FRAME_MS       125U    /* 信标帧周期（8Hz） */
+#define DECODE_P_MAX        0.95f
+
+/* 仿真 */
+#define SIM_STEP_MS         5U
+#define SIM_OBSERVE_MS      1500U
+#define UPDATE_PERIOD_MS    10U     /* 与传感器任务回冲作业周期一致 */
+
+/* 门限 */
+#define PASS_CONF_MIN       0.30f
+#define PASS_MEAN_ERR_DEG   12.0f
+#define PASS_P95_ERR_DEG    28.0f
+#define PASS_SIGN_RATE      0.95f
+#define PASS_COVERAGE       0.90f
+
+static const uint8_t s_codes[BEACON_CODE_SECTORS] = { 0x17, 0x65, 0x9A, 0xB4 };
+
+static const BeaconModelConfig_t s_config = {
+    .mountRad = { DEG(90.0f), DEG(-90.0f), DEG(30.0f), DEG(-30.0f) },
+    .codes = { 0x17, 0x65, 0x9A, 0xB4 },
+    .fullRateHz = 8.0f,
+    .hitTimeoutMs = 500U,
+    .confFullStrength = 1.5f
+};
+
+typedef struct {
+    float x, y, theta;
+} Pose_t;
+
+static uint32_t s_rng = 12345U;
+
+static float Sim_Rand(void)
+{
+    s_rng = s_rng * 1664525U + 1013904223U;
+    return (float)(s_rng >> 8) / 16777216.0f;
+}
+
+static float Sim_Wrap(float a)
+{
+    while (a > PI_F) a -= 2.0f * PI_F;
+    while (a < -PI_F) a += 2.0f * PI_F;
+    return a;
+}
+
+/**
+  * @brief  单个接收头对一帧信标的解码概率与扇区码
+  * @retval 解码概率 (0~DECODE_P_MAX)
+  */
+static float Sim_Receive(const Pose_t *pose, uint8_t rx, uint8_t *command)
+{
+    float facing = pose->theta + s_config.mountRad[rx];
+    float px = pose->x + ROBOT_RADIUS_M * cosf(facing);
+    float py = pose->y + ROBOT_RADIUS_M * sinf(facing);
+
+    float dist = sqrtf(px * px + py * py);
+    float emit = atan2f(py, px);
+    float incidence = Sim_Wrap(atan2f(-py, -px) - facing);
+    if (fabsf(emit) > DOCK_HALF_ANGLE || fabsf(incidence) > RX_FOV_RAD || dist > DOCK_RANGE_M) {
+        return 0.0f;
+    }
+
+    float emitDeg = TO_DEG(emit);
+    if (emitDeg < -DOCK_CENTER_DEG)      *command = s_codes[0];
+    else if (emitDeg < 0.0f)             *command = s_codes[1];
+    else if (emitDeg < DOCK_CENTER_DEG)  *command = s_codes[2];
+    else                                 *command = s_codes[3];
+
+    float range = 1.0f - (dist / DOCK_RANGE_M) * (dist / DOCK_RANGE_M);
+    float p = cosf(incidence) * cosf(emit) * range * 1.2f;
+    return (p > DECODE_P_MAX) ? DECODE_P_MAX : p;
+}
+
+/**
+  * @brief  静止位姿下回放观测
+  * @param  lostAfterMs: 超过该时间后信标消失（0=不消失）
+  */
+static void Sim_Observe(BeaconModel_t *model, const Pose_t *pose, uint32_t startMs, uint32_t durationMs,
+                        uint32_t lostAfterMs)
+{
+    uint32_t phase[BEACON_RX_COUNT];
+    for (uint8_t i = 0; i < BEACON_RX_COUNT; i++) {
+        phase[i] = (uint32_t)(Sim_Rand() * DOCK_FRAME_MS);
+    }
+
+    for (uint32_t t = 0; t < durationMs; t += SIM_STEP_MS) {
+        uint32_t now = startMs + t;
+        bool lost = (lostAfterMs > 0U) && (t >= lostAfterMs);
+        for (uint8_t i = 0; i < BEACON_RX_COUNT && !lost; i++) {
+            if (((t + phase[i]) % DOCK_FRAME_MS) >= SIM_STEP_MS) continue;
+            uint8_t command = 0;
+            float p = Sim_Receive(pose, i, &command);
+            if (p > 0.0f && Sim_Rand() < p) {
+                BeaconModel_Observe(model, i, command, now);
+            }
+        }
+        if ((t % UPDATE_PERIOD_MS) == 0U) {
+            BeaconModel_Update(model, now);
+        }
+    }
+}
+
+static int Sim_CompareFloat(const void *a, const void *b)
+{
+    float fa = *(const float*)a;
+    float fb = *(const float*)b;
+    return (fa > fb) - (fa < fb);
+}
+
+/**
+  * @brief  方位精度：距离 × 相对充电座方位 × 机器人朝向 网格
+  */
+static int Sim_TestBearingGrid(void)
+{
+    static float errors[4096];
+    const float dists[] = { 0.6f, 1.0f, 1.5f, 2.0f, 2.5f, 3.0f };
+    uint32_t evaluated = 0, visible = 0, covered = 0, signChecks = 0, signOk = 0;
+    uint32_t count = 0;
+
+    for (uint8_t d = 0; d < sizeof(dists) / sizeof(dists[0]); d++) {
+        for (int phi = -50; phi <= 50; phi += 10) {
+            for (int bearing = -120; bearing <= 120; bearing += 15) {
+                Pose_t pose;
+                pose.x = dists[d] * cosf(DEG((float)phi));
+                pose.y = dists[d] * sinf(DEG((float)phi));
+                pose.theta = atan2f(-pose.y, -pose.x) - DEG((float)bearing);
+
+                BeaconModel_t model;
+                BeaconModel_Init(&model, &s_config);
+                Sim_Observe(&model, &pose, 1000U, SIM_OBSERVE_MS, 0U);
+                evaluated++;
+
+                if (abs(bearing) > 60) continue;
+                visible++;
+                if (!model.valid || model.confidence < PASS_CONF_MIN) continue;
+                covered++;
+
+                float err = fabsf(TO_DEG(Sim_Wrap(model.bearingRad - DEG((float)bearing))));
+                if (count < sizeof(errors) / sizeof(errors[0])) errors[count++] = err;
+                if (abs(bearing) >= 15) {
+                    signChecks++;
+                    if ((model.bearingRad > 0.0f) == (bearing > 0)) signOk++;
+                }
+            }
+        }
+    }
+
+    qsort(errors, count, sizeof(float), Sim_CompareFloat);
+    float mean = 0.0f;
+    for (uint32_t i = 0; i < count; i++) mean += errors[i];
+    mean = (count > 0U) ? mean / (float)count : 0.0f;
+    float p95 = (count > 0U) ? errors[(count * 95U) / 100U] : 0.0f;
+    float coverage = (visible > 0U) ? (float)covered / (float)visible : 0.0f;
+    float signRate = (signChecks > 0U) ? (float)signOk / (float)signChecks : 0.0f;
+
+    int fail = (mean > PASS_MEAN_ERR_DEG) || (p95 > PASS_P95_ERR_DEG) ||
+               (signRate < PASS_SIGN_RATE) || (coverage < PASS_COVERAGE);
+    printf("[%s] 方位网格: %u 个位姿, |方位|<=60° 有效 %u/%u (%.0f%%)\n",
+           fail ? "FAIL" : " OK ", evaluated, covered, visible, coverage * 100.0f);
+    printf("  误差 mean=%.1f° p95=%.1f° max=%.1f°, 左右判断 %.1f%%\n",
+           mean, p95, (count > 0U) ? errors[count - 1U] : 0.0f, signRate * 100.0f);
+    return fail;
+}
+
+/**
+  * @brief  置信度随距离下降
+  */
+static int Sim_TestConfidenceRange(void)
+{
+    const float dists[] = { 0.6f, 1.5f, 3.0f, 3.8f };
+    float conf[4];
+
+    printf("  置信度(正对):");
+    for (uint8_t d = 0; d < 4; d++) {
+        float sum = 0.0f;
+        for (uint8_t k = 0; k < 20; k++) {
+            Pose_t pose = { dists[d], 0.0f, PI_F };
+            BeaconModel_t model;
+            BeaconModel_Init(&model, &s_config);
+            Sim_Observe(&model, &pose, 1000U, SIM_OBSERVE_MS, 0U);
+            sum += model.confidence;
+        }
+        conf[d] = sum / 20.0f;
+        printf(" %.1fm=%.2f", dists[d], conf[d]);
+    }
+    printf("\n");
+
+    int fail = !(conf[0] >= conf[1] && conf[1] > conf[2] && conf[2] > conf[3]);
+    printf("[%s] 置信度随距离单调下降\n", fail ? "FAIL" : " OK ");
+    return fail;
+}
+
+/**
+  * @brief  信标消失后在命中超时内置信度归零
+  */
+static int Sim_TestDropout(void)
+{
+    Pose_t pose = { 1.0f, 0.2f, PI_F };
+    BeaconModel_t model;
+    BeaconModel_Init(&model, &s_config);
+
+    Sim_Observe(&model, &pose, 1000U, 1000U, 0U);
+    float before = model.confidence;
+    Sim_Observe(&model, &pose, 2000U, s_config.hitTimeoutMs + 20U, 1U);
+
+    int fail = (before < PASS_CONF_MIN) || model.valid || model.confidence != 0.0f;
+    printf("[%s] 信号消失: 之前置信度 %.2f, %ums 后 valid=%d conf=%.2f\n", fail ? "FAIL" : " OK ",
+           before, s_config.hitTimeoutMs + 20U, model.valid, model.confidence);
+    return fail;
+}
+
+/**
+  * @brief  扇区码分布反映机器人在中线哪一侧
+  */
+static int Sim_TestSectorBalance(void)
+{
+    int fail = 0;
+    for (int side = -1; side <= 1; side += 2) {
+        /* 面向充电座，机器人左侧为 -y */
+        Pose_t pose = { 1.5f, -0.4f * (float)side, PI_F };
+        BeaconModel_t model;
+        BeaconModel_Init(&model, &s_config);
+        Sim_Observe(&model, &pose, 1000U, SIM_OBSERVE_MS, 0U);
+        bool ok = (side > 0) ? (model.sectorBalance > 0.5f) : (model.sectorBalance < -0.5f);
+        fail |= !ok;
+        printf("[%s] 偏%s 0.4m: sectorBalance=%+.2f\n", ok ? " OK " : "FAIL",
+               (side > 0) ? "左" : "右", model.sectorBalance);
+    }
+    return fail;
+}
+
+int main(void)
+{
+    int failed = 0;
+    failed += Sim_TestBearingGrid();
+    failed += Sim_TestConfidenceRange();
+    failed += Sim_TestDropout();
+    failed += Sim_TestSectorBalance();
+    printf("%s\n", failed ? "失败" : "全部通过");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,380 @@
+"""
+CleanBot 黑匣子下载与解码
+
+    python blackbox_tool.py info --port COM5                         # 记录数与各 Flash 槽状态
+    python blackbox_tool.py download --port COM5 -o ram.bbx          # 下载 RAM 环（下载期间暂停记录）
+    python blackbox_tool.py download --port COM5 --image 1 -o f1.bbx # 下载 Flash 槽 1 的故障转储
+    python blackbox_tool.py download --port COM5 --all -o dump       # 下载全部未清除的转储 dump_<槽>.bbx
+    python blackbox_tool.py save --port COM5                         # 整机空闲时把 RAM 环写入 Flash
+    python blackbox_tool.py clear --port COM5                        # 清除全部转储
+    python blackbox_tool.py decode f1.bbx -o f1.csv                  # 解码为 CSV 并打印摘要
+
+映像格式见 Utils/blackbox.h：映像头 + 块，块按 seq 排序后逐块解码（每块以关键帧开始，
+被覆盖或中途作废的块不影响其他块）。CSV 中 t_rel_s 为相对转储/下载时刻的时间，
+负值即故障之前。故障后的现场：上电连接后先看 0x2E 故障报告（reason 与此处映像头一致），
+再 download --all 取出转储，确认无误后 clear。
+"""
+import argparse
+import csv
+import struct
+import sys
+import time
+
+from trace_tool import build_frame, iter_frames
+
+MSG_BLACKBOX_CONTROL = 0x16
+MSG_ACK = 0x24
+MSG_BLACKBOX_DATA = 0x2F
+
+OP_INFO = 0x00
+OP_DOWNLOAD = 0x01
+OP_SAVE = 0x02
+OP_CLEAR = 0x03
+
+KIND_INFO = 0x00
+KIND_DATA = 0x01
+DATA_HEADER_FMT = '<BBBBII'
+DATA_HEADER_SIZE = struct.calcsize(DATA_HEADER_FMT)
+INFO_HEADER_FMT = '<BBBBHHHI'
+INFO_HEADER_SIZE = struct.calcsize(INFO_HEADER_FMT)
+FLAG_LAST = 0x01
+
+IMAGE_HEADER_FMT = '<IIIHHHBB'
+IMAGE_HEADER_SIZE = struct.calcsize(IMAGE_HEADER_FMT)
+BLOCK_HEADER_FMT = '<IIHH'
+BLOCK_HEADER_SIZE = struct.calcsize(BLOCK_HEADER_FMT)
+MAGIC = 0x31585842
+ERASED = 0xFFFFFFFF
+
+ACK_STATUS = {0: "ok", 1: "fail", 2: "busy"}
+ACK_INFO = {1: "bad length", 5: "no such image", 6: "no free flash slot", 7: "flash program error"}
+SLOT_STATES = ["free", "dump", "cleared", "dirty"]
+REASONS = ["none", "heartbeat", "hardfault", "memmanage", "busfault", "usagefault", "error_handler"]
+SAFETY_STATES = ["idle", "stop", "backoff", "turn", "hold"]
+
+# 字段顺序与 BlackBoxField_t 一致：(列名, 除数)，除数为 None 的保持整数
+FIELDS = [
+    ("left_target_mps", 1000.0), ("right_target_mps", 1000.0),
+    ("left_speed_mps", 1000.0), ("right_speed_mps", 1000.0),
+    ("left_duty", None), ("right_duty", None),
+    ("yaw_deg", 100.0), ("gyro_z_dps", 10.0),
+    ("accel_x_g", 1000.0), ("accel_y_g", 1000.0),
+    ("state", None), ("faults", None),
+]
+STATE_INDEX = 10
+FAULTS_INDEX = 11
+STATE_BITS = [(3, "docked"), (4, "traj"), (5, "homing"), (6, "usb")]
+FAULT_BITS = [(0, "L_stall"), (1, "L_slip"), (2, "L_jam"), (3, "R_stall"), (4, "R_slip"), (5, "R_jam"),
+              (6, "bumper_L"), (7, "bumper_R"), (8, "cliff_L"), (9, "cliff_C"), (10, "cliff_R"),
+              (11, "dock_failed")]
+
+
+# ========================== 设备交互 ==========================
+
+def open_port(args):
+    import serial
+    return serial.Serial(args.port, args.baud, timeout=0.05)
+
+
+def request(ser, payload, timeout, done):
+    """发送 0x16 并收集回复，done(ack, frames) 为真时结束；返回 (ack, 0x2F 负载列表)"""
+    buf = bytearray()
+    ack = None
+    frames = []
+    ser.write(build_frame(MSG_BLACKBOX_CONTROL, bytes(payload)))
+    end = time.time() + timeout
+    while time.time() < end:
+        chunk = ser.read(4096)
+        if not chunk:
+            continue
+        buf.extend(chunk)
+        for msg_id, data in iter_frames(buf):
+            if msg_id == MSG_ACK and len(data) >= 3 and data[0] == MSG_BLACKBOX_CONTROL:
+                ack = (data[1], data[2])
+            elif msg_id == MSG_BLACKBOX_DATA and len(data) >= 1:
+                frames.append(bytes(data))
+        if ack is not None and (ack[0] != 0 or done(ack, frames)):
+            break
+    return ack, frames
+
+
+def check_ack(ack, op):
+    if ack is None:
+        print(f"[WARN] 未收到 0x16 op={op} 的 ACK", file=sys.stderr)
+        return False
+    status, info = ack
+    if status != 0:
+        print(f"[ERROR] 0x16 op={op}: {ACK_STATUS.get(status, status)} "
+              f"({ACK_INFO.get(info, info) if status == 1 else 'robot moving'})", file=sys.stderr)
+        return False
+    return True
+
+
+def parse_info(data):
+    (_, slots, field_count, enabled, block_size, block_count, period_ms,
+     records) = struct.unpack_from(INFO_HEADER_FMT, data, 0)
+    states = list(data[INFO_HEADER_SIZE:INFO_HEADER_SIZE + slots])
+    return {"slots": slots, "field_count": field_count, "enabled": bool(enabled), "block_size": block_size,
+            "block_count": block_count, "period_ms": period_ms, "records": records, "states": states}
+
+
+def fetch_info(ser, timeout):
+    ack, frames = request(ser, [OP_INFO], timeout,
+                          lambda a, f: any(fr[0] == KIND_INFO for fr in f))
+    check_ack(ack, OP_INFO)
+    for fr in frames:
+        if fr[0] == KIND_INFO and len(fr) >= INFO_HEADER_SIZE:
+            return parse_info(fr)
+    return None
+
+
+def download_image(ser, image, timeout):
+    """下载一个映像，返回 bytes；缺帧时返回 None"""
+    def finished(ack, frames):
+        return any(fr[0] == KIND_DATA and len(fr) >= DATA_HEADER_SIZE and fr[1] == image and fr[2] & FLAG_LAST
+                   for fr in frames)
+
+    ack, frames = request(ser, [OP_DOWNLOAD, image], timeout, finished)
+    if not check_ack(ack, OP_DOWNLOAD):
+        return None
+
+    data = None
+    covered = 0
+    for fr in frames:
+        if fr[0] != KIND_DATA or len(fr) < DATA_HEADER_SIZE:
+            continue
+        _, img, _, _, offset, total = struct.unpack_from(DATA_HEADER_FMT, fr, 0)
+        if img != image:
+            continue
+        if data is None:
+            data = bytearray(total)
+        chunk = fr[DATA_HEADER_SIZE:]
+        data[offset:offset + len(chunk)] = chunk
+        covered += len(chunk)
+    if data is None or covered != len(data):
+        got = 0 if data is None else covered
+        print(f"[ERROR] 映像 {image} 不完整：收到 {got}/{0 if data is None else len(data)} 字节",
+              file=sys.stderr)
+        return None
+    return bytes(data)
+
+
+def info(args):
+    ser = open_port(args)
+    result = fetch_info(ser, args.timeout)
+    ser.close()
+    if result is None:
+        sys.exit(1)
+    print(f"enabled={result['enabled']} records={result['records']} period={result['period_ms']}ms "
+          f"ring={result['block_count']}x{result['block_size']}B fields={result['field_count']}")
+    for i, st in enumerate(result["states"]):
+        print(f"  slot {i + 1}: {SLOT_STATES[st] if st < len(SLOT_STATES) else st}")
+
+
+def download(args):
+    ser = open_port(args)
+    if args.all:
+        result = fetch_info(ser, args.timeout)
+        if result is None:
+            ser.close()
+            sys.exit(1)
+        images = [i + 1 for i, st in enumerate(result["states"]) if st == 1]
+        if not images:
+            print("没有未清除的转储")
+    else:
+        images = [args.image]
+
+    for image in images:
+        data = download_image(ser, image, args.timeout)
+        if data is None:
+            continue
+        path = f"{args.output or 'blackbox'}_{image}.bbx" if args.all else (args.output or "blackbox.bbx")
+        with open(path, "wb") as f:
+            f.write(data)
+        hdr = parse_image_header(data)
+        print(f"映像 {image} -> {path}（{len(data)} 字节，reason={reason_name(hdr['reason'])}）")
+    ser.close()
+
+
+def simple_op(op, name):
+    def run(args):
+        ser = open_port(args)
+        ack, _ = request(ser, [op], args.timeout, lambda a, f: True)
+        ser.close()
+        if not check_ack(ack, op):
+            sys.exit(1)
+        print(f"{name}: ok")
+    return run
+
+
+# ========================== 解码 ==========================
+
+def reason_name(reason):
+    return REASONS[reason] if reason < len(REASONS) else f"reason{reason}"
+
+
+def parse_image_header(data):
+    if len(data) < IMAGE_HEADER_SIZE:
+        raise ValueError("映像过短")
+    (magic, state, uptime_ms, block_size, block_count, period_ms, reason,
+     field_count) = struct.unpack_from(IMAGE_HEADER_FMT, data, 0)
+    if magic != MAGIC:
+        raise ValueError(f"映像头 magic 不符：0x{magic:08X}")
+    return {"cleared": state != ERASED, "uptime_ms": uptime_ms, "block_size": block_size,
+            "block_count": block_count, "period_ms": period_ms, "reason": reason, "field_count": field_count}
+
+
+def read_varint(data, pos, end):
+    value = 0
+    shift = 0
+    while pos < end:
+        b = data[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        if not b & 0x80:
+            return value, pos
+        shift += 7
+        if shift > 35:
+            break
+    raise ValueError("varint 越界")
+
+
+def unzigzag(v):
+    return (v >> 1) ^ -(v & 1)
+
+
+def decode_block(data, base, block_size, field_count):
+    """解码一块，返回 (seq, used, [(t_ms, values)])；空块返回 (0, 0, [])"""
+    seq, base_ms, used, count = struct.unpack_from(BLOCK_HEADER_FMT, data, base)
+    if seq == 0 or used < BLOCK_HEADER_SIZE or used > block_size:
+        return 0, 0, []
+    records = []
+    pos = base + BLOCK_HEADER_SIZE
+    end = base + used
+    t = base_ms
+    prev = [0] * field_count
+    try:
+        for _ in range(count):
+            dt, pos = read_varint(data, pos, end)
+            mask, pos = read_varint(data, pos, end)
+            t += dt
+            for i in range(field_count):
+                if mask & (1 << i):
+                    delta, pos = read_varint(data, pos, end)
+                    prev[i] += unzigzag(delta)
+            records.append((t, list(prev)))
+    except ValueError:
+        print(f"[WARN] 块 seq={seq} 在第 {len(records)} 条记录处截断", file=sys.stderr)
+    return seq, used, records
+
+
+def decode_image(data):
+    hdr = parse_image_header(data)
+    blocks = []
+    for b in range(hdr["block_count"]):
+        base = IMAGE_HEADER_SIZE + b * hdr["block_size"]
+        if base + hdr["block_size"] > len(data):
+            break
+        seq, used, records = decode_block(data, base, hdr["block_size"], hdr["field_count"])
+        if seq:
+            blocks.append((seq, used, records))
+    blocks.sort(key=lambda x: x[0])
+    records = [r for _, _, recs in blocks for r in recs]
+    return hdr, blocks, records
+
+
+def bit_names(value, bits):
+    return ",".join(name for bit, name in bits if value & (1 << bit)) or "-"
+
+
+def state_text(value):
+    safety = value & 0x07
+    name = SAFETY_STATES[safety] if safety < len(SAFETY_STATES) else str(safety)
+    return f"safety={name} {bit_names(value, STATE_BITS)}"
+
+
+def decode(args):
+    with open(args.input, "rb") as f:
+        data = f.read()
+    hdr, blocks, records = decode_image(data)
+
+    names = [name for name, _ in FIELDS[:hdr["field_count"]]] + \
+            [f"field{i}" for i in range(len(FIELDS), hdr["field_count"])]
+    if args.output:
+        with open(args.output, "w", newline="") as f:
+            w = csv.writer(f)
+            w.writerow(["t_ms", "t_rel_s"] + names)
+            for t, values in records:
+                row = [t, f"{(t - hdr['uptime_ms']) / 1000.0:.3f}"]
+                for i, v in enumerate(values):
+                    scale = FIELDS[i][1] if i < len(FIELDS) else None
+                    row.append(f"{v / scale:.3f}" if scale else v)
+                w.writerow(row)
+
+    gaps = sum(1 for a, b in zip(blocks, blocks[1:]) if b[0] != a[0] + 1)
+    print(f"reason={reason_name(hdr['reason'])} uptime={hdr['uptime_ms'] / 1000.0:.3f}s "
+          f"cleared={hdr['cleared']} period={hdr['period_ms']}ms")
+    print(f"blocks={len(blocks)}/{hdr['block_count']} (seq gaps {gaps}) records={len(records)}")
+    if not records:
+        return
+    t0, t1 = records[0][0], records[-1][0]
+    payload = sum(used - BLOCK_HEADER_SIZE for _, used, _ in blocks)
+    print(f"span {t0 / 1000.0:.3f}s .. {t1 / 1000.0:.3f}s ({(t1 - t0) / 1000.0:.1f}s, "
+          f"{payload / len(records):.1f} B/record)")
+
+    # 状态与故障位的变化时间线（故障前的最后若干条）
+    events = []
+    prev_state = prev_faults = None
+    for t, values in records:
+        if len(values) > FAULTS_INDEX:
+            state, faults = values[STATE_INDEX], values[FAULTS_INDEX]
+            if state != prev_state or faults != prev_faults:
+                events.append((t, state, faults))
+                prev_state, prev_faults = state, faults
+    print("state/fault changes:")
+    for t, state, faults in events[-args.events:]:
+        print(f"  {(t - hdr['uptime_ms']) / 1000.0:+9.3f}s  {state_text(state)}  faults={bit_names(faults, FAULT_BITS)}")
+    if args.output:
+        print(f"已写入 {args.output}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="CleanBot 黑匣子下载与解码")
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    def port_args(p):
+        p.add_argument("--port", required=True)
+        p.add_argument("--baud", type=int, default=921600)
+        p.add_argument("--timeout", type=float, default=5.0)
+
+    p = sub.add_parser("info", help="记录数与 Flash 槽状态")
+    port_args(p)
+    p.set_defaults(func=info)
+
+    p = sub.add_parser("download", help="下载映像")
+    port_args(p)
+    p.add_argument("--image", type=int, default=0, help="0=RAM 环，1..N=Flash 槽")
+    p.add_argument("--all", action="store_true", help="下载全部未清除的转储")
+    p.add_argument("-o", "--output", help="文件名，缺省 blackbox.bbx（--all 时为前缀，缺省 blackbox）")
+    p.set_defaults(func=download)
+
+    p = sub.add_parser("save", help="把 RAM 环写入 Flash（整机空闲时）")
+    port_args(p)
+    p.set_defaults(func=simple_op(OP_SAVE, "save"))
+
+    p = sub.add_parser("clear", help="清除全部转储")
+    port_args(p)
+    p.set_defaults(func=simple_op(OP_CLEAR, "clear"))
+
+    p = sub.add_parser("decode", help="解码映像")
+    p.add_argument("input")
+    p.add_argument("-o", "--output", help="CSV 输出")
+    p.add_argument("--events", type=int, default=20, help="显示最后几次状态/故障变化")
+    p.set_defaults(func=decode)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
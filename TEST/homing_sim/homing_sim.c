@@ -0,0 +1,506 @@
+/**
+  ******************************************************************************
+  * @file    homing_sim.c
+  * @brief   红外回冲上位机仿真：随机起点批量运行回冲状态机并统计
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 固件的 ir_homing.c / beacon_model.c / motion_ctrl.c 原样编译，HAL_GetTick、
+  * 电机控制任务接口与 IMU 由本文件提供：
+  * - 底盘：运动控制器（加速度限制）-> 一阶轮速响应（两轮增益随机偏差）
+  *   -> 差速运动学；充电座贴墙，车体碰墙/座时停止并触发对应碰撞开关
+  * - IMU：真实偏航角 + 零偏漂移 + 噪声
+  * - 充电座：原点朝 +x 发射，按接收头相对中线的角度分四个扇区码，
+  *   扇区边界附近两码互相干扰；每个接收头每帧的解码概率 =
+  *   接收头方向增益 × 发射角增益 × 距离衰减
+  * - 充电触点：车体贴座且横向/航向误差在容差内时输出座端电压（刚接触时
+  *   有弹跳），经固件的 charge_contact.c 去抖后送入回冲状态机
+  * - 时序与固件一致：回冲导航 10ms，触点采样 10ms，运动控制 10ms，信标帧 8Hz
+  * 对接判定：状态机首次进入 DOCKED 时，车体须贴座且横向/航向误差在容差内，
+  * 否则记为误对接；状态机判为失败（重试用完）单独计数。
+  *
+  * 用法：homing_sim [-n 次数] [-s 种子] [-m 最低成功率] [-t 序号]
+  *   -t 输出指定序号那次运行的轨迹 CSV（time,x,y,theta,state,conf,bearing,aligned），
+  *      aligned 为收到自身对准码的接收头位图（bit0~3：左/右/左前/右前）
+  ******************************************************************************
+  */
+
+#include "ir_homing.h"
+#include "charge_contact.h"
+#include "motion_ctrl.h"
+#include "imu_task.h"
+#include "motor_ctrl_task.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PI_F                    3.14159265f
+
+/* 车体 */
+#define ROBOT_RADIUS_M          0.16f
+#define WHEEL_TAU_S             0.06f   /* 轮速一阶响应时间常数 */
+#define WHEEL_GAIN_SPREAD       0.04f   /* 两轮增益随机偏差 ±4% */
+
+/* IMU */
+#define IMU_NOISE_DEG           0.2f
+#define IMU_DRIFT_DEG_PER_MIN   1.0f
+
+/* 房间：充电座贴 x=0 的墙 */
+#define ROOM_X_MAX              5.0f
+#define ROOM_Y_HALF             3.0f
+
+/* 充电座发射 */
+#define DOCK_HALF_ANGLE_DEG     70.0f
+#define DOCK_RANGE_M            4.5f
+#define DOCK_CENTER_DEG         6.0f    /* 中间两个扇区的半宽 */
+#define DOCK_BLUR_DEG           1.5f    /* 扇区边界干扰带 */
+#define DOCK_FRAME_MS           125U
+#define DOCK_EMITTER_SETBACK_M  0.08f   /* 发射管在座体正面之后的距离 */
+#define RX_FOV_DEG              110.0f  /* 接收头方向增益过零角 */
+#define DECODE_P_MAX            0.95f
+
+/* 对接容差 */
+#define DOCK_LATERAL_TOL_M      0.04f
+#define DOCK_HEADING_TOL_DEG    15.0f
+#define CONTACT_BOUNCE_MS       40U     /* 触点刚压上时的弹跳时间 */
+
+/* 起点 */
+#define START_DIST_MIN_M        0.8f
+#define START_DIST_MAX_M        4.0f
+#define START_ANGLE_MAX_DEG     60.0f
+
+/* 时序 */
+#define SIM_STEP_MS             1U
+#define HOMING_PERIOD_MS        10U
+#define MOTION_PERIOD_MS        10U
+#define CHARGE_PERIOD_MS        10U
+#define SIM_LIMIT_MS            130000U
+
+/* 接收头实际朝向（与 ir_homing.c 中模型参数一致） */
+static const float s_rxMountDeg[4] = { 90.0f, -90.0f, 30.0f, -30.0f };
+static const uint8_t s_sectorCodes[4] = { IR_CODE_LEFT, IR_CODE_FRONT_LEFT, IR_CODE_FRONT_RIGHT, IR_CODE_RIGHT };
+/* 各接收头对准时应收到的码（IRHoming_IsAligned） */
+static const uint8_t s_rxOwnCode[4] = { IR_CODE_LEFT, IR_CODE_RIGHT, IR_CODE_FRONT_LEFT, IR_CODE_FRONT_RIGHT };
+
+typedef enum {
+    RUN_DOCKED = 0,
+    RUN_FALSE_DOCK,
+    RUN_FAILED,
+    RUN_TIMEOUT,
+    RUN_RESULT_COUNT
+} RunResult_t;
+
+typedef struct {
+    RunResult_t result;
+    float timeS;
+    float lateralM;
+    float headingDeg;
+    HomingState_t lastState;    /* 超时前最后所处的导航状态 */
+    bool atWall;                /* 结束时车体贴墙 */
+} RunStats_t;
+
+/* ---------------- 仿真状态 ---------------- */
+static uint32_t s_nowMs;
+static uint32_t s_rng;
+
+static struct {
+    float x, y, theta;
+    float vl, vr;
+    float gainL, gainR;
+    bool bumperL, bumperR;
+} s_robot;
+
+static MotionCtrl_t s_motion;
+static float s_imuBiasDeg;
+static float s_imuDriftDegPerMs;
+static float s_imuYawDeg;
+
+/* ---------------- 桩函数 ---------------- */
+uint32_t HAL_GetTick(void)
+{
+    return s_nowMs;
+}
+
+void MotorCtrlTask_SetVelocity(float linearMs, float angularRadS)
+{
+    MotionCtrl_SetTarget(&s_motion, linearMs, angularRadS);
+}
+
+void MotorCtrlTask_SetWheelSpeed(float leftSpeedMs, float rightSpeedMs)
+{
+    MotionCtrl_SetTarget(&s_motion, (leftSpeedMs + rightSpeedMs) * 0.5f,
+                         (rightSpeedMs - leftSpeedMs) / WHEEL_TRACK_WIDTH_M);
+}
+
+void IMUTask_GetEuler(float *roll, float *pitch, float *yaw)
+{
+    if (roll) *roll = 0.0f;
+    if (pitch) *pitch = 0.0f;
+    if (yaw) *yaw = s_imuYawDeg;
+}
+
+bool IMUTask_IsDataFresh(uint32_t maxAgeMs)
+{
+    (void)maxAgeMs;
+    return true;
+}
+
+void IMUTask_GetGyro(float *gx, float *gy, float *gz)
+{
+    if (gx) *gx = 0.0f;
+    if (gy) *gy = 0.0f;
+    if (gz) *gz = RAD_TO_DEG((s_robot.vr - s_robot.vl) / WHEEL_TRACK_WIDTH_M);
+}
+
+/* ---------------- 工具 ---------------- */
+static float Sim_Rand(void)
+{
+    s_rng = s_rng * 1664525U + 1013904223U;
+    return (float)(s_rng >> 8) / 16777216.0f;
+}
+
+static float Sim_RandRange(float lo, float hi)
+{
+    return lo + (hi - lo) * Sim_Rand();
+}
+
+static float Sim_WrapRad(float a)
+{
+    while (a > PI_F) a -= 2.0f * PI_F;
+    while (a <= -PI_F) a += 2.0f * PI_F;
+    return a;
+}
+
+/* ---------------- 充电座与接收头 ---------------- */
+
+/**
+  * @brief  单个接收头对一帧信标的解码
+  * @retval true=解出，command 为码值
+  */
+static bool Sim_ReceiveFrame(uint8_t rx, uint8_t *command)
+{
+    float facing = s_robot.theta + DEG_TO_RAD(s_rxMountDeg[rx]);
+    float px = s_robot.x + ROBOT_RADIUS_M * cosf(facing) + DOCK_EMITTER_SETBACK_M;
+    float py = s_robot.y + ROBOT_RADIUS_M * sinf(facing);
+
+    float dist = sqrtf(px * px + py * py);
+    float emitDeg = RAD_TO_DEG(atan2f(py, px));
+    float incDeg = RAD_TO_DEG(Sim_WrapRad(atan2f(-py, -px) - facing));
+    if (fabsf(emitDeg) > DOCK_HALF_ANGLE_DEG || fabsf(incDeg) >= RX_FOV_DEG || dist > DOCK_RANGE_M) {
+        return false;
+    }
+
+    /* 扇区边界附近两码叠加，按位置随机落到一侧 */
+    float blur = Sim_RandRange(-DOCK_BLUR_DEG, DOCK_BLUR_DEG);
+    float sectorDeg = emitDeg + blur;
+    uint8_t sector;
+    if (sectorDeg < -DOCK_CENTER_DEG)      sector = 0;
+    else if (sectorDeg < 0.0f)             sector = 1;
+    else if (sectorDeg < DOCK_CENTER_DEG)  sector = 2;
+    else                                   sector = 3;
+    *command = s_sectorCodes[sector];
+
+    float rxGain = cosf(DEG_TO_RAD(incDeg * 90.0f / RX_FOV_DEG));
+    float emitGain = cosf(DEG_TO_RAD(emitDeg * 90.0f / (DOCK_HALF_ANGLE_DEG + 10.0f)));
+    float range = 1.0f - (dist / DOCK_RANGE_M) * (dist / DOCK_RANGE_M);
+    float p = rxGain * emitGain * range * 1.3f;
+    if (p > DECODE_P_MAX) p = DECODE_P_MAX;
+
+    return Sim_Rand() < p;
+}
+
+/* ---------------- 充电触点 ---------------- */
+
+/**
+  * @brief  车体是否贴座且横向/航向在触点容差内
+  */
+static bool Sim_OnContacts(void)
+{
+    float headingDeg = RAD_TO_DEG(Sim_WrapRad(s_robot.theta - PI_F));
+    return (s_robot.x <= ROBOT_RADIUS_M + 0.005f) &&
+           (fabsf(s_robot.y) <= DOCK_LATERAL_TOL_M) &&
+           (fabsf(headingDeg) <= DOCK_HEADING_TOL_DEG);
+}
+
+/* ---------------- 底盘 ---------------- */
+
+/**
+  * @brief  推进底盘 1 个仿真步长
+  */
+static void Sim_StepRobot(float dt)
+{
+    float tl = 0.0f, tr = 0.0f;
+    MotionCtrl_GetWheelSpeed(&s_motion, &tl, &tr);
+    s_robot.vl += (tl * s_robot.gainL - s_robot.vl) * dt / (WHEEL_TAU_S + dt);
+    s_robot.vr += (tr * s_robot.gainR - s_robot.vr) * dt / (WHEEL_TAU_S + dt);
+
+    float v = (s_robot.vl + s_robot.vr) * 0.5f;
+    float w = (s_robot.vr - s_robot.vl) / WHEEL_TRACK_WIDTH_M;
+    s_robot.theta = Sim_WrapRad(s_robot.theta + w * dt);
+    s_robot.x += v * cosf(s_robot.theta) * dt;
+    s_robot.y += v * sinf(s_robot.theta) * dt;
+
+    /* 充电座所在的墙：车体贴上后不再前进，按墙相对车头的方向触发碰撞开关 */
+    bool contact = false;
+    if (s_robot.x < ROBOT_RADIUS_M) {
+        s_robot.x = ROBOT_RADIUS_M;
+        contact = true;
+    }
+    if (s_robot.x > ROOM_X_MAX) s_robot.x = ROOM_X_MAX;
+    if (s_robot.y > ROOM_Y_HALF) s_robot.y = ROOM_Y_HALF;
+    if (s_robot.y < -ROOM_Y_HALF) s_robot.y = -ROOM_Y_HALF;
+
+    bool left = false, right = false;
+    if (contact) {
+        float wallDeg = RAD_TO_DEG(Sim_WrapRad(PI_F - s_robot.theta));
+        if (fabsf(wallDeg) < 90.0f) {
+            left = (wallDeg > -25.0f);
+            right = (wallDeg < 25.0f);
+        }
+    }
+    s_robot.bumperL = left;
+    s_robot.bumperR = right;
+
+    /* IMU：真实航向 + 零偏漂移 + 噪声，输出 ±180° */
+    s_imuBiasDeg += s_imuDriftDegPerMs * dt * 1000.0f;
+    float yaw = RAD_TO_DEG(s_robot.theta) + s_imuBiasDeg + Sim_RandRange(-IMU_NOISE_DEG, IMU_NOISE_DEG);
+    s_imuYawDeg = RAD_TO_DEG(Sim_WrapRad(DEG_TO_RAD(yaw)));
+}
+
+/**
+  * @brief  运行一次回冲
+  * @param  trace: 非NULL时输出轨迹CSV
+  */
+static RunStats_t Sim_Run(uint32_t seed, FILE *trace)
+{
+    RunStats_t stats = { RUN_TIMEOUT, 0.0f, 0.0f, 0.0f, HOMING_STATE_SEARCHING, false };
+    s_rng = seed * 2654435761U + 1U;
+
+    /* 起点：充电座发射范围内随机位置与朝向 */
+    float dist = Sim_RandRange(START_DIST_MIN_M, START_DIST_MAX_M);
+    float angle = DEG_TO_RAD(Sim_RandRange(-START_ANGLE_MAX_DEG, START_ANGLE_MAX_DEG));
+    memset(&s_robot, 0, sizeof(s_robot));
+    s_robot.x = dist * cosf(angle);
+    s_robot.y = dist * sinf(angle);
+    s_robot.theta = Sim_RandRange(-PI_F, PI_F);
+    s_robot.gainL = 1.0f + Sim_RandRange(-WHEEL_GAIN_SPREAD, WHEEL_GAIN_SPREAD);
+    s_robot.gainR = 1.0f + Sim_RandRange(-WHEEL_GAIN_SPREAD, WHEEL_GAIN_SPREAD);
+
+    s_imuBiasDeg = Sim_RandRange(-180.0f, 180.0f);
+    s_imuDriftDegPerMs = Sim_RandRange(-IMU_DRIFT_DEG_PER_MIN, IMU_DRIFT_DEG_PER_MIN) / 60000.0f;
+    s_imuYawDeg = RAD_TO_DEG(Sim_WrapRad(s_robot.theta + DEG_TO_RAD(s_imuBiasDeg)));
+
+    MotionCtrl_Init(&s_motion, WHEEL_TRACK_WIDTH_M);
+    MotionCtrl_SetLimits(&s_motion,
+                         MOTION_MAX_LINEAR_VEL, MOTION_MAX_LINEAR_ACC, MOTION_MAX_LINEAR_JERK,
+                         MOTION_MAX_ANGULAR_VEL, MOTION_MAX_ANGULAR_ACC, MOTION_MAX_ANGULAR_JERK);
+    MotionCtrl_SetSyncGains(&s_motion, MOTION_SYNC_KP, MOTION_SYNC_KI, MOTION_SYNC_INTEGRAL_MAX);
+    MotionCtrl_SetYawFeedback(&s_motion, MOTION_YAW_FEEDBACK_ENABLE != 0, MOTION_YAW_KP);
+
+    uint32_t framePhase[4];
+    for (uint8_t i = 0; i < 4; i++) {
+        framePhase[i] = (uint32_t)(Sim_Rand() * DOCK_FRAME_MS);
+    }
+
+    s_nowMs = 1000U;
+    IRHoming_t homing;
+    IRHoming_Init(&homing);
+    IRHoming_Start(&homing, 0);
+
+    ChargeContact_t contact;
+    ChargeContact_Init(&contact, CHARGE_CONTACT_ON_MV, CHARGE_CONTACT_OFF_MV,
+                       CHARGE_CONTACT_ON_MS, CHARGE_CONTACT_OFF_MS);
+    bool lastOnContacts = false;
+    uint32_t contactMakeMs = 0;
+
+    bool lastBumperL = false, lastBumperR = false;
+    uint32_t startMs = s_nowMs;
+
+    for (uint32_t t = 0; t < SIM_LIMIT_MS; t += SIM_STEP_MS) {
+        s_nowMs = startMs + t;
+
+        /* 信标帧 */
+        for (uint8_t i = 0; i < 4; i++) {
+            if (((t + framePhase[i]) % DOCK_FRAME_MS) != 0U) continue;
+            uint8_t command = 0;
+            if (Sim_ReceiveFrame(i, &command)) {
+                NEC_Data_t nec;
+                memset(&nec, 0, sizeof(nec));
+                nec.address = 0x00;
+                nec.command = command;
+                nec.addressInv = 0xFF;
+                nec.commandInv = (uint8_t)~command;
+                nec.valid = true;
+                IRHoming_UpdateReceiver(&homing, (IRPosition_t)i, &nec);
+            }
+        }
+
+        /* 碰撞开关（边沿事件） */
+        if (s_robot.bumperL != lastBumperL || s_robot.bumperR != lastBumperR) {
+            lastBumperL = s_robot.bumperL;
+            lastBumperR = s_robot.bumperR;
+            IRHoming_UpdateBumperState(&homing, lastBumperL, lastBumperR);
+        }
+
+        /* 充电触点采样（刚接触时随机弹跳） */
+        if ((t % CHARGE_PERIOD_MS) == 0U) {
+            bool on = Sim_OnContacts();
+            if (on && !lastOnContacts) contactMakeMs = t;
+            lastOnContacts = on;
+            if (on && (t - contactMakeMs) < CONTACT_BOUNCE_MS && Sim_Rand() < 0.5f) on = false;
+            ChargeContact_Update(&contact, on ? CHARGE_DOCK_MV : 0U, s_nowMs);
+            IRHoming_UpdateChargeContact(&homing, ChargeContact_IsPresent(&contact));
+        }
+
+        if ((t % HOMING_PERIOD_MS) == 0U) {
+            IRHoming_Process(&homing);
+            if (homing.state >= HOMING_STATE_SEARCHING && homing.state <= HOMING_STATE_DOCKING) {
+                stats.lastState = homing.state;
+            }
+
+            if (trace != NULL && (t % 100U) == 0U) {
+                const IRReceiverStatus_t *rx[4] = { &homing.left, &homing.right, &homing.frontLeft, &homing.frontRight };
+                unsigned mask = 0;
+                for (uint8_t i = 0; i < 4; i++) {
+                    if (rx[i]->detected && rx[i]->command == s_rxOwnCode[i]) mask |= 1U << i;
+                }
+                fprintf(trace, "%.2f,%.3f,%.3f,%.1f,%d,%.2f,%.1f,%X\n", (float)t * 0.001f,
+                        s_robot.x, s_robot.y, RAD_TO_DEG(s_robot.theta), (int)homing.state,
+                        homing.beacon.confidence, RAD_TO_DEG(homing.beacon.bearingRad), mask);
+            }
+
+            if (homing.state == HOMING_STATE_DOCKED) {
+                stats.timeS = (float)t * 0.001f;
+                stats.lateralM = s_robot.y;
+                stats.headingDeg = RAD_TO_DEG(Sim_WrapRad(s_robot.theta - PI_F));
+                bool touching = (s_robot.x <= ROBOT_RADIUS_M + 0.01f);
+                bool aligned = (fabsf(stats.lateralM) <= DOCK_LATERAL_TOL_M) &&
+                               (fabsf(stats.headingDeg) <= DOCK_HEADING_TOL_DEG);
+                stats.result = (touching && aligned) ? RUN_DOCKED : RUN_FALSE_DOCK;
+                return stats;
+            }
+            if (!homing.enabled) {
+                if (homing.state == HOMING_STATE_FAILED) {
+                    stats.result = RUN_FAILED;
+                }
+                break;
+            }
+        }
+
+        if ((t % MOTION_PERIOD_MS) == 0U) {
+            float gz = 0.0f;
+            IMUTask_GetGyro(NULL, NULL, &gz);
+            MotionCtrl_Update(&s_motion, (float)MOTION_PERIOD_MS * 0.001f, s_robot.vl, s_robot.vr,
+                              DEG_TO_RAD(gz), true);
+        }
+        Sim_StepRobot((float)SIM_STEP_MS * 0.001f);
+    }
+
+    stats.timeS = (float)(s_nowMs - startMs) * 0.001f;
+    stats.atWall = (s_robot.x <= ROBOT_RADIUS_M + 0.01f);
+    return stats;
+}
+
+static int Sim_CompareFloat(const void *a, const void *b)
+{
+    float fa = *(const float*)a;
+    float fb = *(const float*)b;
+    return (fa > fb) - (fa < fb);
+}
+
+static float Sim_Percentile(const float *sorted, uint32_t count, uint32_t pct)
+{
+    if (count == 0U) return 0.0f;
+    uint32_t idx = (count - 1U) * pct / 100U;
+    return sorted[idx];
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t runs = 1000;
+    uint32_t seed = 1;
+    float minSuccess = -1.0f;
+    long traceIndex = -1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            runs = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            minSuccess = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            traceIndex = strtol(argv[++i], NULL, 10);
+        } else {
+            printf("用法: %s [-n 次数] [-s 种子] [-m 最低成功率] [-t 序号]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (traceIndex >= 0) {
+        printf("time,x,y,theta,state,conf,bearing,aligned\n");
+        RunStats_t st = Sim_Run(seed + (uint32_t)traceIndex, stdout);
+        fprintf(stderr, "result=%d time=%.1fs lateral=%.3fm heading=%.1f°\n",
+                (int)st.result, st.timeS, st.lateralM, st.headingDeg);
+        return 0;
+    }
+
+    float *times = (float*)malloc(sizeof(float) * (runs > 0U ? runs : 1U));
+    uint32_t counts[RUN_RESULT_COUNT] = {0};
+    uint32_t docked = 0;
+    float lateralSum = 0.0f, headingSum = 0.0f;
+    uint32_t hist[13] = {0};
+    uint32_t failState[HOMING_STATE_DOCKING + 1] = {0};
+    uint32_t failAtWall = 0;
+
+    for (uint32_t r = 0; r < runs; r++) {
+        RunStats_t st = Sim_Run(seed + r, NULL);
+        counts[st.result]++;
+        if (st.result == RUN_TIMEOUT || st.result == RUN_FAILED) {
+            if (st.lastState <= HOMING_STATE_DOCKING) failState[st.lastState]++;
+            if (st.atWall) failAtWall++;
+        }
+        if (st.result == RUN_DOCKED) {
+            times[docked++] = st.timeS;
+            lateralSum += fabsf(st.lateralM);
+            headingSum += fabsf(st.headingDeg);
+            uint32_t bucket = (uint32_t)(st.timeS / 10.0f);
+            hist[(bucket < 12U) ? bucket : 12U]++;
+        }
+    }
+
+    qsort(times, docked, sizeof(float), Sim_CompareFloat);
+    float mean = 0.0f;
+    for (uint32_t i = 0; i < docked; i++) mean += times[i];
+    mean = (docked > 0U) ? mean / (float)docked : 0.0f;
+    float success = (runs > 0U) ? (float)counts[RUN_DOCKED] / (float)runs : 0.0f;
+
+    printf("回冲仿真: %u 次, 种子 %u\n", runs, seed);
+    printf("  对接成功 %u (%.1f%%)  误对接 %u  重试用完 %u  超时 %u\n", counts[RUN_DOCKED], success * 100.0f,
+           counts[RUN_FALSE_DOCK], counts[RUN_FAILED], counts[RUN_TIMEOUT]);
+    printf("  失败前状态: 搜索 %u 接近 %u 对齐 %u 对接 %u，其中贴墙 %u\n",
+           failState[HOMING_STATE_SEARCHING], failState[HOMING_STATE_APPROACHING],
+           failState[HOMING_STATE_ALIGNING], failState[HOMING_STATE_DOCKING], failAtWall);
+    printf("  对接用时 mean=%.1fs p50=%.1fs p90=%.1fs p99=%.1fs max=%.1fs\n", mean,
+           Sim_Percentile(times, docked, 50), Sim_Percentile(times, docked, 90),
+           Sim_Percentile(times, docked, 99), (docked > 0U) ? times[docked - 1U] : 0.0f);
+    printf("  对接误差 横向=%.1fmm 航向=%.1f°\n",
+           (docked > 0U) ? lateralSum / (float)docked * 1000.0f : 0.0f,
+           (docked > 0U) ? headingSum / (float)docked : 0.0f);
+    printf("  用时分布(s):");
+    for (uint32_t b = 0; b < 13U; b++) {
+        if (hist[b] == 0U) continue;
+        if (b < 12U) printf(" %u-%u:%u", b * 10U, b * 10U + 10U, hist[b]);
+        else printf(" >=120:%u", hist[b]);
+    }
+    printf("\n");
+    free(times);
+
+    if (minSuccess >= 0.0f && success < minSuccess) {
+        printf("[FAIL] 成功率 %.1f%% 低于 %.1f%%\n", success * 100.0f, minSuccess * 100.0f);
+        return 1;
+    }
+    return 0;
+}
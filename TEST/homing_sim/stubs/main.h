@@ -0,0 +1,23 @@
+/**
+  ******************************************************************************
+  * @file    main.h
+  * @brief   上位机仿真桩：替代 CubeMX 生成的 main.h
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 只提供回冲模块用到的 HAL 符号，时间由仿真器推进。
+  ******************************************************************************
+  */
+
+#ifndef __MAIN_H
+#define __MAIN_H
+
+#include <stdint.h>
+
+typedef struct GPIO_TypeDef GPIO_TypeDef;
+typedef struct TIM_HandleTypeDef TIM_HandleTypeDef;
+
+uint32_t HAL_GetTick(void);
+
+#endif /* __MAIN_H */
@@ -0,0 +1,23 @@
+/**
+  ******************************************************************************
+  * @file    motor_ctrl_task.h
+  * @brief   上位机仿真桩：电机控制任务接口
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 回冲模块只调用速度设置接口，由仿真器接到运动控制器与运动学模型；
+  * 配置宏直接取自固件的 hw_config.h / common_def.h。
+  ******************************************************************************
+  */
+
+#ifndef __MOTOR_CTRL_TASK_H__
+#define __MOTOR_CTRL_TASK_H__
+
+#include "hw_config.h"
+#include "common_def.h"
+
+void MotorCtrlTask_SetWheelSpeed(float leftSpeedMs, float rightSpeedMs);
+void MotorCtrlTask_SetVelocity(float linearMs, float angularRadS);
+
+#endif /* __MOTOR_CTRL_TASK_H__ */
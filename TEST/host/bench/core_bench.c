@@ -0,0 +1,333 @@
+/**
+  ******************************************************************************
+  * @file    core_bench.c
+  * @brief   可移植核心模块上位机微基准
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 用法：core_bench [--quick] [--save 文件] [--baseline 文件 [--tolerance 倍数]]
+  * 每项基准重复运行到达到最短时长，输出 ns/次 与吞吐；--save 保存结果，
+  * --baseline 与保存的结果比较，任一项变慢超过 tolerance 倍（默认1.3）时返回非0。
+  * 基线只在同一台机器、同一构建类型下比较才有意义。
+  ******************************************************************************
+  */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "ring_buffer.h"
+#include "usb_frame.h"
+#include "pid_controller.h"
+#include "nec_decode.h"
+#include "encoder_math.h"
+#include "cmsis_os.h"
+#include "nec_synth.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_MAX_RESULTS       16
+#define BENCH_NAME_LEN          24
+#define BENCH_MIN_NS_NORMAL     300000000.0
+#define BENCH_MIN_NS_QUICK      20000000.0
+#define BENCH_DEFAULT_TOLERANCE 1.3
+
+typedef struct {
+    char name[BENCH_NAME_LEN];
+    double nsPerOp;
+    double bytesPerOp;          /* 0=不输出MB/s */
+} BenchResult_t;
+
+/* 单次基准：执行 iterations 次操作 */
+typedef void (*BenchFn_t)(uint32_t iterations);
+
+static BenchResult_t s_results[BENCH_MAX_RESULTS];
+static int s_resultCount = 0;
+static double s_minNs = BENCH_MIN_NS_NORMAL;
+static volatile uint32_t s_sink;
+
+static double Bench_NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+  * @brief  倍增迭代次数直到单轮耗时超过最短时长，记录 ns/次
+  */
+static void Bench_Run(const char *name, BenchFn_t fn, double bytesPerOp)
+{
+    uint32_t iterations = 16;
+    double elapsed = 0.0;
+
+    fn(iterations);     /* 预热 */
+    for (;;) {
+        double start = Bench_NowNs();
+        fn(iterations);
+        elapsed = Bench_NowNs() - start;
+        if (elapsed >= s_minNs || iterations >= (1U << 30)) break;
+        iterations *= 2U;
+    }
+
+    BenchResult_t *r = &s_results[s_resultCount++];
+    snprintf(r->name, sizeof(r->name), "%s", name);
+    r->nsPerOp = elapsed / (double)iterations;
+    r->bytesPerOp = bytesPerOp;
+
+    printf("%-16s %10.1f ns %12.0f /s", r->name, r->nsPerOp, 1e9 / r->nsPerOp);
+    if (bytesPerOp > 0.0) {
+        printf(" %9.1f MB/s", bytesPerOp * 1e3 / r->nsPerOp);
+    }
+    printf("\n");
+}
+
+/* ----------------- 环形缓冲 ----------------- */
+#define RING_SIZE       512U
+#define RING_BLOCK      64U
+
+static uint8_t s_ringStorage[RING_SIZE];
+static RingBuffer_t s_ring;
+
+/* 逐字节写入再读出一个块（与 USB 接收路径一致） */
+static void Bench_RingByte(uint32_t iterations)
+{
+    uint8_t v = 0;
+    uint32_t acc = 0;
+    for (uint32_t it = 0; it < iterations; it++) {
+        for (uint32_t i = 0; i < RING_BLOCK; i++) {
+            RingBuffer_Put(&s_ring, (uint8_t)i);
+        }
+        for (uint32_t i = 0; i < RING_BLOCK; i++) {
+            RingBuffer_Get(&s_ring, &v);
+            acc += v;
+        }
+    }
+    s_sink = acc;
+}
+
+static void Bench_RingBlock(uint32_t iterations)
+{
+    uint8_t in[RING_BLOCK];
+    uint8_t out[RING_BLOCK];
+    memset(in, 0xA5, sizeof(in));
+    uint32_t acc = 0;
+    for (uint32_t it = 0; it < iterations; it++) {
+        RingBuffer_PutData(&s_ring, in, sizeof(in));
+        acc += RingBuffer_GetData(&s_ring, out, sizeof(out));
+    }
+    s_sink = acc + out[0];
+}
+
+/* ----------------- 帧编解码与CRC ----------------- */
+#define CRC_BLOCK       1024U
+#define DECODE_FRAMES   16U
+
+static uint8_t s_crcData[CRC_BLOCK];
+static uint8_t s_payload[USB_FRAME_MAX_PAYLOAD];
+static uint8_t s_stream[DECODE_FRAMES * USB_FRAME_MAX_SIZE];
+static uint32_t s_streamLen = 0;
+
+static void Bench_Crc(uint32_t iterations)
+{
+    uint32_t acc = 0;
+    for (uint32_t it = 0; it < iterations; it++) {
+        acc += UsbFrame_Crc16(s_crcData, CRC_BLOCK);
+    }
+    s_sink = acc;
+}
+
+static void Bench_FrameEncode(uint32_t iterations)
+{
+    uint8_t frame[USB_FRAME_MAX_SIZE];
+    uint32_t acc = 0;
+    for (uint32_t it = 0; it < iterations; it++) {
+        acc += UsbFrame_Encode(frame, sizeof(frame), 0x2B, (uint8_t)it, s_payload, USB_FRAME_MAX_PAYLOAD);
+    }
+    s_sink = acc + frame[USB_FRAME_MAX_SIZE - 1];
+}
+
+/* 一次操作 = 解析一帧满负载帧 */
+static void Bench_FrameDecode(uint32_t iterations)
+{
+    UsbFrameParser_t parser;
+    UsbFrame_ParserInit(&parser);
+    uint32_t frames = 0;
+    uint32_t pos = 0;
+    for (uint32_t it = 0; it < iterations; it++) {
+        uint32_t end = pos + USB_FRAME_MAX_SIZE;
+        for (; pos < end; pos++) {
+            frames += UsbFrame_Parse(&parser, s_stream[pos]) ? 1U : 0U;
+        }
+        if (pos >= s_streamLen) pos = 0;
+    }
+    s_sink = frames;
+}
+
+/* ----------------- PID ----------------- */
+static void Bench_PidStep(uint32_t iterations)
+{
+    PIDController_t pid;
+    HostOS_SetTick(0);
+    PID_Init(&pid, 1.2f, 0.5f, 0.01f);
+    PID_SetTarget(&pid, 0.3f);
+    float y = 0.0f;
+    for (uint32_t it = 0; it < iterations; it++) {
+        HostOS_AdvanceTick(1);
+        float u = PID_Compute(&pid, y);
+        y += (u * 0.0001f - y) * 0.05f;
+    }
+    s_sink = (uint32_t)(y * 1000.0f);
+}
+
+/* ----------------- NEC解码 ----------------- */
+static NecEdge_t s_necEdges[NEC_SYNTH_MAX_EDGES];
+static uint32_t s_necEdgeCount = 0;
+static uint32_t s_necFrameSpan = 0;
+
+/* 一次操作 = 解码一帧完整NEC */
+static void Bench_NecDecode(uint32_t iterations)
+{
+    NEC_Decoder_t dec;
+    NEC_Decoder_Init(&dec);
+    uint32_t frames = 0;
+    uint32_t base = 0;
+    for (uint32_t it = 0; it < iterations; it++) {
+        for (uint32_t i = 0; i < s_necEdgeCount; i++) {
+            if (NEC_Decoder_ProcessEdge(&dec, base + s_necEdges[i].time, s_necEdges[i].mark)) {
+                frames += NEC_Decoder_GetData(&dec).command;
+            }
+        }
+        base += s_necFrameSpan;
+    }
+    s_sink = frames;
+}
+
+/* ----------------- 编码器换算 ----------------- */
+/* 一次操作 = 一个编码器的1kHz更新（计数扩展 + 转速/线速度 + 两次低通 + 角度） */
+static void Bench_EncoderTick(uint32_t iterations)
+{
+    int16_t last = 0;
+    int32_t overflow = 0;
+    int32_t prev = 0;
+    float rpm = 0.0f;
+    float ms = 0.0f;
+    float angle = 0.0f;
+    uint16_t hw = 0;
+    for (uint32_t it = 0; it < iterations; it++) {
+        hw = (uint16_t)(hw + 37U);
+        int32_t count = EncoderMath_ExtendCount((int16_t)hw, &last, &overflow);
+        int32_t delta = count - prev;
+        prev = count;
+        rpm = EncoderMath_Lowpass(rpm, EncoderMath_Rpm(delta, 390U, 1U), 0.8f);
+        ms = EncoderMath_Lowpass(ms, EncoderMath_SpeedMs(delta, 4500U, 1U), 0.2f);
+        angle = EncoderMath_Angle(count, 13U);
+    }
+    s_sink = (uint32_t)(rpm + ms + angle);
+}
+
+static void Bench_Setup(void)
+{
+    RingBuffer_Init(&s_ring, s_ringStorage, RING_SIZE);
+
+    for (uint32_t i = 0; i < CRC_BLOCK; i++) {
+        s_crcData[i] = (uint8_t)(i * 131U + 7U);
+    }
+    for (uint32_t i = 0; i < USB_FRAME_MAX_PAYLOAD; i++) {
+        s_payload[i] = (uint8_t)(i * 29U);
+    }
+    s_streamLen = 0;
+    for (uint32_t f = 0; f < DECODE_FRAMES; f++) {
+        s_streamLen += UsbFrame_Encode(&s_stream[s_streamLen], (uint16_t)(sizeof(s_stream) - s_streamLen),
+                                       0x10, (uint8_t)f, s_payload, USB_FRAME_MAX_PAYLOAD);
+    }
+
+    s_necEdgeCount = NecSynth_Frame(s_necEdges, 0U, 0x5A, 0x3C);
+    s_necFrameSpan = s_necEdges[s_necEdgeCount - 1U].time + 40000U;
+}
+
+/* ----------------- 基线 ----------------- */
+static int Bench_Save(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        printf("无法写入 %s\n", path);
+        return 1;
+    }
+    for (int i = 0; i < s_resultCount; i++) {
+        fprintf(f, "%s %.3f\n", s_results[i].name, s_results[i].nsPerOp);
+    }
+    fclose(f);
+    printf("-> %s\n", path);
+    return 0;
+}
+
+static int Bench_Compare(const char *path, double tolerance)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        printf("无法打开基线 %s\n", path);
+        return 1;
+    }
+
+    int regressions = 0;
+    char name[BENCH_NAME_LEN];
+    double baseNs;
+    printf("\n%-16s %10s %10s %8s\n", "基准", "基线ns", "本次ns", "比值");
+    while (fscanf(f, "%23s %lf", name, &baseNs) == 2) {
+        for (int i = 0; i < s_resultCount; i++) {
+            if (strcmp(name, s_results[i].name) != 0 || baseNs <= 0.0) continue;
+            double ratio = s_results[i].nsPerOp / baseNs;
+            bool slow = (ratio > tolerance);
+            printf("%-16s %10.1f %10.1f %7.2fx%s\n", name, baseNs, s_results[i].nsPerOp, ratio,
+                   slow ? "  变慢" : "");
+            regressions += slow ? 1 : 0;
+        }
+    }
+    fclose(f);
+    printf("%d 项超过 %.2fx\n", regressions, tolerance);
+    return regressions ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *savePath = NULL;
+    const char *baselinePath = NULL;
+    double tolerance = BENCH_DEFAULT_TOLERANCE;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quick") == 0) {
+            s_minNs = BENCH_MIN_NS_QUICK;
+        } else if (strcmp(argv[i], "--save") == 0 && i + 1 < argc) {
+            savePath = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance = atof(argv[++i]);
+        } else {
+            printf("用法: %s [--quick] [--save 文件] [--baseline 文件 [--tolerance 倍数]]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    Bench_Setup();
+
+    Bench_Run("ring_byte", Bench_RingByte, RING_BLOCK);
+    Bench_Run("ring_block", Bench_RingBlock, RING_BLOCK);
+    Bench_Run("crc16_1k", Bench_Crc, CRC_BLOCK);
+    Bench_Run("frame_encode", Bench_FrameEncode, USB_FRAME_MAX_SIZE);
+    Bench_Run("frame_decode", Bench_FrameDecode, USB_FRAME_MAX_SIZE);
+    Bench_Run("pid_step", Bench_PidStep, 0.0);
+    Bench_Run("nec_decode", Bench_NecDecode, 0.0);
+    Bench_Run("encoder_tick", Bench_EncoderTick, 0.0);
+
+    int rc = 0;
+    if (savePath != NULL) {
+        rc |= Bench_Save(savePath);
+    }
+    if (baselinePath != NULL) {
+        rc |= Bench_Compare(baselinePath, tolerance);
+    }
+    return rc;
+}
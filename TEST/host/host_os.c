@@ -0,0 +1,27 @@
+/**
+  ******************************************************************************
+  * @file    host_os.c
+  * @brief   上位机构建的OS垫片实现（手动推进的系统节拍）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "cmsis_os.h"
+
+static uint32_t s_tick = 0;
+
+uint32_t osKernelGetTickCount(void)
+{
+    return s_tick;
+}
+
+void HostOS_SetTick(uint32_t tick)
+{
+    s_tick = tick;
+}
+
+void HostOS_AdvanceTick(uint32_t ms)
+{
+    s_tick += ms;
+}
@@ -0,0 +1,62 @@
+/**
+  ******************************************************************************
+  * @file    nec_synth.h
+  * @brief   上位机用NEC边沿序列合成（单元测试与基准共用）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#ifndef __NEC_SYNTH_H__
+#define __NEC_SYNTH_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define NEC_SYNTH_MAX_EDGES     68      /* 引导2 + 32位×2 + 停止位2 */
+
+typedef struct {
+    uint32_t time;              /* 边沿时间 (us) */
+    bool mark;                  /* 边沿后为载波 */
+} NecEdge_t;
+
+/**
+  * @brief  合成一帧NEC（字节顺序与解码引擎一致：地址、命令、地址反码、命令反码，LSB先发）
+  * @param  edges: 输出，至少 NEC_SYNTH_MAX_EDGES
+  * @param  start: 首个边沿时间 (us)
+  * @retval 边沿数
+  */
+static inline uint32_t NecSynth_Frame(NecEdge_t *edges, uint32_t start, uint8_t address, uint8_t command)
+{
+    uint32_t n = 0;
+    uint32_t t = start;
+    uint32_t data = (uint32_t)address | ((uint32_t)command << 8) |
+                    ((uint32_t)(uint8_t)~address << 16) | ((uint32_t)(uint8_t)~command << 24);
+
+    edges[n].time = t; edges[n++].mark = true;  t += 9000U;
+    edges[n].time = t; edges[n++].mark = false; t += 4500U;
+    for (uint32_t i = 0; i < 32U; i++) {
+        edges[n].time = t; edges[n++].mark = true;  t += 560U;
+        edges[n].time = t; edges[n++].mark = false; t += ((data >> i) & 1U) ? 1690U : 560U;
+    }
+    edges[n].time = t; edges[n++].mark = true;  t += 560U;
+    edges[n].time = t; edges[n++].mark = false;
+    return n;
+}
+
+/**
+  * @brief  合成NEC重复帧
+  * @retval 边沿数
+  */
+static inline uint32_t NecSynth_Repeat(NecEdge_t *edges, uint32_t start)
+{
+    uint32_t n = 0;
+    uint32_t t = start;
+    edges[n].time = t; edges[n++].mark = true;  t += 9000U;
+    edges[n].time = t; edges[n++].mark = false; t += 2250U;
+    edges[n].time = t; edges[n++].mark = true;  t += 560U;
+    edges[n].time = t; edges[n++].mark = false;
+    return n;
+}
+
+#endif /* __NEC_SYNTH_H__ */
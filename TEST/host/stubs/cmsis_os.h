@@ -0,0 +1,25 @@
+/**
+  ******************************************************************************
+  * @file    cmsis_os.h
+  * @brief   上位机构建的OS垫片：替代 CMSIS-RTOS2 头文件
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 可移植模块只用到系统节拍；上位机节拍由测试/基准程序推进，
+  * 保证 PID 等按节拍求 dt 的模块结果可复现。
+  ******************************************************************************
+  */
+
+#ifndef __CMSIS_OS_H__
+#define __CMSIS_OS_H__
+
+#include <stdint.h>
+
+uint32_t osKernelGetTickCount(void);
+
+/* 上位机节拍控制 */
+void HostOS_SetTick(uint32_t tick);
+void HostOS_AdvanceTick(uint32_t ms);
+
+#endif /* __CMSIS_OS_H__ */
@@ -0,0 +1,75 @@
+/**
+  ******************************************************************************
+  * @file    test_encoder_math.c
+  * @brief   编码器计数与速度换算单元测试
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "encoder_math.h"
+#include "test_util.h"
+
+static void Test_ExtendForwardWrap(void)
+{
+    int16_t last = 0;
+    int32_t overflow = 0;
+    int32_t count = 0;
+
+    /* 每次前进 1000 脉冲，跨越多次 int16 回绕 */
+    uint16_t hw = 0;
+    for (int i = 1; i <= 200; i++) {
+        hw = (uint16_t)(hw + 1000U);
+        count = EncoderMath_ExtendCount((int16_t)hw, &last, &overflow);
+    }
+    CHECK_EQ(count, 200000);
+}
+
+static void Test_ExtendBackwardWrap(void)
+{
+    int16_t last = 0;
+    int32_t overflow = 0;
+    int32_t count = 0;
+
+    uint16_t hw = 0;
+    for (int i = 1; i <= 150; i++) {
+        hw = (uint16_t)(hw - 700U);
+        count = EncoderMath_ExtendCount((int16_t)hw, &last, &overflow);
+    }
+    CHECK_EQ(count, -105000);
+}
+
+static void Test_SpeedConversions(void)
+{
+    /* 13线 × 30减速比，1ms内 13 个脉冲 = 1/30 转 / ms = 2000 RPM */
+    CHECK_NEAR(EncoderMath_Rpm(13, 13U * 30U, 1U), 2000.0f, 1e-2);
+    CHECK_NEAR(EncoderMath_Rpm(-390, 390U, 10U), -6000.0f, 1e-2);
+    CHECK_NEAR(EncoderMath_Rpm(10, 0U, 1U), 0.0f, 0.0);
+
+    CHECK_NEAR(EncoderMath_SpeedMs(5, 5000U, 1U), 1.0f, 1e-6);
+    CHECK_NEAR(EncoderMath_SpeedMs(50, 5000U, 20U), 0.5f, 1e-6);
+    CHECK_NEAR(EncoderMath_SpeedMs(5, 5000U, 0U), 0.0f, 0.0);
+}
+
+static void Test_AngleAndLowpass(void)
+{
+    CHECK_NEAR(EncoderMath_Angle(130, 13U), 10.0f * ENCODER_MATH_TWO_PI, 1e-3);
+    CHECK_NEAR(EncoderMath_Angle(-13, 13U), -ENCODER_MATH_TWO_PI, 1e-5);
+    CHECK_NEAR(EncoderMath_Angle(100, 0U), 0.0f, 0.0);
+
+    float y = 0.0f;
+    for (int i = 0; i < 100; i++) {
+        y = EncoderMath_Lowpass(y, 10.0f, 0.2f);
+    }
+    CHECK_NEAR(y, 10.0f, 1e-4);
+    CHECK_NEAR(EncoderMath_Lowpass(4.0f, 8.0f, 0.25f), 5.0f, 1e-6);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_ExtendForwardWrap);
+    TEST_RUN(Test_ExtendBackwardWrap);
+    TEST_RUN(Test_SpeedConversions);
+    TEST_RUN(Test_AngleAndLowpass);
+    return TEST_EXIT();
+}
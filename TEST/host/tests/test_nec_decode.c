@@ -0,0 +1,100 @@
+/**
+  ******************************************************************************
+  * @file    test_nec_decode.c
+  * @brief   NEC解码单元测试（合成边沿序列）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "nec_decode.h"
+#include "nec_synth.h"
+#include "test_util.h"
+
+/* 回放边沿，返回解出的帧数，最后一帧写入 out */
+static int Feed(NEC_Decoder_t *dec, const NecEdge_t *edges, uint32_t n, NEC_Data_t *out)
+{
+    int frames = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (NEC_Decoder_ProcessEdge(dec, edges[i].time, edges[i].mark)) {
+            *out = NEC_Decoder_GetData(dec);
+            frames++;
+        }
+    }
+    return frames;
+}
+
+static void Test_DecodeFrame(void)
+{
+    NEC_Decoder_t dec;
+    NEC_Decoder_Init(&dec);
+
+    NecEdge_t edges[NEC_SYNTH_MAX_EDGES];
+    NEC_Data_t data = {0};
+    uint32_t n = NecSynth_Frame(edges, 1000U, 0x5A, 0xC3);
+
+    CHECK_EQ(Feed(&dec, edges, n, &data), 1);
+    CHECK(data.valid);
+    CHECK(!data.repeat);
+    CHECK_EQ(data.address, 0x5A);
+    CHECK_EQ(data.command, 0xC3);
+    CHECK_EQ(data.commandInv, (uint8_t)~0xC3);
+}
+
+static void Test_RepeatAndTimeWrap(void)
+{
+    NEC_Decoder_t dec;
+    NEC_Decoder_Init(&dec);
+
+    NecEdge_t edges[NEC_SYNTH_MAX_EDGES];
+    NEC_Data_t data = {0};
+    /* 帧跨越 32 位微秒计数回绕 */
+    uint32_t start = 0xFFFFFFFFU - 20000U;
+    uint32_t n = NecSynth_Frame(edges, start, 0x01, 0x02);
+    CHECK_EQ(Feed(&dec, edges, n, &data), 1);
+    CHECK_EQ(data.command, 0x02);
+
+    n = NecSynth_Repeat(edges, edges[n - 1].time + 40000U);
+    CHECK_EQ(Feed(&dec, edges, n, &data), 1);
+    CHECK(data.repeat);
+}
+
+static void Test_RejectsBadInverse(void)
+{
+    NEC_Decoder_t dec;
+    NEC_Decoder_Init(&dec);
+
+    NecEdge_t edges[NEC_SYNTH_MAX_EDGES];
+    NEC_Data_t data = {0};
+    uint32_t n = NecSynth_Frame(edges, 0U, 0x10, 0x20);
+    /* 命令反码最高位由1改为0：把第31位的长空号改短 */
+    uint32_t shift = 1690U - 560U;
+    for (uint32_t i = 2U + 31U * 2U + 2U; i < n; i++) {
+        edges[i].time -= shift;
+    }
+    CHECK_EQ(Feed(&dec, edges, n, &data), 0);
+    CHECK(dec.ir.stats.errorCount > 0U);
+}
+
+static void Test_Timeout(void)
+{
+    NEC_Decoder_t dec;
+    NEC_Decoder_Init(&dec);
+
+    NecEdge_t edges[NEC_SYNTH_MAX_EDGES];
+    NEC_Data_t data = {0};
+    uint32_t n = NecSynth_Frame(edges, 0U, 0x10, 0x20);
+    /* 只送前一半边沿，然后静默 */
+    CHECK_EQ(Feed(&dec, edges, n / 2U, &data), 0);
+    CHECK(NEC_Decoder_Poll(&dec, edges[n / 2U - 1U].time + IR_DECODE_FRAME_TIMEOUT_US + 1U));
+    CHECK_EQ(dec.ir.stats.timeoutCount, 1);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_DecodeFrame);
+    TEST_RUN(Test_RepeatAndTimeWrap);
+    TEST_RUN(Test_RejectsBadInverse);
+    TEST_RUN(Test_Timeout);
+    return TEST_EXIT();
+}
@@ -0,0 +1,91 @@
+/**
+  ******************************************************************************
+  * @file    test_pid.c
+  * @brief   PID控制器单元测试（节拍由OS垫片推进）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "pid_controller.h"
+#include "cmsis_os.h"
+#include "test_util.h"
+
+static void Test_ProportionalOnly(void)
+{
+    PIDController_t pid;
+    HostOS_SetTick(1000);
+    PID_Init(&pid, 2.0f, 0.0f, 0.0f);
+
+    /* 目标为0时不加死区补偿，纯比例 */
+    HostOS_AdvanceTick(10);
+    CHECK_NEAR(PID_Compute(&pid, 50.0f), -100.0f, 1e-4);
+}
+
+static void Test_DeadbandOffset(void)
+{
+    PIDController_t pid;
+    HostOS_SetTick(0);
+    PID_Init(&pid, 1.0f, 0.0f, 0.0f);
+    PID_SetTarget(&pid, 100.0f);
+
+    /* 目标非0时输出按符号叠加 ±200 */
+    HostOS_AdvanceTick(10);
+    CHECK_NEAR(PID_Compute(&pid, 40.0f), 260.0f, 1e-4);
+    HostOS_AdvanceTick(10);
+    CHECK_NEAR(PID_Compute(&pid, 150.0f), -250.0f, 1e-4);
+}
+
+static void Test_IntegralAndLimits(void)
+{
+    PIDController_t pid;
+    HostOS_SetTick(0);
+    PID_Init(&pid, 0.0f, 1.0f, 0.0f);
+    PID_SetIntegralLimit(&pid, -5.0f, 5.0f);
+    PID_SetOutputLimit(&pid, -3.0f, 3.0f);
+
+    HostOS_AdvanceTick(100);
+    PID_Compute(&pid, -10.0f);                  /* 误差10，dt=0.1s */
+    CHECK_NEAR(pid.integral, 1.0f, 1e-5);
+    CHECK_NEAR(pid.output, 1.0f, 1e-5);
+
+    for (int i = 0; i < 20; i++) {
+        HostOS_AdvanceTick(100);
+        PID_Compute(&pid, -10.0f);
+    }
+    CHECK_NEAR(pid.integral, 5.0f, 1e-5);       /* 积分限幅 */
+    CHECK_NEAR(pid.output, 3.0f, 1e-5);         /* 输出限幅 */
+}
+
+static void Test_DerivativeAndZeroDt(void)
+{
+    PIDController_t pid;
+    HostOS_SetTick(0);
+    PID_Init(&pid, 0.0f, 0.0f, 1.0f);
+
+    HostOS_AdvanceTick(10);
+    PID_Compute(&pid, 0.0f);
+    HostOS_AdvanceTick(10);
+    CHECK_NEAR(PID_Compute(&pid, -1.0f), 100.0f, 1e-3);   /* 误差变化1 / 0.01s */
+
+    /* 同一节拍内再次计算：dt按1ms处理 */
+    CHECK_NEAR(PID_Compute(&pid, -1.0f), 0.0f, 1e-3);
+}
+
+static void Test_Disabled(void)
+{
+    PIDController_t pid;
+    PID_Init(&pid, 1.0f, 1.0f, 1.0f);
+    PID_Disable(&pid);
+    CHECK_NEAR(PID_Compute(&pid, 5.0f), 0.0f, 0.0);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_ProportionalOnly);
+    TEST_RUN(Test_DeadbandOffset);
+    TEST_RUN(Test_IntegralAndLimits);
+    TEST_RUN(Test_DerivativeAndZeroDt);
+    TEST_RUN(Test_Disabled);
+    return TEST_EXIT();
+}
@@ -0,0 +1,88 @@
+/**
+  ******************************************************************************
+  * @file    test_ring_buffer.c
+  * @brief   环形缓冲区单元测试
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "ring_buffer.h"
+#include "test_util.h"
+#include <string.h>
+
+static void Test_PutGetOrder(void)
+{
+    uint8_t storage[8];
+    RingBuffer_t rb;
+    RingBuffer_Init(&rb, storage, sizeof(storage));
+
+    CHECK(RingBuffer_IsEmpty(&rb));
+    for (uint8_t i = 0; i < 8; i++) {
+        CHECK(RingBuffer_Put(&rb, i));
+    }
+    CHECK(RingBuffer_IsFull(&rb));
+    CHECK(!RingBuffer_Put(&rb, 99));
+
+    uint8_t v = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        CHECK(RingBuffer_Get(&rb, &v));
+        CHECK_EQ(v, i);
+    }
+    CHECK(!RingBuffer_Get(&rb, &v));
+}
+
+static void Test_WrapAround(void)
+{
+    uint8_t storage[5];
+    RingBuffer_t rb;
+    RingBuffer_Init(&rb, storage, sizeof(storage));
+
+    uint8_t in[3] = {1, 2, 3};
+    uint8_t out[5];
+    for (int round = 0; round < 10; round++) {
+        CHECK_EQ(RingBuffer_PutData(&rb, in, sizeof(in)), 3);
+        CHECK_EQ(RingBuffer_GetData(&rb, out, sizeof(out)), 3);
+        CHECK(memcmp(in, out, sizeof(in)) == 0);
+        in[0]++; in[1]++; in[2]++;
+    }
+    CHECK_EQ(RingBuffer_GetCount(&rb), 0);
+    CHECK_EQ(RingBuffer_GetFree(&rb), 5);
+}
+
+static void Test_PartialPut(void)
+{
+    uint8_t storage[4];
+    RingBuffer_t rb;
+    RingBuffer_Init(&rb, storage, sizeof(storage));
+
+    uint8_t in[6] = {10, 11, 12, 13, 14, 15};
+    CHECK_EQ(RingBuffer_PutData(&rb, in, sizeof(in)), 4);
+    CHECK_EQ(RingBuffer_GetFree(&rb), 0);
+}
+
+static void Test_PutFront(void)
+{
+    uint8_t storage[4];
+    RingBuffer_t rb;
+    RingBuffer_Init(&rb, storage, sizeof(storage));
+
+    RingBuffer_Put(&rb, 2);
+    RingBuffer_Put(&rb, 3);
+    CHECK(RingBuffer_PutFront(&rb, 1));
+
+    uint8_t out[3];
+    CHECK_EQ(RingBuffer_GetData(&rb, out, sizeof(out)), 3);
+    CHECK_EQ(out[0], 1);
+    CHECK_EQ(out[1], 2);
+    CHECK_EQ(out[2], 3);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_PutGetOrder);
+    TEST_RUN(Test_WrapAround);
+    TEST_RUN(Test_PartialPut);
+    TEST_RUN(Test_PutFront);
+    return TEST_EXIT();
+}
@@ -0,0 +1,140 @@
+/**
+  ******************************************************************************
+  * @file    test_usb_frame.c
+  * @brief   USB协议帧编解码单元测试
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "usb_frame.h"
+#include "test_util.h"
+#include <string.h>
+
+static void Test_CrcKnownValue(void)
+{
+    /* CRC-16/CCITT-FALSE 标准校验值 */
+    const uint8_t data[] = "123456789";
+    CHECK_EQ(UsbFrame_Crc16(data, 9), 0x29B1);
+}
+
+static void Test_EncodeLayout(void)
+{
+    uint8_t payload[3] = {0x01, 0x02, 0x03};
+    uint8_t frame[USB_FRAME_MAX_SIZE];
+    uint16_t len = UsbFrame_Encode(frame, sizeof(frame), 0x24, 7, payload, sizeof(payload));
+
+    CHECK_EQ(len, 3 + USB_FRAME_OVERHEAD);
+    CHECK_EQ(frame[0], 0x55);
+    CHECK_EQ(frame[1], 0xAA);
+    CHECK_EQ(frame[2], USB_FRAME_VERSION);
+    CHECK_EQ(frame[3], 3);
+    CHECK_EQ(frame[4], 0);
+    CHECK_EQ(frame[5], 0x24);
+    CHECK_EQ(frame[6], 7);
+    uint16_t crc = UsbFrame_Crc16(&frame[2], 5 + 3);
+    CHECK_EQ(frame[10], crc & 0xFF);
+    CHECK_EQ(frame[11], crc >> 8);
+}
+
+static void Test_EncodeLimits(void)
+{
+    uint8_t payload[USB_FRAME_MAX_PAYLOAD + 1] = {0};
+    uint8_t frame[USB_FRAME_MAX_SIZE];
+
+    CHECK_EQ(UsbFrame_Encode(frame, sizeof(frame), 0x20, 0, payload, USB_FRAME_MAX_PAYLOAD), USB_FRAME_MAX_SIZE);
+    CHECK_EQ(UsbFrame_Encode(frame, sizeof(frame), 0x20, 0, payload, USB_FRAME_MAX_PAYLOAD + 1), 0);
+    CHECK_EQ(UsbFrame_Encode(frame, USB_FRAME_MAX_SIZE - 1, 0x20, 0, payload, USB_FRAME_MAX_PAYLOAD), 0);
+    CHECK_EQ(UsbFrame_Encode(frame, sizeof(frame), 0x20, 0, NULL, 0), USB_FRAME_OVERHEAD);
+}
+
+static void Test_RoundTripWithNoise(void)
+{
+    UsbFrameParser_t parser;
+    UsbFrame_ParserInit(&parser);
+
+    uint8_t stream[512];
+    uint32_t n = 0;
+    /* 帧前杂散字节，含一个孤立帧头 */
+    stream[n++] = 0x00;
+    stream[n++] = 0x55;
+    stream[n++] = 0x12;
+    for (uint8_t f = 0; f < 3; f++) {
+        uint8_t payload[40];
+        for (uint8_t i = 0; i < sizeof(payload); i++) {
+            payload[i] = (uint8_t)(f * 40 + i);
+        }
+        n += UsbFrame_Encode(&stream[n], (uint16_t)(sizeof(stream) - n), (uint8_t)(0x10 + f), f, payload, (uint16_t)(10 + f * 10));
+    }
+
+    int got = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (UsbFrame_Parse(&parser, stream[i])) {
+            CHECK_EQ(parser.msgId, 0x10 + got);
+            CHECK_EQ(parser.seq, got);
+            CHECK_EQ(parser.payloadLen, 10 + got * 10);
+            CHECK_EQ(parser.payload[0], got * 40);
+            got++;
+        }
+    }
+    CHECK_EQ(got, 3);
+    CHECK_EQ(parser.frames, 3);
+    CHECK_EQ(parser.crcErrors, 0);
+}
+
+static void Test_DoubleHeaderByte(void)
+{
+    UsbFrameParser_t parser;
+    UsbFrame_ParserInit(&parser);
+
+    uint8_t stream[32] = {0x55};
+    uint16_t n = (uint16_t)(1 + UsbFrame_Encode(&stream[1], sizeof(stream) - 1, 0x13, 0, (const uint8_t *)"\x02", 1));
+    int got = 0;
+    for (uint16_t i = 0; i < n; i++) {
+        got += UsbFrame_Parse(&parser, stream[i]) ? 1 : 0;
+    }
+    CHECK_EQ(got, 1);
+}
+
+static void Test_RejectsCorruption(void)
+{
+    UsbFrameParser_t parser;
+    UsbFrame_ParserInit(&parser);
+
+    uint8_t payload[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    uint8_t frame[USB_FRAME_MAX_SIZE];
+    uint16_t len = UsbFrame_Encode(frame, sizeof(frame), 0x10, 1, payload, sizeof(payload));
+    frame[9] ^= 0x40;
+
+    for (uint16_t i = 0; i < len; i++) {
+        CHECK(!UsbFrame_Parse(&parser, frame[i]));
+    }
+    CHECK_EQ(parser.crcErrors, 1);
+
+    /* 长度超限：头后给出 0xFFFF 长度 */
+    const uint8_t bad[] = {0x55, 0xAA, 0x01, 0xFF, 0xFF};
+    for (uint16_t i = 0; i < sizeof(bad); i++) {
+        UsbFrame_Parse(&parser, bad[i]);
+    }
+    CHECK_EQ(parser.lenErrors, 1);
+    CHECK_EQ(parser.state, USB_FRAME_WAIT_HEADER0);
+
+    /* 之后的正常帧仍能收到 */
+    frame[9] ^= 0x40;
+    int got = 0;
+    for (uint16_t i = 0; i < len; i++) {
+        got += UsbFrame_Parse(&parser, frame[i]) ? 1 : 0;
+    }
+    CHECK_EQ(got, 1);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_CrcKnownValue);
+    TEST_RUN(Test_EncodeLayout);
+    TEST_RUN(Test_EncodeLimits);
+    TEST_RUN(Test_RoundTripWithNoise);
+    TEST_RUN(Test_DoubleHeaderByte);
+    TEST_RUN(Test_RejectsCorruption);
+    return TEST_EXIT();
+}
@@ -0,0 +1,56 @@
+/**
+  ******************************************************************************
+  * @file    test_util.h
+  * @brief   上位机单元测试断言
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 每个测试文件一个可执行程序：TEST_RUN 逐个运行用例，CHECK 失败时打印位置
+  * 并记为失败但继续执行；TEST_EXIT 汇总并返回非0，供 ctest 判定。
+  ******************************************************************************
+  */
+
+#ifndef __TEST_UTIL_H__
+#define __TEST_UTIL_H__
+
+#include <math.h>
+#include <stdio.h>
+
+static int s_testFailures = 0;
+static int s_testCases = 0;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            printf("  %s:%d: CHECK(%s) 失败\n", __FILE__, __LINE__, #cond); \
+            s_testFailures++; \
+        } \
+    } while (0)
+
+#define CHECK_EQ(a, b) do { \
+        long long va_ = (long long)(a), vb_ = (long long)(b); \
+        if (va_ != vb_) { \
+            printf("  %s:%d: %s == %s 失败 (%lld != %lld)\n", __FILE__, __LINE__, #a, #b, va_, vb_); \
+            s_testFailures++; \
+        } \
+    } while (0)
+
+#define CHECK_NEAR(a, b, tol) do { \
+        double va_ = (double)(a), vb_ = (double)(b); \
+        if (fabs(va_ - vb_) > (tol)) { \
+            printf("  %s:%d: %s ≈ %s 失败 (%g != %g)\n", __FILE__, __LINE__, #a, #b, va_, vb_); \
+            s_testFailures++; \
+        } \
+    } while (0)
+
+#define TEST_RUN(fn) do { \
+        int before_ = s_testFailures; \
+        s_testCases++; \
+        fn(); \
+        printf("[%s] %s\n", (s_testFailures == before_) ? " OK " : "FAIL", #fn); \
+    } while (0)
+
+#define TEST_EXIT() \
+    (printf("%d 个用例，%d 处失败\n", s_testCases, s_testFailures), (s_testFailures != 0))
+
+#endif /* __TEST_UTIL_H__ */
@@ -0,0 +1,169 @@
+"""生成红外边沿测试序列（traces/*.txt）
+
+按充电座信标的实际编码合成接收头输出：加入接收头载波展宽、边沿抖动、
+重复帧、残帧和毛刺，供 ir_bench 回放。用逻辑分析仪采到的真实序列按同样
+格式放入 traces/ 即可一起回放。
+
+文件格式：
+    # active_low 1                 接收头输出极性（1=载波期间低电平）
+    # expect NEC 00 17             期望依次解出的帧：协议 地址 命令 [repeat]
+    # expect_timeouts 1            期望的残帧超时数（可选）
+    <时间us> <电平0/1>             每行一个边沿
+"""
+import os
+import random
+
+OUT_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "traces")
+
+# 充电座信标命令码（与 ir_homing.h 一致），地址 0x00
+BEACON_CODES = [0x17, 0x65, 0x9A, 0xB4]
+
+
+class Trace:
+    def __init__(self, seed, bias_us=0, jitter_us=0.0):
+        self.rng = random.Random(seed)
+        self.bias = bias_us
+        self.jitter = jitter_us
+        self.t = 10000.0
+        self.edges = []
+        self.expects = []
+        self.timeouts = 0
+
+    def _edge(self, mark):
+        t = self.t + (self.rng.gauss(0.0, self.jitter) if self.jitter > 0 else 0.0)
+        # 接收头输出低电平有效
+        self.edges.append((int(round(t)), 0 if mark else 1))
+
+    def pulse(self, mark_us, space_us):
+        """载波 + 间隔；接收头使载波变宽、间隔变窄"""
+        self._edge(True)
+        self.t += mark_us + self.bias
+        self._edge(False)
+        self.t += space_us - self.bias
+
+    def gap(self, us):
+        self.t += us
+
+    def pulse_distance(self, leader, bits, nbits, zero=(560, 560), one=(560, 1690), stop=True):
+        self.pulse(*leader)
+        for i in range(nbits):
+            self.pulse(*(one if (bits >> i) & 1 else zero))
+        if stop:
+            self.pulse(560, 0)
+
+    def nec(self, address, command):
+        # 字节顺序与信标一致：地址、命令、地址反码、命令反码
+        raw = address | (command << 8) | ((address ^ 0xFF) << 16) | ((command ^ 0xFF) << 24)
+        start = self.t
+        self.pulse_distance((9000, 4500), raw, 32)
+        self.expects.append(("NEC", address, command, False))
+        return start
+
+    def nec_repeat(self):
+        self.pulse(9000, 2250)
+        self.pulse(560, 0)
+        self.expects.append(("NEC", self.expects[-1][1], self.expects[-1][2], True))
+
+    def samsung(self, address, command):
+        raw = address | (address << 8) | (command << 16) | ((command ^ 0xFF) << 24)
+        self.pulse_distance((4500, 4500), raw, 32)
+        self.expects.append(("SAMSUNG", address, command, False))
+
+    def sirc12(self, address, command):
+        raw = (command & 0x7F) | ((address & 0x1F) << 7)
+        self._edge(True)
+        self.t += 2400 + self.bias
+        self._edge(False)
+        self.t += 600 - self.bias
+        for i in range(12):
+            width = 1200 if (raw >> i) & 1 else 600
+            self._edge(True)
+            self.t += width + self.bias
+            self._edge(False)
+            self.t += 600 - self.bias
+        self.expects.append(("SIRC12", address, command, False))
+
+    def glitch(self, width_us=40):
+        self._edge(True)
+        self.t += width_us
+        self._edge(False)
+
+    def write(self, name, comment):
+        path = os.path.join(OUT_DIR, name)
+        with open(path, "w", encoding="utf-8") as f:
+            f.write(f"# {comment}\n")
+            f.write("# active_low 1\n")
+            for proto, addr, cmd, rep in self.expects:
+                f.write(f"# expect {proto} {addr:02X} {cmd:02X}{' repeat' if rep else ''}\n")
+            f.write(f"# expect_timeouts {self.timeouts}\n")
+            for t, level in self.edges:
+                f.write(f"{t} {level}\n")
+
+
+def main():
+    os.makedirs(OUT_DIR, exist_ok=True)
+
+    # 1. 理想时序，四个信标码依次发送
+    tr = Trace(1)
+    for code in BEACON_CODES:
+        tr.nec(0x00, code)
+        tr.gap(40000)
+    tr.write("beacon_clean.txt", "信标四个编码，理想时序")
+
+    # 2. 近距离：接收头载波展宽 +120us，抖动 40us
+    tr = Trace(2, bias_us=120, jitter_us=40)
+    for _ in range(3):
+        for code in BEACON_CODES:
+            tr.nec(0x00, code)
+            tr.gap(40000)
+    tr.write("beacon_near_bias.txt", "近距离：载波展宽120us、抖动40us")
+
+    # 3. 远距离：抖动大（边沿50us，脉宽约70us），带重复帧
+    tr = Trace(3, bias_us=60, jitter_us=50)
+    tr.nec(0x00, 0x65)
+    tr.gap(40000)
+    for _ in range(3):
+        tr.nec_repeat()
+        tr.gap(96000)
+    tr.nec(0x00, 0x9A)
+    tr.gap(40000)
+    tr.write("beacon_far_repeat.txt", "远距离：边沿抖动50us，重复帧")
+
+    # 4. 遮挡：帧中途信号中断（残帧超时），随后恢复
+    tr = Trace(4, bias_us=80, jitter_us=30)
+    tr.pulse(9000, 4500)
+    for _ in range(12):
+        tr.pulse(560, 1690)
+    tr.timeouts += 1
+    tr.gap(30000)
+    tr.nec(0x00, 0xB4)
+    tr.gap(40000)
+    tr.write("beacon_blocked.txt", "帧中途被遮挡，残帧超时后恢复")
+
+    # 5. 环境光毛刺夹在帧间
+    tr = Trace(5, bias_us=80, jitter_us=30)
+    tr.glitch(30)
+    tr.gap(5000)
+    tr.glitch(60)
+    tr.gap(20000)
+    tr.nec(0x00, 0x17)
+    tr.gap(15000)
+    tr.glitch(50)
+    tr.gap(30000)
+    tr.nec(0x00, 0x65)
+    tr.gap(40000)
+    tr.write("beacon_glitch.txt", "帧间环境光毛刺")
+
+    # 6. 其他协议（多协议解码器）
+    tr = Trace(6, bias_us=80, jitter_us=30)
+    tr.samsung(0x07, 0x02)
+    tr.gap(50000)
+    tr.sirc12(0x01, 0x15)
+    tr.gap(30000)
+    tr.nec(0x00, 0xA3)
+    tr.gap(40000)
+    tr.write("multi_protocol.txt", "Samsung / SIRC12 / NEC 混合")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,142 @@
+/**
+  ******************************************************************************
+  * @file    ir_bench.c
+  * @brief   红外解码引擎上位机测试台：回放边沿序列并核对解码结果
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 用法：ir_bench <trace.txt> [...]
+  * 序列格式见 gen_traces.py。每个文件按 "# expect" 行核对解出的帧，
+  * 按 "# expect_timeouts" 核对残帧超时数，并打印抖动/载波展宽/判决裕度。
+  * 任一文件不符时返回非0。
+  ******************************************************************************
+  */
+
+#include "ir_decode.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_MAX_EXPECT    64
+
+typedef struct {
+    char proto[16];
+    unsigned address;
+    unsigned command;
+    bool repeat;
+} BenchExpect_t;
+
+static const char* Bench_ProtoName(IRProtocolId_t id)
+{
+    switch (id) {
+        case IR_PROTO_NEC:     return "NEC";
+        case IR_PROTO_SAMSUNG: return "SAMSUNG";
+        case IR_PROTO_SIRC12:  return "SIRC12";
+        default:               return "?";
+    }
+}
+
+/**
+  * @brief  回放一个序列
+  * @retval 0=通过
+  */
+static int Bench_RunTrace(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        printf("[FAIL] %s: 无法打开\n", path);
+        return 1;
+    }
+
+    IRDecoder_t dec;
+    IRDecoder_Init(&dec, IR_PROTO_MASK_ALL);
+
+    BenchExpect_t expect[BENCH_MAX_EXPECT];
+    int expectCount = 0;
+    int expectTimeouts = -1;
+    int activeLow = 1;
+    int matched = 0;
+    int failures = 0;
+    unsigned long lastTime = 0;
+    char line[128];
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (line[0] == '#') {
+            BenchExpect_t e;
+            char rep[16] = "";
+            if (sscanf(line, "# active_low %d", &activeLow) == 1) continue;
+            if (sscanf(line, "# expect_timeouts %d", &expectTimeouts) == 1) continue;
+            if (sscanf(line, "# expect %15s %x %x %15s", e.proto, &e.address, &e.command, rep) >= 3 &&
+                expectCount < BENCH_MAX_EXPECT) {
+                e.repeat = (strcmp(rep, "repeat") == 0);
+                expect[expectCount++] = e;
+            }
+            continue;
+        }
+
+        unsigned long t;
+        int level;
+        if (sscanf(line, "%lu %d", &t, &level) != 2) continue;
+        lastTime = t;
+
+        bool mark = activeLow ? (level == 0) : (level != 0);
+        if (!IRDecoder_ProcessEdge(&dec, (uint32_t)t, mark)) continue;
+
+        IRFrame_t frame;
+        while (IRDecoder_GetFrame(&dec, &frame)) {
+            const char *name = Bench_ProtoName(frame.protocol);
+            printf("  %-8s addr=%02X cmd=%02X%s margin=%u%%\n", name, frame.address, frame.command,
+                   frame.repeat ? " repeat" : "", frame.marginPct);
+            if (matched >= expectCount) {
+                printf("  ^ 多出的帧\n");
+                failures++;
+                continue;
+            }
+            const BenchExpect_t *e = &expect[matched++];
+            if (strcmp(e->proto, name) != 0 || e->address != frame.address ||
+                e->command != frame.command || e->repeat != frame.repeat) {
+                printf("  ^ 期望 %s addr=%02X cmd=%02X%s\n", e->proto, e->address, e->command,
+                       e->repeat ? " repeat" : "");
+                failures++;
+            }
+        }
+    }
+    fclose(f);
+
+    /* 序列结束后的静默期：触发残帧超时 */
+    IRDecoder_Poll(&dec, (uint32_t)(lastTime + IR_DECODE_FRAME_TIMEOUT_US + 1U));
+
+    if (matched < expectCount) {
+        printf("  缺少 %d 帧\n", expectCount - matched);
+        failures++;
+    }
+    if (expectTimeouts >= 0 && dec.stats.timeoutCount != (uint16_t)expectTimeouts) {
+        printf("  超时 %u，期望 %d\n", dec.stats.timeoutCount, expectTimeouts);
+        failures++;
+    }
+
+    const IRDecodeStats_t *st = &dec.stats;
+    printf("[%s] %s\n", failures ? "FAIL" : " OK ", path);
+    printf("  edges=%lu frames=%u ok=%u repeat=%u err=%u timeout=%u\n",
+           (unsigned long)st->edgeCount, st->frameCount, st->okCount, st->repeatCount,
+           st->errorCount, st->timeoutCount);
+    printf("  jitter=%uus bias=%dus margin last=%u%% worst=%u%%\n",
+           st->jitterUs, st->markBiasUs, st->lastMarginPct, st->worstMarginPct);
+    return failures ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        printf("用法: %s <trace.txt> [...]\n", argv[0]);
+        return 2;
+    }
+
+    int failed = 0;
+    for (int i = 1; i < argc; i++) {
+        failed += Bench_RunTrace(argv[i]);
+    }
+    printf("%d/%d 通过\n", argc - 1 - failed, argc - 1);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,185 @@
+"""
+CleanBot 热点剖析读取与比较
+
+    python prof_tool.py fetch --port COM5                      # 读取并显示各探针统计
+    python prof_tool.py fetch --port COM5 --reset -o base.json # 读取后清零，并保存
+    python prof_tool.py reset --port COM5                      # 仅清零，开始新一轮测量
+    python prof_tool.py show base.json                         # 显示保存的结果
+    python prof_tool.py diff base.json new.json                # 比较优化前后
+
+优化前后的对比流程：reset -> 运行场景 -> fetch -o base.json；改代码后重复得到 new.json，再 diff。
+*_period 探针记录周期中断/控制循环相邻两次的间隔，抖动即 max-min（diff 中单列比较），
+例如 MEM_CCM_ENABLE 置 0/1 各测一次即可比较 CCM 放置前后的抖动。
+"""
+import argparse
+import json
+import struct
+import sys
+import time
+
+from trace_tool import build_frame, iter_frames
+
+MSG_PROF_CONTROL = 0x14
+MSG_ACK = 0x24
+MSG_PROF_DATA = 0x2C
+
+PROF_OP_FETCH = 0x00
+PROF_OP_RESET = 0x01
+PROF_OP_FETCH_RESET = 0x02
+
+PROBE_NAMES = ["wheel_ctrl", "motor_output", "encoder_tick", "imu_parse", "usb_send_frame",
+               "tim7_period", "ctrl_period", "wake_latency", "blackbox_record"]
+HEADER_FMT = '<BBBBIIIQHBB'
+HEADER_SIZE = struct.calcsize(HEADER_FMT)
+BAR_WIDTH = 40
+
+
+def parse_prof_data(payload):
+    (pid, probe_count, buckets, min_log2, count, min_c, max_c, sum_c,
+     overhead, cpu_mhz, reset) = struct.unpack_from(HEADER_FMT, payload, 0)
+    hist = list(struct.unpack_from(f'<{buckets}I', payload, HEADER_SIZE))
+    name = PROBE_NAMES[pid] if pid < len(PROBE_NAMES) else f"probe{pid}"
+    return probe_count, {
+        "id": pid, "name": name, "count": count, "min": min_c, "max": max_c, "sum": sum_c,
+        "overhead": overhead, "cpu_mhz": cpu_mhz, "min_log2": min_log2, "hist": hist,
+    }
+
+
+def send_and_collect(args, op):
+    import serial
+
+    ser = serial.Serial(args.port, args.baud, timeout=0.05)
+    buf = bytearray()
+    probes = {}
+    expected = None
+    acked = False
+    ser.write(build_frame(MSG_PROF_CONTROL, bytes([op])))
+    end = time.time() + args.timeout
+    while time.time() < end:
+        chunk = ser.read(4096)
+        if not chunk:
+            continue
+        buf.extend(chunk)
+        for msg_id, payload in iter_frames(buf):
+            if msg_id == MSG_ACK and len(payload) >= 3 and payload[0] == MSG_PROF_CONTROL:
+                acked = True
+            elif msg_id == MSG_PROF_DATA and len(payload) >= HEADER_SIZE:
+                expected, probe = parse_prof_data(payload)
+                probes[probe["id"]] = probe
+        if op == PROF_OP_RESET and acked:
+            break
+        if expected is not None and len(probes) >= expected:
+            break
+    ser.close()
+
+    if not acked:
+        print("[WARN] 未收到 0x14 的 ACK", file=sys.stderr)
+    if op != PROF_OP_RESET and (expected is None or len(probes) < expected):
+        print(f"[WARN] 只收到 {len(probes)} 个探针", file=sys.stderr)
+    return [probes[k] for k in sorted(probes)]
+
+
+def bucket_label(i, min_log2, buckets):
+    lo = 1 << (i + min_log2)
+    if i == 0:
+        return f"<{lo * 2}"
+    if i == buckets - 1:
+        return f">={lo}"
+    return f"{lo}-{lo * 2 - 1}"
+
+
+def print_probes(probes):
+    print(f"{'探针':<16}{'次数':>10}{'min':>9}{'mean':>10}{'max':>9}   (周期 / us)")
+    for p in probes:
+        mhz = p["cpu_mhz"] or 168
+        if p["count"] == 0:
+            print(f"{p['name']:<16}{0:>10}{'-':>9}{'-':>10}{'-':>9}")
+            continue
+        mean = p["sum"] / p["count"]
+        print(f"{p['name']:<16}{p['count']:>10}{p['min']:>9}{mean:>10.1f}{p['max']:>9}"
+              f"   {p['min'] / mhz:.2f} / {mean / mhz:.2f} / {p['max'] / mhz:.2f}")
+    overhead = probes[0]["overhead"] if probes else 0
+    print(f"空探针开销 {overhead} 周期（未扣除）\n")
+
+    for p in probes:
+        if p["count"] == 0:
+            continue
+        print(f"[{p['name']}]")
+        peak = max(p["hist"])
+        used = [i for i, n in enumerate(p["hist"]) if n]
+        for i in range(used[0], used[-1] + 1):
+            n = p["hist"][i]
+            bar = '#' * (round(n * BAR_WIDTH / peak) if peak else 0)
+            print(f"  {bucket_label(i, p['min_log2'], len(p['hist'])):>16} {n:>10} {bar}")
+        print()
+
+
+def fetch(args):
+    probes = send_and_collect(args, PROF_OP_FETCH_RESET if args.reset else PROF_OP_FETCH)
+    print_probes(probes)
+    if args.output:
+        with open(args.output, 'w', encoding='utf-8') as f:
+            json.dump(probes, f, indent=1)
+        print(f"-> {args.output}")
+
+
+def reset(args):
+    send_and_collect(args, PROF_OP_RESET)
+    print("已清零")
+
+
+def load(path):
+    with open(path, encoding='utf-8') as f:
+        return json.load(f)
+
+
+def show(args):
+    print_probes(load(args.input))
+
+
+def diff(args):
+    base = {p["name"]: p for p in load(args.base)}
+    new = {p["name"]: p for p in load(args.new)}
+    print(f"{'探针':<16}{'mean 前':>10}{'mean 后':>10}{'变化':>9}{'max 前':>10}{'max 后':>10}{'变化':>9}"
+          f"{'抖动 前':>10}{'抖动 后':>10}")
+    for name in [n for n in PROBE_NAMES if n in base or n in new] + \
+                sorted((set(base) | set(new)) - set(PROBE_NAMES)):
+        a, b = base.get(name), new.get(name)
+        if not a or not b or not a["count"] or not b["count"]:
+            print(f"{name:<16}{'(无数据)':>10}")
+            continue
+        ma, mb = a["sum"] / a["count"], b["sum"] / b["count"]
+        print(f"{name:<16}{ma:>10.1f}{mb:>10.1f}{(mb - ma) / ma * 100:>8.1f}%"
+              f"{a['max']:>10}{b['max']:>10}{(b['max'] - a['max']) / max(a['max'], 1) * 100:>8.1f}%"
+              f"{a['max'] - a['min']:>10}{b['max'] - b['min']:>10}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="CleanBot 热点剖析读取与比较")
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    for name, func, help_text in (("fetch", fetch, "读取探针统计"), ("reset", reset, "清零探针统计")):
+        p = sub.add_parser(name, help=help_text)
+        p.add_argument("--port", required=True)
+        p.add_argument("--baud", type=int, default=921600)
+        p.add_argument("--timeout", type=float, default=2.0)
+        if name == "fetch":
+            p.add_argument("--reset", action="store_true", help="读取后清零")
+            p.add_argument("-o", "--output", help="保存为 JSON")
+        p.set_defaults(func=func)
+
+    p = sub.add_parser("show", help="显示保存的结果")
+    p.add_argument("input")
+    p.set_defaults(func=show)
+
+    p = sub.add_parser("diff", help="比较两次测量")
+    p.add_argument("base")
+    p.add_argument("new")
+    p.set_defaults(func=diff)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,236 @@
+"""
+CleanBot RAM 预算报告（解析 Keil MDK 链接 map 文件）
+
+    python ram_budget.py                                        # 默认 MDK-ARM/CleanBot/CleanBot.map
+    python ram_budget.py path/to/CleanBot.map --objects         # 同时列出每个目标文件
+    python ram_budget.py --top 20                               # 最大的 20 个 RAM 段（变量）
+    python ram_budget.py --budget Tasks=12288 --budget FreeRTOS=2048   # 超出预算时退出码为 1
+    python ram_budget.py CleanBot\\CleanBot.map -o CleanBot\\CleanBot_ram.txt   # Keil 编译后步骤
+
+按 MDK-ARM/CleanBot.uvprojx 中的源文件路径把目标文件归入模块（Modules/Motor、Tasks、
+FreeRTOS ...），统计各模块在 RAM 执行区内的 RW（.data）与 ZI（.bss）字节数，并给出
+每个 RAM 执行区的占用与剩余。任务栈、TCB、队列存储区均为静态分配，因此计入所在模块
+（freertos.c 的任务栈计入 Core）；FreeRTOS 堆 ucHeap 计入 FreeRTOS。
+map 文件需勾选 Linker -> Memory Map（工程默认已勾选）。
+"""
+import argparse
+import os
+import re
+import sys
+import xml.etree.ElementTree as ET
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+DEFAULT_MAP = os.path.join(ROOT, 'MDK-ARM', 'CleanBot', 'CleanBot.map')
+DEFAULT_PROJECT = os.path.join(ROOT, 'MDK-ARM', 'CleanBot.uvprojx')
+
+# STM32F407：SRAM1+SRAM2 与 CCM；执行区基址落在此范围内视为 RAM
+RAM_RANGES = ((0x10000000, 0x10010000), (0x20000000, 0x20020000))
+
+# 源文件路径前缀 -> 模块名（按顺序匹配；Modules/<X> 单独处理）
+MODULE_PREFIXES = (
+    ('Middlewares/Third_Party/FreeRTOS/', 'FreeRTOS'),
+    ('Middlewares/ST/STM32_USB_Device_Library/', 'USB_Device_Library'),
+    ('Drivers/', 'HAL'),
+    ('USB_DEVICE/', 'USB_DEVICE'),
+    ('Core/', 'Core'),
+)
+LIBRARY_MODULE = 'C library'
+UNKNOWN_MODULE = 'Other'
+
+REGION_RE = re.compile(r'^\s*Execution Region (\S+) \(Exec base: (0x[0-9a-fA-F]+).*?Size: (0x[0-9a-fA-F]+)'
+                       r'(?:, Max: (0x[0-9a-fA-F]+))?')
+ENTRY_RE = re.compile(r'^\s*(0x[0-9a-fA-F]+)\s+(?:0x[0-9a-fA-F]+|-)\s+(0x[0-9a-fA-F]+)\s+(\w+)\s*(.*)$')
+
+
+def module_for_path(path):
+    path = path.replace('\\', '/')
+    while path.startswith('../') or path.startswith('./'):
+        path = path[path.index('/') + 1:]
+    for prefix, name in MODULE_PREFIXES:
+        if path.startswith(prefix):
+            return name
+    parts = path.split('/')
+    if parts[0] == 'Modules' and len(parts) > 2:
+        return 'Modules/' + parts[1]
+    if len(parts) == 1:
+        # MDK-ARM 目录下的启动文件
+        return 'Startup'
+    return parts[0]
+
+
+def load_object_modules(project_path):
+    """uvprojx 中每个源文件对应的目标文件名（Keil 统一小写）-> 模块"""
+    modules = {}
+    if not os.path.exists(project_path):
+        return modules
+    for node in ET.parse(project_path).getroot().iter('FilePath'):
+        path = (node.text or '').strip()
+        base, ext = os.path.splitext(os.path.basename(path.replace('\\', '/')))
+        if ext.lower() in ('.c', '.s'):
+            modules[base.lower() + '.o'] = module_for_path(path)
+    return modules
+
+
+def parse_map(text):
+    """返回 RAM 执行区列表：{name, base, size, max, entries[(size, kind, section, object)]}"""
+    regions = []
+    current = None
+    in_memory_map = False
+    for line in text.splitlines():
+        if line.startswith('Memory Map of the image'):
+            in_memory_map = True
+            continue
+        if not in_memory_map:
+            continue
+        if line.startswith('Image component sizes'):
+            break
+        m = REGION_RE.match(line)
+        if m:
+            base = int(m.group(2), 16)
+            current = None
+            if any(lo <= base < hi for lo, hi in RAM_RANGES):
+                current = {
+                    'name': m.group(1), 'base': base, 'size': int(m.group(3), 16),
+                    'max': int(m.group(4), 16) if m.group(4) else None, 'entries': [],
+                }
+                regions.append(current)
+            continue
+        if current is None:
+            continue
+        m = ENTRY_RE.match(line)
+        if not m:
+            continue
+        size = int(m.group(2), 16)
+        kind = m.group(3)
+        rest = m.group(4).split()
+        if kind == 'PAD' or len(rest) < 3:
+            current['entries'].append((size, 'PAD', '', ''))
+            continue
+        # rest: Attr Idx [E] Section Object
+        obj = rest[-1]
+        section = rest[-2]
+        current['entries'].append((size, 'RW' if kind == 'Data' else 'ZI', section, obj))
+    return regions
+
+
+def object_module(obj, modules):
+    if '(' in obj:
+        return LIBRARY_MODULE
+    return modules.get(obj.lower(), UNKNOWN_MODULE)
+
+
+def section_symbol(section):
+    for prefix in ('.bss.', '.data.', '.bss', '.data'):
+        if section.startswith(prefix):
+            return section[len(prefix):] or section
+    return section
+
+
+def summarize(regions, modules):
+    by_module = {}
+    by_object = {}
+    sections = []
+    padding = 0
+    for region in regions:
+        for size, kind, section, obj in region['entries']:
+            if kind == 'PAD':
+                padding += size
+                continue
+            module = object_module(obj, modules)
+            for table, key in ((by_module, module), (by_object, (module, obj))):
+                rw, zi = table.get(key, (0, 0))
+                table[key] = (rw + size, zi) if kind == 'RW' else (rw, zi + size)
+            sections.append((size, section_symbol(section), obj, region['name']))
+    return by_module, by_object, sections, padding
+
+
+def parse_budgets(items):
+    budgets = {}
+    for item in items or []:
+        name, _, value = item.partition('=')
+        if not value:
+            raise SystemExit(f"bad --budget {item!r}, expected MODULE=BYTES")
+        budgets[name] = int(value, 0)
+    return budgets
+
+
+def render(args, regions, by_module, by_object, sections, padding, budgets):
+    lines = []
+    failures = []
+
+    lines.append("RAM regions")
+    for region in regions:
+        used = region['size']
+        if region['max']:
+            free = region['max'] - used
+            lines.append(f"  {region['name']:<12} 0x{region['base']:08X} {used:7d} / {region['max']:7d}"
+                         f"  ({used * 100.0 / region['max']:5.1f}%)  free {free}")
+        else:
+            lines.append(f"  {region['name']:<12} 0x{region['base']:08X} {used:7d}")
+    lines.append("")
+
+    lines.append(f"  {'Module':<32} {'RW':>7} {'ZI':>7} {'Total':>7} {'Budget':>7}")
+    total_rw = total_zi = 0
+    for module, (rw, zi) in sorted(by_module.items(), key=lambda kv: -(kv[1][0] + kv[1][1])):
+        total_rw += rw
+        total_zi += zi
+        budget = budgets.get(module)
+        mark = ''
+        if budget is not None and rw + zi > budget:
+            mark = '  OVER'
+            failures.append(f"{module} {rw + zi} > {budget}")
+        lines.append(f"  {module:<32} {rw:7d} {zi:7d} {rw + zi:7d} {budget if budget is not None else '':>7}{mark}")
+        if args.objects:
+            objs = [(obj, v) for (mod, obj), v in by_object.items() if mod == module]
+            for obj, (orw, ozi) in sorted(objs, key=lambda kv: -(kv[1][0] + kv[1][1])):
+                lines.append(f"      {obj:<28} {orw:7d} {ozi:7d} {orw + ozi:7d}")
+    lines.append(f"  {'(padding)':<32} {'':>7} {'':>7} {padding:7d}")
+    lines.append(f"  {'total':<32} {total_rw:7d} {total_zi:7d} {total_rw + total_zi + padding:7d}")
+    for module in sorted(set(budgets) - set(by_module)):
+        lines.append(f"  warning: budget for unknown module {module}")
+
+    if args.top > 0:
+        lines.append("")
+        lines.append(f"Largest RAM sections (top {args.top})")
+        for size, name, obj, region in sorted(sections, key=lambda s: -s[0])[:args.top]:
+            lines.append(f"  {size:7d}  {name:<44} {obj:<28} {region}")
+
+    return lines, failures
+
+
+def main():
+    parser = argparse.ArgumentParser(description="CleanBot RAM 预算报告（Keil map 文件）")
+    parser.add_argument("map", nargs='?', default=DEFAULT_MAP, help="链接 map 文件")
+    parser.add_argument("--project", default=DEFAULT_PROJECT, help="uvprojx 工程文件（目标文件 -> 模块）")
+    parser.add_argument("--objects", action="store_true", help="列出每个目标文件")
+    parser.add_argument("--top", type=int, default=10, help="列出最大的 N 个 RAM 段，0 表示不列出")
+    parser.add_argument("--budget", action="append", metavar="MODULE=BYTES", help="模块 RAM 预算，可重复")
+    parser.add_argument("-o", "--output", help="报告同时写入该文件")
+    args = parser.parse_args()
+
+    if not os.path.exists(args.map):
+        print(f"map file not found: {args.map}", file=sys.stderr)
+        return 2
+    with open(args.map, encoding='utf-8', errors='replace') as f:
+        regions = parse_map(f.read())
+    if not regions:
+        print("no RAM execution regions in map file (enable Linker -> Memory Map)", file=sys.stderr)
+        return 2
+
+    budgets = parse_budgets(args.budget)
+    by_module, by_object, sections, padding = summarize(regions, load_object_modules(args.project))
+    lines, failures = render(args, regions, by_module, by_object, sections, padding, budgets)
+    if failures:
+        lines.append("")
+        lines.append("RAM budget exceeded: " + "; ".join(failures))
+
+    report = "\n".join(line.rstrip() for line in lines)
+    print(report)
+    if args.output:
+        with open(args.output, 'w', encoding='utf-8') as f:
+            f.write(report + "\n")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
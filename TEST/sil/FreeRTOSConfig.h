@@ -0,0 +1,102 @@
+/**
+  ******************************************************************************
+  * @file    FreeRTOSConfig.h
+  * @brief   软件在环构建的 FreeRTOS 配置（POSIX 端口）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 功能开关、节拍频率、优先级数与 Core/Inc/FreeRTOSConfig.h 保持一致，
+  * 使任务调度、软件定时器、通知、运行时间统计与事件跟踪钩子行为相同；
+  * 只改动与端口相关的部分：
+  * - 堆：64 位指针使控制块变大，堆放大到 256KB
+  * - 空闲/定时器任务栈：不小于 PTHREAD_STACK_MIN
+  * - configASSERT：打印位置后退出，而非关中断死循环
+  * - 任务切换钩子经 sim_hal.c 包装，钩子内固件的 PRIMASK 操作不会开中断
+  * - 无 Cortex-M 中断优先级与 SVC/PendSV 映射
+  ******************************************************************************
+  */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <stdint.h>
+extern uint32_t SystemCoreClock;
+
+#ifndef CMSIS_device_header
+#define CMSIS_device_header "stm32f4xx_hal.h"
+#endif
+
+#define configUSE_PREEMPTION                     1
+#define configSUPPORT_STATIC_ALLOCATION          1
+#define configSUPPORT_DYNAMIC_ALLOCATION         1
+#define configUSE_IDLE_HOOK                      0
+#define configUSE_TICK_HOOK                      1
+#define configCPU_CLOCK_HZ                       ( SystemCoreClock )
+#define configTICK_RATE_HZ                       ((TickType_t)1000)
+#define configMAX_PRIORITIES                     ( 56 )
+#define configMINIMAL_STACK_SIZE                 ((uint16_t)4096)
+#define configTOTAL_HEAP_SIZE                    ((size_t)(256 * 1024))
+#define configMAX_TASK_NAME_LEN                  ( 16 )
+#define configUSE_TRACE_FACILITY                 1
+#define configUSE_16_BIT_TICKS                   0
+#define configSTACK_DEPTH_TYPE                   uint32_t
+#define configUSE_MUTEXES                        1
+#define configQUEUE_REGISTRY_SIZE                8
+#define configUSE_RECURSIVE_MUTEXES              1
+#define configUSE_COUNTING_SEMAPHORES            1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  0
+#define configMESSAGE_BUFFER_LENGTH_TYPE         size_t
+
+#define configUSE_CO_ROUTINES                    0
+#define configMAX_CO_ROUTINE_PRIORITIES          ( 2 )
+
+#define configUSE_TIMERS                         1
+#define configTIMER_TASK_PRIORITY                ( 2 )
+#define configTIMER_QUEUE_LENGTH                 10
+#define configTIMER_TASK_STACK_DEPTH             4096
+
+/* CMSIS-RTOS V2 flags */
+#define configUSE_OS2_THREAD_SUSPEND_RESUME      1
+#define configUSE_OS2_THREAD_ENUMERATE           1
+#define configUSE_OS2_EVENTFLAGS_FROM_ISR        1
+#define configUSE_OS2_THREAD_FLAGS               1
+#define configUSE_OS2_TIMER                      1
+#define configUSE_OS2_MUTEX                      1
+
+#define INCLUDE_vTaskPrioritySet                 1
+#define INCLUDE_uxTaskPriorityGet                1
+#define INCLUDE_vTaskDelete                      1
+#define INCLUDE_vTaskCleanUpResources            0
+#define INCLUDE_vTaskSuspend                     1
+#define INCLUDE_vTaskDelayUntil                  1
+#define INCLUDE_xTaskDelayUntil                  1
+#define INCLUDE_vTaskDelay                       1
+#define INCLUDE_xTaskGetSchedulerState           1
+#define INCLUDE_xTimerPendFunctionCall           1
+#define INCLUDE_xQueueGetMutexHolder             1
+#define INCLUDE_xSemaphoreGetMutexHolder         1
+#define INCLUDE_uxTaskGetStackHighWaterMark      1
+#define INCLUDE_xTaskGetCurrentTaskHandle        1
+#define INCLUDE_eTaskGetState                    1
+
+/* 断言：打印位置后退出（sim_hal.c） */
+void SimAssert_Failed(const char *file, int line);
+#define configASSERT( x ) do { if ((x) == 0) { SimAssert_Failed(__FILE__, __LINE__); } } while (0)
+
+/* 运行时间统计：与固件相同，时基为 Timebase_GetUs（DWT 由单调时钟折算）；
+   经 sim_hal.c 的钩子包装调用，见 SimHook_RunTimeCounter 说明 */
+#define configGENERATE_RUN_TIME_STATS            1
+#define configUSE_STATS_FORMATTING_FUNCTIONS     0
+void configureTimerForRunTimeStats(void);
+unsigned long getRunTimeCounterValue(void);
+unsigned long SimHook_RunTimeCounter(void);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS   configureTimerForRunTimeStats
+#define portGET_RUN_TIME_COUNTER_VALUE           SimHook_RunTimeCounter
+
+/* 事件跟踪：任务切入时记录任务编号 */
+void Trace_TaskSwitchedIn(uint32_t taskNumber);
+void SimHook_TaskSwitchedIn(uint32_t taskNumber);
+#define traceTASK_SWITCHED_IN()                  SimHook_TaskSwitchedIn(pxCurrentTCB->uxTCBNumber)
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,241 @@
+"""
+CleanBot 上位机协议端到端基准（软件在环或真机）
+
+    python sil_bench.py --spawn build/cleanbot_sil            # 启动 SIL 并连接其 pty
+    python sil_bench.py --spawn build/cleanbot_sil --quick    # 缩短各阶段（ctest 使用）
+    python sil_bench.py --port /tmp/cleanbot                  # 连接已运行的 SIL
+    python sil_bench.py --port COM5                           # 同一套测试跑真机
+
+三个阶段：
+  1. ACK 往返：逐条发送需应答的 CONTROL_CMD（零速），统计收到 0x24 的延迟分布
+  2. 阶跃响应：两轮同时给定 --step-speed，按 0x21 轮速反馈计算上升时间（到稳态值 90%）与稳态误差
+  3. 吞吐：静止状态下统计各消息 ID 的帧率与总字节率
+任一指标超出阈值时退出码为 1；阈值可用命令行参数调整。
+真机测试阶跃时请架空轮子。
+"""
+import argparse
+import os
+import struct
+import subprocess
+import sys
+import time
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+from trace_tool import build_frame, iter_frames  # noqa: E402
+
+MSG_CONTROL_CMD = 0x10
+MSG_IMU_FEEDBACK = 0x20
+MSG_WHEEL_FEEDBACK = 0x21
+MSG_SENSOR_STATUS = 0x22
+MSG_SYSTEM_STATUS = 0x23
+MSG_ACK = 0x24
+
+WORK_MODE_REMOTE = 4
+MSG_NAMES = {
+    0x20: "imu", 0x21: "wheel", 0x22: "sensor", 0x23: "system", 0x24: "ack",
+    0x25: "actuator", 0x26: "traj", 0x27: "motor_diag", 0x28: "ir_stats",
+    0x29: "safety", 0x2A: "homing", 0x2B: "trace", 0x2C: "prof",
+    0x2D: "power", 0x2E: "fault", 0x2F: "blackbox",
+}
+STARTUP_TIMEOUT_S = 5.0
+
+
+def control_cmd(left, right, ack):
+    payload = struct.pack('<ff', left, right) + bytes([WORK_MODE_REMOTE, 0, 0, 0, 0, 1 if ack else 0, 0])
+    return build_frame(MSG_CONTROL_CMD, payload)
+
+
+def percentile(values, p):
+    if not values:
+        return float('nan')
+    ordered = sorted(values)
+    index = min(len(ordered) - 1, int(round(p / 100.0 * (len(ordered) - 1))))
+    return ordered[index]
+
+
+class Link:
+    """串口读写与帧拆分；不使用 reset_input_buffer（pty 上会误报断开），靠读空丢弃旧数据"""
+
+    def __init__(self, port, baud):
+        import serial
+        self.ser = serial.Serial(port, baud, timeout=0.002)
+        self.buf = bytearray()
+
+    def write(self, data):
+        self.ser.write(data)
+
+    def poll(self):
+        self.buf += self.ser.read(4096)
+        return list(iter_frames(self.buf))
+
+    def drain(self, seconds):
+        end = time.perf_counter() + seconds
+        while time.perf_counter() < end:
+            self.poll()
+
+    def close(self):
+        self.ser.close()
+
+
+def spawn_sil(binary):
+    proc = subprocess.Popen([binary], stdout=subprocess.PIPE, text=True)
+    line = proc.stdout.readline().strip()
+    if not line.startswith("PTY "):
+        proc.kill()
+        raise RuntimeError(f"unexpected SIL banner: {line!r}")
+    return proc, line[4:]
+
+
+def wait_for_telemetry(link):
+    end = time.perf_counter() + STARTUP_TIMEOUT_S
+    while time.perf_counter() < end:
+        if any(msg_id == MSG_WHEEL_FEEDBACK for msg_id, _ in link.poll()):
+            return True
+    return False
+
+
+# ----------------- 阶段 -----------------
+def bench_ack(link, count):
+    rtts = []
+    lost = 0
+    for _ in range(count):
+        link.poll()
+        t0 = time.perf_counter()
+        link.write(control_cmd(0.0, 0.0, True))
+        got = False
+        while not got and time.perf_counter() - t0 < 0.5:
+            for msg_id, payload in link.poll():
+                if msg_id == MSG_ACK and payload[0] == MSG_CONTROL_CMD:
+                    rtts.append((time.perf_counter() - t0) * 1000.0)
+                    got = True
+                    break
+        if not got:
+            lost += 1
+    return {
+        "count": len(rtts), "lost": lost,
+        "min": min(rtts) if rtts else float('nan'),
+        "p50": percentile(rtts, 50), "p99": percentile(rtts, 99),
+        "max": max(rtts) if rtts else float('nan'),
+    }
+
+
+def bench_step(link, speed, duration):
+    link.drain(0.2)
+    samples = []
+    t0 = time.perf_counter()
+    link.write(control_cmd(speed, speed, False))
+    while time.perf_counter() - t0 < duration:
+        now = time.perf_counter() - t0
+        for msg_id, payload in link.poll():
+            if msg_id == MSG_WHEEL_FEEDBACK and len(payload) >= 16:
+                _, left, _, right = struct.unpack_from('<ffff', payload)
+                samples.append((now, (left + right) * 0.5))
+    link.write(control_cmd(0.0, 0.0, False))
+    link.drain(0.3)
+
+    if not samples:
+        return {"samples": 0, "rise_ms": float('nan'), "final": float('nan'), "error_pct": float('nan')}
+    tail = [v for t, v in samples if t >= duration * 0.8]
+    final = sum(tail) / len(tail) if tail else samples[-1][1]
+    # 上升时间按稳态值的 90% 计算，稳态误差单独判定
+    target = 0.9 * final
+    rise = next((t for t, v in samples if v >= target), None) if final > 0 else None
+    return {
+        "samples": len(samples),
+        "rise_ms": rise * 1000.0 if rise is not None else float('inf'),
+        "final": final,
+        "error_pct": abs(speed - final) / speed * 100.0,
+    }
+
+
+def bench_throughput(link, duration):
+    link.drain(0.2)
+    counts = {}
+    total_bytes = 0
+    t0 = time.perf_counter()
+    while time.perf_counter() - t0 < duration:
+        for msg_id, payload in link.poll():
+            counts[msg_id] = counts.get(msg_id, 0) + 1
+            total_bytes += 9 + len(payload)
+    elapsed = time.perf_counter() - t0
+    return {msg_id: n / elapsed for msg_id, n in counts.items()}, total_bytes / elapsed
+
+
+# ----------------- 主流程 -----------------
+def run(args, link):
+    failures = []
+
+    def check(ok, text):
+        print(f"  {'ok  ' if ok else 'FAIL'} {text}")
+        if not ok:
+            failures.append(text)
+
+    if not wait_for_telemetry(link):
+        print("no wheel telemetry received")
+        return 1
+
+    print(f"[1] ACK round trip ({args.ack_count} commands)")
+    ack = bench_ack(link, args.ack_count)
+    print(f"  min {ack['min']:.2f} ms  p50 {ack['p50']:.2f} ms  p99 {ack['p99']:.2f} ms  max {ack['max']:.2f} ms")
+    check(ack["lost"] == 0, f"lost acks {ack['lost']} == 0")
+    check(ack["p99"] <= args.max_ack_p99_ms, f"ack p99 {ack['p99']:.2f} ms <= {args.max_ack_p99_ms} ms")
+
+    print(f"[2] step response ({args.step_speed} m/s, {args.step_time} s)")
+    step = bench_step(link, args.step_speed, args.step_time)
+    print(f"  samples {step['samples']}  rise(90%) {step['rise_ms']:.0f} ms  final {step['final']:.3f} m/s")
+    check(step["rise_ms"] <= args.max_rise_ms, f"rise {step['rise_ms']:.0f} ms <= {args.max_rise_ms} ms")
+    check(step["error_pct"] <= args.max_error_pct,
+          f"steady-state error {step['error_pct']:.1f}% <= {args.max_error_pct}%")
+
+    print(f"[3] throughput ({args.tp_time} s)")
+    rates, byte_rate = bench_throughput(link, args.tp_time)
+    for msg_id in sorted(rates):
+        print(f"  0x{msg_id:02X} {MSG_NAMES.get(msg_id, '?'):<11} {rates[msg_id]:8.1f} /s")
+    print(f"  total {byte_rate / 1024.0:.1f} KiB/s")
+    for msg_id, minimum in ((MSG_WHEEL_FEEDBACK, args.min_wheel_hz), (MSG_IMU_FEEDBACK, args.min_imu_hz),
+                            (MSG_SENSOR_STATUS, args.min_sensor_hz)):
+        rate = rates.get(msg_id, 0.0)
+        check(rate >= minimum, f"{MSG_NAMES[msg_id]} {rate:.1f}/s >= {minimum}/s")
+
+    print("PASS" if not failures else f"FAIL ({len(failures)})")
+    return 0 if not failures else 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description="CleanBot 上位机协议端到端基准")
+    target = parser.add_mutually_exclusive_group(required=True)
+    target.add_argument("--spawn", metavar="BIN", help="启动 cleanbot_sil 并连接其 pty")
+    target.add_argument("--port", help="已有串口 / pty 路径")
+    parser.add_argument("--baud", type=int, default=921600)
+    parser.add_argument("--quick", action="store_true", help="缩短各阶段")
+    parser.add_argument("--step-speed", type=float, default=0.3)
+    parser.add_argument("--max-ack-p99-ms", type=float, default=20.0)
+    parser.add_argument("--max-rise-ms", type=float, default=300.0)
+    parser.add_argument("--max-error-pct", type=float, default=30.0)
+    parser.add_argument("--min-wheel-hz", type=float, default=180.0)
+    parser.add_argument("--min-imu-hz", type=float, default=180.0)
+    parser.add_argument("--min-sensor-hz", type=float, default=45.0)
+    args = parser.parse_args()
+
+    args.ack_count = 50 if args.quick else 500
+    args.step_time = 1.0 if args.quick else 3.0
+    args.tp_time = 2.0 if args.quick else 10.0
+
+    proc = None
+    port = args.port
+    if args.spawn:
+        proc, port = spawn_sil(args.spawn)
+    try:
+        link = Link(port, args.baud)
+        try:
+            return run(args, link)
+        finally:
+            link.close()
+    finally:
+        if proc is not None:
+            proc.terminate()
+            proc.wait(timeout=5)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
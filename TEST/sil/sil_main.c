@@ -0,0 +1,146 @@
+/**
+  ******************************************************************************
+  * @file    sil_main.c
+  * @brief   软件在环仿真入口：在 FreeRTOS POSIX 端口上运行完整任务集
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 用法：cleanbot_sil [--link PATH] [--imu FILE] [--flash FILE]
+  *   --link PATH  为 USB 虚拟串口 pty 创建固定路径的符号链接
+  *   --imu FILE   循环回放录制的 IMU 串口原始字节，缺省按对象模型合成
+  *   --flash FILE 仿真 Flash 的内容文件（1MB），保留故障前写入的黑匣子转储，
+  *                供下一次启动经 USB 下载
+  *
+  * 启动顺序与 main.c 相同：BlackBox_Init -> Supervisor_Init -> 外设初始化 -> osKernelInitialize
+  * -> MX_FREERTOS_Init（未修改的 Core/Src/freertos.c）-> osKernelStart。
+  * 额外创建最高优先级的 sim_isr 任务，每个节拍依次执行 TIM7、USART3、
+  * OTG_FS 三个中断的仿真，对应 main.c 的 HAL_TIM_PeriodElapsedCallback、
+  * imu_task.c 的 DMA 空闲回调与 usbd_cdc_if.c 的收发回调，最后推进 IWDG
+  * 计时（任务签到超时后节拍钩子停止喂狗，进程打印快照退出）。
+  ******************************************************************************
+  */
+
+#include "sim.h"
+#include "gpio.h"
+#include "tim.h"
+#include "cmsis_os.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "CleanBotApp.h"
+#include "encoder.h"
+#include "trace.h"
+#include "prof.h"
+#include "supervisor.h"
+#include "blackbox.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define SIM_ISR_TASK_PRIORITY       (configMAX_PRIORITIES - 1)
+#define SIM_ISR_PERIOD_S            0.001f
+
+extern CleanBotApp_t *g_pCleanBotApp;
+extern void MX_FREERTOS_Init(void);
+
+/**
+  * @brief  仿真中断任务：每 1ms 执行一次
+  */
+static void SimIsr_Task(void *argument)
+{
+    (void)argument;
+    TickType_t lastWake = xTaskGetTickCount();
+
+    for (;;) {
+        vTaskDelayUntil(&lastWake, 1);
+
+        SimIsr_Enter();
+
+        /* 对象模型推进 1ms；TIM7 运行时（停靠模式下停止）采样编码器 */
+        SimPlant_Step(SIM_ISR_PERIOD_S);
+        if ((htim7.Instance->CR1 & TIM_CR1_CEN) != 0U) {
+            TRACE_ISR_ENTER(TRACE_ISR_TIM7, 0U);
+            PROF_PERIOD(PROF_TIM7_PERIOD);
+            if (g_pCleanBotApp != NULL) {
+                Encoder_On1kHzTick(&g_pCleanBotApp->encoderWheelLeft);
+                Encoder_On1kHzTick(&g_pCleanBotApp->encoderWheelRight);
+                Encoder_On1kHzTick(&g_pCleanBotApp->encoderFan);
+            }
+            TRACE_ISR_EXIT(TRACE_ISR_TIM7);
+        }
+
+        /* USART3：IMU 字节流 */
+        TRACE_ISR_ENTER(TRACE_ISR_USART3, 0U);
+        SimImu_Tick();
+        TRACE_ISR_EXIT(TRACE_ISR_USART3);
+
+        /* OTG_FS：USB 虚拟串口 */
+        TRACE_ISR_ENTER(TRACE_ISR_OTG_FS, 0U);
+        SimUsb_Tick();
+        TRACE_ISR_EXIT(TRACE_ISR_OTG_FS);
+
+        /* 节拍钩子未按时喂狗则模拟 IWDG 复位 */
+        SimIwdg_Tick();
+
+        SimIsr_Exit();
+    }
+}
+
+static void Sil_OnSignal(int sig)
+{
+    (void)sig;
+    SimUsb_Deinit();
+    _exit(0);
+}
+
+static void Sil_Usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [--link PATH] [--imu FILE] [--flash FILE]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    const char *linkPath = NULL;
+    const char *imuPath = NULL;
+    const char *flashPath = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--link") == 0 && i + 1 < argc) {
+            linkPath = argv[++i];
+        } else if (strcmp(argv[i], "--imu") == 0 && i + 1 < argc) {
+            imuPath = argv[++i];
+        } else if (strcmp(argv[i], "--flash") == 0 && i + 1 < argc) {
+            flashPath = argv[++i];
+        } else {
+            Sil_Usage(argv[0]);
+            return 2;
+        }
+    }
+
+    signal(SIGINT, Sil_OnSignal);
+    signal(SIGTERM, Sil_OnSignal);
+
+    SimHal_Init();
+    if (!SimFlash_Init(flashPath)) {
+        return 1;
+    }
+    BlackBox_Init();
+    Supervisor_Init();
+    MX_GPIO_Init();
+    HAL_TIM_Base_Start_IT(&htim7);
+    SimPlant_Init();
+    if (!SimImu_Init(imuPath) || !SimUsb_Init(linkPath)) {
+        return 1;
+    }
+
+    osKernelInitialize();
+    MX_FREERTOS_Init();
+    xTaskCreate(SimIsr_Task, "sim_isr", configMINIMAL_STACK_SIZE, NULL, SIM_ISR_TASK_PRIORITY, NULL);
+    osKernelStart();
+
+    /* 调度器不返回 */
+    SimUsb_Deinit();
+    return 1;
+}
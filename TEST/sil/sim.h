@@ -0,0 +1,49 @@
+/**
+  ******************************************************************************
+  * @file    sim.h
+  * @brief   软件在环仿真层接口（外设仿真、轮子对象模型、IMU 字节流、USB pty）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 仿真中断由最高优先级的 sim_isr 任务每个系统节拍（1ms）执行一次，
+  * 依次模拟 TIM7（对象模型推进 1ms 后采样编码器）、USART3（IMU 字节流
+  * DMA 空闲中断）与 OTG_FS（pty 收发），期间 __get_IPSR 返回非零。
+  * 对象模型按节拍步进而非按挂钟时间，宿主机负载抖动不会改变闭环动态。
+  ******************************************************************************
+  */
+
+#ifndef __SIM_H__
+#define __SIM_H__
+
+#include "stm32f4xx_hal.h"
+#include <stdbool.h>
+
+/* 仿真中断上下文 */
+void SimIsr_Enter(void);
+void SimIsr_Exit(void);
+
+/* 外设：与 MX_TIMx_Init/MX_USARTx_Init 相同的实例与周期配置，输入脚空闲电平 */
+void SimHal_Init(void);
+void SimGpio_SetInput(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState level);   /* 电平变化且配置为EXTI时触发回调 */
+void SimAdc_SetInputMv(uint16_t mv);                                            /* 充电触点电压 (mV) */
+uint16_t SimUart_Feed(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t len);  /* 写入DMA缓冲并触发空闲事件 */
+uint64_t SimClock_Ns(void);                                                     /* 启动以来的单调时间 (ns) */
+void SimIwdg_Tick(void);                                                        /* 每 1ms 调用，超时未喂狗则退出 */
+bool SimFlash_Init(const char *path);                                           /* 擦除态；path 非空时载入并在加锁时写回 */
+
+/* 轮子对象模型：TIM4 双PWM -> 一阶轮速 -> TIM2/TIM1 编码器计数；TIM3_CH2 -> 风机 -> TIM5 */
+void SimPlant_Init(void);
+void SimPlant_Step(float dt);
+void SimPlant_GetBody(float *yawRateDps, float *yawDeg);
+
+/* IMU：按对象模型合成 WIT9011 帧，或回放录制的原始字节流 */
+bool SimImu_Init(const char *replayPath);
+void SimImu_Tick(void);
+
+/* USB CDC：映射到 Linux pty */
+bool SimUsb_Init(const char *linkPath);
+void SimUsb_Tick(void);
+void SimUsb_Deinit(void);
+
+#endif /* __SIM_H__ */
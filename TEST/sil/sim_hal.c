@@ -0,0 +1,568 @@
+/**
+  ******************************************************************************
+  * @file    sim_hal.c
+  * @brief   软件在环仿真：HAL 外设、中断屏蔽与时钟
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "sim.h"
+#include "tim.h"
+#include "usart.h"
+#include "hw_config.h"
+#include "supervisor.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+uint32_t SystemCoreClock = 168000000U;
+
+/* 仿真寄存器 */
+GPIO_TypeDef g_SimGpio[SIM_GPIO_PORT_COUNT];
+TIM_TypeDef g_SimTim[SIM_TIM_COUNT];
+USART_TypeDef g_SimUsart[6];
+EXTI_TypeDef g_SimExti;
+ADC_Common_TypeDef g_SimAdcCommon;
+CoreDebug_Type g_SimCoreDebug;
+RCC_TypeDef g_SimRcc;
+IWDG_TypeDef g_SimIwdg;
+DBGMCU_TypeDef g_SimDbgmcu;
+SCB_Type g_SimScb;
+uint32_t g_SimBkpSram[1024];
+uint32_t g_SimFlash[SIM_FLASH_SIZE / 4U];
+
+static ADC_TypeDef s_adc1;
+static DWT_Type s_dwt;
+static SysTick_Type s_sysTick;
+SysTick_Type *const SysTick = &s_sysTick;
+
+/* 外设句柄（固件中由 tim.c/usart.c 定义） */
+TIM_HandleTypeDef htim1;
+TIM_HandleTypeDef htim2;
+TIM_HandleTypeDef htim3;
+TIM_HandleTypeDef htim4;
+TIM_HandleTypeDef htim5;
+TIM_HandleTypeDef htim7;
+TIM_HandleTypeDef htim10;
+UART_HandleTypeDef huart1;
+UART_HandleTypeDef huart3;
+UART_HandleTypeDef huart4;
+
+/* 配置为EXTI的引脚：上升沿/下降沿触发掩码 */
+static uint16_t s_extiRising[SIM_GPIO_PORT_COUNT];
+static uint16_t s_extiFalling[SIM_GPIO_PORT_COUNT];
+
+/* 中断屏蔽与中断上下文 */
+static volatile uint32_t s_primask = 0;
+static volatile uint32_t s_ipsr = 0;
+static volatile uint32_t s_kernelHookDepth = 0;
+
+static volatile uint16_t s_adcInputMv = 0;
+static uint32_t s_iwdgElapsedMs = 0;
+static struct timespec s_startTime;
+
+/* 仿真 Flash：解锁状态与写回文件 */
+FLASH_TypeDef g_SimFlashRegs;
+static bool s_flashUnlocked = false;
+static bool s_flashDirty = false;
+static const char *s_flashPath = NULL;
+
+/**
+  * @brief  初始化定时器句柄（实例与周期同 MX_TIMx_Init）
+  */
+static void SimHal_InitTim(TIM_HandleTypeDef *htim, TIM_TypeDef *instance, uint32_t prescaler, uint32_t period)
+{
+    htim->Instance = instance;
+    htim->Init.Prescaler = prescaler;
+    htim->Init.Period = period;
+    instance->PSC = prescaler;
+    instance->ARR = period;
+}
+
+/**
+  * @brief  初始化仿真外设
+  * @note   输入脚空闲电平：按键外部上拉（释放为高），红外接收头低电平有效（空闲为高），
+  *         其余输入（碰撞、下视、光电门）为低，即无碰撞、未悬空
+  * @retval None
+  */
+void SimHal_Init(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &s_startTime);
+
+    SimHal_InitTim(&htim1, TIM1, 0U, 65535U);
+    SimHal_InitTim(&htim2, TIM2, 0U, 0xFFFFFFFFU);
+    SimHal_InitTim(&htim3, TIM3, 84U - 1U, 999U);
+    SimHal_InitTim(&htim4, TIM4, 84U - 1U, 999U);
+    SimHal_InitTim(&htim5, TIM5, 0U, 0xFFFFFFFFU);
+    SimHal_InitTim(&htim7, TIM7, 84U - 1U, 999U);
+    SimHal_InitTim(&htim10, TIM10, 84U - 1U, 999U);
+
+    huart1.Instance = USART1;
+    huart1.Init.BaudRate = 115200U;
+    huart3.Instance = USART3;
+    huart3.Init.BaudRate = 460800U;
+    huart4.Instance = UART4;
+    huart4.Init.BaudRate = 115200U;
+
+    BUTTON1_GPIO_Port->IDR |= BUTTON1_Pin;
+    BUTTON2_GPIO_Port->IDR |= BUTTON2_Pin;
+#if IR_RECEIVER_ACTIVE_LOW
+    L_RECEIVE_GPIO_Port->IDR |= L_RECEIVE_Pin;
+    R_RECEIVE_GPIO_Port->IDR |= R_RECEIVE_Pin;
+#endif
+}
+
+/**
+  * @brief  启动以来的单调时间
+  * @retval 纳秒
+  */
+uint64_t SimClock_Ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)(now.tv_sec - s_startTime.tv_sec) * 1000000000ULL +
+           (uint64_t)now.tv_nsec - (uint64_t)s_startTime.tv_nsec;
+}
+
+/**
+  * @brief  系统毫秒节拍
+  * @note   取RTOS节拍而非挂钟时间，与对象模型、osDelay 周期保持同一时间轴
+  */
+uint32_t HAL_GetTick(void)
+{
+    return (uint32_t)xTaskGetTickCount();
+}
+
+/**
+  * @brief  DWT 寄存器：每次访问按单调时钟刷新 CYCCNT
+  */
+DWT_Type *SimDWT_Regs(void)
+{
+    s_dwt.CYCCNT = (uint32_t)(SimClock_Ns() * (SystemCoreClock / 1000000U) / 1000U);
+    return &s_dwt;
+}
+
+/* ---------------- 中断屏蔽 ---------------- */
+
+/**
+  * @brief  关中断：屏蔽 POSIX 端口的节拍信号，当前任务不会被抢占，仿真中断也无法执行
+  */
+void SimIrq_Disable(void)
+{
+    if (s_kernelHookDepth != 0U) return;
+    portDISABLE_INTERRUPTS();
+    s_primask = 1U;
+}
+
+void SimIrq_Enable(void)
+{
+    if (s_kernelHookDepth != 0U) return;
+    s_primask = 0U;
+    portENABLE_INTERRUPTS();
+}
+
+uint32_t SimIrq_GetPrimask(void)
+{
+    return s_primask;
+}
+
+uint32_t SimIrq_GetIpsr(void)
+{
+    return s_ipsr;
+}
+
+/**
+  * @brief  内核切换任务时调用的钩子（运行时间计数、事件跟踪）
+  * @note   vTaskSwitchContext 在节拍信号处理函数或已关中断的让出路径中执行，
+  *         钩子内固件的 __get_PRIMASK/__disable_irq/__set_PRIMASK 若真正开中断
+  *         会在切换中途放行节拍信号，因此钩子执行期间屏蔽操作为空操作
+  */
+unsigned long SimHook_RunTimeCounter(void)
+{
+    s_kernelHookDepth++;
+    unsigned long value = getRunTimeCounterValue();
+    s_kernelHookDepth--;
+    return value;
+}
+
+void SimHook_TaskSwitchedIn(uint32_t taskNumber)
+{
+    s_kernelHookDepth++;
+    Trace_TaskSwitchedIn(taskNumber);
+    s_kernelHookDepth--;
+}
+
+/**
+  * @brief  进入/退出仿真中断上下文（sim_isr 任务调用外设回调前后）
+  */
+void SimIsr_Enter(void)
+{
+    s_ipsr = (uint32_t)TIM7_IRQn + 16U;
+}
+
+void SimIsr_Exit(void)
+{
+    s_ipsr = 0U;
+}
+
+/* ---------------- GPIO ---------------- */
+
+static uint32_t SimGpio_Index(const GPIO_TypeDef *port)
+{
+    return (uint32_t)(port - g_SimGpio);
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+    if (GPIOx == NULL || GPIO_Init == NULL) return;
+
+    uint32_t index = SimGpio_Index(GPIOx);
+    uint16_t pins = (uint16_t)GPIO_Init->Pin;
+
+    s_extiRising[index] &= (uint16_t)~pins;
+    s_extiFalling[index] &= (uint16_t)~pins;
+    EXTI->IMR &= ~(uint32_t)pins;
+    if ((GPIO_Init->Mode & GPIO_MODE_EXTI_MASK) != 0U) {
+        EXTI->IMR |= pins;
+        if ((GPIO_Init->Mode & 0x00100000U) != 0U) s_extiRising[index] |= pins;
+        if ((GPIO_Init->Mode & 0x00200000U) != 0U) s_extiFalling[index] |= pins;
+    }
+    if (GPIO_Init->Pull == GPIO_PULLUP) {
+        GPIOx->IDR |= pins;
+    } else if (GPIO_Init->Pull == GPIO_PULLDOWN) {
+        GPIOx->IDR &= ~(uint32_t)pins;
+    }
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    return ((GPIOx->IDR & GPIO_Pin) != 0U) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+/**
+  * @brief  输出：ODR 与 IDR 同步（真实芯片输出脚的 IDR 读回输出电平）
+  */
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    if (PinState != GPIO_PIN_RESET) {
+        GPIOx->ODR |= GPIO_Pin;
+        GPIOx->IDR |= GPIO_Pin;
+    } else {
+        GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+        GPIOx->IDR &= ~(uint32_t)GPIO_Pin;
+    }
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    HAL_GPIO_WritePin(GPIOx, GPIO_Pin, ((GPIOx->ODR & GPIO_Pin) != 0U) ? GPIO_PIN_RESET : GPIO_PIN_SET);
+}
+
+/**
+  * @brief  设置仿真输入电平
+  * @note   需在仿真中断上下文调用：引脚配置为EXTI且边沿匹配时直接调用 HAL_GPIO_EXTI_Callback
+  * @param  port: 端口
+  * @param  pin: 引脚（单个）
+  * @param  level: 电平
+  * @retval None
+  */
+void SimGpio_SetInput(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState level)
+{
+    if (port == NULL) return;
+
+    uint32_t index = SimGpio_Index(port);
+    bool wasHigh = (port->IDR & pin) != 0U;
+    bool high = (level != GPIO_PIN_RESET);
+
+    if (wasHigh == high) return;
+    if (high) {
+        port->IDR |= pin;
+    } else {
+        port->IDR &= ~(uint32_t)pin;
+    }
+
+    if ((EXTI->IMR & pin) == 0U) return;
+    if ((high && (s_extiRising[index] & pin) != 0U) || (!high && (s_extiFalling[index] & pin) != 0U)) {
+        HAL_GPIO_EXTI_Callback(pin);
+    }
+}
+
+/* ---------------- TIM ---------------- */
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+    (void)Channel;
+    htim->Instance->CR1 |= TIM_CR1_CEN;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+    __HAL_TIM_SET_COMPARE(htim, Channel, 0U);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Encoder_Start(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+    (void)Channel;
+    htim->Instance->CR1 |= TIM_CR1_CEN;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Encoder_Stop(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+    (void)Channel;
+    htim->Instance->CR1 &= ~TIM_CR1_CEN;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->CR1 |= TIM_CR1_CEN;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->CR1 &= ~TIM_CR1_CEN;
+    return HAL_OK;
+}
+
+/* ---------------- USART ---------------- */
+
+/**
+  * @brief  登记 DMA 接收缓冲（到空闲事件为止）
+  */
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    if (huart == NULL || pData == NULL || Size == 0U) return HAL_ERROR;
+
+    huart->pRxBuffPtr = pData;
+    huart->RxXferSize = Size;
+    return HAL_OK;
+}
+
+/**
+  * @brief  停止 DMA 接收：取消登记的缓冲，之后喂入的字节丢弃
+  */
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart)
+{
+    if (huart == NULL) return HAL_ERROR;
+
+    huart->pRxBuffPtr = NULL;
+    huart->RxXferSize = 0U;
+    return HAL_OK;
+}
+
+/**
+  * @brief  模拟一次 DMA 接收 + 空闲中断
+  * @note   需在仿真中断上下文调用；超出登记缓冲的部分丢弃（与 DMA 满后的行为一致）
+  * @param  huart: 串口句柄
+  * @param  data: 线上字节
+  * @param  len: 字节数
+  * @retval 实际写入的字节数
+  */
+uint16_t SimUart_Feed(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t len)
+{
+    if (huart == NULL || data == NULL || len == 0U || huart->pRxBuffPtr == NULL) return 0;
+
+    uint16_t n = (len > huart->RxXferSize) ? huart->RxXferSize : len;
+    uint8_t *buf = huart->pRxBuffPtr;
+
+    for (uint16_t i = 0; i < n; i++) {
+        buf[i] = data[i];
+    }
+    /* 回调内会重新登记缓冲 */
+    huart->pRxBuffPtr = NULL;
+    HAL_UARTEx_RxEventCallback(huart, n);
+    return n;
+}
+
+/* ---------------- ADC ---------------- */
+
+/**
+  * @brief  ADC1 寄存器：每次访问即完成一次转换
+  */
+ADC_TypeDef *SimADC_Regs(void)
+{
+    float raw = (float)s_adcInputMv / CHARGE_ADC_DIVIDER * 4095.0f / (float)CHARGE_ADC_VREF_MV;
+
+    s_adc1.DR = (raw > 4095.0f) ? 4095U : (uint32_t)raw;
+    s_adc1.SR |= ADC_SR_EOC;
+    return &s_adc1;
+}
+
+void SimAdc_SetInputMv(uint16_t mv)
+{
+    s_adcInputMv = mv;
+}
+
+/* ---------------- FLASH ---------------- */
+
+/**
+  * @brief  初始化仿真 Flash（全部为擦除态），指定文件时载入上次内容
+  * @retval 文件存在但读取失败返回 false
+  */
+bool SimFlash_Init(const char *path)
+{
+    memset(g_SimFlash, 0xFF, sizeof(g_SimFlash));
+    s_flashPath = path;
+    if (path == NULL) return true;
+
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) return true;
+    size_t n = fread(g_SimFlash, 1, sizeof(g_SimFlash), fp);
+    fclose(fp);
+    if (n != sizeof(g_SimFlash)) {
+        fprintf(stderr, "[SIL] flash image %s: expected %zu bytes, got %zu\n", path, sizeof(g_SimFlash), n);
+        return false;
+    }
+    return true;
+}
+
+static void SimFlash_Save(void)
+{
+    if (s_flashPath == NULL || !s_flashDirty) return;
+
+    FILE *fp = fopen(s_flashPath, "wb");
+    if (fp == NULL) return;
+    fwrite(g_SimFlash, 1, sizeof(g_SimFlash), fp);
+    fclose(fp);
+    s_flashDirty = false;
+}
+
+/* STM32F407 扇区布局：0-3 为 16KB，4 为 64KB，5-11 为 128KB */
+static bool SimFlash_SectorRange(uint32_t sector, uint32_t *offset, uint32_t *size)
+{
+    if (sector < 4U) {
+        *offset = sector * 0x4000U;
+        *size = 0x4000U;
+    } else if (sector == 4U) {
+        *offset = 0x10000U;
+        *size = 0x10000U;
+    } else if (sector < 12U) {
+        *offset = (sector - 4U) * 0x20000U;
+        *size = 0x20000U;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+    s_flashUnlocked = true;
+    return HAL_OK;
+}
+
+/**
+  * @brief  加锁：有改动且指定了文件时写回，故障转储后紧接的复位不会丢失
+  */
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+    s_flashUnlocked = false;
+    SimFlash_Save();
+    return HAL_OK;
+}
+
+/**
+  * @brief  按字编程：只能把 1 写成 0（与真实 Flash 相同，未擦除的位保持）
+  */
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data)
+{
+    uint32_t offset = Address - FLASH_BASE;
+
+    if (!s_flashUnlocked || TypeProgram != FLASH_TYPEPROGRAM_WORD ||
+        offset >= SIM_FLASH_SIZE || (offset & 3U) != 0U) {
+        return HAL_ERROR;
+    }
+    g_SimFlash[offset / 4U] &= (uint32_t)Data;
+    s_flashDirty = true;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError)
+{
+    if (!s_flashUnlocked || pEraseInit == NULL || pEraseInit->TypeErase != FLASH_TYPEERASE_SECTORS) {
+        return HAL_ERROR;
+    }
+    for (uint32_t i = 0; i < pEraseInit->NbSectors; i++) {
+        uint32_t offset, size;
+        if (!SimFlash_SectorRange(pEraseInit->Sector + i, &offset, &size)) {
+            if (SectorError != NULL) *SectorError = pEraseInit->Sector + i;
+            return HAL_ERROR;
+        }
+        memset((uint8_t *)g_SimFlash + offset, 0xFF, size);
+    }
+    if (SectorError != NULL) *SectorError = 0xFFFFFFFFU;
+    s_flashDirty = true;
+    return HAL_OK;
+}
+
+/**
+  * @brief  单扇区擦除（仿真中立即完成，未解锁或扇区号无效时忽略）
+  */
+void FLASH_Erase_Sector(uint32_t Sector, uint8_t VoltageRange)
+{
+    uint32_t offset, size;
+
+    (void)VoltageRange;
+    if (!s_flashUnlocked || !SimFlash_SectorRange(Sector, &offset, &size)) return;
+    memset((uint8_t *)g_SimFlash + offset, 0xFF, size);
+    s_flashDirty = true;
+}
+
+HAL_StatusTypeDef FLASH_WaitForLastOperation(uint32_t Timeout)
+{
+    (void)Timeout;
+    return HAL_OK;
+}
+
+/* ---------------- IWDG ---------------- */
+
+/**
+  * @brief  IWDG 计时（sim_isr 每 1ms 调用）
+  * @note   RLR 非零视为已启动；KR 写入重装键值时清零计时，超过 PR/RLR
+  *         折算的超时（LSI 32kHz）打印监督快照后退出，对应硬件复位
+  */
+void SimIwdg_Tick(void)
+{
+    if (g_SimIwdg.RLR == 0U) return;
+    if (g_SimIwdg.KR == 0xAAAAU) {
+        g_SimIwdg.KR = 0U;
+        s_iwdgElapsedMs = 0U;
+        return;
+    }
+
+    uint32_t timeoutMs = (4U << g_SimIwdg.PR) * (g_SimIwdg.RLR + 1U) / 32U;
+    if (++s_iwdgElapsedMs <= timeoutMs) return;
+
+    const SupervisorSnapshot_t *snap = (const SupervisorSnapshot_t *)g_SimBkpSram;
+    fprintf(stderr, "[SIL] IWDG reset: reason %u task %u missMask 0x%02X running %.*s\n",
+            snap->reason, snap->task, snap->missMask, (int)SUPERVISOR_NAME_LEN, snap->runningTask);
+    abort();
+}
+
+void NVIC_SystemReset(void)
+{
+    fprintf(stderr, "[SIL] NVIC_SystemReset\n");
+    abort();
+}
+
+/* ---------------- 错误处理 ---------------- */
+
+void SimAssert_Failed(const char *file, int line)
+{
+    fprintf(stderr, "[SIL] configASSERT failed at %s:%d\n", file, line);
+    abort();
+}
+
+void Error_Handler(void)
+{
+    fprintf(stderr, "[SIL] Error_Handler\n");
+    abort();
+}
@@ -0,0 +1,116 @@
+/**
+  ******************************************************************************
+  * @file    sim_imu.c
+  * @brief   软件在环仿真：WIT9011 字节流（按对象模型合成或回放录制文件）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 合成模式每 5ms（200Hz，与模块默认输出频率一致）送出一组
+  * 0x51 加速度 / 0x52 角速度 / 0x53 角度 帧，偏航数据来自 SimPlant_GetBody；
+  * 回放模式按 115200bps 线速率（约 11.5 字节/ms）循环送出文件内容。
+  ******************************************************************************
+  */
+
+#include "sim.h"
+#include "usart.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SIM_IMU_PERIOD_MS           5U
+#define SIM_IMU_FRAME_LEN           11U
+#define SIM_IMU_REPLAY_BYTES_PER_MS 12U
+#define SIM_IMU_TEMP_RAW            2500    /* 25.00℃ */
+
+static uint8_t *s_replay = NULL;
+static size_t s_replayLen = 0;
+static size_t s_replayPos = 0;
+static uint32_t s_tickCount = 0;
+
+/**
+  * @brief  编码一帧：0x55 | id | x,y,z,温度 (int16 LE) | 累加和
+  */
+static void SimImu_PackFrame(uint8_t *frame, uint8_t id, int16_t x, int16_t y, int16_t z)
+{
+    int16_t v[4] = { x, y, z, SIM_IMU_TEMP_RAW };
+    uint8_t sum = 0;
+
+    frame[0] = 0x55;
+    frame[1] = id;
+    for (int i = 0; i < 4; i++) {
+        frame[2 + 2 * i] = (uint8_t)((uint16_t)v[i] & 0xFFU);
+        frame[3 + 2 * i] = (uint8_t)((uint16_t)v[i] >> 8);
+    }
+    for (uint32_t i = 0; i < SIM_IMU_FRAME_LEN - 1U; i++) {
+        sum += frame[i];
+    }
+    frame[10] = sum;
+}
+
+static int16_t SimImu_Scale(float value, float fullScale)
+{
+    float raw = value * 32768.0f / fullScale;
+
+    if (raw > 32767.0f) raw = 32767.0f;
+    if (raw < -32768.0f) raw = -32768.0f;
+    return (int16_t)raw;
+}
+
+/**
+  * @brief  初始化 IMU 字节源
+  * @param  replayPath: 录制的原始串口字节文件，NULL 表示按对象模型合成
+  * @retval true=成功
+  */
+bool SimImu_Init(const char *replayPath)
+{
+    s_tickCount = 0;
+    if (replayPath == NULL) return true;
+
+    FILE *f = fopen(replayPath, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "[SIL] cannot open IMU replay file %s\n", replayPath);
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size > 0) {
+        s_replay = (uint8_t*)malloc((size_t)size);
+        if (s_replay != NULL) {
+            s_replayLen = fread(s_replay, 1, (size_t)size, f);
+        }
+    }
+    fclose(f);
+    s_replayPos = 0;
+    return (s_replayLen > 0);
+}
+
+/**
+  * @brief  1ms 仿真中断：送出到期的 IMU 字节
+  * @retval None
+  */
+void SimImu_Tick(void)
+{
+    if (s_replayLen > 0) {
+        uint8_t chunk[SIM_IMU_REPLAY_BYTES_PER_MS];
+        for (uint32_t i = 0; i < SIM_IMU_REPLAY_BYTES_PER_MS; i++) {
+            chunk[i] = s_replay[s_replayPos];
+            s_replayPos = (s_replayPos + 1U) % s_replayLen;
+        }
+        SimUart_Feed(&huart3, chunk, (uint16_t)sizeof(chunk));
+        return;
+    }
+
+    if (++s_tickCount < SIM_IMU_PERIOD_MS) return;
+    s_tickCount = 0;
+
+    float yawRateDps = 0.0f;
+    float yawDeg = 0.0f;
+    uint8_t burst[3 * SIM_IMU_FRAME_LEN];
+
+    SimPlant_GetBody(&yawRateDps, &yawDeg);
+    SimImu_PackFrame(&burst[0], 0x51, 0, 0, SimImu_Scale(1.0f, 16.0f));
+    SimImu_PackFrame(&burst[SIM_IMU_FRAME_LEN], 0x52, 0, 0, SimImu_Scale(yawRateDps, 2000.0f));
+    SimImu_PackFrame(&burst[2 * SIM_IMU_FRAME_LEN], 0x53, 0, 0, SimImu_Scale(yawDeg, 180.0f));
+    SimUart_Feed(&huart3, burst, (uint16_t)sizeof(burst));
+}
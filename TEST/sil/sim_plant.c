@@ -0,0 +1,138 @@
+/**
+  ******************************************************************************
+  * @file    sim_plant.c
+  * @brief   软件在环仿真：轮子/风机对象模型与编码器计数
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 读取固件写入的 PWM 比较值（与 CleanBotApp_Init 的通道分配一致）：
+  * - 左轮 TIM4_CH3(INA)/CH4(INB) -> TIM2 编码器；右轮 TIM4_CH1/CH2 -> TIM1 编码器
+  * - 风机 TIM3_CH2 -> TIM5 编码器
+  * 占空比 (INA-INB)/ARR 经一阶惯性得到转速，积分为编码器计数写回 CNT；
+  * 两轮速度按差速运动学得到车体偏航角速度，供 IMU 帧合成。
+  ******************************************************************************
+  */
+
+#include "sim.h"
+#include "tim.h"
+#include "hw_config.h"
+#include <math.h>
+
+#define SIM_WHEEL_MAX_RPM           300.0f  /* 满占空比空载转速 (rpm)，约 1.0 m/s */
+#define SIM_WHEEL_TAU_S             0.08f   /* 轮速时间常数 (s) */
+#define SIM_WHEEL_RIGHT_GAIN        0.97f   /* 右轮增益偏差，给同步控制留出作用空间 */
+#define SIM_FAN_MAX_RPM             20000.0f
+#define SIM_FAN_TAU_S               0.30f
+#define SIM_PI                      3.14159265f
+
+/* 单个转动部件 */
+typedef struct {
+    TIM_HandleTypeDef *pwm;
+    uint32_t channelA;
+    uint32_t channelB;          /* 单PWM时与 channelA 相同 */
+    TIM_HandleTypeDef *encoder;
+    float maxRpm;
+    float gain;
+    float tau;
+    float countsPerRev;
+    float rpm;
+    double counts;              /* 累计编码器计数 */
+} SimRotor_t;
+
+static SimRotor_t s_wheelLeft;
+static SimRotor_t s_wheelRight;
+static SimRotor_t s_fan;
+static float s_yawRad = 0.0f;
+static float s_yawRateRad = 0.0f;
+
+static void SimPlant_InitRotor(SimRotor_t *r, TIM_HandleTypeDef *pwm, uint32_t chA, uint32_t chB,
+                               TIM_HandleTypeDef *encoder, float maxRpm, float gain, float tau, float countsPerRev)
+{
+    r->pwm = pwm;
+    r->channelA = chA;
+    r->channelB = chB;
+    r->encoder = encoder;
+    r->maxRpm = maxRpm;
+    r->gain = gain;
+    r->tau = tau;
+    r->countsPerRev = countsPerRev;
+    r->rpm = 0.0f;
+    r->counts = 0.0;
+}
+
+/**
+  * @brief  推进一个部件
+  */
+static void SimPlant_StepRotor(SimRotor_t *r, float dt)
+{
+    float arr = (float)__HAL_TIM_GET_AUTORELOAD(r->pwm) + 1.0f;
+    float duty = (float)__HAL_TIM_GET_COMPARE(r->pwm, r->channelA);
+
+    if (r->channelB != r->channelA) {
+        duty -= (float)__HAL_TIM_GET_COMPARE(r->pwm, r->channelB);
+    }
+    duty /= arr;
+
+    float target = duty * r->maxRpm * r->gain;
+    r->rpm += (target - r->rpm) * dt / (r->tau + dt);
+    r->counts += (double)(r->rpm / 60.0f * r->countsPerRev * dt);
+
+    /* 计数器按 ARR+1 回绕（32 位定时器直接截断） */
+    int64_t count = (int64_t)floor(r->counts);
+    uint32_t arrReg = __HAL_TIM_GET_AUTORELOAD(r->encoder);
+    uint32_t cnt = (arrReg == 0xFFFFFFFFU) ? (uint32_t)count
+                                            : (uint32_t)(((count % ((int64_t)arrReg + 1)) + (int64_t)arrReg + 1) % ((int64_t)arrReg + 1));
+    __HAL_TIM_SET_COUNTER(r->encoder, cnt);
+}
+
+/**
+  * @brief  初始化对象模型
+  * @retval None
+  */
+void SimPlant_Init(void)
+{
+    float wheelCounts = (float)ENCODER_WHEEL_PPR * (float)ENCODER_WHEEL_GEAR_RATIO;
+
+    SimPlant_InitRotor(&s_wheelLeft, &htim4, TIM_CHANNEL_3, TIM_CHANNEL_4, &htim2,
+                       SIM_WHEEL_MAX_RPM, 1.0f, SIM_WHEEL_TAU_S, wheelCounts);
+    SimPlant_InitRotor(&s_wheelRight, &htim4, TIM_CHANNEL_1, TIM_CHANNEL_2, &htim1,
+                       SIM_WHEEL_MAX_RPM, SIM_WHEEL_RIGHT_GAIN, SIM_WHEEL_TAU_S, wheelCounts);
+    SimPlant_InitRotor(&s_fan, &htim3, TIM_CHANNEL_2, TIM_CHANNEL_2, &htim5,
+                       SIM_FAN_MAX_RPM, 1.0f, SIM_FAN_TAU_S, (float)ENCODER_FAN_PPR * (float)ENCODER_FAN_GEAR_RATIO);
+    s_yawRad = 0.0f;
+    s_yawRateRad = 0.0f;
+}
+
+/**
+  * @brief  推进对象模型
+  * @param  dt: 步长 (s)
+  * @retval None
+  */
+void SimPlant_Step(float dt)
+{
+    SimPlant_StepRotor(&s_wheelLeft, dt);
+    SimPlant_StepRotor(&s_wheelRight, dt);
+    SimPlant_StepRotor(&s_fan, dt);
+
+    float wheelCirc = SIM_PI * WHEEL_DIAMETER_M;
+    float vLeft = s_wheelLeft.rpm / 60.0f * wheelCirc;
+    float vRight = s_wheelRight.rpm / 60.0f * wheelCirc;
+
+    s_yawRateRad = (vRight - vLeft) / WHEEL_TRACK_WIDTH_M;
+    s_yawRad += s_yawRateRad * dt;
+    if (s_yawRad > SIM_PI) s_yawRad -= 2.0f * SIM_PI;
+    if (s_yawRad < -SIM_PI) s_yawRad += 2.0f * SIM_PI;
+}
+
+/**
+  * @brief  车体偏航状态
+  * @param  yawRateDps: 偏航角速度 (deg/s)，可为NULL
+  * @param  yawDeg: 偏航角 (deg, ±180)，可为NULL
+  * @retval None
+  */
+void SimPlant_GetBody(float *yawRateDps, float *yawDeg)
+{
+    if (yawRateDps) *yawRateDps = s_yawRateRad * 180.0f / SIM_PI;
+    if (yawDeg) *yawDeg = s_yawRad * 180.0f / SIM_PI;
+}
@@ -0,0 +1,206 @@
+/**
+  ******************************************************************************
+  * @file    sim_usb.c
+  * @brief   软件在环仿真：USB CDC 虚拟串口映射到 Linux pty
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 替代 USB_DEVICE/App/usbd_cdc_if.c 与 USB 设备栈：
+  * - 上位机打开 pty 从端视为枚举完成（dev_state=CONFIGURED），关闭视为拔出
+  * - OUT：每 1ms 最多读取若干个 64 字节包交给 USB_Comm_RxCpltCallback
+  * - IN：CDC_Transmit_FS 置 TxState 后由 1ms 节拍按全速带宽写出，
+  *   写完清 TxState 并调用 USB_Comm_TxCpltCallback，与 IN 端点完成中断时序一致
+  * 启动后在标准输出首行打印 "PTY <路径>"，供 sil_bench.py 等工具连接。
+  ******************************************************************************
+  */
+
+#define _GNU_SOURCE
+#include "sim.h"
+#include "usb_device.h"
+#include "usbd_cdc_if.h"
+#include "CleanBotApp.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define SIM_USB_PACKET_SIZE         64U
+#define SIM_USB_RX_PACKETS_PER_MS   8U      /* 每节拍最多读取的 OUT 包数 */
+#define SIM_USB_TX_BYTES_PER_MS     1216U   /* 全速批量传输每帧 19 包 */
+#define SIM_USB_TX_BUFFER_SIZE      2048U
+
+extern CleanBotApp_t *g_pCleanBotApp;
+
+USBD_HandleTypeDef hUsbDeviceFS;
+
+static USBD_CDC_HandleTypeDef s_cdc;
+static int s_master = -1;
+static char s_linkPath[256];
+static bool s_connected = false;
+static uint8_t s_txBuf[SIM_USB_TX_BUFFER_SIZE];
+static uint16_t s_txLen = 0;
+static uint16_t s_txPos = 0;
+
+/**
+  * @brief  USB 设备栈初始化：pty 已由 SimUsb_Init 在调度器启动前创建，此处无操作
+  */
+void MX_USB_DEVICE_Init(void)
+{
+}
+
+/**
+  * @brief  创建 pty 并打印从端路径
+  * @param  linkPath: 可选，为从端创建的符号链接路径（NULL 表示不创建）
+  * @retval true=成功
+  */
+bool SimUsb_Init(const char *linkPath)
+{
+    memset(&hUsbDeviceFS, 0, sizeof(hUsbDeviceFS));
+    memset(&s_cdc, 0, sizeof(s_cdc));
+    hUsbDeviceFS.dev_state = USBD_STATE_DEFAULT;
+
+    s_master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (s_master < 0 || grantpt(s_master) != 0 || unlockpt(s_master) != 0) {
+        perror("[SIL] posix_openpt");
+        return false;
+    }
+
+    const char *slavePath = ptsname(s_master);
+    if (slavePath == NULL) {
+        perror("[SIL] ptsname");
+        return false;
+    }
+
+    /* 从端设为原始模式：CDC 是透明字节流 */
+    int slave = open(slavePath, O_RDWR | O_NOCTTY);
+    if (slave >= 0) {
+        struct termios tio;
+        if (tcgetattr(slave, &tio) == 0) {
+            cfmakeraw(&tio);
+            tcsetattr(slave, TCSANOW, &tio);
+        }
+        close(slave);
+    }
+
+    s_linkPath[0] = '\0';
+    if (linkPath != NULL) {
+        unlink(linkPath);
+        if (symlink(slavePath, linkPath) != 0) {
+            perror("[SIL] symlink");
+        } else {
+            snprintf(s_linkPath, sizeof(s_linkPath), "%s", linkPath);
+        }
+    }
+
+    printf("PTY %s\n", (s_linkPath[0] != '\0') ? s_linkPath : slavePath);
+    fflush(stdout);
+    return true;
+}
+
+void SimUsb_Deinit(void)
+{
+    if (s_linkPath[0] != '\0') {
+        unlink(s_linkPath);
+        s_linkPath[0] = '\0';
+    }
+    if (s_master >= 0) {
+        close(s_master);
+        s_master = -1;
+    }
+}
+
+/**
+  * @brief  连接状态变化：等效 CDC_Init_FS / CDC_DeInit_FS
+  */
+static void SimUsb_SetConnected(bool connected)
+{
+    if (connected == s_connected) return;
+    s_connected = connected;
+
+    if (connected) {
+        s_cdc.TxState = 0;
+        hUsbDeviceFS.pClassData = &s_cdc;
+        hUsbDeviceFS.dev_state = USBD_STATE_CONFIGURED;
+    } else {
+        hUsbDeviceFS.dev_state = USBD_STATE_DEFAULT;
+        hUsbDeviceFS.pClassData = NULL;
+        s_txLen = 0;
+        s_txPos = 0;
+    }
+    if (g_pCleanBotApp != NULL) {
+        USB_Comm_SetConnected(&g_pCleanBotApp->usbComm, connected);
+    }
+}
+
+/**
+  * @brief  发送一包（与 usbd_cdc_if.c 中 CDC_Transmit_FS 语义一致）
+  */
+uint8_t CDC_Transmit_FS(uint8_t* Buf, uint16_t Len)
+{
+    USBD_CDC_HandleTypeDef *hcdc = (USBD_CDC_HandleTypeDef*)hUsbDeviceFS.pClassData;
+
+    if (hcdc == NULL || !s_connected) return USBD_FAIL;
+    if (hcdc->TxState != 0) return USBD_BUSY;
+    if (Buf == NULL || Len > SIM_USB_TX_BUFFER_SIZE) return USBD_FAIL;
+
+    memcpy(s_txBuf, Buf, Len);
+    s_txLen = Len;
+    s_txPos = 0;
+    hcdc->TxState = 1;
+    return USBD_OK;
+}
+
+/**
+  * @brief  1ms 仿真中断：连接检测、OUT 接收、IN 发送
+  * @retval None
+  */
+void SimUsb_Tick(void)
+{
+    if (s_master < 0) return;
+
+    struct pollfd pfd = { .fd = s_master, .events = POLLIN | POLLOUT, .revents = 0 };
+    if (poll(&pfd, 1, 0) < 0) return;
+
+    SimUsb_SetConnected((pfd.revents & POLLHUP) == 0);
+    if (!s_connected) return;
+
+    /* OUT 端点 */
+    for (uint32_t i = 0; i < SIM_USB_RX_PACKETS_PER_MS && (pfd.revents & POLLIN); i++) {
+        uint8_t pkt[SIM_USB_PACKET_SIZE];
+        ssize_t n = read(s_master, pkt, sizeof(pkt));
+        if (n <= 0) break;
+        if (g_pCleanBotApp != NULL) {
+            USB_Comm_RxCpltCallback(&g_pCleanBotApp->usbComm, pkt, (uint32_t)n);
+        }
+    }
+
+    /* IN 端点：完成回调内可能立即提交下一包，同一帧内继续发送直到带宽用完 */
+    uint32_t budget = SIM_USB_TX_BYTES_PER_MS;
+    while (s_cdc.TxState != 0 && budget > 0) {
+        uint32_t chunk = (uint32_t)(s_txLen - s_txPos);
+        if (chunk > budget) chunk = budget;
+        if (chunk > 0) {
+            ssize_t n = write(s_master, &s_txBuf[s_txPos], chunk);
+            if (n <= 0) {
+                /* 上位机未读取（pty 缓冲满）：等同主机不轮询 IN 端点 */
+                if (n < 0 && errno != EAGAIN && errno != EINTR) {
+                    perror("[SIL] pty write");
+                }
+                return;
+            }
+            s_txPos = (uint16_t)(s_txPos + (uint16_t)n);
+            budget -= (uint32_t)n;
+        }
+        if (s_txPos < s_txLen) return;
+
+        s_cdc.TxState = 0;
+        if (g_pCleanBotApp != NULL) {
+            USB_Comm_TxCpltCallback(&g_pCleanBotApp->usbComm);
+        }
+    }
+}
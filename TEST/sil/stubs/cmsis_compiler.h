@@ -0,0 +1,95 @@
+/**
+  ******************************************************************************
+  * @file    cmsis_compiler.h
+  * @brief   软件在环构建：Cortex-M 内核寄存器与内建函数的仿真替身
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 固件与 cmsis_os2.c 直接使用的 PRIMASK/IPSR/BASEPRI、SysTick、NVIC、CLZ 等
+  * 在此映射到仿真层（sim_hal.c）：
+  * - __disable_irq/__set_PRIMASK 屏蔽 POSIX 端口的节拍信号，任务间互斥语义与
+  *   单核关中断一致
+  * - __get_IPSR 在仿真中断上下文（sim_isr 任务执行外设回调期间）返回非零，
+  *   cmsis_os2.c 据此走 FromISR 分支
+  * SysTick 以变量而非宏提供，避免 cmsis_os2.c 生成依赖 Cortex-M 端口的
+  * SysTick_Handler。
+  ******************************************************************************
+  */
+
+#ifndef __CMSIS_COMPILER_H
+#define __CMSIS_COMPILER_H
+
+#include <stdint.h>
+
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE             static inline
+#endif
+#ifndef __STATIC_FORCEINLINE
+#define __STATIC_FORCEINLINE        static inline
+#endif
+#ifndef __INLINE
+#define __INLINE                    inline
+#endif
+#ifndef __WEAK
+#define __WEAK                      __attribute__((weak))
+#endif
+#ifndef __ALIGNED
+#define __ALIGNED(x)                __attribute__((aligned(x)))
+#endif
+#ifndef __PACKED
+#define __PACKED                    __attribute__((packed))
+#endif
+#ifndef __USED
+#define __USED                      __attribute__((used))
+#endif
+#ifndef __NO_RETURN
+#define __NO_RETURN                 __attribute__((__noreturn__))
+#endif
+#ifndef __ASM
+#define __ASM                       __asm
+#endif
+
+/* 仿真中断屏蔽与中断上下文（sim_hal.c） */
+void SimIrq_Disable(void);
+void SimIrq_Enable(void);
+uint32_t SimIrq_GetPrimask(void);
+uint32_t SimIrq_GetIpsr(void);
+
+__STATIC_INLINE void __disable_irq(void)            { SimIrq_Disable(); }
+__STATIC_INLINE void __enable_irq(void)             { SimIrq_Enable(); }
+__STATIC_INLINE uint32_t __get_PRIMASK(void)        { return SimIrq_GetPrimask(); }
+__STATIC_INLINE uint32_t __get_IPSR(void)           { return SimIrq_GetIpsr(); }
+__STATIC_INLINE uint32_t __get_BASEPRI(void)        { return 0U; }
+
+__STATIC_INLINE void __set_PRIMASK(uint32_t priMask)
+{
+    if (priMask != 0U) {
+        SimIrq_Disable();
+    } else {
+        SimIrq_Enable();
+    }
+}
+
+__STATIC_INLINE uint8_t __CLZ(uint32_t value)
+{
+    return (value == 0U) ? 32U : (uint8_t)__builtin_clz(value);
+}
+
+#define __NOP()                     ((void)0)
+#define __DSB()                     __sync_synchronize()
+#define __DMB()                     __sync_synchronize()
+#define __ISB()                     __sync_synchronize()
+#define __WFI()                     ((void)0)
+
+/* SysTick（cmsis_os2.c 读取节拍内计数） */
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t LOAD;
+    volatile uint32_t VAL;
+    volatile uint32_t CALIB;
+} SysTick_Type;
+
+extern SysTick_Type *const SysTick;
+
+#endif /* __CMSIS_COMPILER_H */
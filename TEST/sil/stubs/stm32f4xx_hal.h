@@ -0,0 +1,504 @@
+/**
+  ******************************************************************************
+  * @file    stm32f4xx_hal.h
+  * @brief   软件在环构建：STM32F4 HAL 与外设寄存器的仿真替身
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 只覆盖固件实际用到的子集，类型与寄存器布局与真实头文件一致（电机模块按
+  * CCR1..CCR4 连续布局寻址），外设实例指向 sim_hal.c 中的仿真寄存器：
+  * - GPIO：输出写 ODR，输入读 IDR，仿真输入变化经 HAL_GPIO_EXTI_Callback 上报
+  * - TIM：PWM 比较值由轮子对象模型读取，编码器计数由模型写入 CNT
+  * - USART：HAL_UARTEx_ReceiveToIdle_DMA 只登记缓冲，由 IMU 字节流喂入
+  * - ADC1：每次访问置位 EOC，DR 为仿真触点电压
+  * - DWT：CYCCNT 按单调时钟折算为 SystemCoreClock 周期
+  * - IWDG：sim_isr 任务按 PR/RLR 计时，超时未喂狗打印后退出
+  * - BKPSRAM：进程内数组，故障寄存器（SCB）与复位原因（RCC->CSR）恒为0
+  * - FLASH：进程内 1MB 数组（低 4GB 地址），编程按位与、扇区擦除置 0xFF，
+  *   --flash 指定文件时加锁后写回，跨进程保留黑匣子转储
+  ******************************************************************************
+  */
+
+#ifndef __STM32F4xx_HAL_H
+#define __STM32F4xx_HAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include "cmsis_compiler.h"
+
+#define __IO                        volatile
+#define __I                         volatile const
+#define UNUSED(X)                   (void)(X)
+
+#define __NVIC_PRIO_BITS            4U
+
+typedef enum {
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum {
+    RESET = 0U,
+    SET = !RESET
+} FlagStatus, ITStatus;
+
+typedef enum {
+    DISABLE = 0U,
+    ENABLE = !DISABLE
+} FunctionalState;
+
+/* ---------------- 中断号 ---------------- */
+typedef enum {
+    SVCall_IRQn = -5,
+    PendSV_IRQn = -2,
+    SysTick_IRQn = -1,
+    EXTI0_IRQn = 6,
+    EXTI1_IRQn = 7,
+    EXTI2_IRQn = 8,
+    EXTI3_IRQn = 9,
+    EXTI4_IRQn = 10,
+    EXTI9_5_IRQn = 23,
+    USART3_IRQn = 39,
+    EXTI15_10_IRQn = 40,
+    TIM7_IRQn = 55,
+    OTG_FS_IRQn = 67
+} IRQn_Type;
+
+static inline void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority) { (void)IRQn; (void)priority; }
+static inline void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t pre, uint32_t sub) { (void)IRQn; (void)pre; (void)sub; }
+static inline void HAL_NVIC_EnableIRQ(IRQn_Type IRQn) { (void)IRQn; }
+static inline void HAL_NVIC_DisableIRQ(IRQn_Type IRQn) { (void)IRQn; }
+
+/* 时钟使能在仿真中无作用 */
+#define __HAL_RCC_GPIOA_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_GPIOB_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_GPIOC_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_GPIOD_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_GPIOE_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_GPIOF_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_GPIOG_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_GPIOH_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_ADC1_CLK_ENABLE()     ((void)0)
+
+extern uint32_t SystemCoreClock;
+
+uint32_t HAL_GetTick(void);
+
+/* ---------------- GPIO ---------------- */
+typedef struct {
+    __IO uint32_t MODER;
+    __IO uint32_t OTYPER;
+    __IO uint32_t OSPEEDR;
+    __IO uint32_t PUPDR;
+    __IO uint32_t IDR;
+    __IO uint32_t ODR;
+    __IO uint32_t BSRR;
+    __IO uint32_t LCKR;
+    __IO uint32_t AFR[2];
+} GPIO_TypeDef;
+
+#define SIM_GPIO_PORT_COUNT         9U
+extern GPIO_TypeDef g_SimGpio[SIM_GPIO_PORT_COUNT];
+
+#define GPIOA                       (&g_SimGpio[0])
+#define GPIOB                       (&g_SimGpio[1])
+#define GPIOC                       (&g_SimGpio[2])
+#define GPIOD                       (&g_SimGpio[3])
+#define GPIOE                       (&g_SimGpio[4])
+#define GPIOF                       (&g_SimGpio[5])
+#define GPIOG                       (&g_SimGpio[6])
+#define GPIOH                       (&g_SimGpio[7])
+#define GPIOI                       (&g_SimGpio[8])
+
+#define GPIO_PIN_0                  ((uint16_t)0x0001)
+#define GPIO_PIN_1                  ((uint16_t)0x0002)
+#define GPIO_PIN_2                  ((uint16_t)0x0004)
+#define GPIO_PIN_3                  ((uint16_t)0x0008)
+#define GPIO_PIN_4                  ((uint16_t)0x0010)
+#define GPIO_PIN_5                  ((uint16_t)0x0020)
+#define GPIO_PIN_6                  ((uint16_t)0x0040)
+#define GPIO_PIN_7                  ((uint16_t)0x0080)
+#define GPIO_PIN_8                  ((uint16_t)0x0100)
+#define GPIO_PIN_9                  ((uint16_t)0x0200)
+#define GPIO_PIN_10                 ((uint16_t)0x0400)
+#define GPIO_PIN_11                 ((uint16_t)0x0800)
+#define GPIO_PIN_12                 ((uint16_t)0x1000)
+#define GPIO_PIN_13                 ((uint16_t)0x2000)
+#define GPIO_PIN_14                 ((uint16_t)0x4000)
+#define GPIO_PIN_15                 ((uint16_t)0x8000)
+#define GPIO_PIN_All                ((uint16_t)0xFFFF)
+
+typedef enum {
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct {
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+    uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+#define GPIO_MODE_INPUT             0x00000000U
+#define GPIO_MODE_OUTPUT_PP         0x00000001U
+#define GPIO_MODE_OUTPUT_OD         0x00000011U
+#define GPIO_MODE_AF_PP             0x00000002U
+#define GPIO_MODE_AF_OD             0x00000012U
+#define GPIO_MODE_ANALOG            0x00000003U
+#define GPIO_MODE_IT_RISING         0x10110000U
+#define GPIO_MODE_IT_FALLING        0x10210000U
+#define GPIO_MODE_IT_RISING_FALLING 0x10310000U
+#define GPIO_MODE_EXTI_MASK         0x10000000U
+
+#define GPIO_NOPULL                 0x00000000U
+#define GPIO_PULLUP                 0x00000001U
+#define GPIO_PULLDOWN               0x00000002U
+
+#define GPIO_SPEED_FREQ_LOW         0x00000000U
+#define GPIO_SPEED_FREQ_MEDIUM      0x00000001U
+#define GPIO_SPEED_FREQ_HIGH        0x00000002U
+#define GPIO_SPEED_FREQ_VERY_HIGH   0x00000003U
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
+
+/* EXTI：HAL_GPIO_Init 置位中断屏蔽寄存器，仿真输入只在 IMR 使能时回调 */
+typedef struct {
+    __IO uint32_t IMR;
+    __IO uint32_t EMR;
+    __IO uint32_t RTSR;
+    __IO uint32_t FTSR;
+    __IO uint32_t SWIER;
+    __IO uint32_t PR;
+} EXTI_TypeDef;
+
+extern EXTI_TypeDef g_SimExti;
+#define EXTI                        (&g_SimExti)
+
+/* ---------------- TIM ---------------- */
+typedef struct {
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t SMCR;
+    __IO uint32_t DIER;
+    __IO uint32_t SR;
+    __IO uint32_t EGR;
+    __IO uint32_t CCMR1;
+    __IO uint32_t CCMR2;
+    __IO uint32_t CCER;
+    __IO uint32_t CNT;
+    __IO uint32_t PSC;
+    __IO uint32_t ARR;
+    __IO uint32_t RCR;
+    __IO uint32_t CCR1;
+    __IO uint32_t CCR2;
+    __IO uint32_t CCR3;
+    __IO uint32_t CCR4;
+    __IO uint32_t BDTR;
+    __IO uint32_t DCR;
+    __IO uint32_t DMAR;
+    __IO uint32_t OR;
+} TIM_TypeDef;
+
+#define SIM_TIM_COUNT               15U
+extern TIM_TypeDef g_SimTim[SIM_TIM_COUNT];
+
+#define TIM1                        (&g_SimTim[1])
+#define TIM2                        (&g_SimTim[2])
+#define TIM3                        (&g_SimTim[3])
+#define TIM4                        (&g_SimTim[4])
+#define TIM5                        (&g_SimTim[5])
+#define TIM6                        (&g_SimTim[6])
+#define TIM7                        (&g_SimTim[7])
+#define TIM9                        (&g_SimTim[9])
+#define TIM10                       (&g_SimTim[10])
+
+typedef struct {
+    uint32_t Prescaler;
+    uint32_t CounterMode;
+    uint32_t Period;
+    uint32_t ClockDivision;
+    uint32_t RepetitionCounter;
+    uint32_t AutoReloadPreload;
+} TIM_Base_InitTypeDef;
+
+typedef struct {
+    TIM_TypeDef *Instance;
+    TIM_Base_InitTypeDef Init;
+} TIM_HandleTypeDef;
+
+#define TIM_CHANNEL_1               0x00000000U
+#define TIM_CHANNEL_2               0x00000004U
+#define TIM_CHANNEL_3               0x00000008U
+#define TIM_CHANNEL_4               0x0000000CU
+#define TIM_CHANNEL_ALL             0x0000003CU
+
+#define TIM_CR1_CEN                 (1U << 0)
+#define TIM_CR1_UDIS                (1U << 1)
+#define TIM_CCER_CC1E               (1U << 0)
+#define TIM_CCER_CC2E               (1U << 4)
+#define TIM_CCER_CC3E               (1U << 8)
+#define TIM_CCER_CC4E               (1U << 12)
+
+#define __HAL_TIM_SET_COMPARE(h, ch, v)     (*(&((h)->Instance->CCR1) + ((ch) >> 2U)) = (v))
+#define __HAL_TIM_GET_COMPARE(h, ch)        (*(&((h)->Instance->CCR1) + ((ch) >> 2U)))
+#define __HAL_TIM_SET_COUNTER(h, v)         ((h)->Instance->CNT = (v))
+#define __HAL_TIM_GET_COUNTER(h)            ((h)->Instance->CNT)
+#define __HAL_TIM_SET_AUTORELOAD(h, v)      do { (h)->Instance->ARR = (v); (h)->Init.Period = (v); } while (0)
+#define __HAL_TIM_GET_AUTORELOAD(h)         ((h)->Instance->ARR)
+#define __HAL_TIM_ENABLE_OCxPRELOAD(h, ch)  ((void)(h), (void)(ch))
+#define __HAL_TIM_DISABLE_OCxPRELOAD(h, ch) ((void)(h), (void)(ch))
+#define __HAL_TIM_ENABLE(h)                 ((h)->Instance->CR1 |= TIM_CR1_CEN)
+#define __HAL_TIM_DISABLE(h)                ((h)->Instance->CR1 &= ~TIM_CR1_CEN)
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_Encoder_Start(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_Encoder_Stop(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim);
+
+/* ---------------- USART ---------------- */
+typedef struct {
+    __IO uint32_t SR;
+    __IO uint32_t DR;
+    __IO uint32_t BRR;
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t CR3;
+    __IO uint32_t GTPR;
+} USART_TypeDef;
+
+extern USART_TypeDef g_SimUsart[6];
+
+#define USART1                      (&g_SimUsart[0])
+#define USART2                      (&g_SimUsart[1])
+#define USART3                      (&g_SimUsart[2])
+#define UART4                       (&g_SimUsart[3])
+#define UART5                       (&g_SimUsart[4])
+#define USART6                      (&g_SimUsart[5])
+
+typedef struct {
+    uint32_t BaudRate;
+    uint32_t WordLength;
+    uint32_t StopBits;
+    uint32_t Parity;
+    uint32_t Mode;
+    uint32_t HwFlowCtl;
+    uint32_t OverSampling;
+} UART_InitTypeDef;
+
+typedef struct {
+    USART_TypeDef *Instance;
+    UART_InitTypeDef Init;
+    uint8_t *pRxBuffPtr;            /* ReceiveToIdle_DMA 登记的接收缓冲 */
+    uint16_t RxXferSize;
+} UART_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart);
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size);
+
+/* ---------------- ADC ---------------- */
+typedef struct {
+    __IO uint32_t SR;
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t SMPR1;
+    __IO uint32_t SMPR2;
+    __IO uint32_t JOFR1;
+    __IO uint32_t JOFR2;
+    __IO uint32_t JOFR3;
+    __IO uint32_t JOFR4;
+    __IO uint32_t HTR;
+    __IO uint32_t LTR;
+    __IO uint32_t SQR1;
+    __IO uint32_t SQR2;
+    __IO uint32_t SQR3;
+    __IO uint32_t JSQR;
+    __IO uint32_t JDR1;
+    __IO uint32_t JDR2;
+    __IO uint32_t JDR3;
+    __IO uint32_t JDR4;
+    __IO uint32_t DR;
+} ADC_TypeDef;
+
+typedef struct {
+    __IO uint32_t CSR;
+    __IO uint32_t CCR;
+    __IO uint32_t CDR;
+} ADC_Common_TypeDef;
+
+ADC_TypeDef *SimADC_Regs(void);
+extern ADC_Common_TypeDef g_SimAdcCommon;
+
+#define ADC1                        (SimADC_Regs())
+#define ADC                         (&g_SimAdcCommon)
+
+#define ADC_SR_EOC                  (1U << 1)
+#define ADC_SR_OVR                  (1U << 5)
+#define ADC_CR2_ADON                (1U << 0)
+#define ADC_CR2_SWSTART             (1U << 30)
+#define ADC_CCR_ADCPRE              (3U << 16)
+
+/* ---------------- RCC / PWR / 备份 SRAM ---------------- */
+typedef struct {
+    __IO uint32_t CSR;              /* 仅复位原因寄存器 */
+} RCC_TypeDef;
+
+extern RCC_TypeDef g_SimRcc;
+#define RCC                         (&g_SimRcc)
+
+#define RCC_CSR_BORRSTF             (1UL << 25)
+#define RCC_CSR_PINRSTF             (1UL << 26)
+#define RCC_CSR_PORRSTF             (1UL << 27)
+#define RCC_CSR_SFTRSTF             (1UL << 28)
+#define RCC_CSR_IWDGRSTF            (1UL << 29)
+#define RCC_CSR_WWDGRSTF            (1UL << 30)
+#define RCC_CSR_LPWRRSTF            (1UL << 31)
+#define RCC_CSR_RMVF                (1UL << 24)
+
+#define __HAL_RCC_PWR_CLK_ENABLE()      ((void)0)
+#define __HAL_RCC_BKPSRAM_CLK_ENABLE()  ((void)0)
+static inline void HAL_PWR_EnableBkUpAccess(void) {}
+
+extern uint32_t g_SimBkpSram[1024];
+#define BKPSRAM_BASE                ((uintptr_t)g_SimBkpSram)
+
+/* ---------------- FLASH ---------------- */
+#define SIM_FLASH_SIZE              0x00100000U
+
+extern uint32_t g_SimFlash[SIM_FLASH_SIZE / 4U];
+#define FLASH_BASE                  ((uint32_t)(uintptr_t)g_SimFlash)
+
+#define FLASH_TYPEERASE_SECTORS     0x00U
+#define FLASH_TYPEPROGRAM_WORD      0x02U
+#define FLASH_VOLTAGE_RANGE_3       0x02U
+
+#define FLASH_FLAG_EOP              (1UL << 0)
+#define FLASH_FLAG_OPERR            (1UL << 1)
+#define FLASH_FLAG_WRPERR           (1UL << 4)
+#define FLASH_FLAG_PGAERR           (1UL << 5)
+#define FLASH_FLAG_PGPERR           (1UL << 6)
+#define FLASH_FLAG_PGSERR           (1UL << 7)
+#define __HAL_FLASH_CLEAR_FLAG(flag)    ((void)(flag))
+#define __HAL_FLASH_DATA_CACHE_DISABLE()    ((void)0)
+#define __HAL_FLASH_DATA_CACHE_RESET()      ((void)0)
+#define __HAL_FLASH_DATA_CACHE_ENABLE()     ((void)0)
+
+typedef struct {
+    __IO uint32_t ACR;
+    __IO uint32_t KEYR;
+    __IO uint32_t OPTKEYR;
+    __IO uint32_t SR;
+    __IO uint32_t CR;
+    __IO uint32_t OPTCR;
+} FLASH_TypeDef;
+
+extern FLASH_TypeDef g_SimFlashRegs;
+#define FLASH                       (&g_SimFlashRegs)
+#define FLASH_ACR_DCEN              (1UL << 10)
+#define FLASH_CR_SER                (1UL << 1)
+#define FLASH_CR_SNB                (0x1FUL << 3)
+
+#ifndef READ_BIT
+#define READ_BIT(reg, bit)          ((reg) & (bit))
+#define CLEAR_BIT(reg, bit)         ((reg) &= ~(bit))
+#endif
+
+typedef struct {
+    uint32_t TypeErase;
+    uint32_t Banks;
+    uint32_t Sector;
+    uint32_t NbSectors;
+    uint32_t VoltageRange;
+} FLASH_EraseInitTypeDef;
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data);
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError);
+void FLASH_Erase_Sector(uint32_t Sector, uint8_t VoltageRange);
+HAL_StatusTypeDef FLASH_WaitForLastOperation(uint32_t Timeout);
+
+/* ---------------- IWDG / DBGMCU ---------------- */
+typedef struct {
+    __IO uint32_t KR;
+    __IO uint32_t PR;
+    __IO uint32_t RLR;
+    __IO uint32_t SR;
+} IWDG_TypeDef;
+
+extern IWDG_TypeDef g_SimIwdg;
+#define IWDG                        (&g_SimIwdg)
+
+#define IWDG_SR_PVU                 (1UL << 0)
+#define IWDG_SR_RVU                 (1UL << 1)
+
+typedef struct {
+    __IO uint32_t IDCODE;
+    __IO uint32_t CR;
+    __IO uint32_t APB1FZ;
+    __IO uint32_t APB2FZ;
+} DBGMCU_TypeDef;
+
+extern DBGMCU_TypeDef g_SimDbgmcu;
+#define DBGMCU                      (&g_SimDbgmcu)
+
+#define DBGMCU_APB1_FZ_DBG_IWDG_STOP    (1UL << 12)
+
+/* ---------------- SCB 故障状态 ---------------- */
+typedef struct {
+    __IO uint32_t CFSR;
+    __IO uint32_t HFSR;
+    __IO uint32_t MMFAR;
+    __IO uint32_t BFAR;
+} SCB_Type;
+
+extern SCB_Type g_SimScb;
+#define SCB                         (&g_SimScb)
+
+#define SCB_CFSR_MMARVALID_Msk      (1UL << 7)
+#define SCB_CFSR_BFARVALID_Msk      (1UL << 15)
+
+void NVIC_SystemReset(void);
+
+/* ---------------- DWT / CoreDebug ---------------- */
+typedef struct {
+    __IO uint32_t CTRL;
+    __IO uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+    __IO uint32_t DHCSR;
+    __IO uint32_t DCRSR;
+    __IO uint32_t DCRDR;
+    __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+DWT_Type *SimDWT_Regs(void);
+extern CoreDebug_Type g_SimCoreDebug;
+
+#define DWT                         (SimDWT_Regs())
+#define CoreDebug                   (&g_SimCoreDebug)
+
+#define DWT_CTRL_CYCCNTENA_Msk      (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk  (1UL << 24)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __STM32F4xx_HAL_H */
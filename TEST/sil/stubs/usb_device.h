@@ -0,0 +1,27 @@
+/**
+  ******************************************************************************
+  * @file    usb_device.h
+  * @brief   软件在环构建：USB 设备初始化替身
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#ifndef __USB_DEVICE__H__
+#define __USB_DEVICE__H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "usbd_def.h"
+
+extern USBD_HandleTypeDef hUsbDeviceFS;
+
+void MX_USB_DEVICE_Init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USB_DEVICE__H__ */
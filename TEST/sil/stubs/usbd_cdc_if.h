@@ -0,0 +1,30 @@
+/**
+  ******************************************************************************
+  * @file    usbd_cdc_if.h
+  * @brief   软件在环构建：USB CDC 接口替身（CDC 端点映射到 Linux pty）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#ifndef __USBD_CDC_IF_H__
+#define __USBD_CDC_IF_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "usbd_def.h"
+
+typedef struct {
+    volatile uint32_t TxState;      /* 非零：上一包尚未发完 */
+    volatile uint32_t RxState;
+} USBD_CDC_HandleTypeDef;
+
+uint8_t CDC_Transmit_FS(uint8_t *Buf, uint16_t Len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USBD_CDC_IF_H__ */
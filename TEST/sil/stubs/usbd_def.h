@@ -0,0 +1,33 @@
+/**
+  ******************************************************************************
+  * @file    usbd_def.h
+  * @brief   软件在环构建：USB 设备库类型替身（仅 usb_comm.c 用到的字段）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#ifndef __USBD_DEF_H
+#define __USBD_DEF_H
+
+#include <stdint.h>
+#include "stm32f4xx_hal.h"   /* 真实 usbd_def.h 经 usbd_conf.h 引入 HAL 与 CMSIS 内核函数 */
+
+#define USBD_STATE_DEFAULT          0x01U
+#define USBD_STATE_ADDRESSED        0x02U
+#define USBD_STATE_CONFIGURED       0x03U
+#define USBD_STATE_SUSPENDED        0x04U
+
+typedef enum {
+    USBD_OK = 0U,
+    USBD_BUSY,
+    USBD_EMEM,
+    USBD_FAIL
+} USBD_StatusTypeDef;
+
+typedef struct {
+    volatile uint8_t dev_state;     /* pty 有客户端打开时为 CONFIGURED */
+    void *pClassData;               /* 指向 USBD_CDC_HandleTypeDef */
+} USBD_HandleTypeDef;
+
+#endif /* __USBD_DEF_H */
@@ -0,0 +1,272 @@
+"""
+CleanBot 事件跟踪导出与转换
+
+    python trace_tool.py capture --port COM5 -o run.cbtr           # 停止记录并导出缓冲（事后分析）
+    python trace_tool.py capture --port COM5 -o run.cbtr --stream 5 # 清空后连续推送 5 秒
+    python trace_tool.py convert run.cbtr -o run.json               # 转为 Chrome trace JSON
+
+JSON 可在 chrome://tracing 或 https://ui.perfetto.dev 打开。
+任务名取自同时收到的 0x23 SYSTEM_STATUS 帧（1Hz），capture 会至少等待一帧。
+
+.cbtr 文件：b'CBTR' + u8 版本 + u8 cpuMHz + u16 任务名个数 + 任务名个数 × (u8 编号 + 16 字节名)
+           + 事件 × (u32 绝对序号 + u32 周期计数 + u8 类型 + u8 编号 + u16 参数)
+"""
+import argparse
+import json
+import struct
+import sys
+import time
+
+HEADER = b'\x55\xAA'
+VERSION = 0x01
+MSG_TRACE_CONTROL = 0x13
+MSG_SYSTEM_STATUS = 0x23
+MSG_ACK = 0x24
+MSG_TRACE_DATA = 0x2B
+
+TRACE_OP_STOP = 0x00
+TRACE_OP_DUMP = 0x02
+TRACE_OP_STREAM = 0x03
+
+FLAG_LAST = 0x02
+FLAG_LOST = 0x04
+
+EV_ISR_ENTER, EV_ISR_EXIT, EV_TASK_IN, EV_MARK_BEGIN, EV_MARK_END, EV_MARK = range(1, 7)
+ISR_NAMES = ["TIM7", "EXTI", "USART3", "OTG_FS"]
+MARK_NAMES = ["motor_loop", "usb_frame", "sensor_batch"]
+
+TASK_NAME_LEN = 16
+FILE_MAGIC = b'CBTR'
+FILE_VERSION = 1
+EVENT_FMT = '<IIBBH'
+CYCLE_WRAP = 1 << 32
+NAME_WAIT_S = 1.5
+
+
+def crc16_ccitt(data, init=0xFFFF):
+    crc = init
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def build_frame(msg_id, payload, seq=0):
+    body = bytes([VERSION]) + struct.pack('<H', len(payload)) + bytes([msg_id, seq]) + payload
+    return HEADER + body + struct.pack('<H', crc16_ccitt(body))
+
+
+def iter_frames(buf):
+    """从 bytearray 中取出完整帧 (msg_id, payload)，消费掉已处理的字节"""
+    while True:
+        start = buf.find(HEADER)
+        if start < 0:
+            del buf[:max(0, len(buf) - 1)]
+            return
+        del buf[:start]
+        if len(buf) < 9:
+            return
+        length = struct.unpack_from('<H', buf, 3)[0]
+        if length > 128:
+            del buf[:2]
+            continue
+        total = 7 + length + 2
+        if len(buf) < total:
+            return
+        crc = struct.unpack_from('<H', buf, 7 + length)[0]
+        if buf[2] == VERSION and crc16_ccitt(buf[2:7 + length]) == crc:
+            yield buf[5], bytes(buf[7:7 + length])
+            del buf[:total]
+        else:
+            del buf[:2]
+
+
+def parse_task_names(payload, names):
+    first = payload[1]
+    entry = 7 + TASK_NAME_LEN
+    for off in range(14, len(payload) - entry + 1, entry):
+        number = payload[off]
+        names[number] = payload[off + 7:off + entry].split(b'\0', 1)[0].decode(errors='replace')
+    return first
+
+
+# ----------------- 采集 -----------------
+def capture(args):
+    import serial
+
+    ser = serial.Serial(args.port, args.baud, timeout=0.05)
+    buf = bytearray()
+    names = {}
+    events = []
+    cpu_mhz = 168
+    lost_frames = 0
+    done = False
+
+    op = TRACE_OP_STREAM if args.stream else TRACE_OP_DUMP
+    ser.write(build_frame(MSG_TRACE_CONTROL, bytes([op])))
+    end = time.time() + (args.stream if args.stream else args.timeout)
+    finish_time = None
+
+    while True:
+        now = time.time()
+        if finish_time is None and (now >= end or (done and not args.stream)):
+            finish_time = now
+            if args.stream:
+                ser.write(build_frame(MSG_TRACE_CONTROL, bytes([TRACE_OP_STOP])))
+        # 结束后再等一会儿任务名（SYSTEM_STATUS 为 1Hz）
+        if finish_time is not None and (names or now >= finish_time + NAME_WAIT_S):
+            break
+
+        chunk = ser.read(4096)
+        if not chunk:
+            continue
+        buf.extend(chunk)
+        for msg_id, payload in iter_frames(buf):
+            if msg_id == MSG_SYSTEM_STATUS and len(payload) >= 14:
+                parse_task_names(payload, names)
+            elif msg_id == MSG_TRACE_DATA and len(payload) >= 8:
+                flags, count, mhz, _, index = struct.unpack_from('<BBBBI', payload, 0)
+                cpu_mhz = mhz or cpu_mhz
+                if flags & FLAG_LOST:
+                    lost_frames += 1
+                for i in range(count):
+                    cycles, etype, eid, arg = struct.unpack_from('<IBBH', payload, 8 + i * 8)
+                    events.append((index + i, cycles, etype, eid, arg))
+                if flags & FLAG_LAST:
+                    done = True
+    ser.close()
+
+    if not args.stream and not done:
+        print("[WARN] 未收到导出结束帧，数据可能不完整", file=sys.stderr)
+    if lost_frames:
+        print(f"[WARN] {lost_frames} 帧之前有事件被覆盖（推送速度跟不上记录速度）", file=sys.stderr)
+
+    with open(args.output, 'wb') as f:
+        f.write(FILE_MAGIC + struct.pack('<BBH', FILE_VERSION, cpu_mhz, len(names)))
+        for number, name in sorted(names.items()):
+            f.write(struct.pack('<B', number) + name.encode()[:TASK_NAME_LEN].ljust(TASK_NAME_LEN, b'\0'))
+        for ev in events:
+            f.write(struct.pack(EVENT_FMT, *ev))
+    print(f"{len(events)} 个事件, {len(names)} 个任务名 -> {args.output}")
+
+
+# ----------------- 转换 -----------------
+def load_cbtr(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:4] != FILE_MAGIC:
+        raise ValueError(f"{path}: 不是 .cbtr 文件")
+    _, cpu_mhz, name_count = struct.unpack_from('<BBH', data, 4)
+    off = 8
+    names = {}
+    for _ in range(name_count):
+        number = data[off]
+        names[number] = data[off + 1:off + 1 + TASK_NAME_LEN].split(b'\0', 1)[0].decode(errors='replace')
+        off += 1 + TASK_NAME_LEN
+    size = struct.calcsize(EVENT_FMT)
+    events = [struct.unpack_from(EVENT_FMT, data, p) for p in range(off, len(data) - size + 1, size)]
+    return cpu_mhz, names, events
+
+
+def to_chrome_trace(cpu_mhz, names, events):
+    """事件 -> Chrome trace 事件列表；周期计数按顺序展开回绕，时间单位 us"""
+    out = []
+    pid_isr, pid_task, pid_mark = 1, 2, 3
+    for pid, label in ((pid_isr, "中断"), (pid_task, "任务"), (pid_mark, "标记")):
+        out.append({"ph": "M", "name": "process_name", "pid": pid, "args": {"name": label}})
+    for i, name in enumerate(ISR_NAMES):
+        out.append({"ph": "M", "name": "thread_name", "pid": pid_isr, "tid": i, "args": {"name": name}})
+    for i, name in enumerate(MARK_NAMES):
+        out.append({"ph": "M", "name": "thread_name", "pid": pid_mark, "tid": i, "args": {"name": name}})
+    for number, name in names.items():
+        out.append({"ph": "M", "name": "thread_name", "pid": pid_task, "tid": number,
+                    "args": {"name": f"{name} (#{number})"}})
+
+    events = sorted(events, key=lambda e: e[0])
+    base = None
+    wraps = 0
+    last_cycles = None
+    last_index = None
+    running = None  # (task_number, start_us)
+    isr_depth = {}
+
+    for index, cycles, etype, eid, arg in events:
+        if last_cycles is not None and cycles < last_cycles:
+            wraps += 1
+        last_cycles = cycles
+        abs_cycles = cycles + wraps * CYCLE_WRAP
+        if base is None:
+            base = abs_cycles
+        ts = (abs_cycles - base) / float(cpu_mhz)
+
+        if last_index is not None and index != last_index + 1:
+            out.append({"ph": "i", "s": "g", "name": f"丢失 {index - last_index - 1} 个事件",
+                        "pid": pid_task, "tid": 0, "ts": ts})
+            running = None
+            isr_depth.clear()
+        last_index = index
+
+        if etype == EV_TASK_IN:
+            if running is not None:
+                number, start = running
+                out.append({"ph": "X", "name": names.get(number, f"task{number}"), "pid": pid_task,
+                            "tid": number, "ts": start, "dur": ts - start})
+            running = (eid, ts)
+        elif etype in (EV_ISR_ENTER, EV_ISR_EXIT):
+            name = ISR_NAMES[eid] if eid < len(ISR_NAMES) else f"isr{eid}"
+            if etype == EV_ISR_ENTER:
+                isr_depth[eid] = isr_depth.get(eid, 0) + 1
+                ev = {"ph": "B", "name": name, "pid": pid_isr, "tid": eid, "ts": ts}
+                if name == "EXTI":
+                    ev["args"] = {"line": arg}
+                out.append(ev)
+            elif isr_depth.get(eid, 0) > 0:
+                isr_depth[eid] -= 1
+                out.append({"ph": "E", "pid": pid_isr, "tid": eid, "ts": ts})
+        elif etype in (EV_MARK_BEGIN, EV_MARK_END, EV_MARK):
+            name = MARK_NAMES[eid] if eid < len(MARK_NAMES) else f"mark{eid}"
+            if etype == EV_MARK_BEGIN:
+                out.append({"ph": "B", "name": name, "pid": pid_mark, "tid": eid, "ts": ts,
+                            "args": {"arg": arg}})
+            elif etype == EV_MARK_END:
+                out.append({"ph": "E", "pid": pid_mark, "tid": eid, "ts": ts})
+            else:
+                out.append({"ph": "i", "s": "t", "name": name, "pid": pid_mark, "tid": eid, "ts": ts,
+                            "args": {"arg": arg}})
+    return out
+
+
+def convert(args):
+    cpu_mhz, names, events = load_cbtr(args.input)
+    trace = to_chrome_trace(cpu_mhz, names, events)
+    output = args.output or args.input.rsplit('.', 1)[0] + '.json'
+    with open(output, 'w', encoding='utf-8') as f:
+        json.dump({"traceEvents": trace, "displayTimeUnit": "ns"}, f, ensure_ascii=False)
+    print(f"{len(events)} 个事件 -> {output}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="CleanBot 事件跟踪导出与转换")
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    cap = sub.add_parser("capture", help="经USB导出或连续推送跟踪事件")
+    cap.add_argument("--port", required=True)
+    cap.add_argument("--baud", type=int, default=921600)
+    cap.add_argument("-o", "--output", default="trace.cbtr")
+    cap.add_argument("--stream", type=float, default=0.0, help="连续推送秒数（0=导出现有缓冲）")
+    cap.add_argument("--timeout", type=float, default=3.0, help="导出超时 (s)")
+    cap.set_defaults(func=capture)
+
+    conv = sub.add_parser("convert", help=".cbtr 转 Chrome trace JSON")
+    conv.add_argument("input")
+    conv.add_argument("-o", "--output")
+    conv.set_defaults(func=convert)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -10,6 +10,10 @@
 #include "usart.h"
 #include "stm32f4xx_hal.h"
 #include "ring_buffer.h"
+#include "prof.h"
+#include "mem_section.h"
+#include "power_mgr.h"
+#include "supervisor.h"
 #include <string.h>
 #include <stdbool.h>
 
@@ -25,18 +29,27 @@
 #define WIT_ID_ANGLE                   0x53
 #define WIT_FRAME_LEN                  11
 
+/* 收到数据时唤醒IMU任务的线程标志 */
+#define IMU_RX_THREAD_FLAG             0x0001U
+
 /* -------------------------------------- */
 
-/* DMA接收临时缓冲（HAL UART RxEvent DMA to IDLE使用） */
-static uint8_t s_imuDmaRxBuf[IMU_DMA_RX_BUFFER_SIZE];
+/* DMA接收临时缓冲（HAL UART RxEvent DMA to IDLE使用，须在SRAM1） */
+DMA_BUFFER static uint8_t s_imuDmaRxBuf[IMU_DMA_RX_BUFFER_SIZE];
 /* 任务侧环形缓冲（拼接所有收到的字节流） */
-static RingBuffer_t s_rxRing;
-static uint8_t s_rxRingStorage[IMU_RING_BUFFER_SIZE];
+CCM_DATA static RingBuffer_t s_rxRing;
+CCM_DATA static uint8_t s_rxRingStorage[IMU_RING_BUFFER_SIZE];
+/* 接收回调唤醒的任务；停靠模式下停止DMA接收，回调不再重新启动 */
+static osThreadId_t s_imuThread = NULL;
+static volatile bool s_rxStopped = false;
 
 /* 最近一次解算结果（单位：deg、deg/s、g） */
 static volatile float s_roll = 0.0f, s_pitch = 0.0f, s_yaw = 0.0f;
 static volatile float s_gx = 0.0f, s_gy = 0.0f, s_gz = 0.0f;
 static volatile float s_ax = 0.0f, s_ay = 0.0f, s_az = 0.0f;
+/* 最近一次有效帧的时刻 (ms) */
+static volatile uint32_t s_lastFrameTick = 0;
+static volatile bool s_hasFrame = false;
 
 /* 工具函数：WIT 16位有符号，缩放因子见WIT文档
    - 加速度：原始单位 mg (±16g) -> g：raw/32768*16
@@ -82,8 +95,10 @@ static void wit_parse_frame(const uint8_t *frame)
 		s_yaw   = wit_to_angle_deg(z);
 		break;
 	default:
-		break;
+		return;
 	}
+	s_lastFrameTick = HAL_GetTick();
+	s_hasFrame = true;
 }
 
 /* 从环形缓冲中找帧并解析 */
@@ -140,7 +155,12 @@ void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
 	uint32_t written = RingBuffer_PutData(&s_rxRing, s_imuDmaRxBuf, Size);
 	(void)written;
 	/* 继续接收 */
-	HAL_UARTEx_ReceiveToIdle_DMA(&IMU_UART_HANDLE, s_imuDmaRxBuf, IMU_DMA_RX_BUFFER_SIZE);
+	if (!s_rxStopped) {
+		HAL_UARTEx_ReceiveToIdle_DMA(&IMU_UART_HANDLE, s_imuDmaRxBuf, IMU_DMA_RX_BUFFER_SIZE);
+	}
+	if (s_imuThread != NULL) {
+		osThreadFlagsSet(s_imuThread, IMU_RX_THREAD_FLAG);
+	}
 }
 
 /* 公共接口 */
@@ -162,18 +182,46 @@ void IMUTask_GetAccel(float *ax, float *ay, float *az)
 	if (ay) *ay = s_ay;
 	if (az) *az = s_az;
 }
+bool IMUTask_IsDataFresh(uint32_t maxAgeMs)
+{
+	if (!s_hasFrame) return false;
+	return (HAL_GetTick() - s_lastFrameTick) <= maxAgeMs;
+}
 
-/* 任务主体：持续消费环缓 -> 解析 -> 按200Hz上报 */
+/* 任务主体：等待接收回调 -> 消费环缓 -> 解析；停靠模式下停止接收，IMU 串口不再唤醒 CPU */
 void IMUTask_Run(void *argument)
 {
+	(void)argument;
+	bool docked = false;
+
 	/* 初始化环缓与DMA接收 */
 	RingBuffer_Init(&s_rxRing, s_rxRingStorage, IMU_RING_BUFFER_SIZE);
+	s_imuThread = osThreadGetId();
+	PowerMgr_RegisterThread(s_imuThread);
+	Supervisor_RegisterTask(SUPERVISOR_TASK_IMU, s_imuThread);
 	imu_uart_start_rx_to_idle();
 
 	for (;;) {
+		/* 无数据（停靠或IMU掉线）时也按 WATCHDOG_CHECKIN_MS 醒来签到 */
+		osThreadFlagsWait(IMU_RX_THREAD_FLAG | POWER_MODE_THREAD_FLAG, osFlagsWaitAny, WATCHDOG_CHECKIN_MS);
+		Supervisor_Heartbeat(SUPERVISOR_TASK_IMU);
+
+		if (PowerMgr_IsDocked() != docked) {
+			docked = !docked;
+			if (docked) {
+				s_rxStopped = true;
+				HAL_UART_AbortReceive(&IMU_UART_HANDLE);
+			} else {
+				RingBuffer_Reset(&s_rxRing);
+				s_rxStopped = false;
+				imu_uart_start_rx_to_idle();
+			}
+		}
+
 		/* 消费解析字节流 */
+		PROF_BEGIN(PROF_IMU_PARSE);
 		wit_consume_ring();
-		osDelay(1);
+		PROF_END(PROF_IMU_PARSE);
 	}
 }
 
@@ -15,6 +15,7 @@ extern "C" {
 #endif
 
 #include <stdint.h>
+#include <stdbool.h>
 
 /* 任务入口 */
 void IMUTask_Run(void *argument);
@@ -24,6 +25,9 @@ void IMUTask_GetEuler(float *roll, float *pitch, float *yaw);
 void IMUTask_GetGyro(float *gx, float *gy, float *gz);
 void IMUTask_GetAccel(float *ax, float *ay, float *az);
 
+/* 最近 maxAgeMs 内是否解析到有效帧（上电未收到、掉线或停靠停止接收时为 false） */
+bool IMUTask_IsDataFresh(uint32_t maxAgeMs);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,16 @@
 #include "motor_ctrl_task.h"
 #include "CleanBotApp.h"
 #include "led.h"
+#include "imu_task.h"
+#include "safety_reflex.h"
+#include "sensor_manager.h"
+#include "timebase.h"
+#include "trace.h"
+#include "prof.h"
+#include "mem_section.h"
+#include "power_mgr.h"
+#include "supervisor.h"
+#include "tim.h"
 #include "cmsis_os.h"
 #include <string.h>
 
@@ -17,7 +27,7 @@
 extern CleanBotApp_t *g_pCleanBotApp;
 
 /* 电机控制结构体 */
-static MotorCtrl_t g_MotorCtrl;
+CCM_DATA static MotorCtrl_t g_MotorCtrl;
 
 /* LED2闪烁状态 */
 static struct {
@@ -27,6 +37,45 @@ static struct {
 
 #define LED2_TOGGLE_INTERVAL_MS    500
 
+/* 辅助电机（边刷/水泵/风机）软启动斜坡 */
+CCM_DATA static MotorRamp_t g_MotorRamp;
+
+/* 轮电机堵转/打滑/卡滞诊断 */
+CCM_DATA static MotorDiag_t g_MotorDiag;
+
+/* 控制周期上次更新时间 */
+static uint32_t ctrlLastTick;
+
+/* 上一周期轨迹是否在输出 */
+static bool trajWasActive;
+
+/* 其他任务下发的轮速/(v, ω) 指令，由本任务在控制周期开始时取走执行，
+   避免低优先级任务改写运动控制器状态时被本任务抢占读到一半的数据 */
+static struct {
+    WheelCtrlMode_t mode;
+    float a;                /* 直接模式左轮速度 / 速度模式线速度 */
+    float b;                /* 直接模式右轮速度 / 速度模式角速度 */
+    bool pending;
+} wheelCmd;
+
+/* 判定整机空闲（可进入停靠模式）的轮速阈值 (m/s)，高于静止时编码器量化与PID保持零速的微动 */
+#define MOTOR_IDLE_SPEED_MS        0.05f
+
+/**
+ * @brief  最后的控制设定值（监督模块写故障快照时调用，只读静态变量）
+ */
+static void MotorCtrlTask_GetSetpoints(SupervisorSetpoints_t *setpoints)
+{
+    setpoints->leftSpeedMs = g_MotorCtrl.wheelMotor.leftSpeedMs;
+    setpoints->rightSpeedMs = g_MotorCtrl.wheelMotor.rightSpeedMs;
+    setpoints->linearMs = g_MotorCtrl.wheelMotor.linearMs;
+    setpoints->angularRadS = g_MotorCtrl.wheelMotor.angularRadS;
+    setpoints->brushLeft = (uint8_t)g_MotorCtrl.brushMotorLeft;
+    setpoints->brushRight = (uint8_t)g_MotorCtrl.brushMotorRight;
+    setpoints->pump = (uint8_t)g_MotorCtrl.pumpMotor;
+    setpoints->fan = (uint8_t)g_MotorCtrl.fanMotor;
+}
+
 /**
  * @brief  初始化电机控制任务
  */
@@ -35,6 +84,7 @@ void MotorCtrlTask_Init(void)
     memset(&g_MotorCtrl, 0, sizeof(MotorCtrl_t));
     
     g_MotorCtrl.wheelMotor.enabled = false;
+    g_MotorCtrl.wheelMotor.mode = WHEEL_CTRL_MODE_DIRECT;
     g_MotorCtrl.brushMotorLeft = BRUSH_MOTOR_LEVEL_OFF;
     g_MotorCtrl.brushMotorRight = BRUSH_MOTOR_LEVEL_OFF;
     g_MotorCtrl.pumpMotor = PUMP_MOTOR_LEVEL_OFF;
@@ -42,6 +92,45 @@ void MotorCtrlTask_Init(void)
     
     led2State.lastToggleTime = 0;
     led2State.state = false;
+    
+    MotorRamp_Init(&g_MotorRamp);
+    MotorRamp_Config(&g_MotorRamp, MOTOR_RAMP_CH_BRUSH_LEFT,
+                     RAMP_BRUSH_SLEW_UP, RAMP_BRUSH_SLEW_DOWN, RAMP_BRUSH_HEAVY != 0);
+    MotorRamp_Config(&g_MotorRamp, MOTOR_RAMP_CH_BRUSH_RIGHT,
+                     RAMP_BRUSH_SLEW_UP, RAMP_BRUSH_SLEW_DOWN, RAMP_BRUSH_HEAVY != 0);
+    MotorRamp_Config(&g_MotorRamp, MOTOR_RAMP_CH_PUMP,
+                     RAMP_PUMP_SLEW_UP, RAMP_PUMP_SLEW_DOWN, RAMP_PUMP_HEAVY != 0);
+    MotorRamp_Config(&g_MotorRamp, MOTOR_RAMP_CH_FAN,
+                     RAMP_FAN_SLEW_UP, RAMP_FAN_SLEW_DOWN, RAMP_FAN_HEAVY != 0);
+    
+    MotorDiagConfig_t diagCfg = {
+        .dutyDeadband   = MOTOR_DIAG_DUTY_DEADBAND,
+        .freeSpeedMs    = MOTOR_DIAG_FREE_SPEED_MS,
+        .modelTau       = MOTOR_DIAG_MODEL_TAU,
+        .stallDutyMin   = MOTOR_DIAG_STALL_DUTY_MIN,
+        .stallSpeedMax  = MOTOR_DIAG_STALL_SPEED_MAX,
+        .stallTime      = MOTOR_DIAG_STALL_TIME,
+        .jamSpeedRatio  = MOTOR_DIAG_JAM_SPEED_RATIO,
+        .jamDutyMin     = MOTOR_DIAG_JAM_DUTY_MIN,
+        .jamTime        = MOTOR_DIAG_JAM_TIME,
+        .slipYawErr     = MOTOR_DIAG_SLIP_YAW_ERR,
+        .slipTime       = MOTOR_DIAG_SLIP_TIME,
+        .dutyLimitStall = MOTOR_DIAG_DUTY_LIMIT_STALL,
+        .dutyLimitJam   = MOTOR_DIAG_DUTY_LIMIT_JAM,
+        .dutyLimitSlip  = MOTOR_DIAG_DUTY_LIMIT_SLIP,
+        .holdTime       = MOTOR_DIAG_HOLD_TIME,
+    };
+    MotorDiag_Init(&g_MotorDiag, &diagCfg, WHEEL_TRACK_WIDTH_M);
+    
+    ctrlLastTick = osKernelGetTickCount();
+    trajWasActive = false;
+    wheelCmd.pending = false;
+    
+    /* 碰撞/悬崖边沿直接唤醒本任务 */
+    SafetyReflex_SetNotifyThread(osThreadGetId());
+    PowerMgr_RegisterThread(osThreadGetId());
+    Supervisor_RegisterTask(SUPERVISOR_TASK_MOTOR, osThreadGetId());
+    Supervisor_SetSetpointSource(MotorCtrlTask_GetSetpoints);
 }
 
 /**
@@ -64,20 +153,194 @@ static void MotorCtrlTask_UpdateLED2(void)
     }
 }
 
+/**
+ * @brief  直接模式：给定左右轮目标速度（本任务内调用）
+ */
+static void MotorCtrlTask_ApplyWheelSpeed(float leftSpeedMs, float rightSpeedMs)
+{
+    g_MotorCtrl.wheelMotor.mode = WHEEL_CTRL_MODE_DIRECT;
+    g_MotorCtrl.wheelMotor.leftSpeedMs = leftSpeedMs;
+    g_MotorCtrl.wheelMotor.rightSpeedMs = rightSpeedMs;
+    g_MotorCtrl.wheelMotor.enabled = true;
+}
+
+/**
+ * @brief  速度模式：给定底盘 (v, ω)（本任务内调用）
+ */
+static void MotorCtrlTask_ApplyVelocity(float linearMs, float angularRadS)
+{
+    if (g_pCleanBotApp == NULL) return;
+    
+    /* 从直接模式切入时以当前轮速目标作为规划起点，避免速度跳变 */
+    if (g_MotorCtrl.wheelMotor.mode != WHEEL_CTRL_MODE_VELOCITY || !g_MotorCtrl.wheelMotor.enabled) {
+        float left = g_MotorCtrl.wheelMotor.enabled ? g_MotorCtrl.wheelMotor.leftSpeedMs : 0.0f;
+        float right = g_MotorCtrl.wheelMotor.enabled ? g_MotorCtrl.wheelMotor.rightSpeedMs : 0.0f;
+        MotionCtrl_Reset(&g_pCleanBotApp->motionCtrl, (left + right) * 0.5f,
+                         (right - left) / g_pCleanBotApp->motionCtrl.trackWidth);
+    }
+    
+    g_MotorCtrl.wheelMotor.linearMs = linearMs;
+    g_MotorCtrl.wheelMotor.angularRadS = angularRadS;
+    g_MotorCtrl.wheelMotor.mode = WHEEL_CTRL_MODE_VELOCITY;
+    g_MotorCtrl.wheelMotor.enabled = true;
+}
+
+/**
+ * @brief  取走其他任务下发的轮速/(v, ω) 指令并执行（控制周期开始时调用）
+ */
+static void MotorCtrlTask_ApplyCommand(void)
+{
+    __disable_irq();
+    bool pending = wheelCmd.pending;
+    WheelCtrlMode_t mode = wheelCmd.mode;
+    float a = wheelCmd.a;
+    float b = wheelCmd.b;
+    wheelCmd.pending = false;
+    __enable_irq();
+    
+    if (!pending) return;
+    if (mode == WHEEL_CTRL_MODE_VELOCITY) {
+        MotorCtrlTask_ApplyVelocity(a, b);
+    } else {
+        MotorCtrlTask_ApplyWheelSpeed(a, b);
+    }
+}
+
+/**
+ * @brief  轨迹执行（上位机预上传的轨迹按控制周期插值输出）
+ */
+static void MotorCtrlTask_TrajectoryControl(float dt)
+{
+    if (g_pCleanBotApp == NULL) return;
+    
+    Trajectory_t *traj = &g_pCleanBotApp->trajectory;
+    WheelMotorCtrl_t *wheel = &g_MotorCtrl.wheelMotor;
+    
+    /* 当前指令作为启动/恢复时的插值起点 */
+    float left = wheel->enabled ? wheel->leftSpeedMs : 0.0f;
+    float right = wheel->enabled ? wheel->rightSpeedMs : 0.0f;
+    float curA = left;
+    float curB = right;
+    if (traj->type == TRAJ_TYPE_VW) {
+        if (wheel->enabled && wheel->mode == WHEEL_CTRL_MODE_VELOCITY) {
+            MotionCtrl_GetCommand(&g_pCleanBotApp->motionCtrl, &curA, &curB);
+        } else {
+            curA = (left + right) * 0.5f;
+            curB = (right - left) / g_pCleanBotApp->motionCtrl.trackWidth;
+        }
+    }
+    
+    float a = 0.0f;
+    float b = 0.0f;
+    bool active = Trajectory_Step(traj, dt * 1000.0f, curA, curB, &a, &b);
+    if (active) {
+        if (traj->type == TRAJ_TYPE_VW) {
+            MotorCtrlTask_ApplyVelocity(a, b);
+        } else {
+            MotorCtrlTask_ApplyWheelSpeed(a, b);
+        }
+    } else if (trajWasActive) {
+        /* 轨迹结束/中止/缓冲耗尽：经运动控制器平滑停车 */
+        MotorCtrlTask_ApplyVelocity(0.0f, 0.0f);
+    }
+    trajWasActive = active;
+}
+
+/**
+ * @brief  运动控制器更新（速度模式下将 (v, ω) 分解为左右轮目标）
+ */
+static void MotorCtrlTask_MotionControl(float dt)
+{
+    if (g_pCleanBotApp == NULL) return;
+    if (!g_MotorCtrl.wheelMotor.enabled || g_MotorCtrl.wheelMotor.mode != WHEEL_CTRL_MODE_VELOCITY) return;
+    if (dt <= 0.0f) return;
+    
+    float gz = 0.0f;
+    IMUTask_GetGyro(NULL, NULL, &gz);
+    
+    MotionCtrl_t *mc = &g_pCleanBotApp->motionCtrl;
+    MotionCtrl_SetTarget(mc, g_MotorCtrl.wheelMotor.linearMs, g_MotorCtrl.wheelMotor.angularRadS);
+    MotionCtrl_Update(mc, dt,
+                      Encoder_GetSpeedMs(&g_pCleanBotApp->encoderWheelLeft),
+                      Encoder_GetSpeedMs(&g_pCleanBotApp->encoderWheelRight),
+                      DEG_TO_RAD(gz), IMUTask_IsDataFresh(IMU_DATA_MAX_AGE_MS));
+    MotionCtrl_GetWheelSpeed(mc, &g_MotorCtrl.wheelMotor.leftSpeedMs, &g_MotorCtrl.wheelMotor.rightSpeedMs);
+}
+
+/**
+ * @brief  按诊断结果限制轮电机占空比，故障期间清除积分避免饱和
+ */
+static float MotorCtrlTask_LimitWheelOutput(MotorDiagWheelId_t id, PIDController_t *pid, float output)
+{
+    float limit = MotorDiag_GetDutyLimit(&g_MotorDiag, id);
+    if (MotorDiag_GetFaults(&g_MotorDiag, id) != 0U) {
+        pid->integral = 0.0f;
+    }
+    if (output > limit) return limit;
+    if (output < -limit) return -limit;
+    return output;
+}
+
+/**
+ * @brief  安全反射：刹停轮电机
+ */
+static void MotorCtrlTask_ReflexBrake(TIM_HandleTypeDef *wheelTim)
+{
+    Motor_BeginSyncUpdate(wheelTim);
+    Motor_Brake(&g_pCleanBotApp->wheelMotorLeft);
+    Motor_Brake(&g_pCleanBotApp->wheelMotorRight);
+    Motor_EndSyncUpdate(wheelTim);
+    
+    PID_Reset(&g_pCleanBotApp->pidWheelLeft);
+    PID_Reset(&g_pCleanBotApp->pidWheelRight);
+    MotorDiag_Reset(&g_MotorDiag);
+}
+
 /**
  * @brief  轮电机PID控制
  */
 float watch_ms,watch_rpm,watch_target,watch_out=0.0;
-static void MotorCtrlTask_WheelMotorControl(void)
+static void MotorCtrlTask_WheelMotorControl(float dt)
 {
     if (g_pCleanBotApp == NULL) return;
     
+    /* 左右轮共用TIM4，同步更新保证两轮占空比在同一PWM周期生效 */
+    TIM_HandleTypeDef *wheelTim = g_pCleanBotApp->wheelMotorLeft.htim;
+    
+    /* 共用红外接收头引脚的左/右前下视按周期消抖后送反射 */
+    SensorManager_SampleSharedCliff(SensorManager_GetInstance());
+    
+    /* 碰撞/悬崖反射优先于上位机/轨迹/回充指令 */
+    SafetyReflexOutput_t reflex = SafetyReflex_Update(osKernelGetTickCount());
+    if (reflex.triggered) {
+        /* 丢弃原有运动指令：反射结束后停在原地，等待上位机重新下发 */
+        Trajectory_RequestAbort(&g_pCleanBotApp->trajectory);
+        MotionCtrl_Reset(&g_pCleanBotApp->motionCtrl, 0.0f, 0.0f);
+        g_MotorCtrl.wheelMotor.linearMs = 0.0f;
+        g_MotorCtrl.wheelMotor.angularRadS = 0.0f;
+        g_MotorCtrl.wheelMotor.leftSpeedMs = 0.0f;
+        g_MotorCtrl.wheelMotor.rightSpeedMs = 0.0f;
+    }
+    
     if (!g_MotorCtrl.wheelMotor.enabled) {
+        Motor_BeginSyncUpdate(wheelTim);
         Motor_Stop(&g_pCleanBotApp->wheelMotorLeft);
         Motor_Stop(&g_pCleanBotApp->wheelMotorRight);
+        Motor_EndSyncUpdate(wheelTim);
+        MotorDiag_Reset(&g_MotorDiag);
+        SafetyReflex_MarkOutputApplied(Timebase_GetUs() + Motor_GetUsToUpdate(wheelTim, WHEEL_PWM_TIM_CLOCK_MHZ));
         return;
     }
     
+    if (reflex.brake) {
+        MotorCtrlTask_ReflexBrake(wheelTim);
+        SafetyReflex_MarkOutputApplied(Timebase_GetUs() + Motor_GetUsToUpdate(wheelTim, WHEEL_PWM_TIM_CLOCK_MHZ));
+        return;
+    }
+    
+    /* 后退/转向阶段按反射目标速度闭环 */
+    float leftCmdMs = reflex.active ? reflex.leftSpeedMs : g_MotorCtrl.wheelMotor.leftSpeedMs;
+    float rightCmdMs = reflex.active ? reflex.rightSpeedMs : g_MotorCtrl.wheelMotor.rightSpeedMs;
     
     /* 获取当前速度 (m/s) */
     float leftSpeedMs = Encoder_GetSpeedMs(&g_pCleanBotApp->encoderWheelLeft);
@@ -88,8 +351,8 @@ static void MotorCtrlTask_WheelMotorControl(void)
     /* PID控制 - 目标速度转换为RPM（需要根据实际参数计算） */
     /* 简化处理：直接将m/s转换为PWM占空比 */
     /* 这里需要根据实际硬件特性调整转换系数 */
-    float leftTargetRPM = g_MotorCtrl.wheelMotor.leftSpeedMs * 60.0f / (3.14159f * 0.065f);  /* 假设轮子直径0.1m */
-    float rightTargetRPM = g_MotorCtrl.wheelMotor.rightSpeedMs * 60.0f / (3.14159f * 0.065f);
+    float leftTargetRPM = leftCmdMs * 60.0f / (3.14159f * WHEEL_DIAMETER_M);
+    float rightTargetRPM = rightCmdMs * 60.0f / (3.14159f * WHEEL_DIAMETER_M);
 		
 		watch_target = leftTargetRPM;
     
@@ -105,7 +368,13 @@ static void MotorCtrlTask_WheelMotorControl(void)
     float leftOutput = PID_Compute(&g_pCleanBotApp->pidWheelLeft, leftCurrentRPM);
     float rightOutput = PID_Compute(&g_pCleanBotApp->pidWheelRight, rightCurrentRPM);
     
+    /* 堵转/打滑/卡滞限幅 */
+    leftOutput = MotorCtrlTask_LimitWheelOutput(MOTOR_DIAG_WHEEL_LEFT, &g_pCleanBotApp->pidWheelLeft, leftOutput);
+    rightOutput = MotorCtrlTask_LimitWheelOutput(MOTOR_DIAG_WHEEL_RIGHT, &g_pCleanBotApp->pidWheelRight, rightOutput);
+    
     /* 设置电机速度和方向 */
+    Motor_BeginSyncUpdate(wheelTim);
+    
     /* 左轮电机 */
     if (leftOutput >= 0) {
         /* 正向 */
@@ -143,6 +412,18 @@ static void MotorCtrlTask_WheelMotorControl(void)
         if (rightSpeed > 1000) rightSpeed = 1000;
         Motor_SetSpeed(&g_pCleanBotApp->wheelMotorRight, rightSpeed);
     }
+    
+    Motor_EndSyncUpdate(wheelTim);
+    SafetyReflex_MarkOutputApplied(Timebase_GetUs() + Motor_GetUsToUpdate(wheelTim, WHEEL_PWM_TIM_CLOCK_MHZ));
+    
+    /* 诊断：指令/占空比/实测速度/IMU偏航角速度 */
+    float gz = 0.0f;
+    IMUTask_GetGyro(NULL, NULL, &gz);
+    float target[MOTOR_DIAG_WHEEL_COUNT] = { leftCmdMs, rightCmdMs };
+    float duty[MOTOR_DIAG_WHEEL_COUNT] = { leftOutput, rightOutput };
+    float meas[MOTOR_DIAG_WHEEL_COUNT] = { leftSpeedMs, rightSpeedMs };
+    bool yawValid = (MOTOR_DIAG_SLIP_ENABLE != 0) && IMUTask_IsDataFresh(IMU_DATA_MAX_AGE_MS);
+    MotorDiag_Update(&g_MotorDiag, dt, target, duty, meas, DEG_TO_RAD(gz), yawValid);
 }
 
 /**
@@ -165,8 +446,7 @@ static void MotorCtrlTask_BrushMotorControl(void)
             leftSpeed = BRUSH_MOTOR_SPEED_HIGH;
             break;
     }
-    Motor_SetSpeed(&g_pCleanBotApp->brushMotorLeft, leftSpeed);
-    Motor_SetDirection(&g_pCleanBotApp->brushMotorLeft, MOTOR_STATE_FORWARD);
+    MotorRamp_SetTarget(&g_MotorRamp, MOTOR_RAMP_CH_BRUSH_LEFT, leftSpeed);
     
     /* 右边刷 */
     int16_t rightSpeed = 0;
@@ -181,8 +461,7 @@ static void MotorCtrlTask_BrushMotorControl(void)
             rightSpeed = BRUSH_MOTOR_SPEED_HIGH;
             break;
     }
-    Motor_SetSpeed(&g_pCleanBotApp->brushMotorRight, rightSpeed);
-    Motor_SetDirection(&g_pCleanBotApp->brushMotorRight, MOTOR_STATE_FORWARD);
+    MotorRamp_SetTarget(&g_MotorRamp, MOTOR_RAMP_CH_BRUSH_RIGHT, rightSpeed);
 }
 
 /**
@@ -213,8 +492,7 @@ static void MotorCtrlTask_PumpMotorControl(void)
             speed = PUMP_MOTOR_SPEED_ULTRA;
             break;
     }
-    Motor_SetSpeed(&g_pCleanBotApp->pumpMotor, speed);
-    Motor_SetDirection(&g_pCleanBotApp->pumpMotor, MOTOR_STATE_FORWARD);
+    MotorRamp_SetTarget(&g_MotorRamp, MOTOR_RAMP_CH_PUMP, speed);
 }
 
 /**
@@ -246,8 +524,10 @@ static void MotorCtrlTask_FanMotorControl(void)
             break;
     }
     
+    /* 目标经斜坡发生器输出，关闭时同样按斜率下降 */
+    MotorRamp_SetTarget(&g_MotorRamp, MOTOR_RAMP_CH_FAN, (int16_t)targetRPM);
+    
     if (targetRPM == 0) {
-        Motor_Stop(&g_pCleanBotApp->fanMotor);
         return;
     }
     
@@ -261,11 +541,71 @@ static void MotorCtrlTask_FanMotorControl(void)
     
     /* PID计算 */
     float output = PID_Compute(&g_pCleanBotApp->pidFan, currentRPM);
+}
+
+/**
+ * @brief  辅助电机输出（斜坡更新后写入边刷/水泵/风机占空比）
+ */
+static void MotorCtrlTask_AuxMotorOutput(float dt)
+{
+    if (g_pCleanBotApp == NULL) return;
+    
+    MotorRamp_Update(&g_MotorRamp, dt);
+    
+    Motor_SetDirection(&g_pCleanBotApp->brushMotorLeft, MOTOR_STATE_FORWARD);
+    Motor_SetSpeed(&g_pCleanBotApp->brushMotorLeft, MotorRamp_GetOutput(&g_MotorRamp, MOTOR_RAMP_CH_BRUSH_LEFT));
     
-    /* 设置电机速度 */
-    Motor_SetDirection(&g_pCleanBotApp->fanMotor, MOTOR_STATE_FORWARD);
-    Motor_SetSpeed(&g_pCleanBotApp->fanMotor, (int16_t)targetRPM);
+    Motor_SetDirection(&g_pCleanBotApp->brushMotorRight, MOTOR_STATE_FORWARD);
+    Motor_SetSpeed(&g_pCleanBotApp->brushMotorRight, MotorRamp_GetOutput(&g_MotorRamp, MOTOR_RAMP_CH_BRUSH_RIGHT));
+    
+    Motor_SetDirection(&g_pCleanBotApp->pumpMotor, MOTOR_STATE_FORWARD);
+    Motor_SetSpeed(&g_pCleanBotApp->pumpMotor, MotorRamp_GetOutput(&g_MotorRamp, MOTOR_RAMP_CH_PUMP));
+    
+    int16_t fanOutput = MotorRamp_GetOutput(&g_MotorRamp, MOTOR_RAMP_CH_FAN);
+    if (fanOutput == 0) {
+        Motor_Stop(&g_pCleanBotApp->fanMotor);
+    } else {
+        Motor_SetDirection(&g_pCleanBotApp->fanMotor, MOTOR_STATE_FORWARD);
+        Motor_SetSpeed(&g_pCleanBotApp->fanMotor, fanOutput);
+    }
 }
+/**
+ * @brief  进入停靠模式：停止全部电机输出与TIM7编码器采样，LED2熄灭
+ */
+static void MotorCtrlTask_EnterDocked(void)
+{
+    if (g_pCleanBotApp == NULL) return;
+    
+    TIM_HandleTypeDef *wheelTim = g_pCleanBotApp->wheelMotorLeft.htim;
+    Motor_BeginSyncUpdate(wheelTim);
+    Motor_Stop(&g_pCleanBotApp->wheelMotorLeft);
+    Motor_Stop(&g_pCleanBotApp->wheelMotorRight);
+    Motor_EndSyncUpdate(wheelTim);
+    Motor_Stop(&g_pCleanBotApp->brushMotorLeft);
+    Motor_Stop(&g_pCleanBotApp->brushMotorRight);
+    Motor_Stop(&g_pCleanBotApp->pumpMotor);
+    Motor_Stop(&g_pCleanBotApp->fanMotor);
+    MotorDiag_Reset(&g_MotorDiag);
+    
+    HAL_TIM_Base_Stop_IT(&htim7);
+    LED_Off(&g_pCleanBotApp->led2);
+    led2State.state = false;
+}
+
+/**
+ * @brief  退出停靠模式：恢复TIM7采样，丢弃停靠期间的反射触发，控制周期从当前时刻重新计时
+ */
+static void MotorCtrlTask_ExitDocked(void)
+{
+    HAL_TIM_Base_Start_IT(&htim7);
+    SafetyReflex_DiscardPending();
+    if (g_pCleanBotApp != NULL) {
+        PID_Reset(&g_pCleanBotApp->pidWheelLeft);
+        PID_Reset(&g_pCleanBotApp->pidWheelRight);
+    }
+    ctrlLastTick = osKernelGetTickCount();
+}
+
 float leftCurrentRPM,rightCurrentRPM=0.0;
 float leftTarget,rightTarget=0.0;
 /**
@@ -276,11 +616,43 @@ void MotorCtrlTask_Run(void *argument)
     MotorCtrlTask_Init();
     
     while (1) {
+        Supervisor_Heartbeat(SUPERVISOR_TASK_MOTOR);
+        
+        /* 停靠模式：电机已停，不再按2ms周期运行，只等待模式切换（按时签到） */
+        if (PowerMgr_IsDocked()) {
+            MotorCtrlTask_EnterDocked();
+            while (PowerMgr_IsDocked()) {
+                osThreadFlagsWait(POWER_MODE_THREAD_FLAG, osFlagsWaitAny, WATCHDOG_CHECKIN_MS);
+                Supervisor_Heartbeat(SUPERVISOR_TASK_MOTOR);
+            }
+            MotorCtrlTask_ExitDocked();
+        }
+        
+        TRACE_MARK_BEGIN(TRACE_MARK_MOTOR_LOOP, 0U);
+        PROF_PERIOD(PROF_CTRL_PERIOD);
+        
         /* 更新LED2状态 */
         MotorCtrlTask_UpdateLED2();
         
+        /* 控制周期 */
+        uint32_t now = osKernelGetTickCount();
+        float dt = (float)(now - ctrlLastTick) * 0.001f;
+        ctrlLastTick = now;
+        
+        /* 上位机/回充下发的指令 */
+        MotorCtrlTask_ApplyCommand();
+        
+        /* 轨迹执行 */
+        MotorCtrlTask_TrajectoryControl(dt);
+        
+        /* 运动控制器 (v, ω) -> 左右轮目标 */
+        MotorCtrlTask_MotionControl(dt);
+        
+        PROF_BEGIN(PROF_MOTOR_OUTPUT);
         // /* 轮电机控制 */
-        MotorCtrlTask_WheelMotorControl();
+        PROF_BEGIN(PROF_WHEEL_CTRL);
+        MotorCtrlTask_WheelMotorControl(dt);
+        PROF_END(PROF_WHEEL_CTRL);
         // MotorCtrlTask_SetWheelSpeed(leftTarget, rightTarget);
         // /* 边刷电机控制 */
         MotorCtrlTask_BrushMotorControl();
@@ -290,6 +662,10 @@ void MotorCtrlTask_Run(void *argument)
         
         // /* 风机控制 */
          MotorCtrlTask_FanMotorControl();
+        
+        /* 辅助电机斜坡输出 */
+        MotorCtrlTask_AuxMotorOutput(dt);
+        PROF_END(PROF_MOTOR_OUTPUT);
         //  Motor_SetSpeed(&g_pCleanBotApp->fanMotor, 500);
         //  Motor_SetSpeed(&g_pCleanBotApp->pumpMotor, 500);
         //  Motor_SetSpeed(&g_pCleanBotApp->brushMotorLeft, 500);
@@ -301,18 +677,42 @@ void MotorCtrlTask_Run(void *argument)
         // leftCurrentRPM = Encoder_GetSpeed(&g_pCleanBotApp->encoderWheelLeft);
         // rightCurrentRPM = Encoder_GetSpeed(&g_pCleanBotApp->encoderWheelRight);
 
-        osDelay(2);  /* 5ms控制周期 */
+        TRACE_MARK_END(TRACE_MARK_MOTOR_LOOP);
+        
+        /* 2ms控制周期，碰撞/悬崖边沿或电源模式切换提前唤醒 */
+        osThreadFlagsWait(SAFETY_REFLEX_THREAD_FLAG | POWER_MODE_THREAD_FLAG, osFlagsWaitAny, 2);
     }
 }
 
+/**
+ * @brief  登记指令，下一控制周期开始时由电机控制任务执行（后到的覆盖未执行的）
+ */
+static void MotorCtrlTask_PostCommand(WheelCtrlMode_t mode, float a, float b)
+{
+    __disable_irq();
+    wheelCmd.mode = mode;
+    wheelCmd.a = a;
+    wheelCmd.b = b;
+    wheelCmd.pending = true;
+    __enable_irq();
+}
+
 /**
  * @brief  设置轮电机目标速度
  */
 void MotorCtrlTask_SetWheelSpeed(float leftSpeedMs, float rightSpeedMs)
 {
-    g_MotorCtrl.wheelMotor.leftSpeedMs = leftSpeedMs;
-    g_MotorCtrl.wheelMotor.rightSpeedMs = rightSpeedMs;
-    g_MotorCtrl.wheelMotor.enabled = true;
+    MotorCtrlTask_PostCommand(WHEEL_CTRL_MODE_DIRECT, leftSpeedMs, rightSpeedMs);
+}
+
+/**
+ * @brief  设置底盘线速度/角速度目标
+ * @param  linearMs: 线速度 (m/s)，前进为正
+ * @param  angularRadS: 角速度 (rad/s)，左转为正
+ */
+void MotorCtrlTask_SetVelocity(float linearMs, float angularRadS)
+{
+    MotorCtrlTask_PostCommand(WHEEL_CTRL_MODE_VELOCITY, linearMs, angularRadS);
 }
 
 /**
@@ -340,6 +740,58 @@ void MotorCtrlTask_SetFanMotor(FanMotorLevel_t level)
     g_MotorCtrl.fanMotor = level;
 }
 
+/**
+ * @brief  获取辅助电机斜坡状态（遥测使用）
+ */
+const MotorRamp_t* MotorCtrlTask_GetRamp(void)
+{
+    return &g_MotorRamp;
+}
+
+/**
+ * @brief  获取轮电机诊断状态
+ */
+const MotorDiag_t* MotorCtrlTask_GetDiag(void)
+{
+    return &g_MotorDiag;
+}
+
+/**
+ * @brief  整机是否空闲（无轮速/辅助电机输出、无轨迹与反射动作），用于判定能否进入停靠模式
+ */
+bool MotorCtrlTask_IsIdle(void)
+{
+    if (g_pCleanBotApp == NULL) return false;
+    
+    if (wheelCmd.pending) {
+        return false;
+    }
+    const WheelMotorCtrl_t *wheel = &g_MotorCtrl.wheelMotor;
+    if (wheel->enabled && (wheel->leftSpeedMs != 0.0f || wheel->rightSpeedMs != 0.0f ||
+                           (wheel->mode == WHEEL_CTRL_MODE_VELOCITY &&
+                            (wheel->linearMs != 0.0f || wheel->angularRadS != 0.0f)))) {
+        return false;
+    }
+    if (Trajectory_IsActive(&g_pCleanBotApp->trajectory)) {
+        return false;
+    }
+    for (uint8_t i = 0; i < MOTOR_RAMP_CH_COUNT; i++) {
+        if (MotorRamp_GetTarget(&g_MotorRamp, (MotorRampChannelId_t)i) != 0 ||
+            MotorRamp_GetOutput(&g_MotorRamp, (MotorRampChannelId_t)i) != 0) {
+            return false;
+        }
+    }
+    SafetyState_t reflexState = SafetyReflex_GetInstance()->state;
+    if (reflexState != SAFETY_STATE_IDLE && reflexState != SAFETY_STATE_HOLD) {
+        return false;
+    }
+    
+    float left = Encoder_GetSpeedMs(&g_pCleanBotApp->encoderWheelLeft);
+    float right = Encoder_GetSpeedMs(&g_pCleanBotApp->encoderWheelRight);
+    return (left < MOTOR_IDLE_SPEED_MS && left > -MOTOR_IDLE_SPEED_MS &&
+            right < MOTOR_IDLE_SPEED_MS && right > -MOTOR_IDLE_SPEED_MS);
+}
+
 /**
  * @brief  获取轮电机当前速度
  */
@@ -15,11 +15,22 @@ extern "C" {
 #endif
 
 #include "cleanbot_config.h"
+#include "motor_ramp.h"
+#include "motor_diag.h"
+
+/* 轮电机控制模式 */
+typedef enum {
+    WHEEL_CTRL_MODE_DIRECT = 0,     /* 直接给定左右轮速度 (m/s) */
+    WHEEL_CTRL_MODE_VELOCITY        /* 给定 (v, ω)，经运动控制器分解 */
+} WheelCtrlMode_t;
 
 /* 轮电机速度控制（m/s） */
 typedef struct {
+    WheelCtrlMode_t mode;   /* 控制模式 */
     float leftSpeedMs;      /* 左轮目标速度 (m/s) */
     float rightSpeedMs;     /* 右轮目标速度 (m/s) */
+    float linearMs;         /* 目标线速度 (m/s)，速度模式有效 */
+    float angularRadS;      /* 目标角速度 (rad/s)，速度模式有效 */
     bool enabled;           /* 使能标志 */
 } WheelMotorCtrl_t;
 
@@ -63,9 +74,12 @@ typedef struct {
 void MotorCtrlTask_Init(void);
 void MotorCtrlTask_Run(void *argument);
 
-/* 设置轮电机目标速度（主应用层调用） */
+/* 设置轮电机目标速度（主应用层调用，下一控制周期由电机控制任务执行） */
 void MotorCtrlTask_SetWheelSpeed(float leftSpeedMs, float rightSpeedMs);
 
+/* 设置底盘线速度/角速度目标（经运动控制器做加速度限制和两轮同步，下一控制周期执行） */
+void MotorCtrlTask_SetVelocity(float linearMs, float angularRadS);
+
 /* 设置边刷电机档位 */
 void MotorCtrlTask_SetBrushMotor(BrushMotorLevel_t left, BrushMotorLevel_t right);
 
@@ -75,9 +89,18 @@ void MotorCtrlTask_SetPumpMotor(PumpMotorLevel_t level);
 /* 设置风机档位 */
 void MotorCtrlTask_SetFanMotor(FanMotorLevel_t level);
 
+/* 获取辅助电机斜坡状态 */
+const MotorRamp_t* MotorCtrlTask_GetRamp(void);
+
+/* 获取轮电机堵转/打滑/卡滞诊断状态 */
+const MotorDiag_t* MotorCtrlTask_GetDiag(void);
+
 /* 获取轮电机当前速度（m/s） */
 void MotorCtrlTask_GetWheelSpeed(float *leftSpeedMs, float *rightSpeedMs);
 
+/* 整机是否空闲（停靠模式判定） */
+bool MotorCtrlTask_IsIdle(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -15,6 +15,15 @@
 #include "CleanBotApp.h"
 #include "nec_decode.h"
 #include "ir_homing.h"
+#include "charge_adc.h"
+#include "timebase.h"
+#include "trace.h"
+#include "motor_ctrl_task.h"
+#include "power_mgr.h"
+#include "supervisor.h"
+#include "blackbox.h"
+#include "imu_task.h"
+#include "safety_reflex.h"
 #include "cmsis_os.h"
 
 /* 外部应用对象 */
@@ -23,14 +32,6 @@ extern CleanBotApp_t *g_pCleanBotApp;
 /* 需要包含main.h获取GPIO定义 */
 #include "main.h"
 
-/* 按钮单击/双击识别状态 */
-static struct {
-    uint32_t pressTime;
-    uint32_t releaseTime;
-    bool waitingSecondClick;
-    uint32_t firstClickTime;
-} button1State, button2State;
-
 /* LED闪烁状态 */
 static struct {
     uint32_t blinkStartTime;
@@ -38,27 +39,47 @@ static struct {
     bool isBlinking;
 } led3BlinkState;
 
-#define BUTTON_CLICK_TIMEOUT_MS     500
-#define BUTTON_DOUBLE_CLICK_GAP_MS  300
 #define LED_BLINK_INTERVAL_MS       200
 #define LED_BLINK_COUNT             2
 
+/* 周期作业调度 (ms) */
+#define SENSOR_JOB_IR_MS            10      /* 红外边沿批量解码（128边沿缓冲约可容纳20ms） */
+#define SENSOR_JOB_HOMING_MS        10      /* 红外回充定位 */
+#define SENSOR_JOB_CHARGE_MS        10      /* 充电触点电压采样与去抖 */
+#define SENSOR_JOB_LED_MS           20      /* LED闪烁 */
+
+/* 黑匣子采样（低于电机控制任务的优先级，不占用控制循环时间） */
+#if BLACKBOX_ENABLE
+#define SENSOR_JOB_BLACKBOX_MS          BLACKBOX_PERIOD_MS
+#define SENSOR_JOB_BLACKBOX_DOCKED_MS   BLACKBOX_DOCKED_PERIOD_MS
+#else
+#define SENSOR_JOB_BLACKBOX_MS          0
+#define SENSOR_JOB_BLACKBOX_DOCKED_MS   0
+#endif
+
+/* 停靠模式下红外解码与回充定位的周期（POWER_DOCKED_IR_WAKE=0 时暂停） */
+#if POWER_DOCKED_IR_WAKE
+#define SENSOR_JOB_IR_DOCKED_MS     SENSOR_JOB_IR_MS
+#define SENSOR_JOB_HOMING_DOCKED_MS SENSOR_JOB_HOMING_MS
+#else
+#define SENSOR_JOB_IR_DOCKED_MS     0
+#define SENSOR_JOB_HOMING_DOCKED_MS 0
+#endif
+
+/* 周期作业 */
+typedef struct {
+    uint32_t periodMs;
+    uint32_t dockedPeriodMs;        /* 停靠模式下的周期，0=暂停 */
+    uint32_t nextRunMs;
+    void (*run)(SensorManager_t *manager);
+    bool (*armed)(void);            /* 为NULL时一直运行；返回false时按暂停处理 */
+} SensorTaskJob_t;
+
 /**
  * @brief  初始化传感器任务
  */
 void SensorTask_Init(void)
 {
-    /* 初始化按钮状态 */
-    button1State.pressTime = 0;
-    button1State.releaseTime = 0;
-    button1State.waitingSecondClick = false;
-    button1State.firstClickTime = 0;
-    
-    button2State.pressTime = 0;
-    button2State.releaseTime = 0;
-    button2State.waitingSecondClick = false;
-    button2State.firstClickTime = 0;
-    
     /* 初始化LED闪烁状态 */
     led3BlinkState.blinkStartTime = 0;
     led3BlinkState.blinkCount = 0;
@@ -104,132 +125,99 @@ static void SensorTask_StartLEDBlink(uint8_t count)
 }
 
 /**
- * @brief  处理按钮1事件
+ * @brief  处理按钮事件（去抖与手势识别已在传感器管理器的采样定时器中完成）
  */
-static void SensorTask_HandleButton1Event(SensorEvent_t *event)
+static void SensorTask_HandleButtonEvent(SensorEvent_t *event)
 {
     if (g_pCleanBotApp == NULL) return;
     
-    uint32_t currentTime = HAL_GetTick();
-    
-    if (event->type == SENSOR_EVENT_BUTTON1_PRESS) {
-        button1State.pressTime = currentTime;
-        /* 按下时点亮LED3 */
-        LED_On(&g_pCleanBotApp->led3);
-    } else if (event->type == SENSOR_EVENT_BUTTON1_RELEASE) {
-        button1State.releaseTime = currentTime;
-        
-        /* 检查是否在双击窗口内 */
-        if (button1State.waitingSecondClick) {
-            uint32_t gap = currentTime - button1State.firstClickTime;
-            if (gap < BUTTON_DOUBLE_CLICK_GAP_MS) {
-                /* 双击 */
-                // TODO: 处理双击事件
-                SensorTask_StartLEDBlink(2);
-                button1State.waitingSecondClick = false;
-            } else {
-                /* 超时，视为单击 */
-                // TODO: 处理单击事件
-                SensorTask_StartLEDBlink(1);
-                button1State.waitingSecondClick = false;
+    switch (event->type) {
+        case SENSOR_EVENT_BUTTON1_PRESS:
+        case SENSOR_EVENT_BUTTON2_PRESS:
+            /* 任意按键退出停靠模式 */
+            PowerMgr_RequestActive(osKernelGetTickCount());
+            /* 按下时点亮LED3 */
+            LED_On(&g_pCleanBotApp->led3);
+            break;
+        case SENSOR_EVENT_BUTTON1_RELEASE:
+        case SENSOR_EVENT_BUTTON2_RELEASE:
+            if (!led3BlinkState.isBlinking) {
+                LED_Off(&g_pCleanBotApp->led3);
             }
-        } else {
-            /* 第一次单击，等待第二次 */
-            button1State.firstClickTime = currentTime;
-            button1State.waitingSecondClick = true;
-        }
+            break;
+        case SENSOR_EVENT_BUTTON1_CLICK:
+        case SENSOR_EVENT_BUTTON2_CLICK:
+            // TODO: 处理单击事件
+            SensorTask_StartLEDBlink(1);
+            break;
+        case SENSOR_EVENT_BUTTON1_DOUBLE_CLICK:
+        case SENSOR_EVENT_BUTTON2_DOUBLE_CLICK:
+            // TODO: 处理双击事件
+            SensorTask_StartLEDBlink(2);
+            break;
+        case SENSOR_EVENT_BUTTON1_LONG_PRESS:
+        case SENSOR_EVENT_BUTTON2_LONG_PRESS:
+            // TODO: 处理长按事件
+            SensorTask_StartLEDBlink(4);
+            break;
+        default:
+            break;
     }
 }
 
 /**
- * @brief  处理按钮2事件
+ * @brief  红外边沿批量解码（四个接收头）
  */
-static void SensorTask_HandleButton2Event(SensorEvent_t *event)
+static void SensorTask_ProcessIR(SensorManager_t *sensorManager)
 {
     if (g_pCleanBotApp == NULL) return;
     
-    uint32_t currentTime = HAL_GetTick();
-    
-    if (event->type == SENSOR_EVENT_BUTTON2_PRESS) {
-        button2State.pressTime = currentTime;
-        LED_On(&g_pCleanBotApp->led3);
-    } else if (event->type == SENSOR_EVENT_BUTTON2_RELEASE) {
-        button2State.releaseTime = currentTime;
-        
-        if (button2State.waitingSecondClick) {
-            uint32_t gap = currentTime - button2State.firstClickTime;
-            if (gap < BUTTON_DOUBLE_CLICK_GAP_MS) {
-                /* 双击 */
-                SensorTask_StartLEDBlink(2);
-                button2State.waitingSecondClick = false;
-            } else {
-                /* 单击 */
-                SensorTask_StartLEDBlink(1);
-                button2State.waitingSecondClick = false;
-            }
-        } else {
-            button2State.firstClickTime = currentTime;
-            button2State.waitingSecondClick = true;
-        }
-    }
+    SensorManager_ProcessIR(sensorManager, IR_SENSOR_LEFT, &g_pCleanBotApp->irSensorLeft.decoder);
+    SensorManager_ProcessIR(sensorManager, IR_SENSOR_RIGHT, &g_pCleanBotApp->irSensorRight.decoder);
+    SensorManager_ProcessIR(sensorManager, IR_SENSOR_FRONT_LEFT, &g_pCleanBotApp->irSensorFrontLeft.decoder);
+    SensorManager_ProcessIR(sensorManager, IR_SENSOR_FRONT_RIGHT, &g_pCleanBotApp->irSensorFrontRight.decoder);
 }
 
 /**
- * @brief  处理红外传感器事件（NEC解码）
+ * @brief  处理红外传感器事件（已解码的NEC编码）
  */
-static void SensorTask_HandleIREvent(SensorEvent_t *event, IR_Sensor_t *sensor, int index)
+static void SensorTask_HandleIREvent(SensorEvent_t *event, int index)
 {
-    if (event == NULL || sensor == NULL || g_pCleanBotApp == NULL) {
+    if (event == NULL || g_pCleanBotApp == NULL) {
         return;
     }
     
-    /* 从事件数据中提取边沿信息 */
-    /* event->data 格式：bit 0 = 电平(0=低,1=高), bit 1-31 = 时间间隔(微秒) */
-    bool level = (event->data & 0x01) != 0;
+    /* event->data：地址 | 命令<<8 | 地址反码<<16 | 命令反码<<24 */
+    NEC_Data_t necData;
+    necData.address = (uint8_t)(event->data & 0xFF);
+    necData.command = (uint8_t)((event->data >> 8) & 0xFF);
+    necData.addressInv = (uint8_t)((event->data >> 16) & 0xFF);
+    necData.commandInv = (uint8_t)((event->data >> 24) & 0xFF);
+    necData.valid = true;
     
-    /* 使用事件时间戳作为绝对时间（微秒）传递给解码器 */
-    /* 解码器内部会计算时间间隔 */
-    uint32_t absoluteTime = event->timestamp;
+    /* 闪烁LED表示收到有效的NEC信号 */
+    SensorTask_StartLEDBlink(2);
     
-    /* 处理边沿信号到NEC解码器 */
-    bool decodeComplete = NEC_Decoder_ProcessEdge(&sensor->decoder, absoluteTime, level);
-    
-    /* 检查解码是否完成 */
-    if (decodeComplete || NEC_Decoder_IsDataReady(&sensor->decoder)) {
-        /* 获取解码数据 */
-        NEC_Data_t necData = NEC_Decoder_GetData(&sensor->decoder);
-        
-        if (necData.valid) {
-            /* 解码成功，处理NEC数据 */
-            /* 闪烁LED表示收到有效的NEC信号 */
-            SensorTask_StartLEDBlink(2);
-            
-            /* 更新红外回冲定位模块的接收器数据 */
-            IRPosition_t position;
-            switch (index) {
-                case 0:  /* 左侧红外传感器 */
-                    position = IR_POSITION_LEFT;
-                    break;
-                case 1:  /* 右侧红外传感器 */
-                    position = IR_POSITION_RIGHT;
-                    break;
-                case 2:  /* 左前红外传感器 */
-                    position = IR_POSITION_FRONT_LEFT;
-                    break;
-                case 3:  /* 右前红外传感器 */
-                    position = IR_POSITION_FRONT_RIGHT;
-                    break;
-                default:
-                    position = IR_POSITION_LEFT;  /* 默认值，不应该到达这里 */
-                    break;
-            }
-            IRHoming_UpdateReceiver(&g_pCleanBotApp->irHoming, position, &necData);
-        } else {
-            /* 解码失败，可能是时序错误或数据无效 */
-            /* 可以闪烁一次LED表示错误 */
-            SensorTask_StartLEDBlink(1);
-        }
+    /* 更新红外回冲定位模块的接收器数据 */
+    IRPosition_t position;
+    switch (index) {
+        case 0:  /* 左侧红外传感器 */
+            position = IR_POSITION_LEFT;
+            break;
+        case 1:  /* 右侧红外传感器 */
+            position = IR_POSITION_RIGHT;
+            break;
+        case 2:  /* 左前红外传感器 */
+            position = IR_POSITION_FRONT_LEFT;
+            break;
+        case 3:  /* 右前红外传感器 */
+            position = IR_POSITION_FRONT_RIGHT;
+            break;
+        default:
+            position = IR_POSITION_LEFT;  /* 默认值，不应该到达这里 */
+            break;
     }
+    IRHoming_UpdateReceiver(&g_pCleanBotApp->irHoming, position, &necData);
 }
 
 /**
@@ -308,28 +296,214 @@ static void SensorTask_HandleUnderSensorEvent(SensorEvent_t *event)
 }
 
 /**
- * @brief  检查按钮单击超时
+ * @brief  事件分发
  */
-static void SensorTask_CheckButtonTimeout(void)
+static void SensorTask_DispatchEvent(SensorEvent_t *event)
 {
-    uint32_t currentTime = HAL_GetTick();
+    if (g_pCleanBotApp == NULL) return;
     
-    /* 检查按钮1 */
-    if (button1State.waitingSecondClick) {
-        if (currentTime - button1State.firstClickTime > BUTTON_DOUBLE_CLICK_GAP_MS) {
-            /* 超时，视为单击 */
-            SensorTask_StartLEDBlink(1);
-            button1State.waitingSecondClick = false;
-        }
+    switch (event->type) {
+        case SENSOR_EVENT_IR_LEFT:
+            SensorTask_HandleIREvent(event, 0);
+            break;
+        case SENSOR_EVENT_IR_RIGHT:
+            SensorTask_HandleIREvent(event, 1);
+            break;
+        case SENSOR_EVENT_IR_FRONT_LEFT:
+            SensorTask_HandleIREvent(event, 2);
+            break;
+        case SENSOR_EVENT_IR_FRONT_RIGHT:
+            SensorTask_HandleIREvent(event, 3);
+            break;
+        case SENSOR_EVENT_PHOTO_GATE_LEFT:
+        case SENSOR_EVENT_PHOTO_GATE_RIGHT:
+            SensorTask_HandlePhotoGateEvent(event);
+            break;
+        case SENSOR_EVENT_BUTTON1_PRESS:
+        case SENSOR_EVENT_BUTTON1_RELEASE:
+        case SENSOR_EVENT_BUTTON1_CLICK:
+        case SENSOR_EVENT_BUTTON1_DOUBLE_CLICK:
+        case SENSOR_EVENT_BUTTON1_LONG_PRESS:
+        case SENSOR_EVENT_BUTTON2_PRESS:
+        case SENSOR_EVENT_BUTTON2_RELEASE:
+        case SENSOR_EVENT_BUTTON2_CLICK:
+        case SENSOR_EVENT_BUTTON2_DOUBLE_CLICK:
+        case SENSOR_EVENT_BUTTON2_LONG_PRESS:
+            SensorTask_HandleButtonEvent(event);
+            break;
+        case SENSOR_EVENT_UNDER_LEFT:
+        case SENSOR_EVENT_UNDER_RIGHT:
+        case SENSOR_EVENT_UNDER_CENTER:
+            SensorTask_HandleUnderSensorEvent(event);
+            break;
+        default:
+            break;
+    }
+}
+
+/* 周期作业包装 */
+static void SensorTask_JobIR(SensorManager_t *manager)
+{
+    SensorTask_ProcessIR(manager);
+}
+
+static void SensorTask_JobHoming(SensorManager_t *manager)
+{
+    (void)manager;
+    if (g_pCleanBotApp != NULL) {
+        IRHoming_Process(&g_pCleanBotApp->irHoming);
     }
+}
+
+static void SensorTask_JobCharge(SensorManager_t *manager)
+{
+    (void)manager;
+    if (g_pCleanBotApp == NULL) return;
+
+#if CHARGE_ADC_SOURCE == 1
+    /* 替身模拟源：两侧碰撞同时触发视为压上充电触点 */
+    bool pressed = (g_pCleanBotApp->photoGateLeft.state == PHOTO_GATE_BLOCKED) &&
+                   (g_pCleanBotApp->photoGateRight.state == PHOTO_GATE_BLOCKED);
+    ChargeADC_SetStandinMv(pressed ? CHARGE_DOCK_MV : 0U);
+#endif
+
+    uint32_t now = osKernelGetTickCount();
+    ChargeContact_Update(&g_pCleanBotApp->chargeContact, ChargeADC_ReadMv(), now);
+    bool present = ChargeContact_IsPresent(&g_pCleanBotApp->chargeContact);
+    IRHoming_UpdateChargeContact(&g_pCleanBotApp->irHoming, present);
+
+    /* 停靠判定：触点接通且无运动/清扫、回充流程不在进行中 */
+    HomingState_t homingState = IRHoming_GetState(&g_pCleanBotApp->irHoming);
+    bool homingBusy = (homingState >= HOMING_STATE_SEARCHING && homingState <= HOMING_STATE_DOCKING);
+    PowerMgr_Update(present, MotorCtrlTask_IsIdle() && !homingBusy, now);
+}
+
+static void SensorTask_JobLED(SensorManager_t *manager)
+{
+    (void)manager;
+    SensorTask_HandleLEDBlink();
+}
+
+/* 只在闪烁期间排期，空闲时不因LED唤醒任务 */
+static bool SensorTask_LEDArmed(void)
+{
+    return led3BlinkState.isBlinking;
+}
+
+/* 量化并限幅到 int16 范围，相邻两次的差值不会溢出 */
+static int32_t SensorTask_Quantize(float value, float scale)
+{
+    float q = value * scale;
+    if (q > 32767.0f) return 32767;
+    if (q < -32767.0f) return -32767;
+    return (int32_t)((q >= 0.0f) ? (q + 0.5f) : (q - 0.5f));
+}
+
+/**
+ * @brief  黑匣子采样：轮速/占空比（电机诊断）、IMU、控制状态与故障位
+ */
+static void SensorTask_JobBlackBox(SensorManager_t *manager)
+{
+    (void)manager;
+    if (g_pCleanBotApp == NULL) return;
+
+    BlackBoxSample_t sample;
+    const MotorDiag_t *diag = MotorCtrlTask_GetDiag();
+    const MotorDiagWheel_t *left = &diag->wheel[MOTOR_DIAG_WHEEL_LEFT];
+    const MotorDiagWheel_t *right = &diag->wheel[MOTOR_DIAG_WHEEL_RIGHT];
+    float yaw, gz, ax, ay;
+
+    IMUTask_GetEuler(NULL, NULL, &yaw);
+    IMUTask_GetGyro(NULL, NULL, &gz);
+    IMUTask_GetAccel(&ax, &ay, NULL);
+
+    sample.timeMs = osKernelGetTickCount();
+    sample.value[BLACKBOX_FIELD_LEFT_TARGET] = SensorTask_Quantize(left->targetMs, 1000.0f);
+    sample.value[BLACKBOX_FIELD_RIGHT_TARGET] = SensorTask_Quantize(right->targetMs, 1000.0f);
+    sample.value[BLACKBOX_FIELD_LEFT_SPEED] = SensorTask_Quantize(left->measMs, 1000.0f);
+    sample.value[BLACKBOX_FIELD_RIGHT_SPEED] = SensorTask_Quantize(right->measMs, 1000.0f);
+    sample.value[BLACKBOX_FIELD_LEFT_DUTY] = SensorTask_Quantize(left->duty, 1.0f);
+    sample.value[BLACKBOX_FIELD_RIGHT_DUTY] = SensorTask_Quantize(right->duty, 1.0f);
+    sample.value[BLACKBOX_FIELD_YAW] = SensorTask_Quantize(yaw, 100.0f);
+    sample.value[BLACKBOX_FIELD_GYRO_Z] = SensorTask_Quantize(gz, 10.0f);
+    sample.value[BLACKBOX_FIELD_ACCEL_X] = SensorTask_Quantize(ax, 1000.0f);
+    sample.value[BLACKBOX_FIELD_ACCEL_Y] = SensorTask_Quantize(ay, 1000.0f);
+
+    HomingState_t homingState = IRHoming_GetState(&g_pCleanBotApp->irHoming);
+    uint32_t state = (uint32_t)SafetyReflex_GetInstance()->state & BLACKBOX_STATE_SAFETY_MASK;
+    if (PowerMgr_IsDocked()) state |= BLACKBOX_STATE_DOCKED;
+    if (Trajectory_IsActive(&g_pCleanBotApp->trajectory)) state |= BLACKBOX_STATE_TRAJ_ACTIVE;
+    if (homingState >= HOMING_STATE_SEARCHING && homingState <= HOMING_STATE_DOCKING) state |= BLACKBOX_STATE_HOMING;
+    if (USB_Comm_IsConnected(&g_pCleanBotApp->usbComm)) state |= BLACKBOX_STATE_USB_CONNECTED;
+    sample.value[BLACKBOX_FIELD_STATE] = (int32_t)state;
+
+    uint32_t faults = ((uint32_t)MotorDiag_GetFaults(diag, MOTOR_DIAG_WHEEL_LEFT) << BLACKBOX_FAULT_LEFT_SHIFT) |
+                      ((uint32_t)MotorDiag_GetFaults(diag, MOTOR_DIAG_WHEEL_RIGHT) << BLACKBOX_FAULT_RIGHT_SHIFT);
+    if (PhotoGate_IsBlocked(&g_pCleanBotApp->photoGateLeft)) faults |= BLACKBOX_FAULT_BUMPER_LEFT;
+    if (PhotoGate_IsBlocked(&g_pCleanBotApp->photoGateRight)) faults |= BLACKBOX_FAULT_BUMPER_RIGHT;
+    if (g_pCleanBotApp->underLeftSuspended) faults |= BLACKBOX_FAULT_CLIFF_LEFT;
+    if (g_pCleanBotApp->underCenterSuspended) faults |= BLACKBOX_FAULT_CLIFF_CENTER;
+    if (g_pCleanBotApp->underRightSuspended) faults |= BLACKBOX_FAULT_CLIFF_RIGHT;
+    if (homingState == HOMING_STATE_FAILED || homingState == HOMING_STATE_TIMEOUT) faults |= BLACKBOX_FAULT_DOCK_FAILED;
+    sample.value[BLACKBOX_FIELD_FAULTS] = (int32_t)faults;
+
+    BlackBox_Record(&sample);
+}
+
+static SensorTaskJob_t sensorJobs[] = {
+    { SENSOR_JOB_IR_MS,       SENSOR_JOB_IR_DOCKED_MS,     0, SensorTask_JobIR,       NULL },
+    { SENSOR_JOB_CHARGE_MS,   POWER_DOCKED_CHARGE_MS,      0, SensorTask_JobCharge,   NULL },
+    { SENSOR_JOB_HOMING_MS,   SENSOR_JOB_HOMING_DOCKED_MS, 0, SensorTask_JobHoming,   NULL },
+    { SENSOR_JOB_LED_MS,      0,                           0, SensorTask_JobLED,      SensorTask_LEDArmed },
+    { SENSOR_JOB_BLACKBOX_MS, SENSOR_JOB_BLACKBOX_DOCKED_MS, 0, SensorTask_JobBlackBox, NULL },
+};
+
+#define SENSOR_JOB_COUNT    (sizeof(sensorJobs) / sizeof(sensorJobs[0]))
+
+/**
+ * @brief  执行到期的周期作业
+ * @retval 距下一个作业到期的时间 (ms)
+ */
+static uint32_t SensorTask_RunDueJobs(SensorManager_t *manager)
+{
+    uint32_t now = osKernelGetTickCount();
+    uint32_t wait = UINT32_MAX;
+    bool docked = PowerMgr_IsDocked();
     
-    /* 检查按钮2 */
-    if (button2State.waitingSecondClick) {
-        if (currentTime - button2State.firstClickTime > BUTTON_DOUBLE_CLICK_GAP_MS) {
-            SensorTask_StartLEDBlink(1);
-            button2State.waitingSecondClick = false;
+    for (uint32_t i = 0; i < SENSOR_JOB_COUNT; i++) {
+        SensorTaskJob_t *job = &sensorJobs[i];
+        uint32_t periodMs = docked ? job->dockedPeriodMs : job->periodMs;
+        if (periodMs == 0U || (job->armed != NULL && !job->armed())) {
+            /* 暂停中：保持排期为当前时间，恢复后立即运行一次 */
+            job->nextRunMs = now;
+            continue;
+        }
+        if ((int32_t)(now - job->nextRunMs) >= 0) {
+            job->run(manager);
+            job->nextRunMs += periodMs;
+            /* 落后超过一个周期时不补跑，从当前时间重新排期 */
+            if ((int32_t)(now - job->nextRunMs) >= 0) {
+                job->nextRunMs = now + periodMs;
+            }
+        }
+        uint32_t remain = job->nextRunMs - now;
+        if (remain < wait) {
+            wait = remain;
         }
     }
+    return wait;
+}
+
+/**
+ * @brief  电源模式切换：停靠时屏蔽红外接收头中断并熄灭LED3
+ */
+static void SensorTask_ApplyPowerMode(SensorManager_t *manager, bool docked)
+{
+    SensorManager_SetIRCaptureEnabled(manager, !docked || POWER_DOCKED_IR_WAKE);
+    if (docked && g_pCleanBotApp != NULL) {
+        led3BlinkState.isBlinking = false;
+        LED_Off(&g_pCleanBotApp->led3);
+    }
 }
 
 /**
@@ -342,62 +516,47 @@ void SensorTask_Run(void *argument)
     
     SensorTask_Init();
     SensorManager_Start(sensorManager);
+    Supervisor_RegisterTask(SUPERVISOR_TASK_SENSOR, osThreadGetId());
+    
+    uint32_t start = osKernelGetTickCount();
+    for (uint32_t i = 0; i < SENSOR_JOB_COUNT; i++) {
+        sensorJobs[i].nextRunMs = start;
+    }
+    bool docked = false;
     
     while (1) {
-        /* 处理LED闪烁 */
-        SensorTask_HandleLEDBlink();
+        Supervisor_Heartbeat(SUPERVISOR_TASK_SENSOR);
         
-        /* 检查按钮滤波检测 */
-        SensorManager_CheckButtonDebounce(sensorManager);
+        /* 微秒时间基准折算（防止DWT计数器回绕丢失） */
+        Timebase_Update();
         
-        /* 检查按钮超时 */
-        SensorTask_CheckButtonTimeout();
+        /* 周期作业（LED/红外解码/触点采样/回充定位/黑匣子），返回距下次到期时间 */
+        uint32_t wait = SensorTask_RunDueJobs(sensorManager);
         
-        /* 处理红外回冲定位（如果使能） */
-        if (g_pCleanBotApp != NULL) {
-            IRHoming_Process(&g_pCleanBotApp->irHoming);
+        /* 停靠模式由触点作业、按键或USB命令切换，此处同步红外捕获；
+           USB 命令引起的退出最迟在下一次触点作业时生效 */
+        if (PowerMgr_IsDocked() != docked) {
+            docked = !docked;
+            SensorTask_ApplyPowerMode(sensorManager, docked);
+            if (!docked) {
+                wait = 0;
+            }
         }
         
-        /* 从队列获取事件 */
-        if (SensorManager_GetEvent(sensorManager, &event, 10)) {
-            if (g_pCleanBotApp != NULL) {
-                switch (event.type) {
-                    case SENSOR_EVENT_IR_LEFT:
-                        SensorTask_HandleIREvent(&event, &g_pCleanBotApp->irSensorLeft, 0);
-                        break;
-                    case SENSOR_EVENT_IR_RIGHT:
-                        SensorTask_HandleIREvent(&event, &g_pCleanBotApp->irSensorRight, 1);
-                        break;
-                    case SENSOR_EVENT_IR_FRONT_LEFT:
-                        SensorTask_HandleIREvent(&event, &g_pCleanBotApp->irSensorFrontLeft, 2);
-                        break;
-                    case SENSOR_EVENT_IR_FRONT_RIGHT:
-                        SensorTask_HandleIREvent(&event, &g_pCleanBotApp->irSensorFrontRight, 3);
-                        break;
-                    case SENSOR_EVENT_PHOTO_GATE_LEFT:
-                    case SENSOR_EVENT_PHOTO_GATE_RIGHT:
-                        SensorTask_HandlePhotoGateEvent(&event);
-                        break;
-                    case SENSOR_EVENT_BUTTON1_PRESS:
-                    case SENSOR_EVENT_BUTTON1_RELEASE:
-                        SensorTask_HandleButton1Event(&event);
-                        break;
-                    case SENSOR_EVENT_BUTTON2_PRESS:
-                    case SENSOR_EVENT_BUTTON2_RELEASE:
-                        SensorTask_HandleButton2Event(&event);
-                        break;
-                    case SENSOR_EVENT_UNDER_LEFT:
-                    case SENSOR_EVENT_UNDER_RIGHT:
-                    case SENSOR_EVENT_UNDER_CENTER:
-                        SensorTask_HandleUnderSensorEvent(&event);
-                        break;
-                    default:
-                        break;
+        /* 阻塞等待事件直到下一个作业到期，唤醒后一次取空队列 */
+        if (SensorManager_GetEvent(sensorManager, &event, wait)) {
+            uint8_t batch = 0;
+            do {
+                SensorTask_DispatchEvent(&event);
+                if (batch < UINT8_MAX) {
+                    batch++;
                 }
+            } while (SensorManager_GetEvent(sensorManager, &event, 0));
+            
+            TRACE_MARK(TRACE_MARK_SENSOR_BATCH, batch);
+            if (batch > sensorManager->eventBatchMax) {
+                sensorManager->eventBatchMax = batch;
             }
         }
-        
-        osDelay(10);
     }
 }
-
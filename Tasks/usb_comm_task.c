@@ -7,11 +7,19 @@
 
 #include "usb_comm_task.h"
 #include "usb_comm.h"
+#include "usb_frame.h"
 #include "motor_ctrl_task.h"
 #include "imu_task.h"
 #include "CleanBotApp.h"
 #include "encoder.h"
 #include "led.h"
+#include "safety_reflex.h"
+#include "task_stats.h"
+#include "trace.h"
+#include "prof.h"
+#include "power_mgr.h"
+#include "supervisor.h"
+#include "blackbox.h"
 #include "cmsis_os.h"
 #include <math.h>
 #include <string.h>
@@ -24,19 +32,33 @@ extern CleanBotApp_t *g_pCleanBotApp;
 #endif
 
 /* ========================== 协议定义 ========================== */
-#define USB_FRAME_HEADER0             0x55
-#define USB_FRAME_HEADER1             0xAA
-#define USB_PROTOCOL_VERSION          0x01
-#define USB_MAX_PAYLOAD_SIZE          96U
-#define USB_MAX_FRAME_SIZE            (USB_MAX_PAYLOAD_SIZE + 8U)
+#define USB_MAX_PAYLOAD_SIZE          USB_FRAME_MAX_PAYLOAD
+#define USB_MAX_FRAME_SIZE            USB_FRAME_MAX_SIZE
 
 typedef enum {
     USB_MSG_CONTROL_CMD      = 0x10,
+    USB_MSG_TRAJ_APPEND      = 0x11,
+    USB_MSG_TRAJ_CONTROL     = 0x12,
+    USB_MSG_TRACE_CONTROL    = 0x13,
+    USB_MSG_PROF_CONTROL     = 0x14,
+    USB_MSG_FAULT_CONTROL    = 0x15,
+    USB_MSG_BLACKBOX_CONTROL = 0x16,
     USB_MSG_IMU_FEEDBACK     = 0x20,
     USB_MSG_WHEEL_FEEDBACK   = 0x21,
     USB_MSG_SENSOR_STATUS    = 0x22,
     USB_MSG_SYSTEM_STATUS    = 0x23,
-    USB_MSG_ACK_REPLY        = 0x24
+    USB_MSG_ACK_REPLY        = 0x24,
+    USB_MSG_ACTUATOR_STATUS  = 0x25,
+    USB_MSG_TRAJ_STATUS      = 0x26,
+    USB_MSG_MOTOR_DIAG       = 0x27,
+    USB_MSG_IR_STATS         = 0x28,
+    USB_MSG_SAFETY_STATUS    = 0x29,
+    USB_MSG_HOMING_STATUS    = 0x2A,
+    USB_MSG_TRACE_DATA       = 0x2B,
+    USB_MSG_PROF_DATA        = 0x2C,
+    USB_MSG_POWER_STATUS     = 0x2D,
+    USB_MSG_FAULT_REPORT     = 0x2E,
+    USB_MSG_BLACKBOX_DATA    = 0x2F
 } UsbMsgId_t;
 
 typedef enum {
@@ -54,33 +76,12 @@ typedef enum {
     ACK_STATUS_BUSY = 2
 } AckStatus_t;
 
-typedef enum {
-    RX_WAIT_HEADER0 = 0,
-    RX_WAIT_HEADER1,
-    RX_READ_VERSION,
-    RX_READ_LEN_L,
-    RX_READ_LEN_H,
-    RX_READ_MSG_ID,
-    RX_READ_SEQ,
-    RX_READ_PAYLOAD,
-    RX_READ_CRC_L,
-    RX_READ_CRC_H
-} RxState_t;
-
-typedef struct {
-    RxState_t  state;
-    uint8_t    version;
-    uint16_t   payloadLen;
-    uint8_t    msgId;
-    uint8_t    seq;
-    uint16_t   payloadIndex;
-    uint8_t    payload[USB_MAX_PAYLOAD_SIZE];
-    uint16_t   rxCrc;
-} UsbRxParser_t;
-
 typedef struct {
     float leftSpeedMs;
     float rightSpeedMs;
+    float linearMs;
+    float angularRadS;
+    uint8_t ctrlFlags;
     WorkMode_t workMode;
     uint8_t fanLevel;
     uint8_t waterLevel;
@@ -105,6 +106,9 @@ typedef struct {
 #define FAULT_FLAG_BUMPER_RIGHT   (1U << 2)
 #define FAULT_FLAG_CLIFF          (1U << 3)
 #define FAULT_FLAG_DOCK_FAILED    (1U << 4)
+#define FAULT_FLAG_WHEEL_STALL    (1U << 5)
+#define FAULT_FLAG_WHEEL_SLIP     (1U << 6)
+#define FAULT_FLAG_WHEEL_JAM      (1U << 7)
 
 /* 物理常量 */
 #define G_TO_M_S2                 9.80665f
@@ -113,13 +117,104 @@ typedef struct {
 #define PERIOD_WHEEL_MS           5U     /* 200Hz */
 #define PERIOD_IMU_MS             5U    /* 100Hz */
 #define PERIOD_SENSOR_MS          20U    /* 50Hz */
-#define CONNECTION_POLL_MS        50U
+#define PERIOD_ACTUATOR_MS        20U    /* 50Hz */
+#define PERIOD_TRAJ_MS            50U    /* 20Hz */
+#define PERIOD_MOTOR_DIAG_MS      20U    /* 50Hz */
+#define PERIOD_IR_STATS_MS        1000U  /* 1Hz */
+#define PERIOD_SAFETY_MS          100U   /* 10Hz */
+#define PERIOD_HOMING_MS          200U   /* 5Hz */
+#define PERIOD_SYSTEM_MS          1000U  /* 1Hz */
+#define PERIOD_POWER_MS           1000U  /* 1Hz */
+#define CONNECTION_POLL_MS        50U    /* 停靠模式下为 POWER_DOCKED_REPORT_MS */
 
 /* 控制命令payload最小长度（不含保留字节） */
 #define CONTROL_CMD_MIN_PAYLOAD   14U
 
+/* 控制命令标志字节（原保留字节 payload[14]，旧上位机填0保持兼容） */
+#define CONTROL_FLAG_VELOCITY_MODE  (1U << 0)  /* payload[0..7] 为 v(m/s)、ω(rad/s) */
+
+/* 轨迹追加：type(u8) + first_index(u16) + count(u8) + count × {dt_ms(u16), a(f32), b(f32)} */
+#define TRAJ_APPEND_HEADER_SIZE   4U
+#define TRAJ_POINT_WIRE_SIZE      10U
+#define TRAJ_APPEND_MAX_POINTS    ((USB_MAX_PAYLOAD_SIZE - TRAJ_APPEND_HEADER_SIZE) / TRAJ_POINT_WIRE_SIZE)
+
+/* 轨迹控制操作码 */
+#define TRAJ_OP_ABORT             0x00U  /* 中止并清空 */
+#define TRAJ_OP_START             0x01U  /* 开始执行 */
+#define TRAJ_OP_END_OF_STREAM     0x02U  /* 已发送最后一段 */
+
+/* ACK info：失败原因 */
+#define ACK_INFO_BAD_LENGTH       0x01U
+#define ACK_INFO_TRAJ_GAP         0x02U
+#define ACK_INFO_TRAJ_TYPE        0x03U
+#define ACK_INFO_TRAJ_NOT_READY   0x04U
+#define ACK_INFO_BLACKBOX_NO_IMAGE  0x05U
+#define ACK_INFO_BLACKBOX_NO_SLOT   0x06U
+#define ACK_INFO_BLACKBOX_FLASH     0x07U
+#define ACK_INFO_TRAJ_ABORTING    0x08U  /* busy：中止尚未被控制任务处理，稍后重发 */
+
+/* 系统状态：头部 + 每任务条目，任务多时分多帧发送 */
+#define SYSTEM_STATUS_HEADER_SIZE 14U
+#define SYSTEM_STATUS_ENTRY_SIZE  (7U + configMAX_TASK_NAME_LEN)
+#define SYSTEM_STATUS_PER_FRAME   ((USB_MAX_PAYLOAD_SIZE - SYSTEM_STATUS_HEADER_SIZE) / SYSTEM_STATUS_ENTRY_SIZE)
+
+/* 事件跟踪控制操作码 */
+#define TRACE_OP_STOP             0x00U  /* 停止记录并停止推送 */
+#define TRACE_OP_START            0x01U  /* 清空并开始记录 */
+#define TRACE_OP_DUMP             0x02U  /* 停止记录，导出缓冲全部内容 */
+#define TRACE_OP_STREAM           0x03U  /* 清空并开始记录，同时连续推送 */
+
+/* 跟踪数据帧：flags(u8), count(u8), cpuMHz(u8), reserved(u8), index(u32) + count × 8字节事件 */
+#define TRACE_DATA_HEADER_SIZE    8U
+#define TRACE_DATA_MAX_EVENTS     ((USB_MAX_PAYLOAD_SIZE - TRACE_DATA_HEADER_SIZE) / sizeof(TraceEvent_t))
+#define TRACE_DATA_FLAG_DUMP      (1U << 0)
+#define TRACE_DATA_FLAG_LAST      (1U << 1)  /* 导出结束 */
+#define TRACE_DATA_FLAG_LOST      (1U << 2)  /* 本帧之前有事件被覆盖 */
+#define TRACE_FRAMES_PER_LOOP     2U
+#define TRACE_TX_RESERVE          128U       /* 发送缓冲保留给常规遥测的空间 */
+
+/* 剖析控制 (0x14) 操作码 */
+#define PROF_OP_FETCH             0x00U  /* 上传全部探针统计 */
+#define PROF_OP_RESET             0x01U  /* 清零全部探针 */
+#define PROF_OP_FETCH_RESET       0x02U  /* 上传并清零（每个探针读取与清零原子完成） */
+
+/* 剖析数据 (0x2C)：每帧一个探针 */
+#define PROF_DATA_HEADER_SIZE     28U
+#define PROF_DATA_SIZE            (PROF_DATA_HEADER_SIZE + PROF_HIST_BUCKETS * 4U)
+typedef char ProfDataSizeCheck_t[(PROF_DATA_SIZE <= USB_MAX_PAYLOAD_SIZE) ? 1 : -1];
+
+/* 故障快照控制 (0x15) 操作码 */
+#define FAULT_OP_FETCH            0x00U  /* 重新上报 0x2E */
+#define FAULT_OP_CLEAR            0x01U  /* 清除备份SRAM中的快照 */
+
+/* 故障报告 (0x2E)：复位原因 + 上次快照，上电/连接时上报一次 */
+#define FAULT_REPORT_SIZE         (70U + SUPERVISOR_NAME_LEN)
+
+/* 黑匣子控制 (0x16) 操作码 */
+#define BLACKBOX_OP_INFO          0x00U  /* 上报 0x2F 信息帧 */
+#define BLACKBOX_OP_DOWNLOAD      0x01U  /* payload[1]=映像（0 RAM 环，1..N Flash 槽），下载 RAM 环期间暂停记录 */
+#define BLACKBOX_OP_SAVE          0x02U  /* 把 RAM 环写入 Flash 空槽（仅整机空闲时） */
+#define BLACKBOX_OP_CLEAR         0x03U  /* 清除 Flash 中的全部转储 */
+
+/* 黑匣子数据 (0x2F)：kind(u8) 区分信息帧与映像数据帧 */
+#define BLACKBOX_KIND_INFO        0x00U
+#define BLACKBOX_KIND_DATA        0x01U
+#define BLACKBOX_INFO_HEADER_SIZE 14U
+#define BLACKBOX_INFO_SIZE        (BLACKBOX_INFO_HEADER_SIZE + BLACKBOX_FLASH_SLOTS)
+#define BLACKBOX_DATA_HEADER_SIZE 12U
+#define BLACKBOX_DATA_CHUNK       (USB_MAX_PAYLOAD_SIZE - BLACKBOX_DATA_HEADER_SIZE)
+#define BLACKBOX_DATA_FLAG_LAST   (1U << 0)  /* 映像最后一帧 */
+#define BLACKBOX_IMAGE_NONE       0xFFU
+typedef char BlackBoxInfoSizeCheck_t[(BLACKBOX_INFO_SIZE <= USB_MAX_PAYLOAD_SIZE) ? 1 : -1];
+
+typedef enum {
+    TRACE_TX_IDLE = 0,
+    TRACE_TX_STREAM,
+    TRACE_TX_DUMP
+} TraceTxMode_t;
+
 /* ========================== 静态状态 ========================== */
-static UsbRxParser_t          s_rxParser;
+static UsbFrameParser_t       s_rxParser;
 static ControlCommandState_t  s_ctrlState;
 static UsbSeqState_t          s_seqState;
 static uint8_t                s_heartbeatCounter = 0;
@@ -128,10 +223,25 @@ static bool                   s_lastUsbConnected = false;
 static uint32_t               s_lastWheelTick = 0;
 static uint32_t               s_lastImuTick = 0;
 static uint32_t               s_lastSensorTick = 0;
+static uint32_t               s_lastActuatorTick = 0;
+static uint32_t               s_lastTrajTick = 0;
+static uint32_t               s_lastMotorDiagTick = 0;
+static uint32_t               s_lastIrStatsTick = 0;
+static uint32_t               s_lastSafetyTick = 0;
+static uint32_t               s_lastHomingTick = 0;
+static uint32_t               s_lastSystemTick = 0;
+static uint32_t               s_lastPowerTick = 0;
 static uint32_t               s_lastConnPollTick = 0;
+static TraceTxMode_t          s_traceMode = TRACE_TX_IDLE;
+static uint32_t               s_traceIndex = 0;
+static uint8_t                s_profTxIndex = PROF_COUNT;   /* 待上传探针，PROF_COUNT=无 */
+static bool                   s_profTxReset = false;
+static bool                   s_faultReportPending = false;
+static bool                   s_blackBoxInfoPending = false;
+static uint8_t                s_blackBoxTxImage = BLACKBOX_IMAGE_NONE;   /* 下载中的映像 */
+static uint32_t               s_blackBoxTxOffset = 0;
 
 /* ========================== 工具函数声明 ========================== */
-static uint16_t crc16_ccitt(const uint8_t *data, uint16_t len);
 static void USBCommTask_ResetParser(void);
 static void USBCommTask_ProcessByte(uint8_t byte);
 static void USBCommTask_DispatchFrame(uint8_t msgId, uint8_t seq,
@@ -139,11 +249,29 @@ static void USBCommTask_DispatchFrame(uint8_t msgId, uint8_t seq,
 static void USBCommTask_HandleControlCmd(uint8_t seq,
                                          const uint8_t *payload,
                                          uint16_t len);
+static void USBCommTask_HandleTrajAppend(const uint8_t *payload, uint16_t len);
+static void USBCommTask_HandleTrajControl(const uint8_t *payload, uint16_t len);
+static void USBCommTask_HandleTraceControl(const uint8_t *payload, uint16_t len);
+static void USBCommTask_SendTraceData(void);
+static void USBCommTask_HandleProfControl(const uint8_t *payload, uint16_t len);
+static void USBCommTask_SendProfData(void);
+static void USBCommTask_HandleFaultControl(const uint8_t *payload, uint16_t len);
+static void USBCommTask_SendFaultReport(void);
+static void USBCommTask_HandleBlackBoxControl(const uint8_t *payload, uint16_t len);
+static void USBCommTask_SendBlackBoxInfo(void);
+static void USBCommTask_SendBlackBoxData(void);
 static void USBCommTask_ApplyControl(const ControlCommandState_t *ctrl);
-static void USBCommTask_SendAck(AckStatus_t status, uint8_t info);
+static void USBCommTask_SendAck(uint8_t cmdId, AckStatus_t status, uint8_t info);
 static void USBCommTask_SendWheelTelemetry(void);
 static void USBCommTask_SendImuTelemetry(void);
 static void USBCommTask_SendSensorTelemetry(void);
+static void USBCommTask_SendActuatorTelemetry(void);
+static void USBCommTask_SendTrajTelemetry(void);
+static void USBCommTask_SendMotorDiagTelemetry(void);
+static void USBCommTask_SendIrStatsTelemetry(void);
+static void USBCommTask_SendSystemTelemetry(void);
+static void USBCommTask_SendPowerTelemetry(void);
+static bool USBCommTask_PeriodDue(uint32_t *lastTick, uint32_t periodMs, uint32_t now, uint32_t *wait);
 static void USBCommTask_ProcessRxStream(void);
 static void USBCommTask_HandleConnection(void);
 static void USBCommTask_SafeStop(void);
@@ -158,28 +286,10 @@ static FanMotorLevel_t USBCommTask_ToFanLevel(uint8_t level);
 static WorkMode_t USBCommTask_ToWorkMode(uint8_t mode);
 static uint8_t USBCommTask_GetDockStatus(void);
 
-/* ========================== CRC实现 ========================== */
-static uint16_t crc16_ccitt(const uint8_t *data, uint16_t len)
-{
-    uint16_t crc = 0xFFFF;
-    for (uint16_t i = 0; i < len; ++i) {
-        crc ^= (uint16_t)data[i] << 8;
-        for (uint8_t j = 0; j < 8; ++j) {
-            if (crc & 0x8000) {
-                crc = (crc << 1) ^ 0x1021;
-            } else {
-                crc <<= 1;
-            }
-        }
-    }
-    return crc;
-}
-
 /* ========================== 基础工具 ========================== */
 static void USBCommTask_ResetParser(void)
 {
-    memset(&s_rxParser, 0, sizeof(s_rxParser));
-    s_rxParser.state = RX_WAIT_HEADER0;
+    UsbFrame_ParserInit(&s_rxParser);
 }
 
 static uint8_t USBCommTask_NextSeq(uint8_t msgId)
@@ -208,27 +318,13 @@ static void USBCommTask_SendFrame(uint8_t msgId,
         return;
     }
 
+    PROF_BEGIN(PROF_USB_SEND_FRAME);
     uint8_t frame[USB_MAX_FRAME_SIZE];
-    uint16_t idx = 0;
-
-    frame[idx++] = USB_FRAME_HEADER0;
-    frame[idx++] = USB_FRAME_HEADER1;
-    frame[idx++] = USB_PROTOCOL_VERSION;
-    frame[idx++] = (uint8_t)(payloadLen & 0xFF);
-    frame[idx++] = (uint8_t)((payloadLen >> 8) & 0xFF);
-    frame[idx++] = msgId;
-    frame[idx++] = USBCommTask_NextSeq(msgId);
-
-    if (payloadLen > 0 && payload != NULL) {
-        memcpy(&frame[idx], payload, payloadLen);
-        idx += payloadLen;
-    }
-
-    uint16_t crc = crc16_ccitt(&frame[2], (uint16_t)(5U + payloadLen));
-    frame[idx++] = (uint8_t)(crc & 0xFF);
-    frame[idx++] = (uint8_t)((crc >> 8) & 0xFF);
+    uint16_t idx = UsbFrame_Encode(frame, sizeof(frame), msgId, USBCommTask_NextSeq(msgId),
+                                   payload, payloadLen);
 
     USB_Comm_Send(&g_pCleanBotApp->usbComm, frame, idx);
+    PROF_END(PROF_USB_SEND_FRAME);
 }
 
 static void USBCommTask_UpdateLed(bool connected)
@@ -246,84 +342,11 @@ static void USBCommTask_UpdateLed(bool connected)
 /* ========================== 解析器 ========================== */
 static void USBCommTask_ProcessByte(uint8_t byte)
 {
-    switch (s_rxParser.state) {
-        case RX_WAIT_HEADER0:
-            if (byte == USB_FRAME_HEADER0) {
-                s_rxParser.state = RX_WAIT_HEADER1;
-            }
-            break;
-        case RX_WAIT_HEADER1:
-            if (byte == USB_FRAME_HEADER1) {
-                s_rxParser.state = RX_READ_VERSION;
-            } else {
-                s_rxParser.state = RX_WAIT_HEADER0;
-            }
-            break;
-        case RX_READ_VERSION:
-            s_rxParser.version = byte;
-            s_rxParser.state = RX_READ_LEN_L;
-            break;
-        case RX_READ_LEN_L:
-            s_rxParser.payloadLen = byte;
-            s_rxParser.state = RX_READ_LEN_H;
-            break;
-        case RX_READ_LEN_H:
-            s_rxParser.payloadLen |= ((uint16_t)byte << 8);
-            if (s_rxParser.payloadLen > USB_MAX_PAYLOAD_SIZE) {
-                USBCommTask_ResetParser();
-            } else {
-                s_rxParser.state = RX_READ_MSG_ID;
-            }
-            break;
-        case RX_READ_MSG_ID:
-            s_rxParser.msgId = byte;
-            s_rxParser.state = RX_READ_SEQ;
-            break;
-        case RX_READ_SEQ:
-            s_rxParser.seq = byte;
-            s_rxParser.payloadIndex = 0;
-            if (s_rxParser.payloadLen == 0) {
-                s_rxParser.state = RX_READ_CRC_L;
-            } else {
-                s_rxParser.state = RX_READ_PAYLOAD;
-            }
-            break;
-        case RX_READ_PAYLOAD:
-            s_rxParser.payload[s_rxParser.payloadIndex++] = byte;
-            if (s_rxParser.payloadIndex >= s_rxParser.payloadLen) {
-                s_rxParser.state = RX_READ_CRC_L;
-            }
-            break;
-        case RX_READ_CRC_L:
-            s_rxParser.rxCrc = byte;
-            s_rxParser.state = RX_READ_CRC_H;
-            break;
-        case RX_READ_CRC_H: {
-            s_rxParser.rxCrc |= ((uint16_t)byte << 8);
-            uint8_t crcBuf[USB_MAX_PAYLOAD_SIZE + 5U];
-            uint16_t idx = 0;
-            crcBuf[idx++] = s_rxParser.version;
-            crcBuf[idx++] = (uint8_t)(s_rxParser.payloadLen & 0xFF);
-            crcBuf[idx++] = (uint8_t)((s_rxParser.payloadLen >> 8) & 0xFF);
-            crcBuf[idx++] = s_rxParser.msgId;
-            crcBuf[idx++] = s_rxParser.seq;
-            if (s_rxParser.payloadLen > 0) {
-                memcpy(&crcBuf[idx], s_rxParser.payload, s_rxParser.payloadLen);
-                idx += s_rxParser.payloadLen;
-            }
-            uint16_t calc = crc16_ccitt(crcBuf, idx);
-            if (calc == s_rxParser.rxCrc && s_rxParser.version == USB_PROTOCOL_VERSION) {
-                USBCommTask_DispatchFrame(s_rxParser.msgId,
-                                          s_rxParser.seq,
-                                          s_rxParser.payload,
-                                          s_rxParser.payloadLen);
-            }
-            USBCommTask_ResetParser();
-            break;
-        }
-        default:
-            USBCommTask_ResetParser();
-            break;
+    if (UsbFrame_Parse(&s_rxParser, byte)) {
+        USBCommTask_DispatchFrame(s_rxParser.msgId,
+                                  s_rxParser.seq,
+                                  s_rxParser.payload,
+                                  s_rxParser.payloadLen);
     }
 }
 
@@ -331,13 +354,33 @@ static void USBCommTask_DispatchFrame(uint8_t msgId, uint8_t seq,
                                       const uint8_t *payload, uint16_t len)
 {
     (void)seq;
+    TRACE_MARK_BEGIN(TRACE_MARK_USB_FRAME, msgId);
     switch (msgId) {
         case USB_MSG_CONTROL_CMD:
             USBCommTask_HandleControlCmd(seq, payload, len);
             break;
+        case USB_MSG_TRAJ_APPEND:
+            USBCommTask_HandleTrajAppend(payload, len);
+            break;
+        case USB_MSG_TRAJ_CONTROL:
+            USBCommTask_HandleTrajControl(payload, len);
+            break;
+        case USB_MSG_TRACE_CONTROL:
+            USBCommTask_HandleTraceControl(payload, len);
+            break;
+        case USB_MSG_PROF_CONTROL:
+            USBCommTask_HandleProfControl(payload, len);
+            break;
+        case USB_MSG_FAULT_CONTROL:
+            USBCommTask_HandleFaultControl(payload, len);
+            break;
+        case USB_MSG_BLACKBOX_CONTROL:
+            USBCommTask_HandleBlackBoxControl(payload, len);
+            break;
         default:
             break;
     }
+    TRACE_MARK_END(TRACE_MARK_USB_FRAME);
 }
 
 /* ========================== 控制命令处理 ========================== */
@@ -349,14 +392,20 @@ static void USBCommTask_HandleControlCmd(uint8_t seq,
 
     if (payload == NULL || len < CONTROL_CMD_MIN_PAYLOAD) {
         if (needAck) {
-            USBCommTask_SendAck(ACK_STATUS_FAIL, 0x01);
+            USBCommTask_SendAck(USB_MSG_CONTROL_CMD, ACK_STATUS_FAIL, ACK_INFO_BAD_LENGTH);
         }
         return;
     }
 
     ControlCommandState_t nextCtrl = s_ctrlState;
-    memcpy(&nextCtrl.leftSpeedMs,  &payload[0], 4);
-    memcpy(&nextCtrl.rightSpeedMs, &payload[4], 4);
+    nextCtrl.ctrlFlags = (len > CONTROL_CMD_MIN_PAYLOAD) ? payload[14] : 0U;
+    if ((nextCtrl.ctrlFlags & CONTROL_FLAG_VELOCITY_MODE) != 0U) {
+        memcpy(&nextCtrl.linearMs,    &payload[0], 4);
+        memcpy(&nextCtrl.angularRadS, &payload[4], 4);
+    } else {
+        memcpy(&nextCtrl.leftSpeedMs,  &payload[0], 4);
+        memcpy(&nextCtrl.rightSpeedMs, &payload[4], 4);
+    }
     nextCtrl.workMode       = USBCommTask_ToWorkMode(payload[8]);
     nextCtrl.brushLeftLevel = payload[9];
     nextCtrl.brushRightLevel= payload[10];
@@ -366,10 +415,402 @@ static void USBCommTask_HandleControlCmd(uint8_t seq,
     nextCtrl.cmdSeq         = seq;
 
     s_ctrlState = nextCtrl;
+    /* 有运动、清扫或回充动作的命令退出停靠低功耗模式 */
+    bool moving = ((nextCtrl.ctrlFlags & CONTROL_FLAG_VELOCITY_MODE) != 0U) ?
+                  (nextCtrl.linearMs != 0.0f || nextCtrl.angularRadS != 0.0f) :
+                  (nextCtrl.leftSpeedMs != 0.0f || nextCtrl.rightSpeedMs != 0.0f);
+    if (moving || nextCtrl.workMode != WORK_MODE_IDLE || nextCtrl.brushLeftLevel != 0U ||
+        nextCtrl.brushRightLevel != 0U || nextCtrl.fanLevel != 0U || nextCtrl.waterLevel != 0U) {
+        PowerMgr_RequestActive(osKernelGetTickCount());
+    }
     USBCommTask_ApplyControl(&s_ctrlState);
 
     if (needAck) {
-        USBCommTask_SendAck(ACK_STATUS_OK, 0x00);
+        USBCommTask_SendAck(USB_MSG_CONTROL_CMD, ACK_STATUS_OK, 0x00);
+    }
+}
+
+/* ========================== 轨迹命令处理 ========================== */
+static void USBCommTask_HandleTrajAppend(const uint8_t *payload, uint16_t len)
+{
+    if (g_pCleanBotApp == NULL) return;
+    Trajectory_t *traj = &g_pCleanBotApp->trajectory;
+
+    if (payload == NULL || len < TRAJ_APPEND_HEADER_SIZE) {
+        USBCommTask_SendAck(USB_MSG_TRAJ_APPEND, ACK_STATUS_FAIL, ACK_INFO_BAD_LENGTH);
+        return;
+    }
+
+    TrajectoryType_t type = (payload[0] != 0U) ? TRAJ_TYPE_VW : TRAJ_TYPE_WHEEL;
+    uint16_t firstIndex = (uint16_t)payload[1] | ((uint16_t)payload[2] << 8);
+    uint8_t count = payload[3];
+    if (count == 0U || count > TRAJ_APPEND_MAX_POINTS ||
+        len != (uint16_t)(TRAJ_APPEND_HEADER_SIZE + count * TRAJ_POINT_WIRE_SIZE)) {
+        USBCommTask_SendAck(USB_MSG_TRAJ_APPEND, ACK_STATUS_FAIL, ACK_INFO_BAD_LENGTH);
+        return;
+    }
+
+    TrajectoryPoint_t points[TRAJ_APPEND_MAX_POINTS];
+    const uint8_t *p = &payload[TRAJ_APPEND_HEADER_SIZE];
+    for (uint8_t i = 0; i < count; i++) {
+        points[i].dtMs = (uint16_t)p[0] | ((uint16_t)p[1] << 8);
+        memcpy(&points[i].a, &p[2], 4);
+        memcpy(&points[i].b, &p[6], 4);
+        p += TRAJ_POINT_WIRE_SIZE;
+    }
+
+    TrajectoryAppendResult_t result = Trajectory_Append(traj, type, firstIndex, points, count);
+    uint16_t freeSlots = Trajectory_GetFree(traj);
+    uint8_t info = (freeSlots > 0xFFU) ? 0xFFU : (uint8_t)freeSlots;
+    switch (result) {
+        case TRAJ_APPEND_OK:
+            USBCommTask_SendAck(USB_MSG_TRAJ_APPEND, ACK_STATUS_OK, info);
+            break;
+        case TRAJ_APPEND_FULL:
+            USBCommTask_SendAck(USB_MSG_TRAJ_APPEND, ACK_STATUS_BUSY, info);
+            break;
+        case TRAJ_APPEND_ABORTING:
+            USBCommTask_SendAck(USB_MSG_TRAJ_APPEND, ACK_STATUS_BUSY, ACK_INFO_TRAJ_ABORTING);
+            break;
+        case TRAJ_APPEND_TYPE_MISMATCH:
+            USBCommTask_SendAck(USB_MSG_TRAJ_APPEND, ACK_STATUS_FAIL, ACK_INFO_TRAJ_TYPE);
+            break;
+        case TRAJ_APPEND_GAP:
+        default:
+            USBCommTask_SendAck(USB_MSG_TRAJ_APPEND, ACK_STATUS_FAIL, ACK_INFO_TRAJ_GAP);
+            break;
+    }
+}
+
+static void USBCommTask_HandleTrajControl(const uint8_t *payload, uint16_t len)
+{
+    if (g_pCleanBotApp == NULL) return;
+    Trajectory_t *traj = &g_pCleanBotApp->trajectory;
+
+    if (payload == NULL || len < 1U) {
+        USBCommTask_SendAck(USB_MSG_TRAJ_CONTROL, ACK_STATUS_FAIL, ACK_INFO_BAD_LENGTH);
+        return;
+    }
+
+    switch (payload[0]) {
+        case TRAJ_OP_START:
+            if (s_ctrlState.workMode == WORK_MODE_DOCK || !Trajectory_RequestStart(traj)) {
+                USBCommTask_SendAck(USB_MSG_TRAJ_CONTROL, ACK_STATUS_FAIL, ACK_INFO_TRAJ_NOT_READY);
+                return;
+            }
+            PowerMgr_RequestActive(osKernelGetTickCount());
+            s_usbSafeStopped = false;
+            break;
+        case TRAJ_OP_END_OF_STREAM:
+            Trajectory_MarkEndOfStream(traj);
+            break;
+        case TRAJ_OP_ABORT:
+        default:
+            Trajectory_RequestAbort(traj);
+            break;
+    }
+    USBCommTask_SendAck(USB_MSG_TRAJ_CONTROL, ACK_STATUS_OK, payload[0]);
+}
+
+/* ========================== 事件跟踪 ========================== */
+static void USBCommTask_HandleTraceControl(const uint8_t *payload, uint16_t len)
+{
+    if (payload == NULL || len < 1U) {
+        USBCommTask_SendAck(USB_MSG_TRACE_CONTROL, ACK_STATUS_FAIL, ACK_INFO_BAD_LENGTH);
+        return;
+    }
+
+    switch (payload[0]) {
+        case TRACE_OP_START:
+            Trace_Start();
+            s_traceMode = TRACE_TX_IDLE;
+            break;
+        case TRACE_OP_DUMP:
+            Trace_Stop();
+            s_traceIndex = Trace_GetOldest();
+            s_traceMode = TRACE_TX_DUMP;
+            break;
+        case TRACE_OP_STREAM:
+            Trace_Start();
+            s_traceIndex = 0;
+            s_traceMode = TRACE_TX_STREAM;
+            break;
+        case TRACE_OP_STOP:
+        default:
+            Trace_Stop();
+            s_traceMode = TRACE_TX_IDLE;
+            break;
+    }
+    USBCommTask_SendAck(USB_MSG_TRACE_CONTROL, ACK_STATUS_OK, payload[0]);
+}
+
+/* 跟踪数据：导出时连续发送直到缓冲读完（末帧带LAST标志），推送时发送新增事件；
+   每轮最多 TRACE_FRAMES_PER_LOOP 帧，且为常规遥测保留发送缓冲空间 */
+static void USBCommTask_SendTraceData(void)
+{
+    if (g_pCleanBotApp == NULL || s_traceMode == TRACE_TX_IDLE) return;
+
+    for (uint8_t f = 0; f < TRACE_FRAMES_PER_LOOP; f++) {
+        if (USB_Comm_GetTxFree(&g_pCleanBotApp->usbComm) < USB_MAX_FRAME_SIZE + TRACE_TX_RESERVE) {
+            return;
+        }
+
+        TraceEvent_t events[TRACE_DATA_MAX_EVENTS];
+        uint32_t index = s_traceIndex;
+        uint32_t count = Trace_Read(&index, events, TRACE_DATA_MAX_EVENTS);
+        uint32_t first = index - count;
+        bool lost = (first != s_traceIndex);
+        bool last = (s_traceMode == TRACE_TX_DUMP) && (index == Trace_GetHead());
+
+        if (count == 0U && !last) {
+            return;
+        }
+
+        uint8_t payload[TRACE_DATA_HEADER_SIZE + sizeof(events)];
+        payload[0] = (uint8_t)(((s_traceMode == TRACE_TX_DUMP) ? TRACE_DATA_FLAG_DUMP : 0U) |
+                               (last ? TRACE_DATA_FLAG_LAST : 0U) | (lost ? TRACE_DATA_FLAG_LOST : 0U));
+        payload[1] = (uint8_t)count;
+        payload[2] = (uint8_t)(SystemCoreClock / 1000000U);
+        payload[3] = 0;
+        memcpy(&payload[4], &first, 4);
+        memcpy(&payload[TRACE_DATA_HEADER_SIZE], events, count * sizeof(TraceEvent_t));
+        USBCommTask_SendFrame(USB_MSG_TRACE_DATA, payload, (uint16_t)(TRACE_DATA_HEADER_SIZE + count * sizeof(TraceEvent_t)));
+
+        s_traceIndex = index;
+        if (last) {
+            s_traceMode = TRACE_TX_IDLE;
+            return;
+        }
+    }
+}
+
+/* ========================== 热点剖析 ========================== */
+static void USBCommTask_HandleProfControl(const uint8_t *payload, uint16_t len)
+{
+    if (payload == NULL || len < 1U) {
+        USBCommTask_SendAck(USB_MSG_PROF_CONTROL, ACK_STATUS_FAIL, ACK_INFO_BAD_LENGTH);
+        return;
+    }
+
+    switch (payload[0]) {
+        case PROF_OP_RESET:
+            Prof_Reset();
+            s_profTxIndex = PROF_COUNT;
+            break;
+        case PROF_OP_FETCH_RESET:
+            s_profTxIndex = 0;
+            s_profTxReset = true;
+            break;
+        case PROF_OP_FETCH:
+        default:
+            s_profTxIndex = 0;
+            s_profTxReset = false;
+            break;
+    }
+    USBCommTask_SendAck(USB_MSG_PROF_CONTROL, ACK_STATUS_OK, payload[0]);
+}
+
+/* 剖析数据：每个探针一帧，发送缓冲不足时留到下一轮，与跟踪共用保留空间 */
+static void USBCommTask_SendProfData(void)
+{
+    if (g_pCleanBotApp == NULL) return;
+
+    while (s_profTxIndex < PROF_COUNT) {
+        if (USB_Comm_GetTxFree(&g_pCleanBotApp->usbComm) < USB_MAX_FRAME_SIZE + TRACE_TX_RESERVE) {
+            return;
+        }
+
+        ProfStats_t stats;
+        Prof_Get((ProfId_t)s_profTxIndex, &stats, s_profTxReset);
+
+        uint8_t payload[PROF_DATA_SIZE];
+        uint16_t overhead = Prof_GetOverhead();
+        payload[0] = s_profTxIndex;
+        payload[1] = (uint8_t)PROF_COUNT;
+        payload[2] = (uint8_t)PROF_HIST_BUCKETS;
+        payload[3] = (uint8_t)PROF_HIST_MIN_LOG2;
+        memcpy(&payload[4], &stats.count, 4);
+        memcpy(&payload[8], &stats.minCycles, 4);
+        memcpy(&payload[12], &stats.maxCycles, 4);
+        memcpy(&payload[16], &stats.sumCycles, 8);
+        memcpy(&payload[24], &overhead, 2);
+        payload[26] = (uint8_t)(SystemCoreClock / 1000000U);
+        payload[27] = s_profTxReset ? 1U : 0U;
+        memcpy(&payload[PROF_DATA_HEADER_SIZE], stats.hist, sizeof(stats.hist));
+        USBCommTask_SendFrame(USB_MSG_PROF_DATA, payload, sizeof(payload));
+
+        s_profTxIndex++;
+    }
+}
+
+/* ========================== 故障快照 ========================== */
+static void USBCommTask_HandleFaultControl(const uint8_t *payload, uint16_t len)
+{
+    if (payload == NULL || len < 1U) {
+        USBCommTask_SendAck(USB_MSG_FAULT_CONTROL, ACK_STATUS_FAIL, ACK_INFO_BAD_LENGTH);
+        return;
+    }
+
+    switch (payload[0]) {
+        case FAULT_OP_CLEAR:
+            Supervisor_ClearSnapshot();
+            break;
+        case FAULT_OP_FETCH:
+        default:
+            s_faultReportPending = true;
+            break;
+    }
+    USBCommTask_SendAck(USB_MSG_FAULT_CONTROL, ACK_STATUS_OK, payload[0]);
+}
+
+/* 故障报告：发送缓冲不足时留到下一轮 */
+static void USBCommTask_SendFaultReport(void)
+{
+    if (g_pCleanBotApp == NULL) return;
+    if (USB_Comm_GetTxFree(&g_pCleanBotApp->usbComm) < USB_MAX_FRAME_SIZE) return;
+
+    SupervisorSnapshot_t snap;
+    if (!Supervisor_GetSnapshot(&snap)) {
+        memset(&snap, 0, sizeof(snap));
+        snap.task = SUPERVISOR_TASK_NONE;
+    }
+
+    uint8_t payload[FAULT_REPORT_SIZE];
+    uint8_t idx = 0;
+    payload[idx++] = Supervisor_GetResetFlags();
+    payload[idx++] = snap.reason;
+    payload[idx++] = snap.task;
+    payload[idx++] = snap.missMask;
+    memcpy(&payload[idx], &snap.count, 2);      idx += 2;
+    memcpy(&payload[idx], &snap.uptimeMs, 4);   idx += 4;
+    memcpy(&payload[idx], &snap.pc, 4);         idx += 4;
+    memcpy(&payload[idx], &snap.lr, 4);         idx += 4;
+    memcpy(&payload[idx], &snap.psr, 4);        idx += 4;
+    memcpy(&payload[idx], &snap.cfsr, 4);       idx += 4;
+    memcpy(&payload[idx], &snap.hfsr, 4);       idx += 4;
+    memcpy(&payload[idx], &snap.faultAddr, 4);  idx += 4;
+    memcpy(&payload[idx], &snap.setpoints.leftSpeedMs, 4);  idx += 4;
+    memcpy(&payload[idx], &snap.setpoints.rightSpeedMs, 4); idx += 4;
+    memcpy(&payload[idx], &snap.setpoints.linearMs, 4);     idx += 4;
+    memcpy(&payload[idx], &snap.setpoints.angularRadS, 4);  idx += 4;
+    payload[idx++] = snap.setpoints.brushLeft;
+    payload[idx++] = snap.setpoints.brushRight;
+    payload[idx++] = snap.setpoints.pump;
+    payload[idx++] = snap.setpoints.fan;
+    memcpy(&payload[idx], snap.stackFreeWords, sizeof(snap.stackFreeWords)); idx += sizeof(snap.stackFreeWords);
+    memcpy(&payload[idx], snap.beatAgeMs, sizeof(snap.beatAgeMs));           idx += sizeof(snap.beatAgeMs);
+    memcpy(&payload[idx], snap.runningTask, SUPERVISOR_NAME_LEN);            idx += SUPERVISOR_NAME_LEN;
+
+    USBCommTask_SendFrame(USB_MSG_FAULT_REPORT, payload, idx);
+    s_faultReportPending = false;
+}
+
+/* ========================== 黑匣子 ========================== */
+static void USBCommTask_HandleBlackBoxControl(const uint8_t *payload, uint16_t len)
+{
+    if (payload == NULL || len < 1U) {
+        USBCommTask_SendAck(USB_MSG_BLACKBOX_CONTROL, ACK_STATUS_FAIL, ACK_INFO_BAD_LENGTH);
+        return;
+    }
+
+    switch (payload[0]) {
+        case BLACKBOX_OP_DOWNLOAD: {
+            uint8_t image = (len >= 2U) ? payload[1] : BLACKBOX_IMAGE_RAM;
+            if (BlackBox_GetImageSize(image) == 0U) {
+                USBCommTask_SendAck(USB_MSG_BLACKBOX_CONTROL, ACK_STATUS_FAIL, ACK_INFO_BLACKBOX_NO_IMAGE);
+                return;
+            }
+            /* 重新开始下载：RAM 环按新的暂停时刻导出 */
+            BlackBox_SetPaused(false);
+            BlackBox_SetPaused(image == BLACKBOX_IMAGE_RAM);
+            s_blackBoxTxImage = image;
+            s_blackBoxTxOffset = 0;
+            break;
+        }
+        case BLACKBOX_OP_SAVE: {
+            /* 逐字编程期间从 Flash 取指会停顿，运动中不执行 */
+            if (!MotorCtrlTask_IsIdle()) {
+                USBCommTask_SendAck(USB_MSG_BLACKBOX_CONTROL, ACK_STATUS_BUSY, payload[0]);
+                return;
+            }
+            BlackBoxSaveResult_t result = BlackBox_Save();
+            if (result != BLACKBOX_SAVE_OK) {
+                USBCommTask_SendAck(USB_MSG_BLACKBOX_CONTROL, ACK_STATUS_FAIL,
+                                    (result == BLACKBOX_SAVE_NO_SLOT) ? ACK_INFO_BLACKBOX_NO_SLOT : ACK_INFO_BLACKBOX_FLASH);
+                return;
+            }
+            break;
+        }
+        case BLACKBOX_OP_CLEAR:
+            BlackBox_ClearFlash();
+            break;
+        case BLACKBOX_OP_INFO:
+        default:
+            s_blackBoxInfoPending = true;
+            break;
+    }
+    USBCommTask_SendAck(USB_MSG_BLACKBOX_CONTROL, ACK_STATUS_OK, payload[0]);
+}
+
+/* 黑匣子信息：编码参数、记录数与各 Flash 槽状态 */
+static void USBCommTask_SendBlackBoxInfo(void)
+{
+    if (g_pCleanBotApp == NULL) return;
+    if (USB_Comm_GetTxFree(&g_pCleanBotApp->usbComm) < USB_MAX_FRAME_SIZE) return;
+
+    uint8_t payload[BLACKBOX_INFO_SIZE];
+    uint16_t blockSize = (uint16_t)BLACKBOX_BLOCK_SIZE;
+    uint16_t blockCount = (uint16_t)BLACKBOX_BLOCK_COUNT;
+    uint16_t periodMs = (uint16_t)BLACKBOX_PERIOD_MS;
+    uint32_t records = BlackBox_GetRecordCount();
+
+    payload[0] = BLACKBOX_KIND_INFO;
+    payload[1] = (uint8_t)BLACKBOX_FLASH_SLOTS;
+    payload[2] = (uint8_t)BLACKBOX_FIELD_COUNT;
+    payload[3] = (uint8_t)BLACKBOX_ENABLE;
+    memcpy(&payload[4], &blockSize, 2);
+    memcpy(&payload[6], &blockCount, 2);
+    memcpy(&payload[8], &periodMs, 2);
+    memcpy(&payload[10], &records, 4);
+    for (uint8_t slot = 0; slot < BLACKBOX_FLASH_SLOTS; slot++) {
+        payload[BLACKBOX_INFO_HEADER_SIZE + slot] = (uint8_t)BlackBox_GetSlotState(slot);
+    }
+    USBCommTask_SendFrame(USB_MSG_BLACKBOX_DATA, payload, sizeof(payload));
+    s_blackBoxInfoPending = false;
+}
+
+/* 映像数据：与跟踪导出相同的节奏，末帧带 LAST 标志，RAM 环下载完恢复记录 */
+static void USBCommTask_SendBlackBoxData(void)
+{
+    if (g_pCleanBotApp == NULL || s_blackBoxTxImage == BLACKBOX_IMAGE_NONE) return;
+
+    uint32_t total = BlackBox_GetImageSize(s_blackBoxTxImage);
+    for (uint8_t f = 0; f < TRACE_FRAMES_PER_LOOP; f++) {
+        if (USB_Comm_GetTxFree(&g_pCleanBotApp->usbComm) < USB_MAX_FRAME_SIZE + TRACE_TX_RESERVE) {
+            return;
+        }
+
+        uint8_t payload[USB_MAX_PAYLOAD_SIZE];
+        uint32_t count = BlackBox_ReadImage(s_blackBoxTxImage, s_blackBoxTxOffset,
+                                            &payload[BLACKBOX_DATA_HEADER_SIZE], BLACKBOX_DATA_CHUNK);
+        bool last = (s_blackBoxTxOffset + count >= total);
+
+        payload[0] = BLACKBOX_KIND_DATA;
+        payload[1] = s_blackBoxTxImage;
+        payload[2] = last ? BLACKBOX_DATA_FLAG_LAST : 0U;
+        payload[3] = 0;
+        memcpy(&payload[4], &s_blackBoxTxOffset, 4);
+        memcpy(&payload[8], &total, 4);
+        USBCommTask_SendFrame(USB_MSG_BLACKBOX_DATA, payload, (uint16_t)(BLACKBOX_DATA_HEADER_SIZE + count));
+
+        s_blackBoxTxOffset += count;
+        if (last) {
+            if (s_blackBoxTxImage == BLACKBOX_IMAGE_RAM) {
+                BlackBox_SetPaused(false);
+            }
+            s_blackBoxTxImage = BLACKBOX_IMAGE_NONE;
+            return;
+        }
     }
 }
 
@@ -426,9 +867,17 @@ static void USBCommTask_ApplyControl(const ControlCommandState_t *ctrl)
         USBCommTask_ToBrushLevel(ctrl->brushLeftLevel),
         USBCommTask_ToBrushLevel(ctrl->brushRightLevel));
 
+    /* 回充对接：碰撞是正常接触，左右前下视引脚上有基站红外信号，不做反射 */
+    SafetyReflex_SetSuppressMask((ctrl->workMode == WORK_MODE_DOCK) ?
+                                 (uint8_t)(SAFETY_SRC_BIT(SAFETY_SRC_BUMPER_LEFT) |
+                                           SAFETY_SRC_BIT(SAFETY_SRC_BUMPER_RIGHT) |
+                                           SAFETY_SRC_BIT(SAFETY_SRC_CLIFF_LEFT) |
+                                           SAFETY_SRC_BIT(SAFETY_SRC_CLIFF_RIGHT)) : 0U);
+
     /* 轮速控制 */
     if (ctrl->workMode == WORK_MODE_DOCK) {
         if (g_pCleanBotApp != NULL) {
+            Trajectory_RequestAbort(&g_pCleanBotApp->trajectory);
             IRHoming_t *homing = &g_pCleanBotApp->irHoming;
             if (homing != NULL && !IRHoming_IsDocked(homing)) {
                 if (IRHoming_GetState(homing) == HOMING_STATE_IDLE) {
@@ -444,15 +893,21 @@ static void USBCommTask_ApplyControl(const ControlCommandState_t *ctrl)
                 IRHoming_Stop(homing);
             }
         }
-        MotorCtrlTask_SetWheelSpeed(ctrl->leftSpeedMs, ctrl->rightSpeedMs);
+        if (g_pCleanBotApp != NULL && Trajectory_IsActive(&g_pCleanBotApp->trajectory)) {
+            /* 轨迹执行中，轮速由轨迹接管 */
+        } else if ((ctrl->ctrlFlags & CONTROL_FLAG_VELOCITY_MODE) != 0U) {
+            MotorCtrlTask_SetVelocity(ctrl->linearMs, ctrl->angularRadS);
+        } else {
+            MotorCtrlTask_SetWheelSpeed(ctrl->leftSpeedMs, ctrl->rightSpeedMs);
+        }
     }
 
     s_usbSafeStopped = false;
 }
 
-static void USBCommTask_SendAck(AckStatus_t status, uint8_t info)
+static void USBCommTask_SendAck(uint8_t cmdId, AckStatus_t status, uint8_t info)
 {
-    uint8_t payload[3] = { USB_MSG_CONTROL_CMD, (uint8_t)status, info };
+    uint8_t payload[3] = { cmdId, (uint8_t)status, info };
     USBCommTask_SendFrame(USB_MSG_ACK_REPLY, payload, sizeof(payload));
 }
 
@@ -558,6 +1013,18 @@ static void USBCommTask_SendSensorTelemetry(void)
     if (USBCommTask_GetDockStatus() == 3U) {
         faultFlags |= FAULT_FLAG_DOCK_FAILED;
     }
+    const MotorDiag_t *diag = MotorCtrlTask_GetDiag();
+    uint8_t wheelFaults = MotorDiag_GetFaults(diag, MOTOR_DIAG_WHEEL_LEFT) |
+                          MotorDiag_GetFaults(diag, MOTOR_DIAG_WHEEL_RIGHT);
+    if ((wheelFaults & MOTOR_DIAG_FAULT_STALL) != 0U) {
+        faultFlags |= FAULT_FLAG_WHEEL_STALL;
+    }
+    if ((wheelFaults & MOTOR_DIAG_FAULT_SLIP) != 0U) {
+        faultFlags |= FAULT_FLAG_WHEEL_SLIP;
+    }
+    if ((wheelFaults & MOTOR_DIAG_FAULT_JAM) != 0U) {
+        faultFlags |= FAULT_FLAG_WHEEL_JAM;
+    }
 
     payload[5] = faultFlags;
     payload[6] = s_heartbeatCounter++;
@@ -567,6 +1034,236 @@ static void USBCommTask_SendSensorTelemetry(void)
     USBCommTask_SendFrame(USB_MSG_SENSOR_STATUS, payload, sizeof(payload));
 }
 
+/* 辅助电机斜坡：每通道 target(u16) + output(u16)，末尾为正在上升的大电流通道 */
+static void USBCommTask_SendActuatorTelemetry(void)
+{
+    const MotorRamp_t *ramp = MotorCtrlTask_GetRamp();
+    uint8_t payload[MOTOR_RAMP_CH_COUNT * 4U + 1U];
+    uint8_t idx = 0;
+
+    for (uint8_t i = 0; i < MOTOR_RAMP_CH_COUNT; i++) {
+        uint16_t target = (uint16_t)MotorRamp_GetTarget(ramp, (MotorRampChannelId_t)i);
+        uint16_t output = (uint16_t)MotorRamp_GetOutput(ramp, (MotorRampChannelId_t)i);
+        payload[idx++] = (uint8_t)(target & 0xFF);
+        payload[idx++] = (uint8_t)((target >> 8) & 0xFF);
+        payload[idx++] = (uint8_t)(output & 0xFF);
+        payload[idx++] = (uint8_t)((output >> 8) & 0xFF);
+    }
+    payload[idx++] = ramp->heavyActive;
+
+    USBCommTask_SendFrame(USB_MSG_ACTUATOR_STATUS, payload, idx);
+}
+
+/* 轨迹状态：state, type, count(u16), buffered_ms(u16), next_index(u16), executed(u32), underruns(u16) */
+static void USBCommTask_SendTrajTelemetry(void)
+{
+    if (g_pCleanBotApp == NULL) return;
+    const Trajectory_t *traj = &g_pCleanBotApp->trajectory;
+
+    uint8_t payload[14];
+    uint16_t count = Trajectory_GetCount(traj);
+    uint32_t bufferedMs = Trajectory_GetBufferedMs(traj);
+    if (bufferedMs > 0xFFFFU) bufferedMs = 0xFFFFU;
+    uint16_t nextIndex = traj->nextIndex;
+    uint32_t executed = traj->executedCount;
+    uint16_t underruns = traj->underrunCount;
+
+    payload[0] = (uint8_t)traj->state;
+    payload[1] = (uint8_t)traj->type;
+    memcpy(&payload[2], &count, 2);
+    payload[4] = (uint8_t)(bufferedMs & 0xFF);
+    payload[5] = (uint8_t)((bufferedMs >> 8) & 0xFF);
+    memcpy(&payload[6], &nextIndex, 2);
+    memcpy(&payload[8], &executed, 4);
+    memcpy(&payload[12], &underruns, 2);
+
+    USBCommTask_SendFrame(USB_MSG_TRAJ_STATUS, payload, sizeof(payload));
+}
+
+/* 轮电机诊断特征：每轮 duty(i16), target/meas/model(f32), faults(u8)；末尾 IMU/编码器偏航角速度(f32) */
+static void USBCommTask_SendMotorDiagTelemetry(void)
+{
+    const MotorDiag_t *diag = MotorCtrlTask_GetDiag();
+    uint8_t payload[MOTOR_DIAG_WHEEL_COUNT * 15U + 8U];
+    uint8_t idx = 0;
+
+    for (uint8_t i = 0; i < MOTOR_DIAG_WHEEL_COUNT; i++) {
+        const MotorDiagWheel_t *w = &diag->wheel[i];
+        int16_t duty = (int16_t)w->duty;
+        memcpy(&payload[idx], &duty, 2);       idx += 2;
+        memcpy(&payload[idx], &w->targetMs, 4); idx += 4;
+        memcpy(&payload[idx], &w->measMs, 4);   idx += 4;
+        memcpy(&payload[idx], &w->modelMs, 4);  idx += 4;
+        payload[idx++] = w->faults;
+    }
+    memcpy(&payload[idx], &diag->yawRateImu, 4);  idx += 4;
+    memcpy(&payload[idx], &diag->yawRateOdom, 4); idx += 4;
+
+    USBCommTask_SendFrame(USB_MSG_MOTOR_DIAG, payload, idx);
+}
+
+/* 红外解码统计：左/右/左前/右前 各 edges(u32), frames(u16), ok(u16), errors(u16), dropped(u16)；
+   传感器事件队列：highWater(u8), batchMax(u8), dropped(u16)；
+   信号质量：左/右/左前/右前 各 repeats(u16), timeouts(u16), jitterUs(u8), marginPct(u8) */
+static void USBCommTask_SendIrStatsTelemetry(void)
+{
+    if (g_pCleanBotApp == NULL) return;
+
+    const IR_Sensor_t *sensors[4] = {
+        &g_pCleanBotApp->irSensorLeft,
+        &g_pCleanBotApp->irSensorRight,
+        &g_pCleanBotApp->irSensorFrontLeft,
+        &g_pCleanBotApp->irSensorFrontRight
+    };
+    const SensorManager_t *manager = SensorManager_GetInstance();
+    uint8_t payload[4 * 12 + 4 + 4 * 6];
+    uint8_t idx = 0;
+
+    for (uint8_t i = 0; i < 4; i++) {
+        const IRDecodeStats_t *dec = &sensors[i]->decoder.ir.stats;
+        uint32_t dropped32 = manager->irCapture[i].overflowCount;
+        uint16_t dropped = (dropped32 > 0xFFFFU) ? 0xFFFFU : (uint16_t)dropped32;
+        memcpy(&payload[idx], &dec->edgeCount, 4);  idx += 4;
+        memcpy(&payload[idx], &dec->frameCount, 2); idx += 2;
+        memcpy(&payload[idx], &dec->okCount, 2);    idx += 2;
+        memcpy(&payload[idx], &dec->errorCount, 2); idx += 2;
+        memcpy(&payload[idx], &dropped, 2);         idx += 2;
+    }
+
+    uint16_t eventDrops = (manager->eventDropCount > 0xFFFFU) ? 0xFFFFU : (uint16_t)manager->eventDropCount;
+    payload[idx++] = manager->eventHighWater;
+    payload[idx++] = manager->eventBatchMax;
+    memcpy(&payload[idx], &eventDrops, 2);          idx += 2;
+
+    for (uint8_t i = 0; i < 4; i++) {
+        const IRDecodeStats_t *dec = &sensors[i]->decoder.ir.stats;
+        memcpy(&payload[idx], &dec->repeatCount, 2);  idx += 2;
+        memcpy(&payload[idx], &dec->timeoutCount, 2); idx += 2;
+        payload[idx++] = (dec->jitterUs > 0xFFU) ? 0xFFU : (uint8_t)dec->jitterUs;
+        payload[idx++] = dec->worstMarginPct;
+    }
+
+    USBCommTask_SendFrame(USB_MSG_IR_STATS, payload, idx);
+}
+
+/* 安全反射：state, activeMask, lastTriggerMask, triggerCount(u16), lastLatencyUs(u32), maxLatencyUs(u32) */
+static void USBCommTask_SendSafetyTelemetry(void)
+{
+    const SafetyReflex_t *sr = SafetyReflex_GetInstance();
+    uint8_t payload[13];
+    uint8_t idx = 0;
+
+    payload[idx++] = (uint8_t)sr->state;
+    payload[idx++] = sr->activeMask;
+    payload[idx++] = sr->lastTriggerMask;
+    memcpy(&payload[idx], &sr->triggerCount, 2);  idx += 2;
+    memcpy(&payload[idx], &sr->lastLatencyUs, 4); idx += 4;
+    memcpy(&payload[idx], &sr->maxLatencyUs, 4);  idx += 4;
+
+    USBCommTask_SendFrame(USB_MSG_SAFETY_STATUS, payload, idx);
+}
+
+/* 回冲信标估计：state, confidence(%), bearing(i16, 0.1°), sectorBalance(i8, %)；
+   左/右/左前/右前 各 strength(%), dominantCode(0-3扇区码, 4其他, 0xFF无)；
+   航向：searchRotations(u8), flags(bit0航向锁定 bit1转回记忆方向 bit2充电触点接通), headingErr(i16, 0.1°)；
+   对接：contactMv(u16), dockRetries(u8) */
+static void USBCommTask_SendHomingTelemetry(void)
+{
+    if (g_pCleanBotApp == NULL) return;
+
+    const IRHoming_t *homing = &g_pCleanBotApp->irHoming;
+    const BeaconModel_t *beacon = &homing->beacon;
+    uint8_t payload[5 + BEACON_RX_COUNT * 2 + 4 + 3];
+    uint8_t idx = 0;
+
+    int16_t bearing = (int16_t)(beacon->bearingRad * 1800.0f / 3.14159265f);
+    int8_t balance = (int8_t)(beacon->sectorBalance * 100.0f);
+
+    payload[idx++] = (uint8_t)homing->state;
+    payload[idx++] = (uint8_t)(beacon->confidence * 100.0f);
+    memcpy(&payload[idx], &bearing, 2);  idx += 2;
+    payload[idx++] = (uint8_t)balance;
+    for (uint8_t i = 0; i < BEACON_RX_COUNT; i++) {
+        payload[idx++] = (uint8_t)(beacon->rx[i].strength * 100.0f);
+        payload[idx++] = beacon->rx[i].dominantCode;
+    }
+
+    float headingErr = homing->headingLocked ? (homing->headingTargetDeg - homing->yawDeg) :
+                       homing->returning ? (homing->returnYawDeg - homing->yawDeg) : 0.0f;
+    int16_t headingErrDeci = (int16_t)(headingErr * 10.0f);
+    payload[idx++] = (homing->searchRotations > 0xFFU) ? 0xFFU : (uint8_t)homing->searchRotations;
+    payload[idx++] = (uint8_t)((homing->headingLocked ? 0x01U : 0U) | (homing->returning ? 0x02U : 0U) |
+                               (homing->chargeContact ? 0x04U : 0U));
+    memcpy(&payload[idx], &headingErrDeci, 2);  idx += 2;
+    memcpy(&payload[idx], &g_pCleanBotApp->chargeContact.mv, 2);  idx += 2;
+    payload[idx++] = homing->dockRetries;
+
+    USBCommTask_SendFrame(USB_MSG_HOMING_STATUS, payload, idx);
+}
+
+/* 系统状态：total(u8), first(u8), cpuLoad(u16, ‰), heapFree(u32), heapMinFree(u32), windowMs(u16)；
+   其后每任务 number(u8), priority(u8), state(u8), cpu(u16, ‰), stackFreeWords(u16), name[configMAX_TASK_NAME_LEN] */
+static void USBCommTask_SendSystemTelemetry(void)
+{
+    TaskStats_Sample();
+    const TaskStats_t *stats = TaskStats_Get();
+    uint32_t windowMs32 = stats->windowUs / 1000U;
+    uint16_t windowMs = (windowMs32 > 0xFFFFU) ? 0xFFFFU : (uint16_t)windowMs32;
+    uint8_t first = 0;
+
+    do {
+        uint8_t payload[USB_MAX_PAYLOAD_SIZE];
+        uint8_t idx = 0;
+
+        payload[idx++] = stats->count;
+        payload[idx++] = first;
+        memcpy(&payload[idx], &stats->cpuLoadPermille, 2); idx += 2;
+        memcpy(&payload[idx], &stats->heapFree, 4);        idx += 4;
+        memcpy(&payload[idx], &stats->heapMinFree, 4);     idx += 4;
+        memcpy(&payload[idx], &windowMs, 2);               idx += 2;
+
+        for (uint8_t n = 0; n < SYSTEM_STATUS_PER_FRAME && first < stats->count; n++, first++) {
+            const TaskStatsEntry_t *e = &stats->task[first];
+            payload[idx++] = e->number;
+            payload[idx++] = e->priority;
+            payload[idx++] = e->state;
+            memcpy(&payload[idx], &e->cpuPermille, 2);    idx += 2;
+            memcpy(&payload[idx], &e->stackFreeWords, 2); idx += 2;
+            memcpy(&payload[idx], e->name, configMAX_TASK_NAME_LEN);
+            idx += configMAX_TASK_NAME_LEN;
+        }
+
+        USBCommTask_SendFrame(USB_MSG_SYSTEM_STATUS, payload, idx);
+    } while (first < stats->count);
+}
+
+/* 电源状态：mode(u8), sleepPermille(u16), windowMs(u16), sleepCount(u16)，
+   唤醒源 tick/usb/ir/button/imu/other 各 count(u16)，latencyAvgUs(u16), latencyMaxUs(u16)，
+   dockedEntries(u16), dockedMs(u32) */
+static void USBCommTask_SendPowerTelemetry(void)
+{
+    PowerReport_t report;
+    PowerMgr_Sample(&report);
+    uint32_t windowMs32 = report.windowUs / 1000U;
+    uint16_t windowMs = (windowMs32 > 0xFFFFU) ? 0xFFFFU : (uint16_t)windowMs32;
+    uint8_t payload[7 + POWER_WAKE_COUNT * 2 + 10];
+    uint8_t idx = 0;
+
+    payload[idx++] = (uint8_t)report.mode;
+    memcpy(&payload[idx], &report.sleepPermille, 2); idx += 2;
+    memcpy(&payload[idx], &windowMs, 2);             idx += 2;
+    memcpy(&payload[idx], &report.sleepCount, 2);    idx += 2;
+    for (uint8_t i = 0; i < POWER_WAKE_COUNT; i++) {
+        memcpy(&payload[idx], &report.wakeCount[i], 2); idx += 2;
+    }
+    memcpy(&payload[idx], &report.latencyAvgUs, 2);  idx += 2;
+    memcpy(&payload[idx], &report.latencyMaxUs, 2);  idx += 2;
+    memcpy(&payload[idx], &report.dockedEntries, 2); idx += 2;
+    memcpy(&payload[idx], &report.dockedMs, 4);      idx += 4;
+
+    USBCommTask_SendFrame(USB_MSG_POWER_STATUS, payload, idx);
+}
+
 /* ========================== 数据接收 ========================== */
 static void USBCommTask_ProcessRxStream(void)
 {
@@ -595,6 +1292,7 @@ static void USBCommTask_SafeStop(void)
     MotorCtrlTask_SetPumpMotor(PUMP_MOTOR_LEVEL_OFF);
     MotorCtrlTask_SetFanMotor(FAN_MOTOR_LEVEL_OFF);
     if (g_pCleanBotApp != NULL) {
+        Trajectory_RequestAbort(&g_pCleanBotApp->trajectory);
         IRHoming_Stop(&g_pCleanBotApp->irHoming);
     }
     s_usbSafeStopped = true;
@@ -609,6 +1307,10 @@ static void USBCommTask_HandleConnection(void)
     if (connected != s_lastUsbConnected) {
         s_lastUsbConnected = connected;
         USBCommTask_UpdateLed(connected);
+        if (connected) {
+            /* 每次连接上报一次复位原因与故障快照 */
+            s_faultReportPending = true;
+        }
     }
 
     if (!connected && !USB_COMM_DEBUG_MODE) {
@@ -626,9 +1328,22 @@ void USBCommTask_Init(void)
     s_lastWheelTick = osKernelGetTickCount();
     s_lastImuTick = s_lastWheelTick;
     s_lastSensorTick = s_lastWheelTick;
+    s_lastActuatorTick = s_lastWheelTick;
+    s_lastTrajTick = s_lastWheelTick;
+    s_lastMotorDiagTick = s_lastWheelTick;
+    s_lastIrStatsTick = s_lastWheelTick;
+    s_lastSafetyTick = s_lastWheelTick;
+    s_lastHomingTick = s_lastWheelTick;
+    s_lastSystemTick = s_lastWheelTick;
+    /* 与系统状态错开半个周期，避免同一轮的多帧突发超出发送缓冲 */
+    s_lastPowerTick = s_lastWheelTick - PERIOD_POWER_MS / 2U;
     s_lastConnPollTick = s_lastWheelTick;
+    s_faultReportPending = true;
 
+    PowerMgr_RegisterThread(osThreadGetId());
+    Supervisor_RegisterTask(SUPERVISOR_TASK_USB, osThreadGetId());
     if (g_pCleanBotApp != NULL) {
+        USB_Comm_SetNotifyThread(&g_pCleanBotApp->usbComm, osThreadGetId());
         USB_Comm_UpdateConnectionState(&g_pCleanBotApp->usbComm);
         s_lastUsbConnected = USB_Comm_IsConnected(&g_pCleanBotApp->usbComm);
         USBCommTask_UpdateLed(s_lastUsbConnected);
@@ -638,12 +1353,29 @@ void USBCommTask_Init(void)
     }
 }
 
+/* 周期到期返回 true 并更新起点；同时把 *wait 缩短到该周期下次到期的剩余 tick */
+static bool USBCommTask_PeriodDue(uint32_t *lastTick, uint32_t periodMs, uint32_t now, uint32_t *wait)
+{
+    uint32_t elapsed = now - *lastTick;
+    bool due = (elapsed >= periodMs);
+    if (due) {
+        *lastTick = now;
+        elapsed = 0;
+    }
+    if (periodMs - elapsed < *wait) {
+        *wait = periodMs - elapsed;
+    }
+    return due;
+}
+
 void USBCommTask_Run(void *argument)
 {
     (void)argument;
     USBCommTask_Init();
 
     while (1) {
+        Supervisor_Heartbeat(SUPERVISOR_TASK_USB);
+
         if (g_pCleanBotApp == NULL) {
             osDelay(50);
             continue;
@@ -651,24 +1383,63 @@ void USBCommTask_Run(void *argument)
 
         USBCommTask_ProcessRxStream();
 
+        /* 睡到最近一个遥测周期到期，期间收到数据或电源模式切换时提前唤醒 */
         uint32_t now = osKernelGetTickCount();
-        if ((now - s_lastWheelTick) >= PERIOD_WHEEL_MS) {
-            s_lastWheelTick = now;
-            USBCommTask_SendWheelTelemetry();
+        uint32_t wait = osWaitForever;
+        bool docked = PowerMgr_IsDocked();
+        if (!docked) {
+            if (USBCommTask_PeriodDue(&s_lastWheelTick, PERIOD_WHEEL_MS, now, &wait)) {
+                USBCommTask_SendWheelTelemetry();
+            }
+            if (USBCommTask_PeriodDue(&s_lastImuTick, PERIOD_IMU_MS, now, &wait)) {
+                USBCommTask_SendImuTelemetry();
+            }
+            if (USBCommTask_PeriodDue(&s_lastSensorTick, PERIOD_SENSOR_MS, now, &wait)) {
+                USBCommTask_SendSensorTelemetry();
+            }
+            if (USBCommTask_PeriodDue(&s_lastActuatorTick, PERIOD_ACTUATOR_MS, now, &wait)) {
+                USBCommTask_SendActuatorTelemetry();
+            }
+            if (USBCommTask_PeriodDue(&s_lastTrajTick, PERIOD_TRAJ_MS, now, &wait)) {
+                USBCommTask_SendTrajTelemetry();
+            }
+            if (USBCommTask_PeriodDue(&s_lastMotorDiagTick, PERIOD_MOTOR_DIAG_MS, now, &wait)) {
+                USBCommTask_SendMotorDiagTelemetry();
+            }
+            if (USBCommTask_PeriodDue(&s_lastIrStatsTick, PERIOD_IR_STATS_MS, now, &wait)) {
+                USBCommTask_SendIrStatsTelemetry();
+            }
+            if (USBCommTask_PeriodDue(&s_lastSafetyTick, PERIOD_SAFETY_MS, now, &wait)) {
+                USBCommTask_SendSafetyTelemetry();
+            }
+            if (USBCommTask_PeriodDue(&s_lastHomingTick, PERIOD_HOMING_MS, now, &wait)) {
+                USBCommTask_SendHomingTelemetry();
+            }
+        }
+        if (USBCommTask_PeriodDue(&s_lastSystemTick, PERIOD_SYSTEM_MS, now, &wait)) {
+            USBCommTask_SendSystemTelemetry();
+        }
+        if (USBCommTask_PeriodDue(&s_lastPowerTick, PERIOD_POWER_MS, now, &wait)) {
+            USBCommTask_SendPowerTelemetry();
+        }
+        if (s_faultReportPending && s_lastUsbConnected) {
+            USBCommTask_SendFaultReport();
         }
-        if ((now - s_lastImuTick) >= PERIOD_IMU_MS) {
-            s_lastImuTick = now;
-            USBCommTask_SendImuTelemetry();
+        if (s_blackBoxInfoPending) {
+            USBCommTask_SendBlackBoxInfo();
         }
-        if ((now - s_lastSensorTick) >= PERIOD_SENSOR_MS) {
-            s_lastSensorTick = now;
-            USBCommTask_SendSensorTelemetry();
+        USBCommTask_SendTraceData();
+        USBCommTask_SendProfData();
+        USBCommTask_SendBlackBoxData();
+        if (s_traceMode != TRACE_TX_IDLE || s_profTxIndex < PROF_COUNT ||
+            s_blackBoxTxImage != BLACKBOX_IMAGE_NONE || s_blackBoxInfoPending) {
+            wait = 1U;   /* 跟踪推送/剖析上传/黑匣子下载未完成，下个 tick 继续 */
         }
-        if ((now - s_lastConnPollTick) >= CONNECTION_POLL_MS) {
-            s_lastConnPollTick = now;
+        if (USBCommTask_PeriodDue(&s_lastConnPollTick, docked ? POWER_DOCKED_REPORT_MS : CONNECTION_POLL_MS,
+                                  now, &wait)) {
             USBCommTask_HandleConnection();
         }
 
-        osDelay(1);
+        osThreadFlagsWait(USB_COMM_RX_THREAD_FLAG | POWER_MODE_THREAD_FLAG, osFlagsWaitAny, wait);
     }
 }
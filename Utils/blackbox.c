@@ -0,0 +1,415 @@
+/**
+  ******************************************************************************
+  * @file    blackbox.c
+  * @brief   黑匣子记录实现（抽取遥测的差分编码 RAM 环与故障时 Flash 转储）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "blackbox.h"
+#include "main.h"
+#include "prof.h"
+#include "mem_section.h"
+#include <stddef.h>  /* 定义NULL */
+#include <string.h>
+
+/* 单条记录最大长度：dt、mask 与每个字段的 32 位 varint */
+#define BLACKBOX_RECORD_MAX         (5U + 3U + BLACKBOX_FIELD_COUNT * 5U)
+
+/* Flash 保留扇区与槽地址 */
+#define BLACKBOX_FLASH_ADDR         (FLASH_BASE + BLACKBOX_FLASH_OFFSET)
+#define BLACKBOX_SLOT_ADDR(slot)    (BLACKBOX_FLASH_ADDR + (uint32_t)(slot) * BLACKBOX_SLOT_SIZE)
+#define BLACKBOX_ERASED_WORD        0xFFFFFFFFU
+#define BLACKBOX_NO_SLOT            0xFFU
+
+/* 编程前清除的错误标志（上次失败残留会使 HAL 直接返回错误） */
+#define BLACKBOX_FLASH_FLAGS        (FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR | \
+                                     FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR)
+
+/* 环由整块组成，块内偏移用 uint16 表示；槽按字编程 */
+typedef char BlackBoxRingSizeCheck_t[((BLACKBOX_RING_SIZE % BLACKBOX_BLOCK_SIZE) == 0U &&
+                                      BLACKBOX_BLOCK_COUNT >= 2U && BLACKBOX_BLOCK_SIZE <= 0xFFFFU &&
+                                      (BLACKBOX_BLOCK_SIZE % 4U) == 0U) ? 1 : -1];
+typedef char BlackBoxSlotCheck_t[(BLACKBOX_FLASH_SLOTS > 0U && BLACKBOX_FLASH_SLOTS < BLACKBOX_NO_SLOT &&
+                                  (sizeof(BlackBoxImageHeader_t) % 4U) == 0U) ? 1 : -1];
+
+/* 记录器状态 */
+typedef struct {
+    uint32_t head;                  /* 当前写入的块号 */
+    uint32_t nextSeq;               /* 下一块序号 */
+    int32_t prev[BLACKBOX_FIELD_COUNT];
+    uint32_t prevMs;
+    volatile bool paused;
+    uint32_t pausedMs;              /* 暂停时刻（RAM 映像头的时间） */
+    uint32_t records;
+    bool flushed;                   /* 本次上电已做过故障转储 */
+    uint8_t slotState[BLACKBOX_FLASH_SLOTS];
+} BlackBox_t;
+
+CCM_DATA static BlackBox_t g_BlackBox;
+
+/* RAM 环：按字对齐以便整字编程，16KB 放在 SRAM 以节省 CCM */
+static uint32_t s_ring[BLACKBOX_RING_SIZE / 4U];
+
+static BlackBoxBlockHeader_t* BlackBox_Block(uint32_t index)
+{
+    return (BlackBoxBlockHeader_t *)((uint8_t *)s_ring + index * BLACKBOX_BLOCK_SIZE);
+}
+
+static const uint8_t* BlackBox_SlotPtr(uint8_t slot)
+{
+    return (const uint8_t *)(uintptr_t)BLACKBOX_SLOT_ADDR(slot);
+}
+
+static uint8_t* BlackBox_PutVarint(uint8_t *p, uint32_t value)
+{
+    while (value >= 0x80U) {
+        *p++ = (uint8_t)(value | 0x80U);
+        value >>= 7;
+    }
+    *p++ = (uint8_t)value;
+    return p;
+}
+
+/* zigzag：小幅正负差值都编码为小的无符号数 */
+static uint32_t BlackBox_Zigzag(int32_t value)
+{
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static void BlackBox_FillHeader(BlackBoxImageHeader_t *hdr, uint8_t reason, uint32_t uptimeMs)
+{
+    hdr->magic = BLACKBOX_MAGIC;
+    hdr->state = BLACKBOX_ERASED_WORD;
+    hdr->uptimeMs = uptimeMs;
+    hdr->blockSize = (uint16_t)BLACKBOX_BLOCK_SIZE;
+    hdr->blockCount = (uint16_t)BLACKBOX_BLOCK_COUNT;
+    hdr->periodMs = (uint16_t)BLACKBOX_PERIOD_MS;
+    hdr->reason = reason;
+    hdr->fieldCount = (uint8_t)BLACKBOX_FIELD_COUNT;
+}
+
+/**
+  * @brief  开始新块：覆盖最旧的块，首条记录相对全 0 编码
+  * @note   先把 seq 置 0 作废该块再填写，故障转储读到的块要么为空要么完整
+  */
+static void BlackBox_StartBlock(uint32_t timeMs)
+{
+    BlackBox_t *bb = &g_BlackBox;
+
+    bb->head = (bb->head + 1U) % BLACKBOX_BLOCK_COUNT;
+    BlackBoxBlockHeader_t *blk = BlackBox_Block(bb->head);
+    blk->seq = 0U;
+    blk->baseMs = timeMs;
+    blk->used = (uint16_t)sizeof(BlackBoxBlockHeader_t);
+    blk->count = 0U;
+    blk->seq = bb->nextSeq++;
+
+    memset(bb->prev, 0, sizeof(bb->prev));
+    bb->prevMs = timeMs;
+}
+
+/* ========================== Flash 转储 ========================== */
+
+static bool BlackBox_SlotBlank(uint8_t slot)
+{
+    const uint32_t *word = (const uint32_t *)BlackBox_SlotPtr(slot);
+
+    for (uint32_t i = 0; i < BLACKBOX_SLOT_SIZE / 4U; i++) {
+        if (word[i] != BLACKBOX_ERASED_WORD) return false;
+    }
+    return true;
+}
+
+/**
+  * @brief  按映像头判定各槽状态
+  */
+static void BlackBox_ScanFlash(void)
+{
+    BlackBox_t *bb = &g_BlackBox;
+
+    for (uint8_t slot = 0; slot < BLACKBOX_FLASH_SLOTS; slot++) {
+        const BlackBoxImageHeader_t *hdr = (const BlackBoxImageHeader_t *)BlackBox_SlotPtr(slot);
+        if (hdr->magic == BLACKBOX_MAGIC) {
+            bb->slotState[slot] = (hdr->state == BLACKBOX_ERASED_WORD) ? BLACKBOX_SLOT_DUMP : BLACKBOX_SLOT_CLEARED;
+        } else {
+            bb->slotState[slot] = BlackBox_SlotBlank(slot) ? BLACKBOX_SLOT_FREE : BLACKBOX_SLOT_DIRTY;
+        }
+    }
+}
+
+static uint8_t BlackBox_FindFreeSlot(void)
+{
+    for (uint8_t slot = 0; slot < BLACKBOX_FLASH_SLOTS; slot++) {
+        if (g_BlackBox.slotState[slot] == BLACKBOX_SLOT_FREE) return slot;
+    }
+    return BLACKBOX_NO_SLOT;
+}
+
+/**
+  * @brief  擦除保留扇区（128KB，约 1s，期间从 Flash 取指停顿）
+  */
+static bool BlackBox_EraseFlash(void)
+{
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(BLACKBOX_FLASH_FLAGS);
+
+    /* 同 HAL_FLASHEx_Erase 的单扇区流程，只是等待上限为 BLACKBOX_ERASE_TIMEOUT_MS */
+    HAL_StatusTypeDef status = FLASH_WaitForLastOperation(BLACKBOX_ERASE_TIMEOUT_MS);
+    if (status == HAL_OK) {
+        FLASH_Erase_Sector(BLACKBOX_FLASH_SECTOR, FLASH_VOLTAGE_RANGE_3);
+        status = FLASH_WaitForLastOperation(BLACKBOX_ERASE_TIMEOUT_MS);
+        CLEAR_BIT(FLASH->CR, (FLASH_CR_SER | FLASH_CR_SNB));
+    }
+
+    /* 扫描时读过的旧槽头可能留在数据缓存中 */
+    if (READ_BIT(FLASH->ACR, FLASH_ACR_DCEN) != 0U) {
+        __HAL_FLASH_DATA_CACHE_DISABLE();
+        __HAL_FLASH_DATA_CACHE_RESET();
+        __HAL_FLASH_DATA_CACHE_ENABLE();
+    }
+
+    HAL_FLASH_Lock();
+    return status == HAL_OK;
+}
+
+/* 逐字编程，跳过全 1 的字（擦除态无需写入） */
+static bool BlackBox_ProgramWords(uint32_t addr, const uint32_t *data, uint32_t words)
+{
+    for (uint32_t i = 0; i < words; i++) {
+        if (data[i] == BLACKBOX_ERASED_WORD) continue;
+        if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr + i * 4U, data[i]) != HAL_OK) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+  * @brief  把 RAM 环写入下一个空槽：块数据、映像头，最后写 magic
+  * @note   每字编程约 16us，16KB 环约 70ms；HAL 超时基于 HAL_GetTick，故障
+  *         上下文中节拍停止时退化为等待 BSY 清除
+  */
+static BlackBoxSaveResult_t BlackBox_WriteSlot(uint8_t reason)
+{
+    BlackBox_t *bb = &g_BlackBox;
+    uint8_t slot = BlackBox_FindFreeSlot();
+
+    if (slot == BLACKBOX_NO_SLOT) return BLACKBOX_SAVE_NO_SLOT;
+
+    BlackBoxImageHeader_t hdr;
+    BlackBox_FillHeader(&hdr, reason, HAL_GetTick());
+    uint32_t addr = BLACKBOX_SLOT_ADDR(slot);
+    const uint32_t *hdrWords = (const uint32_t *)&hdr;
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(BLACKBOX_FLASH_FLAGS);
+    bool ok = BlackBox_ProgramWords(addr + sizeof(hdr), s_ring, BLACKBOX_RING_SIZE / 4U) &&
+              BlackBox_ProgramWords(addr + 4U, &hdrWords[1], sizeof(hdr) / 4U - 1U) &&
+              BlackBox_ProgramWords(addr, &hdrWords[0], 1U);
+    HAL_FLASH_Lock();
+
+    bb->slotState[slot] = ok ? BLACKBOX_SLOT_DUMP : BLACKBOX_SLOT_DIRTY;
+    return ok ? BLACKBOX_SAVE_OK : BLACKBOX_SAVE_ERROR;
+}
+
+/* ========================== 接口 ========================== */
+
+/**
+  * @brief  初始化记录器并扫描 Flash 槽
+  * @note   在 Supervisor_Init 启动 IWDG 之前调用：扇区没有空槽且没有未清除的
+  *         转储时擦除扇区，擦除期间 CPU 取指停顿（约 1s，最坏数秒），无法喂狗；
+  *         HAL 节拍此时仍在计数，等待上限 BLACKBOX_ERASE_TIMEOUT_MS 有效。
+  *         仍有未清除的转储时保留，故障转储在清除并重新上电前不可用
+  */
+void BlackBox_Init(void)
+{
+    BlackBox_t *bb = &g_BlackBox;
+
+    memset(bb, 0, sizeof(BlackBox_t));
+    bb->head = BLACKBOX_BLOCK_COUNT - 1U;
+    bb->nextSeq = 1U;
+
+#if BLACKBOX_ENABLE
+    BlackBox_ScanFlash();
+
+    bool pending = false;
+    for (uint8_t slot = 0; slot < BLACKBOX_FLASH_SLOTS; slot++) {
+        if (bb->slotState[slot] == BLACKBOX_SLOT_DUMP) pending = true;
+    }
+    if (!pending && BlackBox_FindFreeSlot() == BLACKBOX_NO_SLOT && BlackBox_EraseFlash()) {
+        memset(bb->slotState, BLACKBOX_SLOT_FREE, sizeof(bb->slotState));
+    }
+#endif
+}
+
+/**
+  * @brief  写入一条记录（传感器任务中调用）
+  * @param  sample: 已量化的采样
+  * @retval None
+  */
+void BlackBox_Record(const BlackBoxSample_t *sample)
+{
+#if BLACKBOX_ENABLE
+    BlackBox_t *bb = &g_BlackBox;
+
+    if (sample == NULL || bb->paused) return;
+
+    PROF_BEGIN(PROF_BLACKBOX_RECORD);
+    BlackBoxBlockHeader_t *blk = BlackBox_Block(bb->head);
+    if (blk->seq == 0U || blk->used + BLACKBOX_RECORD_MAX > BLACKBOX_BLOCK_SIZE) {
+        BlackBox_StartBlock(sample->timeMs);
+        blk = BlackBox_Block(bb->head);
+    }
+
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < BLACKBOX_FIELD_COUNT; i++) {
+        if (sample->value[i] != bb->prev[i]) {
+            mask |= 1U << i;
+        }
+    }
+
+    /* 先写记录字节，最后更新 used/count */
+    uint8_t *p = (uint8_t *)blk + blk->used;
+    p = BlackBox_PutVarint(p, sample->timeMs - bb->prevMs);
+    p = BlackBox_PutVarint(p, mask);
+    for (uint32_t i = 0; i < BLACKBOX_FIELD_COUNT; i++) {
+        if ((mask & (1U << i)) != 0U) {
+            p = BlackBox_PutVarint(p, BlackBox_Zigzag(sample->value[i] - bb->prev[i]));
+            bb->prev[i] = sample->value[i];
+        }
+    }
+    bb->prevMs = sample->timeMs;
+
+    blk->count++;
+    blk->used = (uint16_t)(p - (uint8_t *)blk);
+    bb->records++;
+    PROF_END(PROF_BLACKBOX_RECORD);
+#else
+    (void)sample;
+#endif
+}
+
+/**
+  * @brief  暂停/恢复记录（下载 RAM 环与手动保存期间内容保持不变）
+  */
+void BlackBox_SetPaused(bool paused)
+{
+    if (paused && !g_BlackBox.paused) {
+        g_BlackBox.pausedMs = HAL_GetTick();
+    }
+    g_BlackBox.paused = paused;
+}
+
+uint32_t BlackBox_GetRecordCount(void)
+{
+    return g_BlackBox.records;
+}
+
+/**
+  * @brief  故障转储（Supervisor 快照之后调用，中断/故障上下文）
+  * @param  reason: SupervisorReason_t
+  * @note   同步编程约 70ms，调用方必须先关断电机输出（Supervisor_ForceOutputsSafe）
+  */
+void BlackBox_OnFault(uint8_t reason)
+{
+#if BLACKBOX_ENABLE
+    if (g_BlackBox.flushed) return;
+
+    g_BlackBox.flushed = true;
+    (void)BlackBox_WriteSlot(reason);
+#else
+    (void)reason;
+#endif
+}
+
+/**
+  * @brief  手动保存 RAM 环（USB 命令，整机空闲时调用）
+  */
+BlackBoxSaveResult_t BlackBox_Save(void)
+{
+#if BLACKBOX_ENABLE
+    bool paused = g_BlackBox.paused;
+
+    BlackBox_SetPaused(true);
+    BlackBoxSaveResult_t result = BlackBox_WriteSlot(0U);
+    BlackBox_SetPaused(paused);
+    return result;
+#else
+    return BLACKBOX_SAVE_NO_SLOT;
+#endif
+}
+
+/**
+  * @brief  清除全部转储：映像头 state 编程为 0，扇区在写满后的上电时擦除
+  */
+void BlackBox_ClearFlash(void)
+{
+#if BLACKBOX_ENABLE
+    BlackBox_t *bb = &g_BlackBox;
+    const uint32_t cleared = 0U;
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(BLACKBOX_FLASH_FLAGS);
+    for (uint8_t slot = 0; slot < BLACKBOX_FLASH_SLOTS; slot++) {
+        if (bb->slotState[slot] != BLACKBOX_SLOT_DUMP) continue;
+        uint32_t addr = BLACKBOX_SLOT_ADDR(slot) + offsetof(BlackBoxImageHeader_t, state);
+        if (BlackBox_ProgramWords(addr, &cleared, 1U)) {
+            bb->slotState[slot] = BLACKBOX_SLOT_CLEARED;
+        }
+    }
+    HAL_FLASH_Lock();
+#endif
+}
+
+BlackBoxSlotState_t BlackBox_GetSlotState(uint8_t slot)
+{
+    if (slot >= BLACKBOX_FLASH_SLOTS) return BLACKBOX_SLOT_DIRTY;
+    return (BlackBoxSlotState_t)g_BlackBox.slotState[slot];
+}
+
+/**
+  * @brief  下载映像大小
+  * @param  image: BLACKBOX_IMAGE_RAM 或 Flash 槽号+1
+  * @retval 字节数，空槽/不可用返回0
+  */
+uint32_t BlackBox_GetImageSize(uint8_t image)
+{
+    if (image == BLACKBOX_IMAGE_RAM) return BLACKBOX_SLOT_SIZE;
+    if (image > BLACKBOX_FLASH_SLOTS) return 0U;
+
+    BlackBoxSlotState_t state = BlackBox_GetSlotState((uint8_t)(image - 1U));
+    return (state == BLACKBOX_SLOT_DUMP || state == BLACKBOX_SLOT_CLEARED) ? BLACKBOX_SLOT_SIZE : 0U;
+}
+
+/**
+  * @brief  读取映像的一段
+  * @note   RAM 映像的映像头按暂停时刻生成，读取前应先暂停记录
+  * @retval 实际读取的字节数
+  */
+uint32_t BlackBox_ReadImage(uint8_t image, uint32_t offset, uint8_t *out, uint32_t len)
+{
+    uint32_t size = BlackBox_GetImageSize(image);
+
+    if (out == NULL || offset >= size) return 0U;
+    if (len > size - offset) len = size - offset;
+
+    if (image != BLACKBOX_IMAGE_RAM) {
+        memcpy(out, BlackBox_SlotPtr((uint8_t)(image - 1U)) + offset, len);
+        return len;
+    }
+
+    BlackBoxImageHeader_t hdr;
+    uint32_t done = 0;
+    BlackBox_FillHeader(&hdr, 0U, g_BlackBox.pausedMs);
+    if (offset < sizeof(hdr)) {
+        done = sizeof(hdr) - offset;
+        if (done > len) done = len;
+        memcpy(out, (const uint8_t *)&hdr + offset, done);
+    }
+    if (done < len) {
+        memcpy(out + done, (const uint8_t *)s_ring + (offset + done - sizeof(hdr)), len - done);
+    }
+    return len;
+}
@@ -0,0 +1,142 @@
+/**
+  ******************************************************************************
+  * @file    blackbox.h
+  * @brief   黑匣子记录头文件（抽取遥测的差分编码 RAM 环与故障时 Flash 转储）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 传感器任务（优先级低于电机控制任务）每 BLACKBOX_PERIOD_MS 取一次轮速、
+  * 占空比、IMU、控制状态与故障位，编码后写入 RAM 环，控制循环中不增加任何
+  * 代码。RAM 环由 BLACKBOX_BLOCK_SIZE 字节的块组成，写满后覆盖最旧的块：
+  *   块头：uint32 seq（从1递增，0=空块）+ uint32 base_ms + uint16 used
+  *         （含块头的已用字节）+ uint16 count（记录数）
+  *   记录：varint dt_ms + varint mask（字段变化位图）+ 变化字段的
+  *         zigzag varint 差值；块内首条记录相对全 0 编码（关键帧）
+  * 静止时一条记录 2 字节，行驶时约 15~25 字节。
+  *
+  * 签到超时、故障异常与 Error_Handler（Supervisor 关断电机输出并写快照之后）把 RAM 环
+  * 原样写入 Flash 保留扇区的下一个空槽，只写不擦：槽 = 映像头 + RAM 环，
+  * 映像头的 magic 最后写入，中途复位的槽不会被当作有效转储。上位机经
+  * USB 0x16 下载（0x2F），TEST/blackbox_tool.py 解码为 CSV；清除只把
+  * 映像头 state 编程为 0，扇区写满且没有未清除的转储时在上电时擦除。
+  ******************************************************************************
+  */
+
+#ifndef __BLACKBOX_H__
+#define __BLACKBOX_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "system_config.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 记录字段（顺序即编码位序，上位机 blackbox_tool.py 按同一顺序命名） */
+typedef enum {
+    BLACKBOX_FIELD_LEFT_TARGET = 0, /* 左轮目标速度 (mm/s) */
+    BLACKBOX_FIELD_RIGHT_TARGET,
+    BLACKBOX_FIELD_LEFT_SPEED,      /* 左轮实测速度 (mm/s) */
+    BLACKBOX_FIELD_RIGHT_SPEED,
+    BLACKBOX_FIELD_LEFT_DUTY,       /* 左轮占空比 (-1000~1000) */
+    BLACKBOX_FIELD_RIGHT_DUTY,
+    BLACKBOX_FIELD_YAW,             /* 偏航角 (0.01°) */
+    BLACKBOX_FIELD_GYRO_Z,          /* 偏航角速度 (0.1°/s) */
+    BLACKBOX_FIELD_ACCEL_X,         /* 加速度 (mg) */
+    BLACKBOX_FIELD_ACCEL_Y,
+    BLACKBOX_FIELD_STATE,           /* 控制状态 BLACKBOX_STATE_xxx */
+    BLACKBOX_FIELD_FAULTS,          /* 故障位 BLACKBOX_FAULT_xxx */
+    BLACKBOX_FIELD_COUNT
+} BlackBoxField_t;
+
+/* 控制状态位 */
+#define BLACKBOX_STATE_SAFETY_MASK      0x07U       /* 安全反射状态（SafetyState_t） */
+#define BLACKBOX_STATE_DOCKED           (1U << 3)   /* 停靠模式 */
+#define BLACKBOX_STATE_TRAJ_ACTIVE      (1U << 4)   /* 轨迹执行中 */
+#define BLACKBOX_STATE_HOMING           (1U << 5)   /* 回充流程进行中 */
+#define BLACKBOX_STATE_USB_CONNECTED    (1U << 6)
+
+/* 故障位 */
+#define BLACKBOX_FAULT_LEFT_SHIFT       0U          /* 左轮诊断故障位（MOTOR_DIAG_FAULT_xxx） */
+#define BLACKBOX_FAULT_RIGHT_SHIFT      3U          /* 右轮诊断故障位 */
+#define BLACKBOX_FAULT_BUMPER_LEFT      (1U << 6)
+#define BLACKBOX_FAULT_BUMPER_RIGHT     (1U << 7)
+#define BLACKBOX_FAULT_CLIFF_LEFT       (1U << 8)
+#define BLACKBOX_FAULT_CLIFF_CENTER     (1U << 9)
+#define BLACKBOX_FAULT_CLIFF_RIGHT      (1U << 10)
+#define BLACKBOX_FAULT_DOCK_FAILED      (1U << 11)
+
+/* 一次采样（各字段已按上述单位量化） */
+typedef struct {
+    uint32_t timeMs;
+    int32_t value[BLACKBOX_FIELD_COUNT];
+} BlackBoxSample_t;
+
+/* RAM 环中的块头 */
+typedef struct {
+    uint32_t seq;
+    uint32_t baseMs;
+    uint16_t used;
+    uint16_t count;
+} BlackBoxBlockHeader_t;
+
+/* 映像头：下载映像与 Flash 槽的开头，其后为 blockCount 个块 */
+typedef struct {
+    uint32_t magic;                 /* BLACKBOX_MAGIC */
+    uint32_t state;                 /* 0xFFFFFFFF=未清除，0=已清除（Flash 上编程为0） */
+    uint32_t uptimeMs;              /* 转储/下载时刻 */
+    uint16_t blockSize;
+    uint16_t blockCount;
+    uint16_t periodMs;
+    uint8_t reason;                 /* SupervisorReason_t，RAM 映像与手动保存为0 */
+    uint8_t fieldCount;
+} BlackBoxImageHeader_t;
+
+#define BLACKBOX_MAGIC              0x31585842U     /* "BBX1" */
+#define BLACKBOX_BLOCK_COUNT        (BLACKBOX_RING_SIZE / BLACKBOX_BLOCK_SIZE)
+#define BLACKBOX_SLOT_SIZE          (sizeof(BlackBoxImageHeader_t) + BLACKBOX_RING_SIZE)
+#define BLACKBOX_FLASH_SLOTS        (BLACKBOX_FLASH_SIZE / BLACKBOX_SLOT_SIZE)
+
+/* 映像编号：0 为 RAM 环，1..BLACKBOX_FLASH_SLOTS 为 Flash 槽 */
+#define BLACKBOX_IMAGE_RAM          0U
+
+/* Flash 槽状态 */
+typedef enum {
+    BLACKBOX_SLOT_FREE = 0,         /* 已擦除，可写入 */
+    BLACKBOX_SLOT_DUMP,             /* 未清除的转储 */
+    BLACKBOX_SLOT_CLEARED,          /* 已清除，等待整扇区擦除 */
+    BLACKBOX_SLOT_DIRTY             /* 写入中途复位，不可用 */
+} BlackBoxSlotState_t;
+
+/* 保存结果 */
+typedef enum {
+    BLACKBOX_SAVE_OK = 0,
+    BLACKBOX_SAVE_NO_SLOT,          /* 没有空槽（未清除的转储占满扇区） */
+    BLACKBOX_SAVE_ERROR             /* Flash 编程失败，该槽标记为不可用 */
+} BlackBoxSaveResult_t;
+
+/* 函数声明 */
+void BlackBox_Init(void);                           /* 启动 IWDG 前调用：扫描 Flash 槽，必要时擦除扇区 */
+void BlackBox_Record(const BlackBoxSample_t *sample);
+void BlackBox_SetPaused(bool paused);               /* 下载 RAM 环期间暂停记录 */
+uint32_t BlackBox_GetRecordCount(void);             /* 上电以来写入的记录数 */
+
+/* Flash 转储 */
+/* 故障/中断上下文：写入下一个空槽，每次上电只写一次。同步编程约 70ms，
+   前提：调用方已关断电机PWM输出（Supervisor 在快照之前完成） */
+void BlackBox_OnFault(uint8_t reason);
+BlackBoxSaveResult_t BlackBox_Save(void);           /* 任务上下文手动保存 */
+void BlackBox_ClearFlash(void);                     /* 清除全部转储 */
+BlackBoxSlotState_t BlackBox_GetSlotState(uint8_t slot);
+
+/* 下载映像：映像头 + 全部块（由上位机按 seq 排序） */
+uint32_t BlackBox_GetImageSize(uint8_t image);      /* 不存在或空槽返回0 */
+uint32_t BlackBox_ReadImage(uint8_t image, uint32_t offset, uint8_t *out, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BLACKBOX_H__ */
@@ -0,0 +1,487 @@
+/**
+  ******************************************************************************
+  * @file    ir_decode.c
+  * @brief   表驱动多协议红外解码引擎实现
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "ir_decode.h"
+#include <stddef.h>  /* 定义NULL */
+#include <string.h>
+
+/* NEC：字节顺序与充电座信标一致（地址、命令、地址反码、命令反码） */
+static bool IRDecode_UnpackNEC(uint32_t raw, IRFrame_t *frame)
+{
+    uint8_t address = (uint8_t)(raw >> 0);
+    uint8_t command = (uint8_t)(raw >> 8);
+    uint8_t addressInv = (uint8_t)(raw >> 16);
+    uint8_t commandInv = (uint8_t)(raw >> 24);
+
+    if ((uint8_t)(address ^ addressInv) != 0xFFU || (uint8_t)(command ^ commandInv) != 0xFFU) {
+        return false;
+    }
+    frame->address = address;
+    frame->command = command;
+    return true;
+}
+
+/* Samsung：地址字节重复两次，命令 + 命令反码 */
+static bool IRDecode_UnpackSamsung(uint32_t raw, IRFrame_t *frame)
+{
+    uint8_t address = (uint8_t)(raw >> 0);
+    uint8_t address2 = (uint8_t)(raw >> 8);
+    uint8_t command = (uint8_t)(raw >> 16);
+    uint8_t commandInv = (uint8_t)(raw >> 24);
+
+    if (address != address2 || (uint8_t)(command ^ commandInv) != 0xFFU) {
+        return false;
+    }
+    frame->address = address;
+    frame->command = command;
+    return true;
+}
+
+/* SIRC 12位：7位命令 + 5位地址，无校验 */
+static bool IRDecode_UnpackSIRC12(uint32_t raw, IRFrame_t *frame)
+{
+    frame->command = (uint8_t)(raw & 0x7FU);
+    frame->address = (uint16_t)((raw >> 7) & 0x1FU);
+    return true;
+}
+
+/* 协议描述表（新增协议只需在此追加一行并实现unpack） */
+static const IRProtocol_t s_protocols[IR_PROTO_COUNT] = {
+    /* id               coding                    leader       repeat  zero(m/s)  one(m/s)    bits window unpack */
+    { IR_PROTO_NEC,     IR_CODING_PULSE_DISTANCE, 9000, 4500,  2250,   560, 560,  560, 1690,  32,  150,   IRDecode_UnpackNEC },
+    { IR_PROTO_SAMSUNG, IR_CODING_PULSE_DISTANCE, 4500, 4500,  0,      560, 560,  560, 1690,  32,  0,     IRDecode_UnpackSamsung },
+    { IR_PROTO_SIRC12,  IR_CODING_PULSE_WIDTH,    2400, 600,   0,      600, 600,  1200, 600,  12,  0,     IRDecode_UnpackSIRC12 },
+};
+
+/**
+  * @brief  获取协议描述
+  */
+const IRProtocol_t* IRDecoder_GetProtocol(IRProtocolId_t id)
+{
+    if (id >= IR_PROTO_COUNT) return NULL;
+    return &s_protocols[id];
+}
+
+/**
+  * @brief  初始化解码器
+  * @param  dec: 解码器对象指针
+  * @param  protocolMask: 允许的协议 (IR_PROTO_MASK)
+  * @retval None
+  */
+void IRDecoder_Init(IRDecoder_t *dec, uint8_t protocolMask)
+{
+    if (dec == NULL) return;
+
+    memset(dec, 0, sizeof(IRDecoder_t));
+    dec->protocolMask = protocolMask & IR_PROTO_MASK_ALL;
+    dec->state = IR_DECODE_IDLE;
+    dec->jitterQ4 = IR_DECODE_JITTER_INIT_US * 16;
+    dec->stats.jitterUs = IR_DECODE_JITTER_INIT_US;
+    dec->stats.lastMarginPct = 100;
+    dec->stats.worstMarginPct = 100;
+}
+
+/**
+  * @brief  丢弃当前帧（自适应参数与统计保留）
+  * @param  dec: 解码器对象指针
+  * @retval None
+  */
+void IRDecoder_Reset(IRDecoder_t *dec)
+{
+    if (dec == NULL) return;
+
+    dec->state = IR_DECODE_IDLE;
+    dec->proto = NULL;
+    dec->candidates = 0;
+    dec->inMark = false;
+    dec->data = 0;
+    dec->bitCount = 0;
+    dec->ready = false;
+}
+
+/**
+  * @brief  清零统计
+  * @param  dec: 解码器对象指针
+  * @retval None
+  */
+void IRDecoder_ResetStats(IRDecoder_t *dec)
+{
+    if (dec == NULL) return;
+
+    memset(&dec->stats, 0, sizeof(IRDecodeStats_t));
+    dec->stats.jitterUs = (uint16_t)(dec->jitterQ4 / 16);
+    dec->stats.markBiasUs = (int16_t)(dec->biasQ4 / 16);
+    dec->stats.lastMarginPct = 100;
+    dec->stats.worstMarginPct = 100;
+}
+
+/**
+  * @brief  当前时序容差：基础比例 + 3倍实测抖动，限制在最大比例内
+  */
+static uint32_t IRDecode_Tolerance(const IRDecoder_t *dec, uint32_t nominal)
+{
+    uint32_t tol = nominal * IR_DECODE_TOL_BASE_PCT / 100U + (uint32_t)(3 * dec->jitterQ4 / 16);
+    uint32_t maxTol = nominal * IR_DECODE_TOL_MAX_PCT / 100U;
+    if (tol > maxTol) tol = maxTol;
+    if (tol < IR_DECODE_TOL_MIN_US) tol = IR_DECODE_TOL_MIN_US;
+    return tol;
+}
+
+static uint32_t IRDecode_AbsDiff(uint32_t a, uint32_t b)
+{
+    return (a > b) ? (a - b) : (b - a);
+}
+
+/* 补偿接收头载波展宽：载波减去偏置，间隔加上偏置 */
+static uint32_t IRDecode_CorrectMark(const IRDecoder_t *dec, uint32_t markUs)
+{
+    int32_t v = (int32_t)markUs - dec->biasQ4 / 16;
+    return (v > 0) ? (uint32_t)v : 0U;
+}
+
+static uint32_t IRDecode_CorrectSpace(const IRDecoder_t *dec, uint32_t spaceUs)
+{
+    int32_t v = (int32_t)spaceUs + dec->biasQ4 / 16;
+    return (v > 0) ? (uint32_t)v : 0U;
+}
+
+/**
+  * @brief  以判定后的符号更新载波展宽与抖动估计
+  */
+static void IRDecode_Adapt(IRDecoder_t *dec, uint32_t rawMarkUs, uint32_t nominalMarkUs, uint32_t deviationUs)
+{
+    int32_t bias = ((int32_t)rawMarkUs - (int32_t)nominalMarkUs) * 16;
+    dec->biasQ4 += (bias - dec->biasQ4) / 16;
+    if (dec->biasQ4 > IR_DECODE_BIAS_MAX_US * 16) dec->biasQ4 = IR_DECODE_BIAS_MAX_US * 16;
+    if (dec->biasQ4 < -IR_DECODE_BIAS_MAX_US * 16) dec->biasQ4 = -IR_DECODE_BIAS_MAX_US * 16;
+
+    dec->jitterQ4 += ((int32_t)deviationUs * 16 - dec->jitterQ4) / 16;
+
+    dec->stats.markBiasUs = (int16_t)(dec->biasQ4 / 16);
+    dec->stats.jitterUs = (uint16_t)(dec->jitterQ4 / 16);
+}
+
+/**
+  * @brief  数据位查表判定
+  * @param  markUs: 载波长度（原始测量）
+  * @param  spaceUs: 间隔长度（原始测量），脉宽编码不参与判定
+  * @retval 0/1，-1=不匹配
+  */
+static int8_t IRDecode_ClassifyBit(IRDecoder_t *dec, uint32_t markUs, uint32_t spaceUs)
+{
+    const IRProtocol_t *p = dec->proto;
+    bool useSpace = (p->coding == IR_CODING_PULSE_DISTANCE);
+    uint32_t m = IRDecode_CorrectMark(dec, markUs);
+    uint32_t s = IRDecode_CorrectSpace(dec, spaceUs);
+
+    const uint16_t symMark[2] = { p->zeroMarkUs, p->oneMarkUs };
+    const uint16_t symSpace[2] = { p->zeroSpaceUs, p->oneSpaceUs };
+    uint32_t dist[2];
+    bool ok[2];
+
+    for (uint8_t i = 0; i < 2; i++) {
+        uint32_t errM = IRDecode_AbsDiff(m, symMark[i]);
+        uint32_t errS = useSpace ? IRDecode_AbsDiff(s, symSpace[i]) : 0U;
+        dist[i] = errM + errS;
+        ok[i] = errM <= IRDecode_Tolerance(dec, symMark[i]) &&
+                (!useSpace || errS <= IRDecode_Tolerance(dec, symSpace[i]));
+    }
+
+    int8_t bit;
+    if (ok[0] && (!ok[1] || dist[0] <= dist[1])) {
+        bit = 0;
+    } else if (ok[1]) {
+        bit = 1;
+    } else {
+        return -1;
+    }
+
+    /* 判决裕度：到另一符号与到本符号的距离差占两符号间距的比例 */
+    uint32_t span = IRDecode_AbsDiff(symMark[0], symMark[1]) +
+                    (useSpace ? IRDecode_AbsDiff(symSpace[0], symSpace[1]) : 0U);
+    uint8_t other = (uint8_t)(1 - bit);
+    uint32_t margin = (span > 0U && dist[other] > dist[bit]) ? (dist[other] - dist[bit]) * 100U / span : 0U;
+    if (margin > 100U) margin = 100U;
+    if (margin < dec->frameMargin) {
+        dec->frameMargin = (uint8_t)margin;
+    }
+
+    uint32_t deviation = useSpace ? dist[bit] / 2U : dist[bit];
+    IRDecode_Adapt(dec, markUs, symMark[bit], deviation);
+    return bit;
+}
+
+/**
+  * @brief  帧中时序错误：丢弃残帧，载波起点可能是新帧引导码
+  */
+static void IRDecode_Fail(IRDecoder_t *dec, bool atMarkStart)
+{
+    if (dec->state == IR_DECODE_DATA || dec->state == IR_DECODE_STOP) {
+        dec->stats.errorCount++;
+    }
+    dec->state = atMarkStart ? IR_DECODE_LEADER_MARK : IR_DECODE_IDLE;
+}
+
+/**
+  * @brief  完整帧：校验并输出
+  */
+static bool IRDecode_Finish(IRDecoder_t *dec, uint32_t timeUs)
+{
+    const IRProtocol_t *p = dec->proto;
+    IRFrame_t frame;
+
+    memset(&frame, 0, sizeof(frame));
+    frame.protocol = p->id;
+    frame.raw = dec->data;
+    frame.bits = dec->bitCount;
+    frame.marginPct = dec->frameMargin;
+    dec->state = IR_DECODE_IDLE;
+
+    if (!p->unpack(dec->data, &frame)) {
+        dec->stats.errorCount++;
+        return false;
+    }
+
+    dec->stats.okCount++;
+    dec->stats.lastMarginPct = frame.marginPct;
+    if (frame.marginPct < dec->stats.worstMarginPct) {
+        dec->stats.worstMarginPct = frame.marginPct;
+    }
+    dec->last = frame;
+    dec->lastValid = true;
+    dec->lastFrameUs = timeUs;
+    dec->frame = frame;
+    dec->ready = true;
+    return true;
+}
+
+/**
+  * @brief  载波起点（上一间隔结束）
+  */
+static bool IRDecode_OnMarkStart(IRDecoder_t *dec, uint32_t timeUs, uint32_t spaceUs)
+{
+    dec->markStartUs = timeUs;
+
+    switch (dec->state) {
+        case IR_DECODE_LEADER_SPACE: {
+            /* 在引导码载波匹配的协议中按间隔查表：数据帧或重复帧 */
+            const IRProtocol_t *best = NULL;
+            bool repeat = false;
+            uint32_t bestErr = UINT32_MAX;
+            uint32_t s = IRDecode_CorrectSpace(dec, spaceUs);
+            for (uint8_t i = 0; i < IR_PROTO_COUNT; i++) {
+                if ((dec->candidates & IR_PROTO_MASK(i)) == 0U) continue;
+                const IRProtocol_t *p = &s_protocols[i];
+                uint32_t err = IRDecode_AbsDiff(s, p->leaderSpaceUs);
+                if (err <= IRDecode_Tolerance(dec, p->leaderSpaceUs) && err < bestErr) {
+                    best = p;
+                    repeat = false;
+                    bestErr = err;
+                }
+                if (p->repeatSpaceUs != 0U) {
+                    err = IRDecode_AbsDiff(s, p->repeatSpaceUs);
+                    if (err <= IRDecode_Tolerance(dec, p->repeatSpaceUs) && err < bestErr) {
+                        best = p;
+                        repeat = true;
+                        bestErr = err;
+                    }
+                }
+            }
+            if (best == NULL) {
+                dec->state = IR_DECODE_LEADER_MARK;
+                return false;
+            }
+            dec->proto = best;
+            if (repeat) {
+                dec->state = IR_DECODE_REPEAT;
+            } else {
+                dec->state = IR_DECODE_DATA;
+                dec->data = 0;
+                dec->bitCount = 0;
+                dec->frameMargin = 100;
+                dec->stats.frameCount++;
+            }
+            return false;
+        }
+
+        case IR_DECODE_DATA:
+            if (dec->proto->coding == IR_CODING_PULSE_WIDTH) {
+                /* 脉宽编码：位间隔固定 */
+                uint32_t s = IRDecode_CorrectSpace(dec, spaceUs);
+                if (IRDecode_AbsDiff(s, dec->proto->zeroSpaceUs) > IRDecode_Tolerance(dec, dec->proto->zeroSpaceUs)) {
+                    IRDecode_Fail(dec, true);
+                }
+                return false;
+            } else {
+                /* 间隔编码：载波+间隔成对判定上一位 */
+                int8_t bit = IRDecode_ClassifyBit(dec, dec->markUs, spaceUs);
+                if (bit < 0) {
+                    IRDecode_Fail(dec, true);
+                    return false;
+                }
+                dec->data |= ((uint32_t)bit << dec->bitCount);
+                dec->bitCount++;
+                if (dec->bitCount >= dec->proto->bits) {
+                    dec->state = IR_DECODE_STOP;
+                }
+                return false;
+            }
+
+        default:
+            /* 空闲或状态异常：本载波可能是引导码 */
+            dec->state = IR_DECODE_LEADER_MARK;
+            return false;
+    }
+}
+
+/**
+  * @brief  载波结束（间隔开始）
+  */
+static bool IRDecode_OnMarkEnd(IRDecoder_t *dec, uint32_t timeUs, uint32_t markUs)
+{
+    dec->markUs = markUs;
+    uint32_t m = IRDecode_CorrectMark(dec, markUs);
+
+    switch (dec->state) {
+        case IR_DECODE_LEADER_MARK:
+            dec->candidates = 0;
+            for (uint8_t i = 0; i < IR_PROTO_COUNT; i++) {
+                if ((dec->protocolMask & IR_PROTO_MASK(i)) == 0U) continue;
+                const IRProtocol_t *p = &s_protocols[i];
+                if (IRDecode_AbsDiff(m, p->leaderMarkUs) <= IRDecode_Tolerance(dec, p->leaderMarkUs)) {
+                    dec->candidates |= IR_PROTO_MASK(i);
+                }
+            }
+            dec->state = (dec->candidates != 0U) ? IR_DECODE_LEADER_SPACE : IR_DECODE_IDLE;
+            return false;
+
+        case IR_DECODE_DATA:
+            if (dec->proto->coding == IR_CODING_PULSE_WIDTH) {
+                int8_t bit = IRDecode_ClassifyBit(dec, markUs, 0);
+                if (bit < 0) {
+                    IRDecode_Fail(dec, false);
+                    return false;
+                }
+                dec->data |= ((uint32_t)bit << dec->bitCount);
+                dec->bitCount++;
+                if (dec->bitCount >= dec->proto->bits) {
+                    return IRDecode_Finish(dec, timeUs);
+                }
+            }
+            return false;
+
+        case IR_DECODE_STOP:
+            if (IRDecode_AbsDiff(m, dec->proto->zeroMarkUs) > IRDecode_Tolerance(dec, dec->proto->zeroMarkUs)) {
+                IRDecode_Fail(dec, false);
+                return false;
+            }
+            return IRDecode_Finish(dec, timeUs);
+
+        case IR_DECODE_REPEAT:
+            dec->state = IR_DECODE_IDLE;
+            if (IRDecode_AbsDiff(m, dec->proto->zeroMarkUs) > IRDecode_Tolerance(dec, dec->proto->zeroMarkUs)) {
+                return false;
+            }
+            /* 重复帧只在同协议有效帧之后的窗口内有效 */
+            if (!dec->lastValid || dec->last.protocol != dec->proto->id ||
+                (timeUs - dec->lastFrameUs) > (uint32_t)dec->proto->repeatWindowMs * 1000U) {
+                return false;
+            }
+            dec->frame = dec->last;
+            dec->frame.repeat = true;
+            dec->frame.marginPct = 100;
+            dec->lastFrameUs = timeUs;
+            dec->ready = true;
+            dec->stats.repeatCount++;
+            return true;
+
+        default:
+            dec->state = IR_DECODE_IDLE;
+            return false;
+    }
+}
+
+/**
+  * @brief  帧是否已开始（引导码已确认）
+  */
+static bool IRDecode_InFrame(const IRDecoder_t *dec)
+{
+    return dec->state == IR_DECODE_DATA || dec->state == IR_DECODE_STOP || dec->state == IR_DECODE_REPEAT;
+}
+
+/**
+  * @brief  处理一个边沿
+  * @param  dec: 解码器对象指针
+  * @param  timeUs: 边沿时间（微秒，允许回绕）
+  * @param  mark: 边沿后的状态（true=载波开始，false=载波结束）
+  * @retval true=有新帧（含重复帧），用 IRDecoder_GetFrame 取出
+  */
+bool IRDecoder_ProcessEdge(IRDecoder_t *dec, uint32_t timeUs, bool mark)
+{
+    if (dec == NULL) return false;
+
+    uint32_t duration = timeUs - dec->lastEdgeUs;
+    dec->lastEdgeUs = timeUs;
+    dec->stats.edgeCount++;
+
+    /* 长时间无边沿：残帧作废 */
+    if (dec->state != IR_DECODE_IDLE && duration > IR_DECODE_FRAME_TIMEOUT_US) {
+        if (IRDecode_InFrame(dec)) {
+            dec->stats.timeoutCount++;
+        }
+        dec->state = IR_DECODE_IDLE;
+    }
+
+    /* 极性与上一边沿相同说明丢过边沿 */
+    if (mark == dec->inMark) {
+        IRDecode_Fail(dec, mark);
+        dec->markStartUs = timeUs;
+        return false;
+    }
+    dec->inMark = mark;
+
+    if (mark) {
+        return IRDecode_OnMarkStart(dec, timeUs, duration);
+    }
+    return IRDecode_OnMarkEnd(dec, timeUs, duration);
+}
+
+/**
+  * @brief  超时检查（无新边沿时定期调用）
+  * @param  dec: 解码器对象指针
+  * @param  nowUs: 当前时间（不早于已处理的最后一个边沿）
+  * @retval true=丢弃了超时的残帧
+  */
+bool IRDecoder_Poll(IRDecoder_t *dec, uint32_t nowUs)
+{
+    if (dec == NULL || dec->state == IR_DECODE_IDLE) return false;
+    if ((nowUs - dec->lastEdgeUs) <= IR_DECODE_FRAME_TIMEOUT_US) return false;
+
+    bool inFrame = IRDecode_InFrame(dec);
+    if (inFrame) {
+        dec->stats.timeoutCount++;
+    }
+    dec->state = IR_DECODE_IDLE;
+    return inFrame;
+}
+
+/**
+  * @brief  取出解码结果
+  * @param  dec: 解码器对象指针
+  * @param  frame: 输出帧
+  * @retval true=有新帧
+  */
+bool IRDecoder_GetFrame(IRDecoder_t *dec, IRFrame_t *frame)
+{
+    if (dec == NULL || frame == NULL || !dec->ready) return false;
+
+    *frame = dec->frame;
+    dec->ready = false;
+    return true;
+}
@@ -0,0 +1,147 @@
+/**
+  ******************************************************************************
+  * @file    ir_decode.h
+  * @brief   表驱动多协议红外解码引擎头文件
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 各协议的引导码、重复码、数据位时序以描述表给出，解码器按表查找对
+  * 每个载波脉冲/间隔分类，不再为每种协议手写状态机：
+  * - 容差自适应：基础比例容差 + 3倍实测抖动，上限为最大比例容差；
+  *   接收头普遍把载波脉冲拉宽、间隔缩短，偏置在线估计后先行补偿
+  * - 支持重复帧（NEC按住键时的 9ms+2.25ms 短帧）
+  * - 帧内超过 IR_DECODE_FRAME_TIMEOUT_US 无边沿时丢弃残帧并计数
+  * - 信号质量：边沿抖动、数据位判决裕度（0%=落在判决边界，100%=与标称一致）
+  * 与硬件无关，可直接在上位机编译，回放记录的边沿序列做测试。
+  ******************************************************************************
+  */
+
+#ifndef __IR_DECODE_H__
+#define __IR_DECODE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 协议编号 */
+typedef enum {
+    IR_PROTO_NEC = 0,               /* NEC 32位（充电座信标） */
+    IR_PROTO_SAMSUNG,               /* Samsung 32位（4.5ms引导码） */
+    IR_PROTO_SIRC12,                /* Sony SIRC 12位（脉宽编码） */
+    IR_PROTO_COUNT
+} IRProtocolId_t;
+
+#define IR_PROTO_MASK(id)           ((uint8_t)(1U << (id)))
+#define IR_PROTO_MASK_ALL           ((uint8_t)((1U << IR_PROTO_COUNT) - 1U))
+
+/* 编码方式 */
+typedef enum {
+    IR_CODING_PULSE_DISTANCE = 0,   /* 间隔长度区分0/1，帧尾有结束脉冲 */
+    IR_CODING_PULSE_WIDTH           /* 脉冲宽度区分0/1，无结束脉冲 */
+} IRCoding_t;
+
+/* 解码结果 */
+typedef struct {
+    IRProtocolId_t protocol;        /* 协议 */
+    uint32_t raw;                   /* 原始数据位（先收到的位在低位） */
+    uint16_t address;               /* 地址码 */
+    uint8_t command;                /* 命令码 */
+    uint8_t bits;                   /* 数据位数 */
+    bool repeat;                    /* 重复帧（沿用上一帧数据） */
+    uint8_t marginPct;              /* 本帧最小判决裕度 (%) */
+} IRFrame_t;
+
+/* 协议描述 */
+typedef struct {
+    IRProtocolId_t id;
+    IRCoding_t coding;
+    uint16_t leaderMarkUs;          /* 引导码载波 */
+    uint16_t leaderSpaceUs;         /* 引导码间隔 */
+    uint16_t repeatSpaceUs;         /* 重复帧间隔，0=无重复帧 */
+    uint16_t zeroMarkUs;            /* 数据0 载波 */
+    uint16_t zeroSpaceUs;           /* 数据0 间隔 */
+    uint16_t oneMarkUs;             /* 数据1 载波 */
+    uint16_t oneSpaceUs;            /* 数据1 间隔 */
+    uint8_t bits;                   /* 数据位数 */
+    uint16_t repeatWindowMs;        /* 重复帧须在上一帧后该时间内到达 */
+    bool (*unpack)(uint32_t raw, IRFrame_t *frame);  /* 校验并拆出地址/命令 */
+} IRProtocol_t;
+
+/* 解码状态 */
+typedef enum {
+    IR_DECODE_IDLE = 0,             /* 等待引导码 */
+    IR_DECODE_LEADER_MARK,          /* 引导码载波中 */
+    IR_DECODE_LEADER_SPACE,         /* 引导码间隔中 */
+    IR_DECODE_DATA,                 /* 数据位 */
+    IR_DECODE_STOP,                 /* 等待结束脉冲 */
+    IR_DECODE_REPEAT                /* 重复帧，等待结束脉冲 */
+} IRDecodeState_t;
+
+/* 解码统计与信号质量 */
+typedef struct {
+    uint32_t edgeCount;             /* 收到的边沿数 */
+    uint16_t frameCount;            /* 识别到的引导码数（帧开始） */
+    uint16_t okCount;               /* 解码成功帧数（不含重复帧） */
+    uint16_t repeatCount;           /* 重复帧数 */
+    uint16_t errorCount;            /* 时序/校验错误帧数 */
+    uint16_t timeoutCount;          /* 残帧超时数 */
+    uint16_t jitterUs;              /* 边沿抖动（平均绝对偏差，us） */
+    int16_t markBiasUs;             /* 接收头载波展宽估计 (us) */
+    uint8_t lastMarginPct;          /* 最近一帧最小判决裕度 (%) */
+    uint8_t worstMarginPct;         /* 统计期内最小判决裕度 (%) */
+} IRDecodeStats_t;
+
+/* 解码器 */
+typedef struct {
+    const IRProtocol_t *proto;      /* 当前帧协议 */
+    uint8_t protocolMask;           /* 允许的协议 */
+    uint8_t candidates;             /* 引导码载波匹配的协议 */
+    IRDecodeState_t state;
+    bool inMark;                    /* 当前处于载波中 */
+    uint32_t lastEdgeUs;            /* 上一边沿时间 */
+    uint32_t markStartUs;           /* 当前/上一载波起点 */
+    uint32_t markUs;                /* 上一载波长度 */
+    uint32_t data;                  /* 已收数据位 */
+    uint8_t bitCount;               /* 已收位数 */
+    uint8_t frameMargin;            /* 本帧最小裕度 */
+
+    /* 自适应（定点 x16） */
+    int32_t biasQ4;                 /* 载波展宽 */
+    int32_t jitterQ4;               /* 抖动 */
+
+    /* 重复帧 */
+    IRFrame_t last;                 /* 上一有效帧 */
+    bool lastValid;
+    uint32_t lastFrameUs;           /* 上一有效帧（含重复帧）结束时间 */
+
+    IRFrame_t frame;                /* 输出帧 */
+    bool ready;                     /* 输出帧就绪 */
+    IRDecodeStats_t stats;
+} IRDecoder_t;
+
+/* 调参 */
+#define IR_DECODE_TOL_BASE_PCT      25      /* 基础容差 (%) */
+#define IR_DECODE_TOL_MAX_PCT       50      /* 最大容差 (%) */
+#define IR_DECODE_TOL_MIN_US        150     /* 最小容差 (us) */
+#define IR_DECODE_JITTER_INIT_US    40      /* 抖动初值（尚无样本时） */
+#define IR_DECODE_BIAS_MAX_US       200     /* 载波展宽补偿上限 (us) */
+#define IR_DECODE_FRAME_TIMEOUT_US  12000U  /* 帧内无边沿超时 (us) */
+
+/* 函数声明 */
+void IRDecoder_Init(IRDecoder_t *dec, uint8_t protocolMask);
+void IRDecoder_Reset(IRDecoder_t *dec);
+void IRDecoder_ResetStats(IRDecoder_t *dec);
+bool IRDecoder_ProcessEdge(IRDecoder_t *dec, uint32_t timeUs, bool mark);
+bool IRDecoder_Poll(IRDecoder_t *dec, uint32_t nowUs);
+bool IRDecoder_GetFrame(IRDecoder_t *dec, IRFrame_t *frame);
+const IRProtocol_t* IRDecoder_GetProtocol(IRProtocolId_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __IR_DECODE_H__ */
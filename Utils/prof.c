@@ -0,0 +1,160 @@
+/**
+  ******************************************************************************
+  * @file    prof.c
+  * @brief   热点代码周期计数剖析实现
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "prof.h"
+#include "mem_section.h"
+#include <stddef.h>  /* 定义NULL */
+#include <string.h>
+
+#define PROF_CALIBRATE_RUNS     8U
+
+#if PROF_ENABLE
+/* 各探针统计 */
+CCM_DATA static ProfStats_t s_stats[PROF_COUNT];
+/* 周期探针上次经过的时间戳及其是否有效 */
+static uint32_t s_lastStamp[PROF_COUNT];
+static bool s_stampValid[PROF_COUNT];
+#endif
+
+/* 空探针开销（周期） */
+static uint16_t s_overhead = 0;
+
+/**
+  * @brief  使能DWT周期计数并测量空探针开销
+  * @retval None
+  */
+void Prof_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+#if PROF_ENABLE
+    uint32_t best = UINT32_MAX;
+    for (uint32_t i = 0; i < PROF_CALIBRATE_RUNS; i++) {
+        /* 与 PROF_BEGIN/PROF_END 相同的两次读取，中间无代码 */
+        uint32_t start = DWT->CYCCNT;
+        uint32_t cycles = DWT->CYCCNT - start;
+        if (cycles < best) {
+            best = cycles;
+        }
+    }
+    s_overhead = (best > UINT16_MAX) ? UINT16_MAX : (uint16_t)best;
+#endif
+    Prof_Reset();
+}
+
+/**
+  * @brief  计入一次测量（中断/任务均可调用）
+  * @param  id: 探针编号
+  * @param  cycles: 本次耗时（周期）
+  * @retval None
+  */
+void Prof_Record(ProfId_t id, uint32_t cycles)
+{
+#if PROF_ENABLE
+    if ((uint32_t)id >= PROF_COUNT) return;
+
+    uint32_t bucket = 0;
+    if (cycles != 0U) {
+        uint32_t log2 = 31U - __CLZ(cycles);
+        if (log2 >= PROF_HIST_MIN_LOG2) {
+            bucket = log2 - PROF_HIST_MIN_LOG2;
+            if (bucket >= PROF_HIST_BUCKETS) {
+                bucket = PROF_HIST_BUCKETS - 1U;
+            }
+        }
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    ProfStats_t *s = &s_stats[id];
+    if (s->count == 0U || cycles < s->minCycles) {
+        s->minCycles = cycles;
+    }
+    if (cycles > s->maxCycles) {
+        s->maxCycles = cycles;
+    }
+    s->count++;
+    s->sumCycles += cycles;
+    s->hist[bucket]++;
+    __set_PRIMASK(primask);
+#else
+    (void)id;
+    (void)cycles;
+#endif
+}
+
+/**
+  * @brief  计入距上次经过同一探针的间隔（中断/任务均可调用）
+  * @param  id: 探针编号
+  * @retval None
+  */
+void Prof_RecordPeriod(ProfId_t id)
+{
+#if PROF_ENABLE
+    if ((uint32_t)id >= PROF_COUNT) return;
+
+    uint32_t now = DWT->CYCCNT;
+    /* 探针只在一个上下文中使用，时间戳无需临界区 */
+    if (s_stampValid[id]) {
+        Prof_Record(id, now - s_lastStamp[id]);
+    }
+    s_lastStamp[id] = now;
+    s_stampValid[id] = true;
+#else
+    (void)id;
+#endif
+}
+
+/**
+  * @brief  读取探针统计快照
+  * @param  id: 探针编号
+  * @param  out: 输出
+  * @param  reset: 读取后清零（与读取在同一临界区内，不丢测量）
+  * @retval true=成功
+  */
+bool Prof_Get(ProfId_t id, ProfStats_t *out, bool reset)
+{
+    if (out == NULL || (uint32_t)id >= PROF_COUNT) return false;
+
+#if PROF_ENABLE
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *out = s_stats[id];
+    if (reset) {
+        memset(&s_stats[id], 0, sizeof(ProfStats_t));
+    }
+    __set_PRIMASK(primask);
+#else
+    (void)reset;
+    memset(out, 0, sizeof(ProfStats_t));
+#endif
+    return true;
+}
+
+/**
+  * @brief  清零全部探针
+  * @retval None
+  */
+void Prof_Reset(void)
+{
+#if PROF_ENABLE
+    for (uint32_t i = 0; i < PROF_COUNT; i++) {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        memset(&s_stats[i], 0, sizeof(ProfStats_t));
+        __set_PRIMASK(primask);
+    }
+#endif
+}
+
+uint16_t Prof_GetOverhead(void)
+{
+    return s_overhead;
+}
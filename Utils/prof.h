@@ -0,0 +1,84 @@
+/**
+  ******************************************************************************
+  * @file    prof.h
+  * @brief   热点代码周期计数剖析头文件
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 以 DWT CYCCNT 为时钟的命名探针：PROF_BEGIN/PROF_END 包住一段代码，
+  * 每次执行后累计次数、最小/最大/总周期数，并按 log2 分桶计入直方图
+  * （桶 i 覆盖 [2^(i+PROF_HIST_MIN_LOG2), 2^(i+1+PROF_HIST_MIN_LOG2)) 周期，
+  * 首桶含更短、末桶含更长）。每个探针只应在一个执行上下文中使用，
+  * 统计更新在短暂关中断内完成，中断与任务中均可埋点。
+  * PROF_PERIOD 记录相邻两次经过同一点的间隔，用于衡量周期性中断与
+  * 控制循环的抖动（max-min），首次经过只记时间戳。
+  * USB 0x14 命令读取/清零统计表，0x2C 帧逐个探针上传，
+  * 上位机 TEST/prof_tool.py 显示并比较前后两次测量。
+  * PROF_ENABLE=0 时宏不产生任何代码。
+  ******************************************************************************
+  */
+
+#ifndef __PROF_H__
+#define __PROF_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "system_config.h"
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 直方图桶数与首桶上界（2^PROF_HIST_MIN_LOG2 周期） */
+#define PROF_HIST_BUCKETS           16U
+#define PROF_HIST_MIN_LOG2          5U
+
+/* 探针编号（上位机 prof_tool.py 按同一顺序命名） */
+typedef enum {
+    PROF_WHEEL_CTRL = 0,        /* MotorCtrlTask_WheelMotorControl */
+    PROF_MOTOR_OUTPUT,          /* 电机控制任务输出级（轮/刷/泵/风机/斜坡） */
+    PROF_ENCODER_TICK,          /* Encoder_On1kHzTick（TIM7中断，单个编码器） */
+    PROF_IMU_PARSE,             /* wit_consume_ring */
+    PROF_USB_SEND_FRAME,        /* USBCommTask_SendFrame */
+    PROF_TIM7_PERIOD,           /* TIM7 1kHz中断相邻两次进入的间隔 */
+    PROF_CTRL_PERIOD,           /* 电机控制循环相邻两次开始的间隔（2ms，安全反射提前唤醒时变短） */
+    PROF_WAKE_LATENCY,          /* tickless 睡眠唤醒到首个非空闲任务切入（power_mgr.c） */
+    PROF_BLACKBOX_RECORD,       /* BlackBox_Record（传感器任务，差分编码一条记录） */
+    PROF_COUNT
+} ProfId_t;
+
+/* 单个探针统计 */
+typedef struct {
+    uint32_t count;             /* 执行次数 */
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint64_t sumCycles;
+    uint32_t hist[PROF_HIST_BUCKETS];
+} ProfStats_t;
+
+/* 函数声明 */
+void Prof_Init(void);                                   /* 使能DWT并测量空探针开销 */
+void Prof_Record(ProfId_t id, uint32_t cycles);
+void Prof_RecordPeriod(ProfId_t id);                    /* 计入距上次调用的间隔 */
+bool Prof_Get(ProfId_t id, ProfStats_t *out, bool reset);   /* 读取快照，可同时清零 */
+void Prof_Reset(void);                                  /* 清零全部探针 */
+uint16_t Prof_GetOverhead(void);                        /* 空探针开销（周期），未从统计中扣除 */
+
+/* 埋点宏：BEGIN/END 须在同一作用域内成对使用；PROF_ENABLE=0 时不产生代码 */
+#if PROF_ENABLE
+#define PROF_BEGIN(id)              uint32_t prof_start_##id = DWT->CYCCNT
+#define PROF_END(id)                Prof_Record((id), DWT->CYCCNT - prof_start_##id)
+#define PROF_PERIOD(id)             Prof_RecordPeriod(id)
+#else
+#define PROF_BEGIN(id)              ((void)0)
+#define PROF_END(id)                ((void)0)
+#define PROF_PERIOD(id)             ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PROF_H__ */
@@ -0,0 +1,117 @@
+/**
+  ******************************************************************************
+  * @file    task_stats.c
+  * @brief   任务运行统计实现
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "task_stats.h"
+#include <stdbool.h>
+#include <string.h>
+
+/* 空闲任务名（与 tasks.c 默认值一致） */
+#ifndef configIDLE_TASK_NAME
+#define configIDLE_TASK_NAME        "IDLE"
+#endif
+
+/* 统计结果 */
+static TaskStats_t s_stats;
+
+/* uxTaskGetSystemState 输出缓冲（静态分配，避免占用调用任务的栈） */
+static TaskStatus_t s_status[TASK_STATS_MAX_TASKS];
+
+/* 上次采样时的总运行时间 (us) */
+static uint32_t s_lastTotalUs = 0;
+
+/**
+  * @brief  查找上次采样中同编号任务的累计运行时间
+  * @retval true=找到
+  */
+static bool TaskStats_FindPrevious(const TaskStatsEntry_t *prev, uint8_t count, uint8_t number, uint32_t *runTimeUs)
+{
+    for (uint8_t i = 0; i < count; i++) {
+        if (prev[i].number == number) {
+            *runTimeUs = prev[i].runTimeUs;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+  * @brief  采样一次全部任务的运行统计
+  * @note   新建任务首次出现时以0为起点，窗口内占用按其全部运行时间计
+  * @retval None
+  */
+void TaskStats_Sample(void)
+{
+    static TaskStatsEntry_t prev[TASK_STATS_MAX_TASKS];
+    uint32_t totalUs = 0;
+
+    UBaseType_t count = uxTaskGetSystemState(s_status, TASK_STATS_MAX_TASKS, &totalUs);
+    if (count == 0U) {
+        return;
+    }
+
+    uint8_t prevCount = s_stats.count;
+    memcpy(prev, s_stats.task, sizeof(prev));
+
+    uint32_t windowUs = totalUs - s_lastTotalUs;
+    s_lastTotalUs = totalUs;
+    uint32_t idleUs = 0;
+
+    for (UBaseType_t i = 0; i < count; i++) {
+        const TaskStatus_t *st = &s_status[i];
+        TaskStatsEntry_t *e = &s_stats.task[i];
+        uint32_t lastRunUs = 0;
+
+        (void)TaskStats_FindPrevious(prev, prevCount, (uint8_t)st->xTaskNumber, &lastRunUs);
+        uint32_t runUs = st->ulRunTimeCounter - lastRunUs;
+
+        strncpy(e->name, st->pcTaskName, configMAX_TASK_NAME_LEN - 1);
+        e->name[configMAX_TASK_NAME_LEN - 1] = '\0';
+        e->number = (uint8_t)st->xTaskNumber;
+        e->priority = (uint8_t)st->uxCurrentPriority;
+        e->state = (uint8_t)st->eCurrentState;
+        e->stackFreeWords = (st->usStackHighWaterMark > 0xFFFFU) ? 0xFFFFU : (uint16_t)st->usStackHighWaterMark;
+        e->runTimeUs = st->ulRunTimeCounter;
+        e->cpuPermille = (windowUs > 0U) ?
+                         (uint16_t)(((uint64_t)runUs * 1000U + windowUs / 2U) / windowUs) : 0U;
+        if (e->cpuPermille > 1000U) {
+            e->cpuPermille = 1000U;
+        }
+
+        if (strcmp(st->pcTaskName, configIDLE_TASK_NAME) == 0) {
+            idleUs = runUs;
+        }
+    }
+
+    /* 按任务编号排序，上位机显示顺序固定 */
+    for (UBaseType_t i = 1; i < count; i++) {
+        TaskStatsEntry_t key = s_stats.task[i];
+        UBaseType_t j = i;
+        while (j > 0U && s_stats.task[j - 1U].number > key.number) {
+            s_stats.task[j] = s_stats.task[j - 1U];
+            j--;
+        }
+        s_stats.task[j] = key;
+    }
+
+    s_stats.count = (uint8_t)count;
+    s_stats.windowUs = windowUs;
+    s_stats.cpuLoadPermille = (windowUs > 0U && idleUs < windowUs) ?
+                              (uint16_t)(((uint64_t)(windowUs - idleUs) * 1000U) / windowUs) : 0U;
+    s_stats.heapFree = (uint32_t)xPortGetFreeHeapSize();
+    s_stats.heapMinFree = (uint32_t)xPortGetMinimumEverFreeHeapSize();
+    s_stats.sampleCount++;
+}
+
+/**
+  * @brief  获取最近一次采样结果
+  */
+const TaskStats_t* TaskStats_Get(void)
+{
+    return &s_stats;
+}
@@ -0,0 +1,61 @@
+/**
+  ******************************************************************************
+  * @file    task_stats.h
+  * @brief   任务运行统计头文件（CPU占用/栈余量/堆余量）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * FreeRTOS 运行时间统计以 Timebase_GetUs() 的微秒计数为时基（见
+  * FreeRTOSConfig.h），每次采样用 uxTaskGetSystemState 取各任务累计运行
+  * 时间，与上次采样相减得到本窗口的 CPU 占用（千分比），计数按 2^32us
+  * 回绕，采样间隔远小于回绕周期即可。栈余量为 uxTaskGetStackHighWaterMark
+  * 的历史最小剩余（字），堆为 heap_4 的当前剩余与历史最小剩余。
+  ******************************************************************************
+  */
+
+#ifndef __TASK_STATS_H__
+#define __TASK_STATS_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdint.h>
+
+/* 最多统计的任务数（须大于实际任务数，否则 uxTaskGetSystemState 不返回数据） */
+#define TASK_STATS_MAX_TASKS        12
+
+/* 单个任务统计 */
+typedef struct {
+    char name[configMAX_TASK_NAME_LEN];
+    uint8_t number;             /* 任务编号（创建顺序） */
+    uint8_t priority;           /* 当前优先级 */
+    uint8_t state;              /* eTaskState：0运行/1就绪/2阻塞/3挂起/4删除 */
+    uint16_t cpuPermille;       /* 本窗口CPU占用 (‰) */
+    uint16_t stackFreeWords;    /* 栈历史最小剩余 (字) */
+    uint32_t runTimeUs;         /* 累计运行时间 (us，2^32回绕) */
+} TaskStatsEntry_t;
+
+/* 任务运行统计 */
+typedef struct {
+    TaskStatsEntry_t task[TASK_STATS_MAX_TASKS];
+    uint8_t count;              /* 任务数 */
+    uint16_t cpuLoadPermille;   /* 本窗口除空闲任务外的CPU占用 (‰) */
+    uint32_t windowUs;          /* 本窗口长度 (us) */
+    uint32_t heapFree;          /* 堆当前剩余 (字节) */
+    uint32_t heapMinFree;       /* 堆历史最小剩余 (字节) */
+    uint32_t sampleCount;       /* 采样次数 */
+} TaskStats_t;
+
+/* 函数声明 */
+void TaskStats_Sample(void);                /* 采样一次（任务上下文，内部挂起调度器遍历任务） */
+const TaskStats_t* TaskStats_Get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TASK_STATS_H__ */
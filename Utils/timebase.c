@@ -0,0 +1,67 @@
+/**
+  ******************************************************************************
+  * @file    timebase.c
+  * @brief   微秒时间基准实现（DWT周期计数器）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "timebase.h"
+#include "main.h"
+
+/* 每微秒周期数 */
+static uint32_t s_cyclesPerUs = 1;
+
+/* 已折算为微秒的周期计数位置 */
+static uint32_t s_lastCycles = 0;
+
+/* 微秒累计值 */
+static uint32_t s_usCounter = 0;
+
+/**
+  * @brief  初始化时间基准（使能DWT周期计数器）
+  * @retval None
+  */
+void Timebase_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    s_cyclesPerUs = SystemCoreClock / 1000000U;
+    if (s_cyclesPerUs == 0U) {
+        s_cyclesPerUs = 1;
+    }
+    s_lastCycles = DWT->CYCCNT;
+    s_usCounter = 0;
+}
+
+/**
+  * @brief  获取当前微秒计数（中断/任务均可调用）
+  * @note   不足1us的周期余数保留到下次折算，不会累积误差
+  * @retval 微秒计数，2^32us回绕
+  */
+uint32_t Timebase_GetUs(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t cycles = DWT->CYCCNT;
+    uint32_t elapsed = cycles - s_lastCycles;
+    uint32_t us = elapsed / s_cyclesPerUs;
+    s_usCounter += us;
+    s_lastCycles += us * s_cyclesPerUs;
+    uint32_t now = s_usCounter;
+
+    __set_PRIMASK(primask);
+    return now;
+}
+
+/**
+  * @brief  周期折算，防止DWT计数器回绕丢失（需在25s内至少调用一次）
+  * @retval None
+  */
+void Timebase_Update(void)
+{
+    (void)Timebase_GetUs();
+}
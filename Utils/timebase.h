@@ -0,0 +1,35 @@
+/**
+  ******************************************************************************
+  * @file    timebase.h
+  * @brief   微秒时间基准头文件（DWT周期计数器）
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * HAL_GetTick() 只有1ms分辨率，无法满足红外编码（NEC位宽562/1687us）的
+  * 边沿测量。此处以内核DWT周期计数器为基准，扩展为按2^32us自然回绕的
+  * 32位微秒计数，可在中断与任务中调用，边沿间隔直接用无符号减法计算。
+  * DWT计数器在168MHz下约25.5s回绕一次，Timebase_Update() 需在此周期内
+  * 至少调用一次（由传感器任务周期调用）。
+  ******************************************************************************
+  */
+
+#ifndef __TIMEBASE_H__
+#define __TIMEBASE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* 函数声明 */
+void Timebase_Init(void);
+uint32_t Timebase_GetUs(void);
+void Timebase_Update(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIMEBASE_H__ */
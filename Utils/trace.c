@@ -0,0 +1,156 @@
+/**
+  ******************************************************************************
+  * @file    trace.c
+  * @brief   二进制事件跟踪实现
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  */
+
+#include "trace.h"
+#include "main.h"
+#include "mem_section.h"
+#include <stddef.h>  /* 定义NULL */
+
+#define TRACE_RING_MASK     (TRACE_RING_EVENTS - 1U)
+
+/* 环形缓冲大小须为2的幂 */
+typedef char TraceRingSizeCheck_t[((TRACE_RING_EVENTS & TRACE_RING_MASK) == 0U) ? 1 : -1];
+
+#if TRACE_ENABLE
+/* 事件环形缓冲 */
+CCM_DATA static TraceEvent_t s_ring[TRACE_RING_EVENTS];
+#endif
+
+/* 已写入事件总数 */
+static volatile uint32_t s_head = 0;
+
+/* 是否记录 */
+static volatile bool s_running = false;
+
+/**
+  * @brief  使能DWT周期计数并开始记录
+  * @retval None
+  */
+void Trace_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    Trace_Start();
+}
+
+/**
+  * @brief  清空并开始记录
+  * @retval None
+  */
+void Trace_Start(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    s_head = 0;
+    s_running = (TRACE_ENABLE != 0);
+    __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  停止记录，缓冲内容保持不变供导出
+  * @retval None
+  */
+void Trace_Stop(void)
+{
+    s_running = false;
+}
+
+bool Trace_IsRunning(void)
+{
+    return s_running;
+}
+
+/**
+  * @brief  记录一个事件（中断/任务均可调用）
+  * @param  type: 事件类型
+  * @param  id: 中断/任务/标记编号
+  * @param  arg: 参数
+  * @retval None
+  */
+void Trace_Record(uint8_t type, uint8_t id, uint16_t arg)
+{
+#if TRACE_ENABLE
+    if (!s_running) return;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    TraceEvent_t *e = &s_ring[s_head & TRACE_RING_MASK];
+    e->cycles = DWT->CYCCNT;
+    e->type = type;
+    e->id = id;
+    e->arg = arg;
+    s_head++;
+    __set_PRIMASK(primask);
+#else
+    (void)type;
+    (void)id;
+    (void)arg;
+#endif
+}
+
+/**
+  * @brief  任务切换钩子（在调度器临界区内调用）
+  * @param  taskNumber: 切入任务的编号
+  * @retval None
+  */
+void Trace_TaskSwitchedIn(uint32_t taskNumber)
+{
+    Trace_Record(TRACE_EV_TASK_IN, (uint8_t)taskNumber, 0U);
+}
+
+uint32_t Trace_GetHead(void)
+{
+    return s_head;
+}
+
+/**
+  * @brief  缓冲中最旧事件的绝对序号
+  */
+uint32_t Trace_GetOldest(void)
+{
+    uint32_t head = s_head;
+    return (head > TRACE_RING_EVENTS) ? (head - TRACE_RING_EVENTS) : 0U;
+}
+
+/**
+  * @brief  按绝对序号读取事件
+  * @param  index: 输入起始序号，输出下一次读取的序号；起始事件已被覆盖时跳到最旧事件
+  * @param  out: 输出缓冲
+  * @param  max: 最多读取个数
+  * @retval 实际读取个数
+  */
+uint32_t Trace_Read(uint32_t *index, TraceEvent_t *out, uint32_t max)
+{
+#if TRACE_ENABLE
+    if (index == NULL || out == NULL) return 0;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t head = s_head;
+    uint32_t oldest = (head > TRACE_RING_EVENTS) ? (head - TRACE_RING_EVENTS) : 0U;
+    uint32_t i = *index;
+    if ((int32_t)(i - oldest) < 0) {
+        i = oldest;
+    }
+    uint32_t n = 0;
+    while (n < max && i != head) {
+        out[n++] = s_ring[i & TRACE_RING_MASK];
+        i++;
+    }
+    __set_PRIMASK(primask);
+
+    *index = i;
+    return n;
+#else
+    (void)index;
+    (void)out;
+    (void)max;
+    return 0;
+#endif
+}
@@ -0,0 +1,95 @@
+/**
+  ******************************************************************************
+  * @file    trace.h
+  * @brief   二进制事件跟踪头文件
+  * @author  CleanBot Team
+  * @date    2025-01-XX
+  ******************************************************************************
+  * @attention
+  * 每个事件8字节：DWT周期计数时间戳 + 类型 + 编号 + 参数，写入固定大小的
+  * 环形缓冲（满后覆盖最旧事件），中断与任务中均可记录，写入时短暂关中断。
+  * 事件以写入总数作为绝对序号，读取方据此发现被覆盖而丢失的事件。
+  * 来源：中断进出（TIM7/EXTI/USART3/OTG_FS）、FreeRTOS 任务切换钩子
+  * traceTASK_SWITCHED_IN、控制循环与USB解析中的标记。USB 0x13 命令控制
+  * 启停/导出/连续推送，0x2B 帧上传，上位机 TEST/trace_tool.py 转换为
+  * Chrome trace / Perfetto 可打开的 JSON 时间线。
+  * DWT计数在168MHz下约25.5s回绕，上位机按事件顺序展开，相邻事件间隔
+  * 超过回绕周期时时间线会错位。
+  ******************************************************************************
+  */
+
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "system_config.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 事件类型 */
+typedef enum {
+    TRACE_EV_ISR_ENTER = 1,     /* id=TraceIsrId_t，arg=EXTI线号等 */
+    TRACE_EV_ISR_EXIT,
+    TRACE_EV_TASK_IN,           /* id=任务编号（uxTaskNumber，与0x23任务统计一致） */
+    TRACE_EV_MARK_BEGIN,        /* id=TraceMarkId_t，arg=附加值 */
+    TRACE_EV_MARK_END,
+    TRACE_EV_MARK               /* 瞬时标记 */
+} TraceEventType_t;
+
+/* 中断编号 */
+typedef enum {
+    TRACE_ISR_TIM7 = 0,
+    TRACE_ISR_EXTI,
+    TRACE_ISR_USART3,
+    TRACE_ISR_OTG_FS
+} TraceIsrId_t;
+
+/* 代码标记编号 */
+typedef enum {
+    TRACE_MARK_MOTOR_LOOP = 0,  /* 电机控制循环一次 */
+    TRACE_MARK_USB_FRAME,       /* USB帧分发，arg=msgId */
+    TRACE_MARK_SENSOR_BATCH     /* 传感器任务一次唤醒处理的事件数，arg=batch */
+} TraceMarkId_t;
+
+/* 跟踪事件 */
+typedef struct {
+    uint32_t cycles;            /* DWT周期计数 */
+    uint8_t type;               /* TraceEventType_t */
+    uint8_t id;
+    uint16_t arg;
+} TraceEvent_t;
+
+/* 函数声明 */
+void Trace_Init(void);                          /* 使能DWT并开始记录 */
+void Trace_Start(void);                         /* 清空并开始记录 */
+void Trace_Stop(void);                          /* 停止记录（冻结缓冲内容） */
+bool Trace_IsRunning(void);
+void Trace_Record(uint8_t type, uint8_t id, uint16_t arg);
+void Trace_TaskSwitchedIn(uint32_t taskNumber); /* FreeRTOS traceTASK_SWITCHED_IN 钩子 */
+uint32_t Trace_GetHead(void);                   /* 已写入事件总数（下一事件的绝对序号） */
+uint32_t Trace_GetOldest(void);                 /* 缓冲中最旧事件的绝对序号 */
+uint32_t Trace_Read(uint32_t *index, TraceEvent_t *out, uint32_t max);
+
+/* 埋点宏：TRACE_ENABLE=0 时不产生代码 */
+#if TRACE_ENABLE
+#define TRACE_ISR_ENTER(id, arg)    Trace_Record(TRACE_EV_ISR_ENTER, (uint8_t)(id), (uint16_t)(arg))
+#define TRACE_ISR_EXIT(id)          Trace_Record(TRACE_EV_ISR_EXIT, (uint8_t)(id), 0U)
+#define TRACE_MARK_BEGIN(id, arg)   Trace_Record(TRACE_EV_MARK_BEGIN, (uint8_t)(id), (uint16_t)(arg))
+#define TRACE_MARK_END(id)          Trace_Record(TRACE_EV_MARK_END, (uint8_t)(id), 0U)
+#define TRACE_MARK(id, arg)         Trace_Record(TRACE_EV_MARK, (uint8_t)(id), (uint16_t)(arg))
+#else
+#define TRACE_ISR_ENTER(id, arg)    ((void)0)
+#define TRACE_ISR_EXIT(id)          ((void)0)
+#define TRACE_MARK_BEGIN(id, arg)   ((void)0)
+#define TRACE_MARK_END(id)          ((void)0)
+#define TRACE_MARK(id, arg)         ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TRACE_H__ */